@@ -0,0 +1 @@
+/usr/share/aclocal/lt~obsolete.m4
\ No newline at end of file
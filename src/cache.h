@@ -80,6 +80,9 @@ struct cache {
   /* Particle sound speed. */
   float *restrict soundspeed SWIFT_CACHE_ALIGN;
 
+  /* Particle time-bin (stored as a float for the limiter comparisons). */
+  float *restrict time_bin SWIFT_CACHE_ALIGN;
+
   /* Cache size. */
   int count;
 };
@@ -146,6 +149,7 @@ __attribute__((always_inline)) INLINE void cache_init(struct cache *c,
     free(c->pOrho2);
     free(c->balsara);
     free(c->soundspeed);
+    free(c->time_bin);
   }
 
   error += posix_memalign((void **)&c->x, SWIFT_CACHE_ALIGNMENT, sizeBytes);
@@ -167,6 +171,8 @@ __attribute__((always_inline)) INLINE void cache_init(struct cache *c,
       posix_memalign((void **)&c->balsara, SWIFT_CACHE_ALIGNMENT, sizeBytes);
   error +=
       posix_memalign((void **)&c->soundspeed, SWIFT_CACHE_ALIGNMENT, sizeBytes);
+  error +=
+      posix_memalign((void **)&c->time_bin, SWIFT_CACHE_ALIGNMENT, sizeBytes);
 
   if (error != 0)
     error("Couldn't allocate cache, no. of particles: %d", (int)count);
@@ -1069,6 +1075,160 @@ cache_read_two_partial_cells_sorted_force(
   }
 }
 
+/**
+ * @brief Populate cache for the time-step limiter loops by reading in the
+ * particles in unsorted order.
+ *
+ * Only the positions, smoothing lengths and time-bins are read. Particles not
+ * starting their step get a zero smoothing length such that they are never
+ * found to be in range of their neighbours. Inhibited and padded particles
+ * get a zero time-bin such that they can never be woken up.
+ *
+ * Unlike the hydro readers, this function is independent of the flavour of
+ * SPH as it only reads generic #part fields.
+ *
+ * @param ci The #cell.
+ * @param ci_cache The cache.
+ * @param max_active_bin The largest time-bin starting its step now.
+ * @return count_align The no. of particles in the cache padded to a multiple
+ * of the vector length.
+ */
+__attribute__((always_inline)) INLINE int cache_read_particles_limiter(
+    const struct cell *restrict const ci, struct cache *restrict const ci_cache,
+    const timebin_t max_active_bin) {
+
+  /* Let the compiler know that the data is aligned and create pointers to the
+   * arrays inside the cache. */
+  swift_declare_aligned_ptr(float, x, ci_cache->x, SWIFT_CACHE_ALIGNMENT);
+  swift_declare_aligned_ptr(float, y, ci_cache->y, SWIFT_CACHE_ALIGNMENT);
+  swift_declare_aligned_ptr(float, z, ci_cache->z, SWIFT_CACHE_ALIGNMENT);
+  swift_declare_aligned_ptr(float, h, ci_cache->h, SWIFT_CACHE_ALIGNMENT);
+  swift_declare_aligned_ptr(float, tb, ci_cache->time_bin,
+                            SWIFT_CACHE_ALIGNMENT);
+
+  const int count = ci->hydro.count;
+  const struct part *restrict parts = ci->hydro.parts;
+  const double loc[3] = {ci->loc[0], ci->loc[1], ci->loc[2]};
+  const double max_dx = ci->hydro.dx_max_part;
+  const float pos_padded[3] = {-(2. * ci->width[0] + max_dx),
+                               -(2. * ci->width[1] + max_dx),
+                               -(2. * ci->width[2] + max_dx)};
+
+  /* Shift the particles positions to a local frame so single precision can be
+   * used instead of double precision. */
+  for (int i = 0; i < count; i++) {
+
+    /* Pad inhibited particles. */
+    if (parts[i].time_bin >= time_bin_inhibited) {
+      x[i] = pos_padded[0];
+      y[i] = pos_padded[1];
+      z[i] = pos_padded[2];
+      h[i] = 0.f;
+      tb[i] = 0.f;
+
+      continue;
+    }
+
+    x[i] = (float)(parts[i].x[0] - loc[0]);
+    y[i] = (float)(parts[i].x[1] - loc[1]);
+    z[i] = (float)(parts[i].x[2] - loc[2]);
+    h[i] = (parts[i].time_bin <= max_active_bin) ? parts[i].h : 0.f;
+    tb[i] = (float)parts[i].time_bin;
+  }
+
+  /* Pad cache if the no. of particles is not a multiple of the vector
+   * length. */
+  int count_align = count;
+  const int rem = count % VEC_SIZE;
+  if (rem != 0) {
+    count_align += VEC_SIZE - rem;
+
+    /* Set positions to something outside of the range of any particle */
+    for (int i = count; i < count_align; i++) {
+      x[i] = pos_padded[0];
+      y[i] = pos_padded[1];
+      z[i] = pos_padded[2];
+      h[i] = 0.f;
+      tb[i] = 0.f;
+    }
+  }
+
+  return count_align;
+}
+
+/**
+ * @brief Populate cache for the time-step limiter pair loops by reading in
+ * the particles in sorted order.
+ *
+ * The positions are expressed relative to the frame given by @c loc (i.e. the
+ * position of the other cell, including any periodic shift). The cache is
+ * padded with fake particles that can never be woken up.
+ *
+ * @param ci The #cell.
+ * @param sort The sorted list of particles along the pair axis.
+ * @param loc The origin of the frame in which to express the positions.
+ * @param ci_cache The cache.
+ * @return count_align The no. of particles in the cache padded to a multiple
+ * of the vector length.
+ */
+__attribute__((always_inline)) INLINE int cache_read_particles_sorted_limiter(
+    const struct cell *restrict const ci,
+    const struct sort_entry *restrict const sort, const double loc[3],
+    struct cache *restrict const ci_cache) {
+
+  /* Let the compiler know that the data is aligned and create pointers to the
+   * arrays inside the cache. */
+  swift_declare_aligned_ptr(float, x, ci_cache->x, SWIFT_CACHE_ALIGNMENT);
+  swift_declare_aligned_ptr(float, y, ci_cache->y, SWIFT_CACHE_ALIGNMENT);
+  swift_declare_aligned_ptr(float, z, ci_cache->z, SWIFT_CACHE_ALIGNMENT);
+  swift_declare_aligned_ptr(float, tb, ci_cache->time_bin,
+                            SWIFT_CACHE_ALIGNMENT);
+
+  const int count = ci->hydro.count;
+  const struct part *restrict parts = ci->hydro.parts;
+  const double max_dx = ci->hydro.dx_max_part;
+  const float pos_padded[3] = {-(2. * ci->width[0] + max_dx),
+                               -(2. * ci->width[1] + max_dx),
+                               -(2. * ci->width[2] + max_dx)};
+
+  for (int i = 0; i < count; i++) {
+    const struct part *restrict p = &parts[sort[i].i];
+
+    /* Pad inhibited particles. */
+    if (p->time_bin >= time_bin_inhibited) {
+      x[i] = pos_padded[0];
+      y[i] = pos_padded[1];
+      z[i] = pos_padded[2];
+      tb[i] = 0.f;
+
+      continue;
+    }
+
+    x[i] = (float)(p->x[0] - loc[0]);
+    y[i] = (float)(p->x[1] - loc[1]);
+    z[i] = (float)(p->x[2] - loc[2]);
+    tb[i] = (float)p->time_bin;
+  }
+
+  /* Pad cache if the no. of particles is not a multiple of the vector
+   * length. */
+  int count_align = count;
+  const int rem = count % VEC_SIZE;
+  if (rem != 0) {
+    count_align += VEC_SIZE - rem;
+
+    /* Set positions to something outside of the range of any particle */
+    for (int i = count; i < count_align; i++) {
+      x[i] = pos_padded[0];
+      y[i] = pos_padded[1];
+      z[i] = pos_padded[2];
+      tb[i] = 0.f;
+    }
+  }
+
+  return count_align;
+}
+
 /**
  * @brief Clean the memory allocated by a #cache object.
  *
@@ -1090,6 +1250,7 @@ static INLINE void cache_clean(struct cache *c) {
     free(c->pOrho2);
     free(c->balsara);
     free(c->soundspeed);
+    free(c->time_bin);
   }
   c->count = 0;
 }
@@ -539,8 +539,9 @@ int cell_pack_end_step(const struct cell *c, struct pcell_step *pcell);
 int cell_unpack_end_step(struct cell *c, const struct pcell_step *pcell);
 void cell_pack_timebin(const struct cell *const c, timebin_t *const t);
 void cell_unpack_timebin(struct cell *const c, timebin_t *const t);
-int cell_pack_multipoles(struct cell *c, struct gravity_tensors *m);
-int cell_unpack_multipoles(struct cell *c, struct gravity_tensors *m);
+int cell_pack_multipoles(struct cell *c, struct gravity_tensors_foreign *m);
+int cell_unpack_multipoles(struct cell *c,
+                           struct gravity_tensors_foreign *m);
 int cell_pack_sf_counts(struct cell *c, struct pcell_sf *pcell);
 int cell_unpack_sf_counts(struct cell *c, struct pcell_sf *pcell);
 int cell_get_tree_size(struct cell *c);
@@ -1165,6 +1166,22 @@ __attribute__((always_inline)) INLINE static void cell_free_hydro_sorts(
 #endif
 }
 
+/**
+ * @brief Free the cached list of long-range M-M partners of a top-level cell.
+ *
+ * @param c The #cell.
+ */
+__attribute__((always_inline)) INLINE static void
+cell_free_grav_long_range_list(struct cell *c) {
+
+  if (c->grav.long_range_list != NULL) {
+    swift_free("grav.long_range_list", c->grav.long_range_list);
+    c->grav.long_range_list = NULL;
+  }
+  c->grav.long_range_count = 0;
+  c->grav.long_range_has_far = 0;
+}
+
 /**
  * @brief Returns the array of sorted indices for the gas particles of a given
  * cell along agiven direction.
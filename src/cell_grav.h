@@ -68,6 +68,17 @@ struct cell_grav {
   /*! Task computing long range non-periodic gravity interactions */
   struct task *long_range;
 
+  /*! Indices in the top-level cell array of the cells this top-level cell
+   * interacts with via M-M in the long-range task. Valid until the next
+   * rebuild. */
+  int *long_range_list;
+
+  /*! Number of entries in #long_range_list */
+  int long_range_count;
+
+  /*! Are there top-level cells beyond the mesh truncation distance? */
+  char long_range_has_far;
+
   /*! Implicit task for the down propagation */
   struct task *down_in;
 
@@ -244,6 +244,9 @@ int cell_unpack(struct pcell *restrict pc, struct cell *restrict c,
     mp->CoM_rebuild[2] = pc->grav.CoM_rebuild[2];
     mp->r_max = pc->grav.r_max;
     mp->r_max_rebuild = pc->grav.r_max_rebuild;
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+    mp->mac_tolerance_factor = 1.f;
+#endif
   }
 
   /* Number of new cells created. */
@@ -470,11 +473,23 @@ void cell_unpack_timebin(struct cell *const c, timebin_t *const t) {
  * @return The number of packed cells.
  */
 int cell_pack_multipoles(struct cell *restrict c,
-                         struct gravity_tensors *restrict pcells) {
+                         struct gravity_tensors_foreign *restrict pcells) {
 #ifdef WITH_MPI
 
-  /* Pack this cell's data. */
-  pcells[0] = *c->grav.multipole;
+  /* Pack this cell's data (everything but the field tensor). */
+  const struct gravity_tensors *mp = c->grav.multipole;
+  pcells[0].m_pole = mp->m_pole;
+  pcells[0].CoM[0] = mp->CoM[0];
+  pcells[0].CoM[1] = mp->CoM[1];
+  pcells[0].CoM[2] = mp->CoM[2];
+  pcells[0].CoM_rebuild[0] = mp->CoM_rebuild[0];
+  pcells[0].CoM_rebuild[1] = mp->CoM_rebuild[1];
+  pcells[0].CoM_rebuild[2] = mp->CoM_rebuild[2];
+  pcells[0].r_max = mp->r_max;
+  pcells[0].r_max_rebuild = mp->r_max_rebuild;
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+  pcells[0].mac_tolerance_factor = mp->mac_tolerance_factor;
+#endif
 
   /* Fill in the progeny, depth-first recursion. */
   int count = 1;
@@ -501,11 +516,23 @@ int cell_pack_multipoles(struct cell *restrict c,
  * @return The number of cells created.
  */
 int cell_unpack_multipoles(struct cell *restrict c,
-                           struct gravity_tensors *restrict pcells) {
+                           struct gravity_tensors_foreign *restrict pcells) {
 #ifdef WITH_MPI
 
   /* Unpack this cell's data. */
-  *c->grav.multipole = pcells[0];
+  struct gravity_tensors *mp = c->grav.multipole;
+  mp->m_pole = pcells[0].m_pole;
+  mp->CoM[0] = pcells[0].CoM[0];
+  mp->CoM[1] = pcells[0].CoM[1];
+  mp->CoM[2] = pcells[0].CoM[2];
+  mp->CoM_rebuild[0] = pcells[0].CoM_rebuild[0];
+  mp->CoM_rebuild[1] = pcells[0].CoM_rebuild[1];
+  mp->CoM_rebuild[2] = pcells[0].CoM_rebuild[2];
+  mp->r_max = pcells[0].r_max;
+  mp->r_max_rebuild = pcells[0].r_max_rebuild;
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+  mp->mac_tolerance_factor = pcells[0].mac_tolerance_factor;
+#endif
 
   /* Fill in the progeny, depth-first recursion. */
   int count = 1;
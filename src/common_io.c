@@ -1224,381 +1224,352 @@ void io_duplicate_black_holes_gparts(struct threadpool* tp,
                  &data);
 }
 
+/*! Number of particles handled by each block of the selection */
+#define io_select_block_size 4096
+
 /**
- * @brief Copy every non-inhibited #part into the parts_written array.
- *
- * Also takes into account possible downsampling.
- *
- * @param parts The array of #part containing all particles.
- * @param xparts The array of #xpart containing all particles.
- * @param parts_written The array of #part to fill with particles we want to
- * write.
- * @param xparts_written The array of #xpart  to fill with particles we want to
- * write.
- * @param subsample Are we subsampling the particles?
- * @param subsample_ratio The fraction of particles to write if subsampling.
- * @param snap_num The snapshot ID (used to seed the RNG when sub-sampling).
- * @param Nparts The total number of #part.
- * @param Nparts_written The total number of #part to write.
+ * @brief Data passed to the particle selection mappers.
  */
-void io_collect_parts_to_write(const struct part* restrict parts,
-                               const struct xpart* restrict xparts,
-                               struct part* restrict parts_written,
-                               struct xpart* restrict xparts_written,
-                               const int subsample, const float subsample_ratio,
-                               const int snap_num, const size_t Nparts,
-                               const size_t Nparts_written) {
+struct io_select_data {
 
-  size_t count = 0;
+  /*! The particle array */
+  const void* parts;
 
-  /* Loop over all parts */
-  for (size_t i = 0; i < Nparts; ++i) {
+  /*! The number of particles in the array */
+  size_t N;
 
-    /* And collect the ones that have not been removed */
-    if (parts[i].time_bin != time_bin_inhibited &&
-        parts[i].time_bin != time_bin_not_created) {
+  /*! Are we subsampling the particles? */
+  int subsample;
 
-      /* When subsampling, select particles at random */
-      if (subsample) {
-        const float r = random_unit_interval(parts[i].id, snap_num,
-                                             random_number_snapshot_sampling);
+  /*! The fraction of particles to write if subsampling */
+  float subsample_ratio;
 
-        if (r > subsample_ratio) continue;
-      }
+  /*! The snapshot ID (used to seed the RNG when sub-sampling) */
+  int snap_num;
 
-      parts_written[count] = parts[i];
-      xparts_written[count] = xparts[i];
-      count++;
-    }
+  /*! Number of selected particles in each block (first pass), then index of
+   * the first particle of each block in the list (second pass) */
+  size_t* counts;
+
+  /*! The list of selected particles (NULL during the first pass) */
+  size_t* index;
+};
+
+/**
+ * @brief Generates a mapper selecting the particles to write.
+ *
+ * The elements are block indices (i.e. offsets from NULL). During the first
+ * pass (index == NULL), the mapper counts the particles selected in each
+ * block. During the second pass, it writes their indices in the list.
+ *
+ * @param NAME The name of the mapper.
+ * @param TYPE The particle type.
+ * @param ID The field used to seed the random sub-sampling.
+ * @param SELECT Additional condition on parts[i] to select a particle.
+ */
+#define IO_SELECT_TO_WRITE_MAPPER(NAME, TYPE, ID, SELECT)                      \
+  static void io_select_##NAME##_mapper(void* map_data, int num_blocks,       \
+                                        void* extra_data) {                   \
+                                                                              \
+    struct io_select_data* data = (struct io_select_data*)extra_data;         \
+    const struct TYPE* parts = (const struct TYPE*)data->parts;               \
+    const size_t first_block = (size_t)map_data;                              \
+                                                                              \
+    for (int b = 0; b < num_blocks; ++b) {                                    \
+                                                                              \
+      const size_t block = first_block + b;                                   \
+      const size_t start = block * io_select_block_size;                      \
+      const size_t end = min(start + io_select_block_size, data->N);          \
+      size_t count = 0;                                                       \
+                                                                              \
+      for (size_t i = start; i < end; ++i) {                                  \
+                                                                              \
+        /* Skip the ones that have been removed */                            \
+        if (parts[i].time_bin == time_bin_inhibited ||                        \
+            parts[i].time_bin == time_bin_not_created || !(SELECT))           \
+          continue;                                                           \
+                                                                              \
+        /* When subsampling, select particles at random */                    \
+        if (data->subsample) {                                                \
+          const float r = random_unit_interval(                               \
+              parts[i].ID, data->snap_num, random_number_snapshot_sampling);  \
+          if (r > data->subsample_ratio) continue;                            \
+        }                                                                     \
+                                                                              \
+        if (data->index != NULL) data->index[data->counts[block] + count] = i; \
+        count++;                                                              \
+      }                                                                       \
+                                                                              \
+      if (data->index == NULL) data->counts[block] = count;                   \
+    }                                                                         \
   }
 
-  /* Check that everything is fine */
-  if (count != Nparts_written)
-    error("Collected the wrong number of particles (%zu vs. %zu expected)",
-          count, Nparts_written);
-}
+IO_SELECT_TO_WRITE_MAPPER(parts, part, id, 1);
+IO_SELECT_TO_WRITE_MAPPER(sinks, sink, id, 1);
+IO_SELECT_TO_WRITE_MAPPER(sparts, spart, id, 1);
+IO_SELECT_TO_WRITE_MAPPER(bparts, bpart, id, 1);
+IO_SELECT_TO_WRITE_MAPPER(gparts, gpart, id_or_neg_offset,
+                          parts[i].type == swift_type_dark_matter);
+IO_SELECT_TO_WRITE_MAPPER(gparts_background, gpart, id_or_neg_offset,
+                          parts[i].type == swift_type_dark_matter_background);
+IO_SELECT_TO_WRITE_MAPPER(gparts_neutrino, gpart, id_or_neg_offset,
+                          parts[i].type == swift_type_neutrino);
 
 /**
- * @brief Copy every non-inhibited #spart into the sparts_written array.
+ * @brief Build the list of the particles to write in parallel.
  *
- * Also takes into account possible downsampling.
+ * The particles are processed in blocks. A first pass counts the particles
+ * selected in each block and a second one writes their indices at the
+ * position given by the prefix sum of the counts. The list is hence sorted.
  *
- * @param sparts The array of #spart containing all particles.
- * @param sparts_written The array of #spart to fill with particles we want to
- * write.
+ * @param e The #engine (for the threadpool).
+ * @param mapper The selection mapper for this particle type.
+ * @param parts The particle array.
  * @param subsample Are we subsampling the particles?
  * @param subsample_ratio The fraction of particles to write if subsampling.
  * @param snap_num The snapshot ID (used to seed the RNG when sub-sampling).
- * @param Nsparts The total number of #part.
- * @param Nsparts_written The total number of #part to write.
+ * @param N The number of particles in the array.
+ * @param N_written The number of particles we expect to select.
+ *
+ * @return The list of indices (to be freed with swift_free("index_written",
+ * ...)). NULL if no particle is selected.
  */
-void io_collect_sparts_to_write(const struct spart* restrict sparts,
-                                struct spart* restrict sparts_written,
-                                const int subsample,
-                                const float subsample_ratio, const int snap_num,
-                                const size_t Nsparts,
-                                const size_t Nsparts_written) {
+static size_t* io_select_to_write(const struct engine* e,
+                                  threadpool_map_function mapper,
+                                  const void* parts, const int subsample,
+                                  const float subsample_ratio,
+                                  const int snap_num, const size_t N,
+                                  const size_t N_written) {
 
-  size_t count = 0;
-
-  /* Loop over all parts */
-  for (size_t i = 0; i < Nsparts; ++i) {
+  const size_t num_blocks =
+      (N + io_select_block_size - 1) / io_select_block_size;
 
-    /* And collect the ones that have not been removed */
-    if (sparts[i].time_bin != time_bin_inhibited &&
-        sparts[i].time_bin != time_bin_not_created) {
+  struct io_select_data data;
+  data.parts = parts;
+  data.N = N;
+  data.subsample = subsample;
+  data.subsample_ratio = subsample_ratio;
+  data.snap_num = snap_num;
+  data.index = NULL;
+  data.counts = (size_t*)malloc(num_blocks * sizeof(size_t));
+  if (num_blocks > 0 && data.counts == NULL)
+    error("Unable to allocate selection counts");
+
+  /* Count the particles selected in each block */
+  threadpool_map((struct threadpool*)&e->threadpool, mapper, NULL, num_blocks,
+                 1, threadpool_auto_chunk_size, &data);
+
+  /* Turn the counts into the start of each block in the list */
+  size_t count = 0;
+  for (size_t b = 0; b < num_blocks; ++b) {
+    const size_t block_count = data.counts[b];
+    data.counts[b] = count;
+    count += block_count;
+  }
 
-      /* When subsampling, select particles at random */
-      if (subsample) {
-        const float r = random_unit_interval(sparts[i].id, snap_num,
-                                             random_number_snapshot_sampling);
+  /* Check that everything is fine */
+  if (count != N_written)
+    error("Selected the wrong number of particles (%zu vs. %zu expected)",
+          count, N_written);
 
-        if (r > subsample_ratio) continue;
-      }
+  /* Now write the indices */
+  if (count > 0) {
+    data.index = (size_t*)swift_malloc("index_written", count * sizeof(size_t));
+    if (data.index == NULL) error("Unable to allocate the selection list");
 
-      sparts_written[count] = sparts[i];
-      count++;
-    }
+    threadpool_map((struct threadpool*)&e->threadpool, mapper, NULL,
+                   num_blocks, 1, threadpool_auto_chunk_size, &data);
   }
 
-  /* Check that everything is fine */
-  if (count != Nsparts_written)
-    error("Collected the wrong number of s-particles (%zu vs. %zu expected)",
-          count, Nsparts_written);
+  free(data.counts);
+  return data.index;
+}
+
+/**
+ * @brief List the non-inhibited #part to write.
+ *
+ * Also takes into account possible downsampling.
+ *
+ * @param e The #engine.
+ * @param parts The array of #part containing all particles.
+ * @param subsample Are we subsampling the particles?
+ * @param subsample_ratio The fraction of particles to write if subsampling.
+ * @param snap_num The snapshot ID (used to seed the RNG when sub-sampling).
+ * @param Nparts The total number of #part.
+ * @param Nparts_written The total number of #part to write.
+ *
+ * @return The indices of the particles to write (see io_select_to_write()).
+ */
+size_t* io_select_parts_to_write(const struct engine* e,
+                                 const struct part* parts, const int subsample,
+                                 const float subsample_ratio,
+                                 const int snap_num, const size_t Nparts,
+                                 const size_t Nparts_written) {
+  return io_select_to_write(e, io_select_parts_mapper, parts, subsample,
+                            subsample_ratio, snap_num, Nparts, Nparts_written);
 }
 
 /**
- * @brief Copy every non-inhibited #sink into the sinks_written array.
+ * @brief List the non-inhibited #sink to write.
  *
  * Also takes into account possible downsampling.
  *
+ * @param e The #engine.
  * @param sinks The array of #sink containing all particles.
- * @param sinks_written The array of #sink to fill with particles we want to
- * write.
  * @param subsample Are we subsampling the particles?
  * @param subsample_ratio The fraction of particles to write if subsampling.
  * @param snap_num The snapshot ID (used to seed the RNG when sub-sampling).
  * @param Nsinks The total number of #sink.
  * @param Nsinks_written The total number of #sink to write.
+ *
+ * @return The indices of the particles to write (see io_select_to_write()).
  */
-void io_collect_sinks_to_write(const struct sink* restrict sinks,
-                               struct sink* restrict sinks_written,
-                               const int subsample, const float subsample_ratio,
-                               const int snap_num, const size_t Nsinks,
-                               const size_t Nsinks_written) {
-
-  size_t count = 0;
-
-  /* Loop over all parts */
-  for (size_t i = 0; i < Nsinks; ++i) {
-
-    /* And collect the ones that have not been removed */
-    if (sinks[i].time_bin != time_bin_inhibited &&
-        sinks[i].time_bin != time_bin_not_created) {
-
-      /* When subsampling, select particles at random */
-      if (subsample) {
-        const float r = random_unit_interval(sinks[i].id, snap_num,
-                                             random_number_snapshot_sampling);
-
-        if (r > subsample_ratio) continue;
-      }
-
-      sinks_written[count] = sinks[i];
-      count++;
-    }
-  }
+size_t* io_select_sinks_to_write(const struct engine* e,
+                                 const struct sink* sinks, const int subsample,
+                                 const float subsample_ratio,
+                                 const int snap_num, const size_t Nsinks,
+                                 const size_t Nsinks_written) {
+  return io_select_to_write(e, io_select_sinks_mapper, sinks, subsample,
+                            subsample_ratio, snap_num, Nsinks, Nsinks_written);
+}
 
-  /* Check that everything is fine */
-  if (count != Nsinks_written)
-    error("Collected the wrong number of sink-particles (%zu vs. %zu expected)",
-          count, Nsinks_written);
+/**
+ * @brief List the non-inhibited #spart to write.
+ *
+ * Also takes into account possible downsampling.
+ *
+ * @param e The #engine.
+ * @param sparts The array of #spart containing all particles.
+ * @param subsample Are we subsampling the particles?
+ * @param subsample_ratio The fraction of particles to write if subsampling.
+ * @param snap_num The snapshot ID (used to seed the RNG when sub-sampling).
+ * @param Nsparts The total number of #spart.
+ * @param Nsparts_written The total number of #spart to write.
+ *
+ * @return The indices of the particles to write (see io_select_to_write()).
+ */
+size_t* io_select_sparts_to_write(const struct engine* e,
+                                  const struct spart* sparts,
+                                  const int subsample,
+                                  const float subsample_ratio,
+                                  const int snap_num, const size_t Nsparts,
+                                  const size_t Nsparts_written) {
+  return io_select_to_write(e, io_select_sparts_mapper, sparts, subsample,
+                            subsample_ratio, snap_num, Nsparts,
+                            Nsparts_written);
 }
 
 /**
- * @brief Copy every non-inhibited #bpart into the bparts_written array.
+ * @brief List the non-inhibited #bpart to write.
  *
  * Also takes into account possible downsampling.
  *
+ * @param e The #engine.
  * @param bparts The array of #bpart containing all particles.
- * @param bparts_written The array of #bpart to fill with particles we want to
- * write.
  * @param subsample Are we subsampling the particles?
  * @param subsample_ratio The fraction of particles to write if subsampling.
  * @param snap_num The snapshot ID (used to seed the RNG when sub-sampling).
- * @param Nbparts The total number of #part.
- * @param Nbparts_written The total number of #part to write.
+ * @param Nbparts The total number of #bpart.
+ * @param Nbparts_written The total number of #bpart to write.
+ *
+ * @return The indices of the particles to write (see io_select_to_write()).
  */
-void io_collect_bparts_to_write(const struct bpart* restrict bparts,
-                                struct bpart* restrict bparts_written,
-                                const int subsample,
-                                const float subsample_ratio, const int snap_num,
-                                const size_t Nbparts,
-                                const size_t Nbparts_written) {
-
-  size_t count = 0;
-
-  /* Loop over all parts */
-  for (size_t i = 0; i < Nbparts; ++i) {
-
-    /* And collect the ones that have not been removed */
-    if (bparts[i].time_bin != time_bin_inhibited &&
-        bparts[i].time_bin != time_bin_not_created) {
-
-      /* When subsampling, select particles at random */
-      if (subsample) {
-        const float r = random_unit_interval(bparts[i].id, snap_num,
-                                             random_number_snapshot_sampling);
-
-        if (r > subsample_ratio) continue;
-      }
-
-      bparts_written[count] = bparts[i];
-      count++;
-    }
-  }
-
-  /* Check that everything is fine */
-  if (count != Nbparts_written)
-    error("Collected the wrong number of s-particles (%zu vs. %zu expected)",
-          count, Nbparts_written);
+size_t* io_select_bparts_to_write(const struct engine* e,
+                                  const struct bpart* bparts,
+                                  const int subsample,
+                                  const float subsample_ratio,
+                                  const int snap_num, const size_t Nbparts,
+                                  const size_t Nbparts_written) {
+  return io_select_to_write(e, io_select_bparts_mapper, bparts, subsample,
+                            subsample_ratio, snap_num, Nbparts,
+                            Nbparts_written);
 }
 
 /**
- * @brief Copy every non-inhibited regulat DM #gpart into the gparts_written
- * array.
+ * @brief List the non-inhibited DM #gpart to write.
  *
- * Also takes into account possible downsampling.
+ * Also takes into account possible downsampling. The VELOCIraptor data of
+ * the particles, if any, is read through the same indices.
  *
+ * @param e The #engine.
  * @param gparts The array of #gpart containing all particles.
- * @param vr_data The array of gpart-related VELOCIraptor output.
- * @param gparts_written The array of #gpart to fill with particles we want to
- * write.
- * @param vr_data_written The array of gpart-related VELOCIraptor with particles
- * we want to write.
  * @param subsample Are we subsampling the particles?
  * @param subsample_ratio The fraction of particles to write if subsampling.
  * @param snap_num The snapshot ID (used to seed the RNG when sub-sampling).
- * @param Ngparts The total number of #part.
- * @param Ngparts_written The total number of #part to write.
- * @param with_stf Are we running with STF? i.e. do we want to collect vr data?
+ * @param Ngparts The total number of #gpart.
+ * @param Ngparts_written The total number of DM #gpart to write.
+ *
+ * @return The indices of the particles to write (see io_select_to_write()).
  */
-void io_collect_gparts_to_write(
-    const struct gpart* restrict gparts,
-    const struct velociraptor_gpart_data* restrict vr_data,
-    struct gpart* restrict gparts_written,
-    struct velociraptor_gpart_data* restrict vr_data_written,
-    const int subsample, const float subsample_ratio, const int snap_num,
-    const size_t Ngparts, const size_t Ngparts_written, const int with_stf) {
-
-  size_t count = 0;
-
-  /* Loop over all parts */
-  for (size_t i = 0; i < Ngparts; ++i) {
-
-    /* And collect the ones that have not been removed */
-    if ((gparts[i].time_bin != time_bin_inhibited) &&
-        (gparts[i].time_bin != time_bin_not_created) &&
-        (gparts[i].type == swift_type_dark_matter)) {
-
-      /* When subsampling, select particles at random */
-      if (subsample) {
-        const float r =
-            random_unit_interval(gparts[i].id_or_neg_offset, snap_num,
-                                 random_number_snapshot_sampling);
-
-        if (r > subsample_ratio) continue;
-      }
-
-      if (with_stf) vr_data_written[count] = vr_data[i];
-
-      gparts_written[count] = gparts[i];
-      count++;
-    }
-  }
-
-  /* Check that everything is fine */
-  if (count != Ngparts_written)
-    error("Collected the wrong number of g-particles (%zu vs. %zu expected)",
-          count, Ngparts_written);
+size_t* io_select_gparts_to_write(const struct engine* e,
+                                  const struct gpart* gparts,
+                                  const int subsample,
+                                  const float subsample_ratio,
+                                  const int snap_num, const size_t Ngparts,
+                                  const size_t Ngparts_written) {
+  return io_select_to_write(e, io_select_gparts_mapper, gparts, subsample,
+                            subsample_ratio, snap_num, Ngparts,
+                            Ngparts_written);
 }
 
 /**
- * @brief Copy every non-inhibited background DM #gpart into the gparts_written
- * array.
+ * @brief List the non-inhibited background DM #gpart to write.
  *
  * Also takes into account possible downsampling.
  *
+ * @param e The #engine.
  * @param gparts The array of #gpart containing all particles.
- * @param vr_data The array of gpart-related VELOCIraptor output.
- * @param gparts_written The array of #gpart to fill with particles we want to
- * write.
- * @param vr_data_written The array of gpart-related VELOCIraptor with particles
- * we want to write.
  * @param subsample Are we subsampling the particles?
  * @param subsample_ratio The fraction of particles to write if subsampling.
  * @param snap_num The snapshot ID (used to seed the RNG when sub-sampling).
- * @param Ngparts The total number of #part.
- * @param Ngparts_written The total number of #part to write.
- * @param with_stf Are we running with STF? i.e. do we want to collect vr data?
+ * @param Ngparts The total number of #gpart.
+ * @param Ngparts_written The total number of background #gpart to write.
+ *
+ * @return The indices of the particles to write (see io_select_to_write()).
  */
-void io_collect_gparts_background_to_write(
-    const struct gpart* restrict gparts,
-    const struct velociraptor_gpart_data* restrict vr_data,
-    struct gpart* restrict gparts_written,
-    struct velociraptor_gpart_data* restrict vr_data_written,
-    const int subsample, const float subsample_ratio, const int snap_num,
-    const size_t Ngparts, const size_t Ngparts_written, const int with_stf) {
-
-  size_t count = 0;
-
-  /* Loop over all parts */
-  for (size_t i = 0; i < Ngparts; ++i) {
-
-    /* And collect the ones that have not been removed */
-    if ((gparts[i].time_bin != time_bin_inhibited) &&
-        (gparts[i].time_bin != time_bin_not_created) &&
-        (gparts[i].type == swift_type_dark_matter_background)) {
-
-      /* When subsampling, select particles at random */
-      if (subsample) {
-        const float r =
-            random_unit_interval(gparts[i].id_or_neg_offset, snap_num,
-                                 random_number_snapshot_sampling);
-
-        if (r > subsample_ratio) continue;
-      }
-
-      if (with_stf) vr_data_written[count] = vr_data[i];
-
-      gparts_written[count] = gparts[i];
-      count++;
-    }
-  }
-
-  /* Check that everything is fine */
-  if (count != Ngparts_written)
-    error("Collected the wrong number of g-particles (%zu vs. %zu expected)",
-          count, Ngparts_written);
+size_t* io_select_gparts_background_to_write(
+    const struct engine* e, const struct gpart* gparts, const int subsample,
+    const float subsample_ratio, const int snap_num, const size_t Ngparts,
+    const size_t Ngparts_written) {
+  return io_select_to_write(e, io_select_gparts_background_mapper, gparts,
+                            subsample, subsample_ratio, snap_num, Ngparts,
+                            Ngparts_written);
 }
 
 /**
- * @brief Copy every non-inhibited neutrino DM #gpart into the gparts_written
- * array.
+ * @brief List the non-inhibited neutrino #gpart to write.
  *
  * Also takes into account possible downsampling.
  *
+ * @param e The #engine.
  * @param gparts The array of #gpart containing all particles.
- * @param vr_data The array of gpart-related VELOCIraptor output.
- * @param gparts_written The array of #gpart to fill with particles we want to
- * write.
- * @param vr_data_written The array of gpart-related VELOCIraptor with particles
- * we want to write.
  * @param subsample Are we subsampling the particles?
  * @param subsample_ratio The fraction of particles to write if subsampling.
  * @param snap_num The snapshot ID (used to seed the RNG when sub-sampling).
- * @param Ngparts The total number of #part.
- * @param Ngparts_written The total number of #part to write.
- * @param with_stf Are we running with STF? i.e. do we want to collect vr data?
+ * @param Ngparts The total number of #gpart.
+ * @param Ngparts_written The total number of neutrino #gpart to write.
+ *
+ * @return The indices of the particles to write (see io_select_to_write()).
  */
-void io_collect_gparts_neutrino_to_write(
-    const struct gpart* restrict gparts,
-    const struct velociraptor_gpart_data* restrict vr_data,
-    struct gpart* restrict gparts_written,
-    struct velociraptor_gpart_data* restrict vr_data_written,
-    const int subsample, const float subsample_ratio, const int snap_num,
-    const size_t Ngparts, const size_t Ngparts_written, const int with_stf) {
-
-  size_t count = 0;
-
-  /* Loop over all parts */
-  for (size_t i = 0; i < Ngparts; ++i) {
-
-    /* And collect the ones that have not been removed */
-    if ((gparts[i].time_bin != time_bin_inhibited) &&
-        (gparts[i].time_bin != time_bin_not_created) &&
-        (gparts[i].type == swift_type_neutrino)) {
-
-      /* When subsampling, select particles at random */
-      if (subsample) {
-        const float r =
-            random_unit_interval(gparts[i].id_or_neg_offset, snap_num,
-                                 random_number_snapshot_sampling);
-
-        if (r > subsample_ratio) continue;
-      }
-
-      if (with_stf) vr_data_written[count] = vr_data[i];
-
-      gparts_written[count] = gparts[i];
-      count++;
-    }
-  }
+size_t* io_select_gparts_neutrino_to_write(
+    const struct engine* e, const struct gpart* gparts, const int subsample,
+    const float subsample_ratio, const int snap_num, const size_t Ngparts,
+    const size_t Ngparts_written) {
+  return io_select_to_write(e, io_select_gparts_neutrino_mapper, gparts,
+                            subsample, subsample_ratio, snap_num, Ngparts,
+                            Ngparts_written);
+}
 
-  /* Check that everything is fine */
-  if (count != Ngparts_written)
-    error("Collected the wrong number of g-particles (%zu vs. %zu expected)",
-          count, Ngparts_written);
+/**
+ * @brief Set the list of particle indices read by a set of fields.
+ *
+ * @param list The #io_props of the fields.
+ * @param num_fields The number of fields.
+ * @param index The indices of the particles to write (NULL for all of them).
+ */
+void io_set_write_index(struct io_props* list, const int num_fields,
+                        const size_t* index) {
+  for (int i = 0; i < num_fields; ++i) list[i].index = index;
 }
 
 /**
@@ -32,6 +32,10 @@
 #define FILENAME_BUFFER_SIZE 150
 #define IO_BUFFER_ALIGNMENT 1024
 
+/* Maximal size of the buffers filled in one pass over the particles when
+ * writing snapshots */
+#define IO_FUSED_COPY_MAX_BYTES (512ULL * 1024ULL * 1024ULL)
+
 /* Avoid cyclic inclusion problems */
 struct cell;
 struct space;
@@ -110,7 +114,7 @@ void io_write_part_type_names(hid_t h_grp);
 void io_write_cell_offsets(hid_t h_grp, const int cdim[3], const double dim[3],
                            const struct cell* cells_top, const int nr_cells,
                            const double width[3], const int nodeID,
-                           const int distributed,
+                           const int distributed, const int* node_files,
                            const int subsample[swift_type_count],
                            const float subsample_fraction[swift_type_count],
                            const int snap_num,
@@ -120,6 +124,16 @@ void io_write_cell_offsets(hid_t h_grp, const int cdim[3], const double dim[3],
                            const int num_fields[swift_type_count],
                            const struct unit_system* internal_units,
                            const struct unit_system* snapshot_units);
+void io_write_array(hid_t h_grp, const size_t n, const int dim,
+                    const void* array, const enum IO_DATA_TYPE type,
+                    const char* name, const char* array_content);
+long long io_select_cells_in_region(hid_t h_file, const int ptype,
+                                    const double box_size[3],
+                                    const double region_min[3],
+                                    const double region_max[3],
+                                    long long** chunk_offsets,
+                                    long long** chunk_counts,
+                                    int* num_chunks);
 
 void io_read_unit_system(hid_t h_file, struct unit_system* ic_units,
                          const struct unit_system* internal_units,
@@ -131,6 +145,16 @@ void io_copy_temp_buffer(void* temp, const struct engine* e,
                          const struct io_props props, size_t N,
                          const struct unit_system* internal_units,
                          const struct unit_system* snapshot_units);
+void io_copy_temp_buffers_fused(void** temps, const struct engine* e,
+                                const struct io_props* props,
+                                const int num_fields, size_t N,
+                                const struct unit_system* internal_units,
+                                const struct unit_system* snapshot_units);
+int io_copy_next_field_group(void** temps, const struct engine* e,
+                             const struct io_props* props, const int first,
+                             const int num_fields, size_t N,
+                             const struct unit_system* internal_units,
+                             const struct unit_system* snapshot_units);
 
 #endif /* HAVE_HDF5 */
 
@@ -169,52 +193,44 @@ long long io_count_neutrinos_to_write(const struct space* s,
                                       const float subsample_ratio,
                                       const int snap_num);
 
-void io_collect_parts_to_write(const struct part* restrict parts,
-                               const struct xpart* restrict xparts,
-                               struct part* restrict parts_written,
-                               struct xpart* restrict xparts_written,
-                               const int subsample, const float subsample_ratio,
-                               const int snap_num, const size_t Nparts,
-                               const size_t Nparts_written);
-void io_collect_sinks_to_write(const struct sink* restrict sinks,
-                               struct sink* restrict sinks_written,
-                               const int subsample, const float subsample_ratio,
-                               const int snap_num, const size_t Nsinks,
-                               const size_t Nsinks_written);
-void io_collect_sparts_to_write(const struct spart* restrict sparts,
-                                struct spart* restrict sparts_written,
-                                const int subsample,
-                                const float subsample_ratio, const int snap_num,
-                                const size_t Nsparts,
-                                const size_t Nsparts_written);
-void io_collect_bparts_to_write(const struct bpart* restrict bparts,
-                                struct bpart* restrict bparts_written,
-                                const int subsample,
-                                const float subsample_ratio, const int snap_num,
-                                const size_t Nbparts,
-                                const size_t Nbparts_written);
-void io_collect_gparts_to_write(const struct gpart* restrict gparts,
-                                const struct velociraptor_gpart_data* vr_data,
-                                struct gpart* restrict gparts_written,
-                                struct velociraptor_gpart_data* vr_data_written,
-                                const int subsample,
-                                const float subsample_ratio, const int snap_num,
-                                const size_t Ngparts,
-                                const size_t Ngparts_written, int with_stf);
-void io_collect_gparts_background_to_write(
-    const struct gpart* restrict gparts,
-    const struct velociraptor_gpart_data* vr_data,
-    struct gpart* restrict gparts_written,
-    struct velociraptor_gpart_data* vr_data_written, const int subsample,
+size_t* io_select_parts_to_write(const struct engine* e,
+                                 const struct part* parts, const int subsample,
+                                 const float subsample_ratio,
+                                 const int snap_num, const size_t Nparts,
+                                 const size_t Nparts_written);
+size_t* io_select_sinks_to_write(const struct engine* e,
+                                 const struct sink* sinks, const int subsample,
+                                 const float subsample_ratio,
+                                 const int snap_num, const size_t Nsinks,
+                                 const size_t Nsinks_written);
+size_t* io_select_sparts_to_write(const struct engine* e,
+                                  const struct spart* sparts,
+                                  const int subsample,
+                                  const float subsample_ratio,
+                                  const int snap_num, const size_t Nsparts,
+                                  const size_t Nsparts_written);
+size_t* io_select_bparts_to_write(const struct engine* e,
+                                  const struct bpart* bparts,
+                                  const int subsample,
+                                  const float subsample_ratio,
+                                  const int snap_num, const size_t Nbparts,
+                                  const size_t Nbparts_written);
+size_t* io_select_gparts_to_write(const struct engine* e,
+                                  const struct gpart* gparts,
+                                  const int subsample,
+                                  const float subsample_ratio,
+                                  const int snap_num, const size_t Ngparts,
+                                  const size_t Ngparts_written);
+size_t* io_select_gparts_background_to_write(
+    const struct engine* e, const struct gpart* gparts, const int subsample,
     const float subsample_ratio, const int snap_num, const size_t Ngparts,
-    const size_t Ngparts_written, int with_stf);
-void io_collect_gparts_neutrino_to_write(
-    const struct gpart* restrict gparts,
-    const struct velociraptor_gpart_data* vr_data,
-    struct gpart* restrict gparts_written,
-    struct velociraptor_gpart_data* vr_data_written, const int subsample,
+    const size_t Ngparts_written);
+size_t* io_select_gparts_neutrino_to_write(
+    const struct engine* e, const struct gpart* gparts, const int subsample,
     const float subsample_ratio, const int snap_num, const size_t Ngparts,
-    const size_t Ngparts_written, int with_stf);
+    const size_t Ngparts_written);
+void io_set_write_index(struct io_props* list, const int num_fields,
+                        const size_t* index);
 
 void io_prepare_dm_gparts(struct threadpool* tp, struct gpart* const gparts,
                           size_t Ndm);
@@ -197,12 +197,12 @@ long long IO_COUNT_PARTICLES_TO_WRITE(neutrinos, neutrinos);
  * @param array_content The name of the parent group (only used for error
  * messages).
  */
-void io_write_array(hid_t h_grp, const int n, const int dim, const void* array,
-                    const enum IO_DATA_TYPE type, const char* name,
-                    const char* array_content) {
+void io_write_array(hid_t h_grp, const size_t n, const int dim,
+                    const void* array, const enum IO_DATA_TYPE type,
+                    const char* name, const char* array_content) {
 
   /* Create memory space */
-  const hsize_t shape[2] = {(hsize_t)n, dim};
+  const hsize_t shape[2] = {(hsize_t)n, (hsize_t)dim};
   hid_t h_space = H5Screate(H5S_SIMPLE);
   if (h_space < 0)
     error("Error while creating data space for %s %s", name, array_content);
@@ -214,7 +214,7 @@ void io_write_array(hid_t h_grp, const int n, const int dim, const void* array,
   /* Dataset type */
   hid_t h_type = H5Tcopy(io_hdf5_type(type));
 
-  const hsize_t chunk[2] = {(1024 > n ? n : 1024), dim};
+  const hsize_t chunk[2] = {(hsize_t)(1024 > n ? n : 1024), (hsize_t)dim};
   hid_t h_prop = H5Pcreate(H5P_DATASET_CREATE);
   h_err = H5Pset_chunk(h_prop, dim > 1 ? 2 : 1, chunk);
   if (h_err < 0)
@@ -254,12 +254,15 @@ void io_write_array(hid_t h_grp, const int n, const int dim, const void* array,
 /**
  * @brief Compute and write the top-level cell counts and offsets meta-data.
  *
- * @param h_grp the hdf5 group to write to.
+ * @param h_grp the hdf5 group to write to. For distributed snapshots, nodes
+ * that do not write a file pass a negative value.
  * @param cdim The number of top-level cells along each axis.
  * @param dim The box size.
  * @param cells_top The top-level cells.
  * @param nr_cells The number of top-level cells.
  * @param distributed Is this a distributed snapshot?
+ * @param node_files For distributed snapshots, the index of the file written
+ * by each node. NULL if every node writes its own file.
  * @param subsample Are we subsampling the different particle types?
  * @param subsample_fraction The fraction of particles to keep when subsampling.
  * @param snap_num The snapshot number used as subsampling random seed.
@@ -275,7 +278,7 @@ void io_write_array(hid_t h_grp, const int n, const int dim, const void* array,
 void io_write_cell_offsets(hid_t h_grp, const int cdim[3], const double dim[3],
                            const struct cell* cells_top, const int nr_cells,
                            const double width[3], const int nodeID,
-                           const int distributed,
+                           const int distributed, const int* node_files,
                            const int subsample[swift_type_count],
                            const float subsample_fraction[swift_type_count],
                            const int snap_num,
@@ -287,7 +290,7 @@ void io_write_cell_offsets(hid_t h_grp, const int cdim[3], const double dim[3],
                            const struct unit_system* snapshot_units) {
 
 #ifdef SWIFT_DEBUG_CHECKS
-  if (distributed) {
+  if (distributed && node_files == NULL) {
     if (global_offsets[0] != 0 || global_offsets[1] != 0 ||
         global_offsets[2] != 0 || global_offsets[3] != 0 ||
         global_offsets[4] != 0 || global_offsets[5] != 0 ||
@@ -379,7 +382,8 @@ void io_write_cell_offsets(hid_t h_grp, const int cdim[3], const double dim[3],
 
     /* Store in which file this cell will be found */
     if (distributed) {
-      files[i] = cells_top[i].nodeID;
+      files[i] = node_files ? node_files[cells_top[i].nodeID]
+                            : cells_top[i].nodeID;
     } else {
       files[i] = 0;
     }
@@ -437,8 +441,8 @@ void io_write_cell_offsets(hid_t h_grp, const int cdim[3], const double dim[3],
           &min_nupart_pos[i * 3], &max_nupart_pos[i * 3]);
 
       /* Offsets including the global offset of all particles on this MPI rank
-       * Note that in the distributed case, the global offsets are 0 such that
-       * we actually compute the offset in the file written by this rank. */
+       * Note that in the distributed case, the global offsets are those of
+       * this rank in its file such that we compute the offset in that file. */
       offset_part[i] = local_offset_part + global_offsets[swift_type_gas];
       offset_gpart[i] =
           local_offset_gpart + global_offsets[swift_type_dark_matter];
@@ -556,7 +560,7 @@ void io_write_cell_offsets(hid_t h_grp, const int cdim[3], const double dim[3],
 #endif
 
   /* When writing a single file, only rank 0 writes the meta-data */
-  if ((distributed) || (!distributed && nodeID == 0)) {
+  if ((distributed && h_grp >= 0) || (!distributed && nodeID == 0)) {
 
     /* Unit conversion if necessary */
     const double factor = units_conversion_factor(
@@ -759,4 +763,176 @@ void io_write_cell_offsets(hid_t h_grp, const int cdim[3], const double dim[3],
   free(max_nupart_pos);
 }
 
+/**
+ * @brief A contiguous range of particles in a snapshot dataset.
+ */
+struct io_cell_chunk {
+  long long offset;
+  long long count;
+};
+
+/**
+ * @brief Sort #io_cell_chunk by increasing offset.
+ */
+static int io_cell_chunk_compare(const void* a, const void* b) {
+  const struct io_cell_chunk* ca = (const struct io_cell_chunk*)a;
+  const struct io_cell_chunk* cb = (const struct io_cell_chunk*)b;
+  return (ca->offset > cb->offset) - (ca->offset < cb->offset);
+}
+
+/**
+ * @brief Find the particles of a given type lying in the top-level cells that
+ * overlap a region, using the cell meta-data written alongside a snapshot.
+ *
+ * A cell is selected if the envelope of its particles (the "MinPositions" and
+ * "MaxPositions" of the meta-data) intersects the region. The offsets of the
+ * selected cells are sorted and neighbouring cells are merged, such that the
+ * particles can then be read with a few contiguous hyperslabs.
+ *
+ * The offsets are only meaningful within the file they refer to, so all the
+ * selected cells must lie in the first file of the snapshot. The region is
+ * not wrapped periodically and must hence lie within the box.
+ *
+ * @param h_file The (opened) HDF5 file.
+ * @param ptype The type of particles to look for.
+ * @param box_size The size of the box (in the file's units).
+ * @param region_min The lower corner of the region (in the file's units).
+ * @param region_max The upper corner of the region (in the file's units).
+ * @param chunk_offsets (return) The first particle of each range. Must be
+ * freed by the caller.
+ * @param chunk_counts (return) The number of particles of each range. Must be
+ * freed by the caller.
+ * @param num_chunks (return) The number of ranges.
+ *
+ * @return The total number of particles selected.
+ */
+long long io_select_cells_in_region(hid_t h_file, const int ptype,
+                                    const double box_size[3],
+                                    const double region_min[3],
+                                    const double region_max[3],
+                                    long long** chunk_offsets,
+                                    long long** chunk_counts,
+                                    int* num_chunks) {
+
+  /* We do not wrap the region around the periodic boundaries */
+  for (int k = 0; k < 3; ++k)
+    if (region_min[k] < 0. || region_max[k] > box_size[k])
+      error(
+          "The region to read [%e %e %e] - [%e %e %e] crosses the edge of the "
+          "box [%e %e %e]. Only regions within the box can be read.",
+          region_min[0], region_min[1], region_min[2], region_max[0],
+          region_max[1], region_max[2], box_size[0], box_size[1],
+          box_size[2]);
+
+  /* Check that we can use the cell meta-data */
+  if (H5Lexists(h_file, "/Cells", 0) <= 0)
+    error(
+        "Reading a region of the ICs requires the cell meta-data written in "
+        "snapshots (group '/Cells').");
+
+  const hid_t h_grp = H5Gopen(h_file, "/Cells", H5P_DEFAULT);
+  if (h_grp < 0) error("Error while opening the cell meta-data group");
+
+  const hid_t h_subgrp = H5Gopen(h_grp, "Meta-data", H5P_DEFAULT);
+  if (h_subgrp < 0) error("Error while opening the cell meta-data");
+  int nr_cells = 0;
+  io_read_attribute(h_subgrp, "nr_cells", INT, &nr_cells);
+  H5Gclose(h_subgrp);
+
+  char name[PARTICLE_GROUP_BUFFER_SIZE];
+  snprintf(name, PARTICLE_GROUP_BUFFER_SIZE, "PartType%d", ptype);
+
+  long long* counts = (long long*)malloc(nr_cells * sizeof(long long));
+  long long* offsets = (long long*)malloc(nr_cells * sizeof(long long));
+  double* min_pos = (double*)malloc(3 * nr_cells * sizeof(double));
+  double* max_pos = (double*)malloc(3 * nr_cells * sizeof(double));
+  int* files = (int*)calloc(nr_cells, sizeof(int));
+  struct io_cell_chunk* chunks =
+      (struct io_cell_chunk*)malloc(nr_cells * sizeof(struct io_cell_chunk));
+  if (counts == NULL || offsets == NULL || min_pos == NULL ||
+      max_pos == NULL || files == NULL || chunks == NULL)
+    error("Unable to allocate memory for the cell meta-data");
+
+  /* Read the cell meta-data for this particle type */
+  const hid_t h_counts = H5Gopen(h_grp, "Counts", H5P_DEFAULT);
+  const hid_t h_offsets = H5Gopen(h_grp, "OffsetsInFile", H5P_DEFAULT);
+  const hid_t h_min = H5Gopen(h_grp, "MinPositions", H5P_DEFAULT);
+  const hid_t h_max = H5Gopen(h_grp, "MaxPositions", H5P_DEFAULT);
+  if (h_counts < 0 || h_offsets < 0 || h_min < 0 || h_max < 0)
+    error("Incomplete cell meta-data in the ICs");
+  if (H5Lexists(h_counts, name, 0) <= 0)
+    error("No cell meta-data for particle type %d", ptype);
+  io_read_array_dataset(h_counts, name, LONGLONG, counts, nr_cells);
+  io_read_array_dataset(h_offsets, name, LONGLONG, offsets, nr_cells);
+  io_read_array_dataset(h_min, name, DOUBLE, min_pos, 3 * nr_cells);
+  io_read_array_dataset(h_max, name, DOUBLE, max_pos, 3 * nr_cells);
+  H5Gclose(h_counts);
+  H5Gclose(h_offsets);
+  H5Gclose(h_min);
+  H5Gclose(h_max);
+
+  /* Which file each cell is in (older snapshots are single files) */
+  if (H5Lexists(h_grp, "Files", 0) > 0) {
+    const hid_t h_files = H5Gopen(h_grp, "Files", H5P_DEFAULT);
+    if (h_files < 0) error("Error while opening the cell files meta-data");
+    io_read_array_dataset(h_files, name, INT, files, nr_cells);
+    H5Gclose(h_files);
+  }
+  H5Gclose(h_grp);
+
+  /* Collect the cells overlapping the region */
+  int count = 0;
+  for (int i = 0; i < nr_cells; ++i) {
+    if (counts[i] == 0) continue;
+    int overlaps = 1;
+    for (int k = 0; k < 3; ++k)
+      if (min_pos[3 * i + k] > region_max[k] ||
+          max_pos[3 * i + k] < region_min[k])
+        overlaps = 0;
+    if (overlaps) {
+      if (files[i] != 0)
+        error(
+            "Cell %d of the region is stored in file %d of a distributed "
+            "snapshot. Only regions of single-file snapshots can be read.",
+            i, files[i]);
+      chunks[count].offset = offsets[i];
+      chunks[count].count = counts[i];
+      count++;
+    }
+  }
+
+  /* Merge the cells that are contiguous in the file */
+  qsort(chunks, count, sizeof(struct io_cell_chunk), io_cell_chunk_compare);
+  int merged = 0;
+  long long total = 0;
+  for (int i = 0; i < count; ++i) {
+    if (merged > 0 && chunks[merged - 1].offset + chunks[merged - 1].count ==
+                          chunks[i].offset)
+      chunks[merged - 1].count += chunks[i].count;
+    else
+      chunks[merged++] = chunks[i];
+    total += chunks[i].count;
+  }
+
+  /* Return the ranges */
+  *num_chunks = merged;
+  *chunk_offsets = (long long*)malloc(max(merged, 1) * sizeof(long long));
+  *chunk_counts = (long long*)malloc(max(merged, 1) * sizeof(long long));
+  if (*chunk_offsets == NULL || *chunk_counts == NULL)
+    error("Unable to allocate memory for the particle ranges");
+  for (int i = 0; i < merged; ++i) {
+    (*chunk_offsets)[i] = chunks[i].offset;
+    (*chunk_counts)[i] = chunks[i].count;
+  }
+
+  free(counts);
+  free(offsets);
+  free(min_pos);
+  free(max_pos);
+  free(files);
+  free(chunks);
+
+  return total;
+}
+
 #endif /* HAVE_HDF5 */
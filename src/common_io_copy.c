@@ -455,6 +455,253 @@ void io_convert_sink_l_mapper(void* restrict temp, int N,
     props.convert_sink_l(e, sinks + delta + i, &temp_l[i * dim]);
 }
 
+/*! Number of particles converted per field before moving to the next field
+ * in the fused copy. Small enough to keep the particles in cache. */
+#define io_fused_copy_block_size 256
+
+/**
+ * @brief Data passed to the fused copy mapper.
+ */
+struct io_fused_copy_data {
+
+  /*! The fields to copy */
+  const struct io_props* props;
+
+  /*! One output buffer per field */
+  void** temps;
+
+  /*! Unit conversion factor per field */
+  const double* factors;
+
+  /*! Number of fields */
+  int num_fields;
+
+  /*! The #engine */
+  const struct engine* e;
+};
+
+/**
+ * @brief Convert a block of particles for a single field using its
+ * conversion function.
+ *
+ * @param props The #io_props of the field.
+ * @param e The #engine.
+ * @param offset Index of the first particle of the block.
+ * @param count Number of particles in the block.
+ * @param out Start of the output for this block.
+ */
+static void io_fused_convert_block(const struct io_props* props,
+                                   const struct engine* e, const size_t offset,
+                                   const int count, char* out) {
+
+  const size_t dim = props->dimension;
+
+#define IO_CONVERT_BLOCK(func, type, ...)                              \
+  for (int i = 0; i < count; i++) {                                    \
+    const size_t k = (index != NULL) ? index[offset + i] : offset + i; \
+    props->func(e, __VA_ARGS__, &((type*)out)[i * dim]);               \
+  }
+
+  /* The particles may be read through a list of indices */
+  const size_t* index = props->index;
+  if (props->convert_part_f != NULL) {
+    IO_CONVERT_BLOCK(convert_part_f, float, props->parts + k,
+                     props->xparts + k);
+  } else if (props->convert_part_i != NULL) {
+    IO_CONVERT_BLOCK(convert_part_i, int, props->parts + k, props->xparts + k);
+  } else if (props->convert_part_d != NULL) {
+    IO_CONVERT_BLOCK(convert_part_d, double, props->parts + k,
+                     props->xparts + k);
+  } else if (props->convert_part_l != NULL) {
+    IO_CONVERT_BLOCK(convert_part_l, long long, props->parts + k,
+                     props->xparts + k);
+  } else if (props->convert_gpart_f != NULL) {
+    IO_CONVERT_BLOCK(convert_gpart_f, float, props->gparts + k);
+  } else if (props->convert_gpart_i != NULL) {
+    IO_CONVERT_BLOCK(convert_gpart_i, int, props->gparts + k);
+  } else if (props->convert_gpart_d != NULL) {
+    IO_CONVERT_BLOCK(convert_gpart_d, double, props->gparts + k);
+  } else if (props->convert_gpart_l != NULL) {
+    IO_CONVERT_BLOCK(convert_gpart_l, long long, props->gparts + k);
+  } else if (props->convert_spart_f != NULL) {
+    IO_CONVERT_BLOCK(convert_spart_f, float, props->sparts + k);
+  } else if (props->convert_spart_i != NULL) {
+    IO_CONVERT_BLOCK(convert_spart_i, int, props->sparts + k);
+  } else if (props->convert_spart_d != NULL) {
+    IO_CONVERT_BLOCK(convert_spart_d, double, props->sparts + k);
+  } else if (props->convert_spart_l != NULL) {
+    IO_CONVERT_BLOCK(convert_spart_l, long long, props->sparts + k);
+  } else if (props->convert_sink_f != NULL) {
+    IO_CONVERT_BLOCK(convert_sink_f, float, props->sinks + k);
+  } else if (props->convert_sink_i != NULL) {
+    IO_CONVERT_BLOCK(convert_sink_i, int, props->sinks + k);
+  } else if (props->convert_sink_d != NULL) {
+    IO_CONVERT_BLOCK(convert_sink_d, double, props->sinks + k);
+  } else if (props->convert_sink_l != NULL) {
+    IO_CONVERT_BLOCK(convert_sink_l, long long, props->sinks + k);
+  } else if (props->convert_bpart_f != NULL) {
+    IO_CONVERT_BLOCK(convert_bpart_f, float, props->bparts + k);
+  } else if (props->convert_bpart_i != NULL) {
+    IO_CONVERT_BLOCK(convert_bpart_i, int, props->bparts + k);
+  } else if (props->convert_bpart_d != NULL) {
+    IO_CONVERT_BLOCK(convert_bpart_d, double, props->bparts + k);
+  } else if (props->convert_bpart_l != NULL) {
+    IO_CONVERT_BLOCK(convert_bpart_l, long long, props->bparts + k);
+  } else {
+    error("Missing conversion function");
+  }
+
+#undef IO_CONVERT_BLOCK
+}
+
+/**
+ * @brief Mapper function filling the buffers of several fields in a single
+ * sweep over the particles.
+ *
+ * The elements are particle indices, i.e. byte offsets from NULL.
+ */
+void io_fused_copy_mapper(void* map_data, int N, void* extra_data) {
+
+  const struct io_fused_copy_data* data =
+      (const struct io_fused_copy_data*)extra_data;
+  const size_t first = (size_t)map_data;
+
+  for (int b = 0; b < N; b += io_fused_copy_block_size) {
+
+    const size_t offset = first + b;
+    const int count = min(io_fused_copy_block_size, N - b);
+
+    /* Deal with every field for this block of particles */
+    for (int f = 0; f < data->num_fields; f++) {
+
+      const struct io_props* props = &data->props[f];
+      const size_t copySize = io_sizeof_type(props->type) * props->dimension;
+      char* out = (char*)data->temps[f] + offset * copySize;
+
+      if (props->conversion == 0) {
+
+        /* Strided copy straight from the particles */
+        if (props->index != NULL) {
+          const size_t* index = props->index + offset;
+          for (int i = 0; i < count; i++)
+            memcpy(out + i * copySize,
+                   props->field + index[i] * props->partSize, copySize);
+        } else {
+          const char* in = props->field + offset * props->partSize;
+          for (int i = 0; i < count; i++)
+            memcpy(out + i * copySize, in + i * props->partSize, copySize);
+        }
+
+      } else {
+        io_fused_convert_block(props, data->e, offset, count, out);
+      }
+
+      /* Unit conversion while the block is still in cache */
+      const double factor = data->factors[f];
+      if (factor != 1.) {
+        const size_t num_elements = (size_t)count * props->dimension;
+        if (io_is_double_precision(props->type)) {
+          double* out_d = (double*)out;
+          for (size_t i = 0; i < num_elements; ++i) out_d[i] *= factor;
+        } else {
+          float* out_f = (float*)out;
+          for (size_t i = 0; i < num_elements; ++i) out_f[i] *= factor;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Copy several fields of the same particles into their temporary
+ * buffers in a single pass over the particle arrays.
+ *
+ * This is equivalent to calling io_copy_temp_buffer() for each field but the
+ * particles are only walked once.
+ *
+ * @param temps The buffers to be filled, one per field. Must be allocated and
+ * aligned properly.
+ * @param e The #engine.
+ * @param props The #io_props of the fields we are copying.
+ * @param num_fields The number of fields.
+ * @param N The number of particles to copy
+ * @param internal_units The system of units used internally.
+ * @param snapshot_units The system of units used for the snapshots.
+ */
+void io_copy_temp_buffers_fused(void** temps, const struct engine* e,
+                                const struct io_props* props,
+                                const int num_fields, size_t N,
+                                const struct unit_system* internal_units,
+                                const struct unit_system* snapshot_units) {
+
+  if (num_fields == 0 || N == 0) return;
+
+  double* factors = (double*)malloc(num_fields * sizeof(double));
+  if (factors == NULL) error("Unable to allocate unit conversion factors");
+  for (int f = 0; f < num_fields; f++)
+    factors[f] =
+        units_conversion_factor(internal_units, snapshot_units, props[f].units);
+
+  struct io_fused_copy_data data;
+  data.props = props;
+  data.temps = temps;
+  data.factors = factors;
+  data.num_fields = num_fields;
+  data.e = e;
+
+  threadpool_map((struct threadpool*)&e->threadpool, io_fused_copy_mapper,
+                 NULL, N, 1, threadpool_auto_chunk_size, &data);
+
+  free(factors);
+}
+
+/**
+ * @brief Allocate and fill the buffers of the next group of fields to write.
+ *
+ * Consecutive fields are added to the group until their buffers exceed
+ * #IO_FUSED_COPY_MAX_BYTES (a group always contains at least one field). The
+ * buffers are then filled with a single pass over the particles. The caller
+ * is responsible for freeing them with swift_free("writebuff", ...).
+ *
+ * @param temps (return) The buffers of the fields in the group.
+ * @param e The #engine.
+ * @param props The #io_props of all the fields to write.
+ * @param first The index of the first field of the group.
+ * @param num_fields The total number of fields to write.
+ * @param N The number of particles to copy
+ * @param internal_units The system of units used internally.
+ * @param snapshot_units The system of units used for the snapshots.
+ *
+ * @return The number of fields in the group.
+ */
+int io_copy_next_field_group(void** temps, const struct engine* e,
+                             const struct io_props* props, const int first,
+                             const int num_fields, size_t N,
+                             const struct unit_system* internal_units,
+                             const struct unit_system* snapshot_units) {
+
+  size_t group_size = 0;
+  int last = first;
+  while (last < num_fields) {
+
+    const size_t size =
+        N * io_sizeof_type(props[last].type) * props[last].dimension;
+    if (last > first && group_size + size > IO_FUSED_COPY_MAX_BYTES) break;
+
+    if (swift_memalign("writebuff", &temps[last - first], IO_BUFFER_ALIGNMENT,
+                       size) != 0)
+      error("Unable to allocate temporary i/o buffer");
+
+    group_size += size;
+    last++;
+  }
+
+  io_copy_temp_buffers_fused(temps, e, props + first, last - first, N,
+                             internal_units, snapshot_units);
+
+  return last - first;
+}
+
 /**
  * @brief Copy the particle data into a temporary buffer ready for i/o.
  *
@@ -465,12 +712,21 @@ void io_convert_sink_l_mapper(void* restrict temp, int N,
  * @param N The number of particles to copy
  * @param internal_units The system of units used internally.
  * @param snapshot_units The system of units used for the snapshots.
+ *
+ * Fields reading the particles through a list of indices are handled by the
+ * fused copy.
  */
 void io_copy_temp_buffer(void* temp, const struct engine* e,
                          struct io_props props, size_t N,
                          const struct unit_system* internal_units,
                          const struct unit_system* snapshot_units) {
 
+  if (props.index != NULL) {
+    io_copy_temp_buffers_fused(&temp, e, &props, /*num_fields=*/1, N,
+                               internal_units, snapshot_units);
+    return;
+  }
+
   const size_t typeSize = io_sizeof_type(props.type);
   const size_t copySize = typeSize * props.dimension;
   const size_t num_elements = N * props.dimension;
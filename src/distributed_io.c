@@ -24,6 +24,7 @@
 
 /* Some standard headers. */
 #include <hdf5.h>
+#include <limits.h>
 #include <math.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -64,6 +65,150 @@
 /* Are we timing the i/o? */
 //#define IO_SPEED_MEASUREMENT
 
+/* Maximal size of the messages used to collect the fields on the rank
+ * writing a file and of the pieces written to it. */
+#ifndef DISTRIBUTED_IO_GATHER_MAX_BYTES
+#define DISTRIBUTED_IO_GATHER_MAX_BYTES (256LL * 1024LL * 1024LL)
+#endif
+
+/**
+ * @brief Number of particles of a field sent in each message to the rank
+ * writing the file.
+ *
+ * @param props The #io_props of the field.
+ */
+static size_t distributed_io_gather_chunk_size(const struct io_props props) {
+
+  const size_t elem_size = props.dimension * io_sizeof_type(props.type);
+  const size_t max_elems = DISTRIBUTED_IO_GATHER_MAX_BYTES / elem_size;
+  return max_elems > 0 ? max_elems : 1;
+}
+
+/**
+ * @brief Sends the converted buffer of a field to the rank writing the file
+ * in pieces of at most #DISTRIBUTED_IO_GATHER_MAX_BYTES.
+ *
+ * @param props The #io_props of the field.
+ * @param temp The buffer of this rank.
+ * @param N The number of particles in the buffer.
+ * @param file_comm The communicator of the ranks writing to this file.
+ */
+static void distributed_io_send_field(const struct io_props props,
+                                      const void* temp, const size_t N,
+                                      MPI_Comm file_comm) {
+
+  const size_t elem_size = props.dimension * io_sizeof_type(props.type);
+  const size_t chunk_size = distributed_io_gather_chunk_size(props);
+
+  for (size_t offset = 0; offset < N; offset += chunk_size) {
+    const size_t this_chunk = min(chunk_size, N - offset);
+    MPI_Send((const char*)temp + offset * elem_size,
+             (int)(this_chunk * elem_size), MPI_BYTE, 0, 0, file_comm);
+  }
+}
+
+/**
+ * @brief Writes a slab of particles of a field to an HDF5 dataset.
+ *
+ * @param h_data The HDF5 dataset to write to.
+ * @param props The #io_props of the field.
+ * @param buff The data to write.
+ * @param N The number of particles to write.
+ * @param offset The index of the first particle in the dataset.
+ */
+static void distributed_io_write_slab(hid_t h_data,
+                                      const struct io_props props,
+                                      const void* buff, const size_t N,
+                                      const size_t offset) {
+
+  if (N == 0) return;
+
+  const int rank = (props.dimension > 1) ? 2 : 1;
+  const hsize_t shape[2] = {N, props.dimension};
+  const hsize_t start[2] = {offset, 0};
+
+  const hid_t h_memspace = H5Screate_simple(rank, shape, NULL);
+  if (h_memspace < 0)
+    error("Error while creating memory space for field '%s'.", props.name);
+
+  const hid_t h_filespace = H5Dget_space(h_data);
+  if (h_filespace < 0)
+    error("Error while getting file space for field '%s'.", props.name);
+
+  hid_t h_err = H5Sselect_hyperslab(h_filespace, H5S_SELECT_SET, start, NULL,
+                                    shape, NULL);
+  if (h_err < 0)
+    error("Error while selecting the slab of field '%s'.", props.name);
+
+  h_err = H5Dwrite(h_data, io_hdf5_type(props.type), h_memspace, h_filespace,
+                   H5P_DEFAULT, buff);
+  if (h_err < 0) error("Error while writing data array '%s'.", props.name);
+
+  H5Sclose(h_filespace);
+  H5Sclose(h_memspace);
+}
+
+/**
+ * @brief Writes the buffers of a field of all the ranks of a file group to
+ * the dataset, on the rank writing the file.
+ *
+ * The data of the other ranks is received and written in pieces of at most
+ * #DISTRIBUTED_IO_GATHER_MAX_BYTES such that the writing rank never holds
+ * the field for the whole file in memory.
+ *
+ * @param h_data The HDF5 dataset to write to.
+ * @param props The #io_props of the field.
+ * @param temp The buffer of this rank.
+ * @param N_ranks_file The number of particles of each type sent by each rank
+ * of the group.
+ * @param ptype The type of particles we are writing.
+ * @param file_comm The communicator of the ranks writing to this file.
+ */
+static void distributed_io_write_gathered(hid_t h_data,
+                                          const struct io_props props,
+                                          const void* temp,
+                                          const long long* N_ranks_file,
+                                          const int ptype, MPI_Comm file_comm) {
+
+  int file_size;
+  MPI_Comm_size(file_comm, &file_size);
+
+  const size_t elem_size = props.dimension * io_sizeof_type(props.type);
+  const size_t chunk_size = distributed_io_gather_chunk_size(props);
+
+  /* Our own particles go first */
+  size_t offset = N_ranks_file[ptype];
+  distributed_io_write_slab(h_data, props, temp, offset, 0);
+
+  /* Largest piece we will receive */
+  size_t buff_size = 0;
+  for (int i = 1; i < file_size; ++i) {
+    const size_t N = N_ranks_file[i * swift_type_count + ptype];
+    const size_t this_chunk = min(chunk_size, N);
+    buff_size = max(buff_size, this_chunk);
+  }
+  if (buff_size == 0) return;
+
+  void* buff = NULL;
+  if (swift_memalign("writebuff", &buff, IO_BUFFER_ALIGNMENT,
+                     buff_size * elem_size) != 0)
+    error("Unable to allocate aggregation buffer");
+
+  /* Now the ones of the other ranks, in rank order */
+  for (int i = 1; i < file_size; ++i) {
+    const size_t N = N_ranks_file[i * swift_type_count + ptype];
+    for (size_t done = 0; done < N; done += chunk_size) {
+      const size_t this_chunk = min(chunk_size, N - done);
+      MPI_Recv(buff, (int)(this_chunk * elem_size), MPI_BYTE, i, 0, file_comm,
+               MPI_STATUS_IGNORE);
+      distributed_io_write_slab(h_data, props, buff, this_chunk, offset);
+      offset += this_chunk;
+    }
+  }
+
+  swift_free("writebuff", buff);
+}
+
 /**
  * @brief Writes a data array in given HDF5 group.
  *
@@ -73,48 +218,29 @@
  * @param partTypeGroupName The name of the group containing the particles in
  * the HDF5 file.
  * @param props The #io_props of the field to read
+ * @param temp The buffer containing the field converted to snapshot units.
  * @param N The number of particles to write.
+ * @param N_ranks_file The number of particles of each type sent by each rank
+ * of the file group.
+ * @param ptype The type of particles we are writing.
+ * @param file_comm The communicator of the ranks writing to this file.
  * @param lossy_compression Level of lossy compression to use for this field.
- * @param internal_units The #unit_system used internally
  * @param snapshot_units The #unit_system used in the snapshots
- *
- * @todo A better version using HDF5 hyper-slabs to write the file directly from
- * the part array will be written once the structures have been stabilized.
  */
 void write_distributed_array(
     const struct engine* e, hid_t grp, const char* fileName,
-    const char* partTypeGroupName, const struct io_props props, const size_t N,
+    const char* partTypeGroupName, const struct io_props props,
+    const void* temp, const size_t N, const long long* N_ranks_file,
+    const int ptype, MPI_Comm file_comm,
     const enum lossy_compression_schemes lossy_compression,
-    const struct unit_system* internal_units,
     const struct unit_system* snapshot_units) {
 
 #ifdef IO_SPEED_MEASUREMENT
-  const ticks tic_total = getticks();
-#endif
-
   const size_t typeSize = io_sizeof_type(props.type);
-  const size_t num_elements = N * props.dimension;
-
-  /* message("Writing '%s' array...", props.name); */
-
-  /* Allocate temporary buffer */
-  void* temp = NULL;
-  if (swift_memalign("writebuff", (void**)&temp, IO_BUFFER_ALIGNMENT,
-                     num_elements * typeSize) != 0)
-    error("Unable to allocate temporary i/o buffer");
-
-#ifdef IO_SPEED_MEASUREMENT
   ticks tic = getticks();
 #endif
 
-  /* Copy the particle data to the temporary buffer */
-  io_copy_temp_buffer(temp, e, props, N, internal_units, snapshot_units);
-
-#ifdef IO_SPEED_MEASUREMENT
-  if (engine_rank == IO_SPEED_MEASUREMENT || IO_SPEED_MEASUREMENT == -1)
-    message("Copying for '%s' took %.3f %s.", props.name,
-            clocks_from_ticks(getticks() - tic), clocks_getunit());
-#endif
+  /* message("Writing '%s' array...", props.name); */
 
   /* Create data space */
   hid_t h_space;
@@ -205,10 +331,18 @@ void write_distributed_array(
   tic = getticks();
 #endif
 
-  /* Write temporary buffer to HDF5 dataspace */
-  h_err = H5Dwrite(h_data, io_hdf5_type(props.type), h_space, H5S_ALL,
-                   H5P_DEFAULT, temp);
-  if (h_err < 0) error("Error while writing data array '%s'.", props.name);
+  /* Write temporary buffer to HDF5 dataspace, collecting the other ranks'
+   * data if we write for a whole group */
+  int file_size;
+  MPI_Comm_size(file_comm, &file_size);
+  if (file_size > 1) {
+    distributed_io_write_gathered(h_data, props, temp, N_ranks_file, ptype,
+                                  file_comm);
+  } else {
+    h_err = H5Dwrite(h_data, io_hdf5_type(props.type), h_space, H5S_ALL,
+                     H5P_DEFAULT, temp);
+    if (h_err < 0) error("Error while writing data array '%s'.", props.name);
+  }
 
 #ifdef IO_SPEED_MEASUREMENT
   ticks toc = getticks();
@@ -258,7 +392,6 @@ void write_distributed_array(
   io_write_attribute_s(h_data, "Description", props.description);
 
   /* Free and close everything */
-  swift_free("writebuff", temp);
   H5Tclose(h_type);
   H5Pclose(h_prop);
   H5Dclose(h_data);
@@ -732,6 +865,58 @@ void write_virtual_file(struct engine* e, const char* fileName_base,
 #endif
 }
 
+/**
+ * @brief Groups the ranks writing their particles to the same file.
+ *
+ * With nodes_per_file set to 0, every rank writes its own file. Otherwise,
+ * the ranks sharing a node are grouped and the particles of nodes_per_file
+ * consecutive nodes end up in the same file. The nodes are numbered in the
+ * order of their lowest rank and the lowest rank of each group writes the
+ * file. The files are hence ordered like their writing ranks.
+ *
+ * @param comm The communicator used by the MPI ranks.
+ * @param nodes_per_file The number of nodes writing to each file.
+ * @param file_comm (return) The communicator of the ranks sharing our file.
+ * @param file_index (return) The index of the file we contribute to.
+ * @param num_files (return) The total number of files.
+ */
+static void distributed_io_make_file_groups(MPI_Comm comm,
+                                            const int nodes_per_file,
+                                            MPI_Comm* file_comm,
+                                            int* file_index, int* num_files) {
+
+  int mpi_rank, mpi_size;
+  MPI_Comm_rank(comm, &mpi_rank);
+  MPI_Comm_size(comm, &mpi_size);
+
+  if (nodes_per_file == 0) {
+    MPI_Comm_dup(MPI_COMM_SELF, file_comm);
+    *file_index = mpi_rank;
+    *num_files = mpi_size;
+    return;
+  }
+
+  /* Find the ranks sharing our node */
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, mpi_rank, MPI_INFO_NULL,
+                      &node_comm);
+  int node_rank;
+  MPI_Comm_rank(node_comm, &node_rank);
+
+  /* Number the nodes in the order of their lowest rank */
+  const int is_leader = (node_rank == 0);
+  int node_index = 0, num_nodes = 0;
+  MPI_Exscan(&is_leader, &node_index, 1, MPI_INT, MPI_SUM, comm);
+  if (mpi_rank == 0) node_index = 0;
+  MPI_Bcast(&node_index, 1, MPI_INT, 0, node_comm);
+  MPI_Allreduce(&is_leader, &num_nodes, 1, MPI_INT, MPI_SUM, comm);
+  MPI_Comm_free(&node_comm);
+
+  *file_index = node_index / nodes_per_file;
+  *num_files = (num_nodes + nodes_per_file - 1) / nodes_per_file;
+  MPI_Comm_split(comm, *file_index, mpi_rank, file_comm);
+}
+
 /**
  * @brief Writes a snapshot distributed into multiple files.
  *
@@ -743,8 +928,9 @@ void write_virtual_file(struct engine* e, const char* fileName_base,
  * @param comm The communicator used by the MPI ranks.
  * @param info The MPI information object.
  *
- * Creates a series of HDF5 output files (1 per MPI node) as a snapshot.
- * Writes the particles contained in the engine.
+ * Creates a series of HDF5 output files (1 per MPI rank or, if
+ * Snapshots:distributed_nodes_per_file is set, 1 per group of nodes) as a
+ * snapshot. Writes the particles contained in the engine.
  * If such files already exist, it is erased and replaced by the new one.
  * The companion XMF file is also updated accordingly.
  */
@@ -755,7 +941,6 @@ void write_output_distributed(struct engine* e,
                               MPI_Comm comm, MPI_Info info) {
 
   hid_t h_file = 0, h_grp = 0;
-  int numFiles = mpi_size;
   const struct part* parts = e->s->parts;
   const struct xpart* xparts = e->s->xparts;
   const struct gpart* gparts = e->s->gparts;
@@ -790,6 +975,16 @@ void write_output_distributed(struct engine* e,
   const size_t Nstars = e->s->nr_sparts;
   const size_t Nblackholes = e->s->nr_bparts;
 
+  /* Group the ranks writing to the same file */
+  MPI_Comm file_comm;
+  int file_index, num_files;
+  distributed_io_make_file_groups(comm, e->snapshot_distributed_nodes_per_file,
+                                  &file_comm, &file_index, &num_files);
+  int file_rank, file_size;
+  MPI_Comm_rank(file_comm, &file_rank);
+  MPI_Comm_size(file_comm, &file_size);
+  const int is_writer = (file_rank == 0);
+
   /* Determine if we are writing a reduced snapshot, and if so which
    * output selection type to use */
   char current_selection_name[FIELD_BUFFER_SIZE] =
@@ -837,7 +1032,7 @@ void write_output_distributed(struct engine* e,
 
     sprintf(fileName, "%s/%s_%0*d/%s_%0*d.%d.hdf5", snapshot_subdir_name,
             snapshot_base_name, number_digits, snap_count, snapshot_base_name,
-            number_digits, snap_count, mpi_rank);
+            number_digits, snap_count, file_index);
 
     sprintf(fileName_base, "%s/%s_%0*d/%s_%0*d", snapshot_subdir_name,
             snapshot_base_name, number_digits, snap_count, snapshot_base_name,
@@ -848,7 +1043,7 @@ void write_output_distributed(struct engine* e,
 
     sprintf(fileName, "%s_%0*d/%s_%0*d.%d.hdf5", snapshot_base_name,
             number_digits, snap_count, snapshot_base_name, number_digits,
-            snap_count, mpi_rank);
+            snap_count, file_index);
 
     sprintf(fileName_base, "%s_%0*d/%s_%0*d", snapshot_base_name, number_digits,
             snap_count, snapshot_base_name, number_digits, snap_count);
@@ -948,11 +1143,38 @@ void write_output_distributed(struct engine* e,
   long long N_total[swift_type_count] = {0};
   MPI_Allreduce(N, N_total, swift_type_count, MPI_LONG_LONG_INT, MPI_SUM, comm);
 
-  /* Collect the number of particles written by each rank */
+  /* Select the number of particles sent by each rank of our group on the
+   * rank writing the file, as well as the position of our particles in it */
+  long long* N_ranks_file = NULL;
+  if (is_writer)
+    N_ranks_file =
+        (long long*)malloc(file_size * swift_type_count * sizeof(long long));
+  MPI_Gather(N, swift_type_count, MPI_LONG_LONG_INT, N_ranks_file,
+             swift_type_count, MPI_LONG_LONG_INT, 0, file_comm);
+  long long N_file[swift_type_count] = {0};
+  long long file_offsets[swift_type_count] = {0};
+  MPI_Allreduce(N, N_file, swift_type_count, MPI_LONG_LONG_INT, MPI_SUM,
+                file_comm);
+  MPI_Exscan(N, file_offsets, swift_type_count, MPI_LONG_LONG_INT, MPI_SUM,
+             file_comm);
+  if (file_rank == 0)
+    for (int i = 0; i < swift_type_count; ++i) file_offsets[i] = 0;
+
+  /* Select the number of particles written in each file */
   long long* N_counts =
-      (long long*)malloc(mpi_size * swift_type_count * sizeof(long long));
-  MPI_Gather(N, swift_type_count, MPI_LONG_LONG_INT, N_counts, swift_type_count,
-             MPI_LONG_LONG_INT, 0, comm);
+      (long long*)calloc(num_files * swift_type_count, sizeof(long long));
+  if (is_writer)
+    memcpy(&N_counts[file_index * swift_type_count], N_file,
+           swift_type_count * sizeof(long long));
+  MPI_Reduce(mpi_rank == 0 ? MPI_IN_PLACE : N_counts, N_counts,
+             num_files * swift_type_count, MPI_LONG_LONG_INT, MPI_SUM, 0, comm);
+
+  /* Which file holds the particles of each rank? */
+  int* node_files = NULL;
+  if (e->snapshot_distributed_nodes_per_file > 0) {
+    node_files = (int*)malloc(mpi_size * sizeof(int));
+    MPI_Allgather(&file_index, 1, MPI_INT, node_files, 1, MPI_INT, comm);
+  }
 
   /* List what fields to write.
    * Note that we want to want to write a 0-size dataset for some species
@@ -972,148 +1194,158 @@ void write_output_distributed(struct engine* e,
     int offset = rand() % e->snapshot_lustre_OST_count;
     MPI_Bcast(&offset, 1, MPI_INT, 0, MPI_COMM_WORLD);
 
-    char string[1200];
-    sprintf(string, "lfs setstripe -c 1 -i %d %s",
-            ((e->nodeID + offset) % e->snapshot_lustre_OST_count), fileName);
-    const int result = system(string);
-    if (result != 0) {
-      message("lfs setstripe command returned error code %d", result);
+    if (is_writer) {
+      char string[1200];
+      sprintf(string, "lfs setstripe -c 1 -i %d %s",
+              ((file_index + offset) % e->snapshot_lustre_OST_count), fileName);
+      const int result = system(string);
+      if (result != 0) {
+        message("lfs setstripe command returned error code %d", result);
+      }
     }
   }
 
-  /* Open file */
-  /* message("Opening file '%s'.", fileName); */
-  h_file = H5Fcreate(fileName, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-  if (h_file < 0) error("Error while opening file '%s'.", fileName);
-
-  /* Open header to write simulation properties */
-  /* message("Writing file header..."); */
-  h_grp = H5Gcreate(h_file, "/Header", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-  if (h_grp < 0) error("Error while creating file header\n");
-
-  /* Convert basic output information to snapshot units */
-  const double factor_time =
-      units_conversion_factor(internal_units, snapshot_units, UNIT_CONV_TIME);
-  const double factor_length =
-      units_conversion_factor(internal_units, snapshot_units, UNIT_CONV_LENGTH);
-  const double dblTime = e->time * factor_time;
-  const double dim[3] = {e->s->dim[0] * factor_length,
-                         e->s->dim[1] * factor_length,
-                         e->s->dim[2] * factor_length};
-
-  /* Print the relevant information and print status */
-  io_write_attribute(h_grp, "BoxSize", DOUBLE, dim, 3);
-  io_write_attribute(h_grp, "Time", DOUBLE, &dblTime, 1);
-  const int dimension = (int)hydro_dimension;
-  io_write_attribute(h_grp, "Dimension", INT, &dimension, 1);
-  io_write_attribute(h_grp, "Redshift", DOUBLE, &e->cosmology->z, 1);
-  io_write_attribute(h_grp, "Scale-factor", DOUBLE, &e->cosmology->a, 1);
-  io_write_attribute_s(h_grp, "Code", "SWIFT");
-  io_write_attribute_s(h_grp, "RunName", e->run_name);
-
   /* We write rank 0's hostname so that it is uniform across all files. */
   char systemname[256] = {0};
   if (mpi_rank == 0) sprintf(systemname, "%s", hostname());
   MPI_Bcast(systemname, 256, MPI_CHAR, 0, comm);
-  io_write_attribute_s(h_grp, "System", systemname);
-  io_write_attribute(h_grp, "Shift", DOUBLE, e->s->initial_shift, 3);
-
-  /* Write out the particle types */
-  io_write_part_type_names(h_grp);
-
-  /* Write out the time-base */
-  if (with_cosmology) {
-    io_write_attribute_d(h_grp, "TimeBase_dloga", e->time_base);
-    const double delta_t = cosmology_get_timebase(e->cosmology, e->ti_current);
-    io_write_attribute_d(h_grp, "TimeBase_dt", delta_t);
-  } else {
-    io_write_attribute_d(h_grp, "TimeBase_dloga", 0);
-    io_write_attribute_d(h_grp, "TimeBase_dt", e->time_base);
-  }
-
-  /* Store the time at which the snapshot was written */
-  time_t tm = time(NULL);
-  struct tm* timeinfo = localtime(&tm);
-  char snapshot_date[64];
-  strftime(snapshot_date, 64, "%T %F %Z", timeinfo);
-  io_write_attribute_s(h_grp, "SnapshotDate", snapshot_date);
-
-  /* GADGET-2 legacy values:  Number of particles of each type */
-  long long numParticlesThisFile[swift_type_count] = {0};
-  unsigned int numParticles[swift_type_count] = {0};
-  unsigned int numParticlesHighWord[swift_type_count] = {0};
 
   /* Total number of fields to write per ptype */
   int numFields[swift_type_count] = {0};
-
-  for (int ptype = 0; ptype < swift_type_count; ++ptype) {
-    numParticles[ptype] = (unsigned int)N_total[ptype];
-    numParticlesHighWord[ptype] = (unsigned int)(N_total[ptype] >> 32);
-
+  for (int ptype = 0; ptype < swift_type_count; ++ptype)
     numFields[ptype] = output_options_get_num_fields_to_write(
         output_options, current_selection_name, ptype);
 
-    if (numFields[ptype] == 0) {
-      numParticlesThisFile[ptype] = 0;
+  /* Only the rank writing the file creates it and writes its header */
+  if (is_writer) {
+
+    /* Open file */
+    /* message("Opening file '%s'.", fileName); */
+    h_file = H5Fcreate(fileName, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    if (h_file < 0) error("Error while opening file '%s'.", fileName);
+
+    /* Open header to write simulation properties */
+    /* message("Writing file header..."); */
+    h_grp = H5Gcreate(h_file, "/Header", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    if (h_grp < 0) error("Error while creating file header\n");
+
+    /* Convert basic output information to snapshot units */
+    const double factor_time =
+        units_conversion_factor(internal_units, snapshot_units, UNIT_CONV_TIME);
+    const double factor_length = units_conversion_factor(
+        internal_units, snapshot_units, UNIT_CONV_LENGTH);
+    const double dblTime = e->time * factor_time;
+    const double dim[3] = {e->s->dim[0] * factor_length,
+                           e->s->dim[1] * factor_length,
+                           e->s->dim[2] * factor_length};
+
+    /* Print the relevant information and print status */
+    io_write_attribute(h_grp, "BoxSize", DOUBLE, dim, 3);
+    io_write_attribute(h_grp, "Time", DOUBLE, &dblTime, 1);
+    const int dimension = (int)hydro_dimension;
+    io_write_attribute(h_grp, "Dimension", INT, &dimension, 1);
+    io_write_attribute(h_grp, "Redshift", DOUBLE, &e->cosmology->z, 1);
+    io_write_attribute(h_grp, "Scale-factor", DOUBLE, &e->cosmology->a, 1);
+    io_write_attribute_s(h_grp, "Code", "SWIFT");
+    io_write_attribute_s(h_grp, "RunName", e->run_name);
+    io_write_attribute_s(h_grp, "System", systemname);
+    io_write_attribute(h_grp, "Shift", DOUBLE, e->s->initial_shift, 3);
+
+    /* Write out the particle types */
+    io_write_part_type_names(h_grp);
+
+    /* Write out the time-base */
+    if (with_cosmology) {
+      io_write_attribute_d(h_grp, "TimeBase_dloga", e->time_base);
+      const double delta_t =
+          cosmology_get_timebase(e->cosmology, e->ti_current);
+      io_write_attribute_d(h_grp, "TimeBase_dt", delta_t);
     } else {
-      numParticlesThisFile[ptype] = N[ptype];
+      io_write_attribute_d(h_grp, "TimeBase_dloga", 0);
+      io_write_attribute_d(h_grp, "TimeBase_dt", e->time_base);
     }
-  }
 
-  io_write_attribute(h_grp, "NumPart_ThisFile", LONGLONG, numParticlesThisFile,
-                     swift_type_count);
-  io_write_attribute(h_grp, "NumPart_Total", UINT, numParticles,
-                     swift_type_count);
-  io_write_attribute(h_grp, "NumPart_Total_HighWord", UINT,
-                     numParticlesHighWord, swift_type_count);
-  io_write_attribute(h_grp, "TotalNumberOfParticles", LONGLONG, N_total,
-                     swift_type_count);
-  double MassTable[swift_type_count] = {0};
-  io_write_attribute(h_grp, "MassTable", DOUBLE, MassTable, swift_type_count);
-  io_write_attribute(h_grp, "InitialMassTable", DOUBLE,
-                     e->s->initial_mean_mass_particles, swift_type_count);
-  unsigned int flagEntropy[swift_type_count] = {0};
-  flagEntropy[0] = writeEntropyFlag();
-  io_write_attribute(h_grp, "Flag_Entropy_ICs", UINT, flagEntropy,
-                     swift_type_count);
-  io_write_attribute_i(h_grp, "NumFilesPerSnapshot", numFiles);
-  io_write_attribute_i(h_grp, "ThisFile", mpi_rank);
-  io_write_attribute_s(h_grp, "SelectOutput", current_selection_name);
-  io_write_attribute_i(h_grp, "Virtual", 0);
-  io_write_attribute(h_grp, "CanHaveTypes", INT, to_write, swift_type_count);
+    /* Store the time at which the snapshot was written */
+    time_t tm = time(NULL);
+    struct tm* timeinfo = localtime(&tm);
+    char snapshot_date[64];
+    strftime(snapshot_date, 64, "%T %F %Z", timeinfo);
+    io_write_attribute_s(h_grp, "SnapshotDate", snapshot_date);
+
+    /* GADGET-2 legacy values:  Number of particles of each type */
+    long long numParticlesThisFile[swift_type_count] = {0};
+    unsigned int numParticles[swift_type_count] = {0};
+    unsigned int numParticlesHighWord[swift_type_count] = {0};
+
+    for (int ptype = 0; ptype < swift_type_count; ++ptype) {
+      numParticles[ptype] = (unsigned int)N_total[ptype];
+      numParticlesHighWord[ptype] = (unsigned int)(N_total[ptype] >> 32);
+
+      if (numFields[ptype] == 0) {
+        numParticlesThisFile[ptype] = 0;
+      } else {
+        numParticlesThisFile[ptype] = N_file[ptype];
+      }
+    }
 
-  if (subsample_any) {
-    io_write_attribute_s(h_grp, "OutputType", "SubSampled");
-    io_write_attribute(h_grp, "SubSampleFractions", FLOAT, subsample_fraction,
+    io_write_attribute(h_grp, "NumPart_ThisFile", LONGLONG,
+                       numParticlesThisFile, swift_type_count);
+    io_write_attribute(h_grp, "NumPart_Total", UINT, numParticles,
                        swift_type_count);
-  } else {
-    io_write_attribute_s(h_grp, "OutputType", "FullVolume");
-  }
+    io_write_attribute(h_grp, "NumPart_Total_HighWord", UINT,
+                       numParticlesHighWord, swift_type_count);
+    io_write_attribute(h_grp, "TotalNumberOfParticles", LONGLONG, N_total,
+                       swift_type_count);
+    double MassTable[swift_type_count] = {0};
+    io_write_attribute(h_grp, "MassTable", DOUBLE, MassTable, swift_type_count);
+    io_write_attribute(h_grp, "InitialMassTable", DOUBLE,
+                       e->s->initial_mean_mass_particles, swift_type_count);
+    unsigned int flagEntropy[swift_type_count] = {0};
+    flagEntropy[0] = writeEntropyFlag();
+    io_write_attribute(h_grp, "Flag_Entropy_ICs", UINT, flagEntropy,
+                       swift_type_count);
+    io_write_attribute_i(h_grp, "NumFilesPerSnapshot", num_files);
+    io_write_attribute_i(h_grp, "ThisFile", file_index);
+    io_write_attribute_s(h_grp, "SelectOutput", current_selection_name);
+    io_write_attribute_i(h_grp, "Virtual", 0);
+    io_write_attribute(h_grp, "CanHaveTypes", INT, to_write, swift_type_count);
+
+    if (subsample_any) {
+      io_write_attribute_s(h_grp, "OutputType", "SubSampled");
+      io_write_attribute(h_grp, "SubSampleFractions", FLOAT, subsample_fraction,
+                         swift_type_count);
+    } else {
+      io_write_attribute_s(h_grp, "OutputType", "FullVolume");
+    }
 
-  /* Close header */
-  H5Gclose(h_grp);
+    /* Close header */
+    H5Gclose(h_grp);
 
-  /* Copy metadata from ICs to the file */
-  ic_info_write_hdf5(e->ics_metadata, h_file);
+    /* Copy metadata from ICs to the file */
+    ic_info_write_hdf5(e->ics_metadata, h_file);
 
-  /* Write all the meta-data */
-  io_write_meta_data(h_file, e, internal_units, snapshot_units);
+    /* Write all the meta-data */
+    io_write_meta_data(h_file, e, internal_units, snapshot_units);
+  }
 
   /* Now write the top-level cell structure
-   * We use a global offset of 0 here. This means that the cells will write
-   * their offset with respect to the start of the file they belong to and
-   * not a global offset */
-  long long global_offsets[swift_type_count] = {0};
-  h_grp = H5Gcreate(h_file, "/Cells", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-  if (h_grp < 0) error("Error while creating cells group");
+   * We use the offset of this rank in its file here. This means that the
+   * cells will write their offset with respect to the start of the file they
+   * belong to and not a global offset */
+  h_grp = -1;
+  if (is_writer) {
+    h_grp = H5Gcreate(h_file, "/Cells", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    if (h_grp < 0) error("Error while creating cells group");
+  }
 
   /* Write the location of the particles in the arrays */
   io_write_cell_offsets(h_grp, e->s->cdim, e->s->dim, e->s->cells_top,
                         e->s->nr_cells, e->s->width, mpi_rank,
-                        /*distributed=*/1, subsample, subsample_fraction,
-                        e->snapshot_output_count, N_total, global_offsets,
-                        to_write, numFields, internal_units, snapshot_units);
-  H5Gclose(h_grp);
+                        /*distributed=*/1, node_files, subsample,
+                        subsample_fraction, e->snapshot_output_count, N_total,
+                        file_offsets, to_write, numFields, internal_units,
+                        snapshot_units);
+  if (is_writer) H5Gclose(h_grp);
 
   /* Loop over all particle types */
   for (int ptype = 0; ptype < swift_type_count; ptype++) {
@@ -1127,34 +1359,31 @@ void write_output_distributed(struct engine* e,
     char partTypeGroupName[PARTICLE_GROUP_BUFFER_SIZE];
     snprintf(partTypeGroupName, PARTICLE_GROUP_BUFFER_SIZE, "/PartType%d",
              ptype);
-    h_grp = H5Gcreate(h_file, partTypeGroupName, H5P_DEFAULT, H5P_DEFAULT,
-                      H5P_DEFAULT);
-    if (h_grp < 0) error("Error while creating particle group.\n");
-
-    /* Add an alias name for convenience */
-    char aliasName[PARTICLE_GROUP_BUFFER_SIZE];
-    snprintf(aliasName, PARTICLE_GROUP_BUFFER_SIZE, "/%sParticles",
-             part_type_names[ptype]);
-    hid_t h_err = H5Lcreate_soft(partTypeGroupName, h_grp, aliasName,
-                                 H5P_DEFAULT, H5P_DEFAULT);
-    if (h_err < 0) error("Error while creating alias for particle group.\n");
+    if (is_writer) {
+      h_grp = H5Gcreate(h_file, partTypeGroupName, H5P_DEFAULT, H5P_DEFAULT,
+                        H5P_DEFAULT);
+      if (h_grp < 0) error("Error while creating particle group.\n");
+
+      /* Add an alias name for convenience */
+      char aliasName[PARTICLE_GROUP_BUFFER_SIZE];
+      snprintf(aliasName, PARTICLE_GROUP_BUFFER_SIZE, "/%sParticles",
+               part_type_names[ptype]);
+      hid_t h_err = H5Lcreate_soft(partTypeGroupName, h_grp, aliasName,
+                                   H5P_DEFAULT, H5P_DEFAULT);
+      if (h_err < 0)
+        error("Error while creating alias for particle group.\n");
 
-    /* Write the number of particles as an attribute */
-    io_write_attribute_ll(h_grp, "NumberOfParticles", N[ptype]);
-    io_write_attribute_ll(h_grp, "TotalNumberOfParticles", N_total[ptype]);
+      /* Write the number of particles as an attribute */
+      io_write_attribute_ll(h_grp, "NumberOfParticles", N_file[ptype]);
+      io_write_attribute_ll(h_grp, "TotalNumberOfParticles", N_total[ptype]);
+    }
 
     int num_fields = 0;
     struct io_props list[100];
     bzero(list, 100 * sizeof(struct io_props));
     size_t Nparticles = 0;
 
-    struct part* parts_written = NULL;
-    struct xpart* xparts_written = NULL;
-    struct gpart* gparts_written = NULL;
-    struct velociraptor_gpart_data* gpart_group_data_written = NULL;
-    struct sink* sinks_written = NULL;
-    struct spart* sparts_written = NULL;
-    struct bpart* bparts_written = NULL;
+    size_t* index_written = NULL;
 
     /* Write particle fields from the particle structure */
     switch (ptype) {
@@ -1175,26 +1404,17 @@ void write_output_distributed(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           Nparticles = Ngas_written;
 
-          /* Allocate temporary arrays */
-          if (swift_memalign("parts_written", (void**)&parts_written,
-                             part_align,
-                             Ngas_written * sizeof(struct part)) != 0)
-            error("Error while allocating temporary memory for parts");
-          if (swift_memalign("xparts_written", (void**)&xparts_written,
-                             xpart_align,
-                             Ngas_written * sizeof(struct xpart)) != 0)
-            error("Error while allocating temporary memory for xparts");
-
-          /* Collect the particles we want to write */
-          io_collect_parts_to_write(
-              parts, xparts, parts_written, xparts_written,
-              subsample[swift_type_gas], subsample_fraction[swift_type_gas],
-              e->snapshot_output_count, Ngas, Ngas_written);
+          /* Select the particles we want to write */
+          index_written =
+              io_select_parts_to_write(e, parts, subsample[swift_type_gas],
+                                       subsample_fraction[swift_type_gas],
+                                       e->snapshot_output_count, Ngas,
+                                       Ngas_written);
 
           /* Select the fields to write */
-          io_select_hydro_fields(parts_written, xparts_written, with_cosmology,
-                                 with_cooling, with_temperature, with_fof,
-                                 with_stf, with_rt, e, &num_fields, list);
+          io_select_hydro_fields(parts, xparts, with_cosmology, with_cooling,
+                                 with_temperature, with_fof, with_stf, with_rt,
+                                 e, &num_fields, list);
         }
       } break;
 
@@ -1214,32 +1434,15 @@ void write_output_distributed(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           Nparticles = Ndm_written;
 
-          /* Allocate temporary array */
-          if (swift_memalign("gparts_written", (void**)&gparts_written,
-                             gpart_align,
-                             Ndm_written * sizeof(struct gpart)) != 0)
-            error("Error while allocating temporary memory for gparts");
-
-          if (with_stf) {
-            if (swift_memalign(
-                    "gpart_group_written", (void**)&gpart_group_data_written,
-                    gpart_align,
-                    Ndm_written * sizeof(struct velociraptor_gpart_data)) != 0)
-              error(
-                  "Error while allocating temporary memory for gparts STF "
-                  "data");
-          }
-
-          /* Collect the non-inhibited DM particles from gpart */
-          io_collect_gparts_to_write(
-              gparts, e->s->gpart_group_data, gparts_written,
-              gpart_group_data_written, subsample[swift_type_dark_matter],
+          /* Select the non-inhibited DM particles from gpart */
+          index_written = io_select_gparts_to_write(
+              e, gparts, subsample[swift_type_dark_matter],
               subsample_fraction[swift_type_dark_matter],
-              e->snapshot_output_count, Ntot, Ndm_written, with_stf);
+              e->snapshot_output_count, Ntot, Ndm_written);
 
           /* Select the fields to write */
-          io_select_dm_fields(gparts_written, gpart_group_data_written,
-                              with_fof, with_stf, e, &num_fields, list);
+          io_select_dm_fields(gparts, e->s->gpart_group_data, with_fof,
+                              with_stf, e, &num_fields, list);
         }
       } break;
 
@@ -1248,33 +1451,15 @@ void write_output_distributed(struct engine* e,
         /* Ok, we need to fish out the particles we want */
         Nparticles = Ndm_background;
 
-        /* Allocate temporary array */
-        if (swift_memalign("gparts_written", (void**)&gparts_written,
-                           gpart_align,
-                           Ndm_background * sizeof(struct gpart)) != 0)
-          error("Error while allocating temporart memory for gparts");
-
-        if (with_stf) {
-          if (swift_memalign(
-                  "gpart_group_written", (void**)&gpart_group_data_written,
-                  gpart_align,
-                  Ndm_background * sizeof(struct velociraptor_gpart_data)) != 0)
-            error(
-                "Error while allocating temporart memory for gparts STF "
-                "data");
-        }
-
-        /* Collect the non-inhibited DM particles from gpart */
-        io_collect_gparts_background_to_write(
-            gparts, e->s->gpart_group_data, gparts_written,
-            gpart_group_data_written,
-            subsample[swift_type_dark_matter_background],
+        /* Select the non-inhibited DM particles from gpart */
+        index_written = io_select_gparts_background_to_write(
+            e, gparts, subsample[swift_type_dark_matter_background],
             subsample_fraction[swift_type_dark_matter_background],
-            e->snapshot_output_count, Ntot, Ndm_background, with_stf);
+            e->snapshot_output_count, Ntot, Ndm_background);
 
         /* Select the fields to write */
-        io_select_dm_fields(gparts_written, gpart_group_data_written, with_fof,
-                            with_stf, e, &num_fields, list);
+        io_select_dm_fields(gparts, e->s->gpart_group_data, with_fof, with_stf,
+                            e, &num_fields, list);
       } break;
 
       case swift_type_neutrino: {
@@ -1282,32 +1467,15 @@ void write_output_distributed(struct engine* e,
         /* Ok, we need to fish out the particles we want */
         Nparticles = Ndm_neutrino;
 
-        /* Allocate temporary array */
-        if (swift_memalign("gparts_written", (void**)&gparts_written,
-                           gpart_align,
-                           Ndm_neutrino * sizeof(struct gpart)) != 0)
-          error("Error while allocating temporart memory for gparts");
-
-        if (with_stf) {
-          if (swift_memalign(
-                  "gpart_group_written", (void**)&gpart_group_data_written,
-                  gpart_align,
-                  Ndm_neutrino * sizeof(struct velociraptor_gpart_data)) != 0)
-            error(
-                "Error while allocating temporart memory for gparts STF "
-                "data");
-        }
-
-        /* Collect the non-inhibited DM particles from gpart */
-        io_collect_gparts_neutrino_to_write(
-            gparts, e->s->gpart_group_data, gparts_written,
-            gpart_group_data_written, subsample[swift_type_neutrino],
+        /* Select the non-inhibited DM particles from gpart */
+        index_written = io_select_gparts_neutrino_to_write(
+            e, gparts, subsample[swift_type_neutrino],
             subsample_fraction[swift_type_neutrino], e->snapshot_output_count,
-            Ntot, Ndm_neutrino, with_stf);
+            Ntot, Ndm_neutrino);
 
         /* Select the fields to write */
-        io_select_neutrino_fields(gparts_written, gpart_group_data_written,
-                                  with_fof, with_stf, e, &num_fields, list);
+        io_select_neutrino_fields(gparts, e->s->gpart_group_data, with_fof,
+                                  with_stf, e, &num_fields, list);
       } break;
 
       case swift_type_sink: {
@@ -1325,21 +1493,16 @@ void write_output_distributed(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           Nparticles = Nsinks_written;
 
-          /* Allocate temporary arrays */
-          if (swift_memalign("sinks_written", (void**)&sinks_written,
-                             sink_align,
-                             Nsinks_written * sizeof(struct sink)) != 0)
-            error("Error while allocating temporary memory for sinks");
-
-          /* Collect the particles we want to write */
-          io_collect_sinks_to_write(
-              sinks, sinks_written, subsample[swift_type_sink],
-              subsample_fraction[swift_type_sink], e->snapshot_output_count,
-              Nsinks, Nsinks_written);
+          /* Select the particles we want to write */
+          index_written =
+              io_select_sinks_to_write(e, sinks, subsample[swift_type_sink],
+                                       subsample_fraction[swift_type_sink],
+                                       e->snapshot_output_count, Nsinks,
+                                       Nsinks_written);
 
           /* Select the fields to write */
-          io_select_sink_fields(sinks_written, with_cosmology, with_fof,
-                                with_stf, e, &num_fields, list);
+          io_select_sink_fields(sinks, with_cosmology, with_fof, with_stf, e,
+                                &num_fields, list);
         }
       } break;
 
@@ -1358,21 +1521,16 @@ void write_output_distributed(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           Nparticles = Nstars_written;
 
-          /* Allocate temporary arrays */
-          if (swift_memalign("sparts_written", (void**)&sparts_written,
-                             spart_align,
-                             Nstars_written * sizeof(struct spart)) != 0)
-            error("Error while allocating temporary memory for sparts");
-
-          /* Collect the particles we want to write */
-          io_collect_sparts_to_write(
-              sparts, sparts_written, subsample[swift_type_stars],
-              subsample_fraction[swift_type_stars], e->snapshot_output_count,
-              Nstars, Nstars_written);
+          /* Select the particles we want to write */
+          index_written =
+              io_select_sparts_to_write(e, sparts, subsample[swift_type_stars],
+                                        subsample_fraction[swift_type_stars],
+                                        e->snapshot_output_count, Nstars,
+                                        Nstars_written);
 
           /* Select the fields to write */
-          io_select_star_fields(sparts_written, with_cosmology, with_fof,
-                                with_stf, with_rt, e, &num_fields, list);
+          io_select_star_fields(sparts, with_cosmology, with_fof, with_stf,
+                                with_rt, e, &num_fields, list);
         }
       } break;
 
@@ -1391,21 +1549,15 @@ void write_output_distributed(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           Nparticles = Nblackholes_written;
 
-          /* Allocate temporary arrays */
-          if (swift_memalign("bparts_written", (void**)&bparts_written,
-                             bpart_align,
-                             Nblackholes_written * sizeof(struct bpart)) != 0)
-            error("Error while allocating temporary memory for bparts");
-
-          /* Collect the particles we want to write */
-          io_collect_bparts_to_write(
-              bparts, bparts_written, subsample[swift_type_black_hole],
+          /* Select the particles we want to write */
+          index_written = io_select_bparts_to_write(
+              e, bparts, subsample[swift_type_black_hole],
               subsample_fraction[swift_type_black_hole],
               e->snapshot_output_count, Nblackholes, Nblackholes_written);
 
           /* Select the fields to write */
-          io_select_bh_fields(bparts_written, with_cosmology, with_fof,
-                              with_stf, e, &num_fields, list);
+          io_select_bh_fields(bparts, with_cosmology, with_fof, with_stf, e,
+                              &num_fields, list);
         }
       } break;
 
@@ -1413,6 +1565,9 @@ void write_output_distributed(struct engine* e,
         error("Particle Type %d not yet supported. Aborting", ptype);
     }
 
+    /* Read the selected particles through their indices */
+    io_set_write_index(list, num_fields, index_written);
+
     /* Did the user specify a non-standard default for the entire particle
      * type? */
     const enum lossy_compression_schemes compression_level_current_default =
@@ -1420,7 +1575,9 @@ void write_output_distributed(struct engine* e,
             output_options->select_output, current_selection_name,
             (enum part_type)ptype, e->verbose);
 
-    /* Write everything that is not cancelled */
+    /* Select everything that is not cancelled */
+    struct io_props list_written[100];
+    enum lossy_compression_schemes compression_written[100];
     int num_fields_written = 0;
     for (int i = 0; i < num_fields; ++i) {
 
@@ -1432,41 +1589,60 @@ void write_output_distributed(struct engine* e,
               e->verbose);
 
       if (compression_level != compression_do_not_write) {
-        write_distributed_array(e, h_grp, fileName, partTypeGroupName, list[i],
-                                Nparticles, compression_level, internal_units,
-                                snapshot_units);
+        list_written[num_fields_written] = list[i];
+        compression_written[num_fields_written] = compression_level;
         num_fields_written++;
       }
     }
 
+    /* Copy groups of fields in one pass over the particles and write them */
+    for (int first = 0; first < num_fields_written;) {
+
+      void* temps[100];
+      const int group_size = io_copy_next_field_group(
+          temps, e, list_written, first, num_fields_written, Nparticles,
+          internal_units, snapshot_units);
+
+      for (int k = 0; k < group_size; ++k) {
+
+        /* The writing rank collects the data of the others piece by piece
+         * as it writes them */
+        if (is_writer)
+          write_distributed_array(
+              e, h_grp, fileName, partTypeGroupName, list_written[first + k],
+              temps[k], N_file[ptype], N_ranks_file, ptype, file_comm,
+              compression_written[first + k], snapshot_units);
+        else
+          distributed_io_send_field(list_written[first + k], temps[k],
+                                    Nparticles, file_comm);
+
+        swift_free("writebuff", temps[k]);
+      }
+      first += group_size;
+    }
+
     /* Only write this now that we know exactly how many fields there are. */
-    io_write_attribute_i(h_grp, "NumberOfFields", num_fields_written);
+    if (is_writer)
+      io_write_attribute_i(h_grp, "NumberOfFields", num_fields_written);
 
     /* Free temporary arrays */
-    if (parts_written) swift_free("parts_written", parts_written);
-    if (xparts_written) swift_free("xparts_written", xparts_written);
-    if (gparts_written) swift_free("gparts_written", gparts_written);
-    if (gpart_group_data_written)
-      swift_free("gpart_group_written", gpart_group_data_written);
-    if (sinks_written) swift_free("sinks_written", sinks_written);
-    if (sparts_written) swift_free("sparts_written", sparts_written);
-    if (bparts_written) swift_free("bparts_written", bparts_written);
+    if (index_written) swift_free("index_written", index_written);
 
     /* Close particle group */
-    H5Gclose(h_grp);
+    if (is_writer) H5Gclose(h_grp);
   }
 
   /* message("Done writing particles..."); */
 
   /* Close file */
-  H5Fclose(h_file);
+  if (is_writer) H5Fclose(h_file);
 
 #if H5_VERSION_GE(1, 10, 0)
 
   /* Write the virtual meta-file */
   if (mpi_rank == 0)
     write_virtual_file(e, fileName_base, xmfFileName, N_total, N_counts,
-                       mpi_size, to_write, numFields, current_selection_name,
+                       num_files, to_write, numFields, current_selection_name,
                        internal_units, snapshot_units, subsample_any,
                        subsample_fraction);
 
@@ -1495,17 +1671,27 @@ void write_output_distributed(struct engine* e,
   }
 
   /* We need to recompute the offsets since they are now with respect
-   * to a single file. */
-  for (int i = 0; i < swift_type_count; ++i) global_offsets[i] = 0;
-  MPI_Exscan(N, global_offsets, swift_type_count, MPI_LONG_LONG_INT, MPI_SUM,
-             comm);
+   * to a single file. The files are stacked in the order of their writing
+   * ranks, to which we add the offset of this rank in its file. */
+  long long global_offsets[swift_type_count] = {0};
+  long long file_contribution[swift_type_count] = {0};
+  if (is_writer)
+    for (int i = 0; i < swift_type_count; ++i) file_contribution[i] = N_file[i];
+  MPI_Exscan(file_contribution, global_offsets, swift_type_count,
+             MPI_LONG_LONG_INT, MPI_SUM, comm);
+  if (mpi_rank == 0)
+    for (int i = 0; i < swift_type_count; ++i) global_offsets[i] = 0;
+  MPI_Bcast(global_offsets, swift_type_count, MPI_LONG_LONG_INT, 0, file_comm);
+  for (int i = 0; i < swift_type_count; ++i)
+    global_offsets[i] += file_offsets[i];
 
   /* Write the location of the particles in the arrays */
   io_write_cell_offsets(h_grp_cells, e->s->cdim, e->s->dim, e->s->cells_top,
                         e->s->nr_cells, e->s->width, mpi_rank,
-                        /*distributed=*/0, subsample, subsample_fraction,
-                        e->snapshot_output_count, N_total, global_offsets,
-                        to_write, numFields, internal_units, snapshot_units);
+                        /*distributed=*/0, /*node_files=*/NULL, subsample,
+                        subsample_fraction, e->snapshot_output_count, N_total,
+                        global_offsets, to_write, numFields, internal_units,
+                        snapshot_units);
 
   /* Close everything */
   if (mpi_rank == 0) {
@@ -1515,8 +1701,11 @@ void write_output_distributed(struct engine* e,
 
 #endif
 
-  /* Free the counts-per-rank array */
+  /* Free the counts-per-file arrays */
   free(N_counts);
+  free(N_ranks_file);
+  free(node_files);
+  MPI_Comm_free(&file_comm);
 
   /* Make sure nobody is allowed to progress until everyone is done. */
   MPI_Barrier(comm);
@@ -73,6 +73,7 @@
 #include "gravity.h"
 #include "gravity_cache.h"
 #include "hydro.h"
+#include "image_maps.h"
 #include "lightcone/lightcone.h"
 #include "lightcone/lightcone_array.h"
 #include "line_of_sight.h"
@@ -95,6 +96,7 @@
 #include "rt_properties.h"
 #include "runner.h"
 #include "sink_properties.h"
+#include "snapshot_delta.h"
 #include "sort_part.h"
 #include "star_formation.h"
 #include "star_formation_logger.h"
@@ -133,7 +135,8 @@ const char *engine_policy_names[] = {"none",
                                      "line of sight",
                                      "sink",
                                      "rt",
-                                     "power spectra"};
+                                     "power spectra",
+                                     "image maps"};
 
 const int engine_default_snapshot_subsample[swift_type_count] = {0};
 
@@ -528,16 +531,71 @@ void engine_exchange_top_multipoles(struct engine *e) {
   /* Each node (space) has constructed its own top-level multipoles.
    * We now need to make sure every other node has a copy of everything.
    *
-   * We use our home-made reduction operation that simply performs a XOR
-   * operation on the multipoles. Since only local multipoles are non-zero and
-   * each multipole is only present once, the bit-by-bit XOR will
-   * create the desired result.
+   * Only the occupied cells carry any information. Rather than reducing the
+   * whole top-level grid, which is mostly empty when a few particles force
+   * a large box, every node gathers the multipoles of the occupied cells of
+   * all the others along with their indices in the grid. The foreign
+   * multipoles are zero on entry so this is equivalent to a reduction.
+   * Only the exchange is sparse: the grid itself stays dense (see
+   * space.cells_top).
    */
-  int err = MPI_Allreduce(MPI_IN_PLACE, e->s->multipoles_top, e->s->nr_cells,
-                          multipole_mpi_type, multipole_mpi_reduce_op,
+  struct space *s = e->s;
+  const int nr_nodes = e->nr_nodes;
+  const int nr_local = s->nr_local_cells_with_particles;
+
+  int *counts = (int *)malloc(nr_nodes * sizeof(int));
+  int *offsets = (int *)malloc(nr_nodes * sizeof(int));
+  if (counts == NULL || offsets == NULL)
+    error("Failed to allocate multipole exchange counts.");
+
+  int err = MPI_Allgather(&nr_local, 1, MPI_INT, counts, 1, MPI_INT,
                           MPI_COMM_WORLD);
   if (err != MPI_SUCCESS)
-    mpi_error(err, "Failed to all-reduce the top-level multipoles.");
+    mpi_error(err, "Failed to gather the number of occupied top cells.");
+
+  int nr_total = 0;
+  for (int k = 0; k < nr_nodes; ++k) {
+    offsets[k] = nr_total;
+    nr_total += counts[k];
+  }
+
+  int *cids = (int *)swift_malloc("top_multipole_cids",
+                                  max(nr_total, 1) * sizeof(int));
+  struct gravity_tensors *mpoles = NULL;
+  if (cids == NULL ||
+      swift_memalign("top_multipoles", (void **)&mpoles, multipole_align,
+                     max(nr_total, 1) * sizeof(struct gravity_tensors)) != 0)
+    error("Failed to allocate top-level multipole exchange buffers.");
+
+  /* Pack our own contribution in place */
+  const int my_offset = offsets[e->nodeID];
+  for (int k = 0; k < nr_local; ++k) {
+    const int cid = s->local_cells_with_particles_top[k];
+    cids[my_offset + k] = cid;
+    memcpy(&mpoles[my_offset + k], &s->multipoles_top[cid],
+           sizeof(struct gravity_tensors));
+  }
+
+  err = MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, cids, counts,
+                       offsets, MPI_INT, MPI_COMM_WORLD);
+  if (err != MPI_SUCCESS)
+    mpi_error(err, "Failed to gather the indices of the top-level cells.");
+  err = MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, mpoles, counts,
+                       offsets, multipole_mpi_type, MPI_COMM_WORLD);
+  if (err != MPI_SUCCESS)
+    mpi_error(err, "Failed to gather the top-level multipoles.");
+
+  /* Unpack everything that is not ours */
+  for (int k = 0; k < nr_total; ++k) {
+    if (k >= my_offset && k < my_offset + nr_local) continue;
+    memcpy(&s->multipoles_top[cids[k]], &mpoles[k],
+           sizeof(struct gravity_tensors));
+  }
+
+  swift_free("top_multipole_cids", cids);
+  swift_free("top_multipoles", mpoles);
+  free(counts);
+  free(offsets);
 
 #ifdef SWIFT_DEBUG_CHECKS
   long long counter = 0;
@@ -603,17 +661,17 @@ void engine_exchange_proxy_multipoles(struct engine *e) {
       count_send_cells += p->cells_out[k]->mpi.pcell_size;
   }
 
-  /* Allocate the buffers for the packed data */
-  struct gravity_tensors *buffer_send = NULL;
-  if (swift_memalign("send_gravity_tensors", (void **)&buffer_send,
-                     SWIFT_CACHE_ALIGNMENT,
-                     count_send_cells * sizeof(struct gravity_tensors)) != 0)
+  /* Allocate the buffers for the packed data (field tensors are not sent) */
+  struct gravity_tensors_foreign *buffer_send = NULL;
+  if (swift_memalign(
+          "send_gravity_tensors", (void **)&buffer_send, SWIFT_CACHE_ALIGNMENT,
+          count_send_cells * sizeof(struct gravity_tensors_foreign)) != 0)
     error("Unable to allocate memory for multipole transactions");
 
-  struct gravity_tensors *buffer_recv = NULL;
-  if (swift_memalign("recv_gravity_tensors", (void **)&buffer_recv,
-                     SWIFT_CACHE_ALIGNMENT,
-                     count_recv_cells * sizeof(struct gravity_tensors)) != 0)
+  struct gravity_tensors_foreign *buffer_recv = NULL;
+  if (swift_memalign(
+          "recv_gravity_tensors", (void **)&buffer_recv, SWIFT_CACHE_ALIGNMENT,
+          count_recv_cells * sizeof(struct gravity_tensors_foreign)) != 0)
     error("Unable to allocate memory for multipole transactions");
 
   /* Also allocate the MPI requests */
@@ -637,8 +695,9 @@ void engine_exchange_proxy_multipoles(struct engine *e) {
       const int num_elements = p->cells_in[k]->mpi.pcell_size;
 
       /* Receive everything */
-      MPI_Irecv(&buffer_recv[this_recv], num_elements, multipole_mpi_type,
-                p->cells_in[k]->nodeID, p->cells_in[k]->mpi.tag, MPI_COMM_WORLD,
+      MPI_Irecv(&buffer_recv[this_recv], num_elements,
+                multipole_foreign_mpi_type, p->cells_in[k]->nodeID,
+                p->cells_in[k]->mpi.tag, MPI_COMM_WORLD,
                 &requests[this_request]);
 
       /* Move to the next slot in the buffers */
@@ -657,9 +716,10 @@ void engine_exchange_proxy_multipoles(struct engine *e) {
 
       /* Send everything (note the use of cells_in[0] to get the correct node
        * ID. */
-      MPI_Isend(&buffer_send[this_send], num_elements, multipole_mpi_type,
-                p->cells_in[0]->nodeID, p->cells_out[k]->mpi.tag,
-                MPI_COMM_WORLD, &requests[this_request]);
+      MPI_Isend(&buffer_send[this_send], num_elements,
+                multipole_foreign_mpi_type, p->cells_in[0]->nodeID,
+                p->cells_out[k]->mpi.tag, MPI_COMM_WORLD,
+                &requests[this_request]);
 
       /* Move to the next slot in the buffers */
       this_send += num_elements;
@@ -1349,6 +1409,10 @@ void engine_rebuild(struct engine *e, const int repartitioned,
   /* Make the list of top-level cells that have tasks */
   space_list_useful_top_level_cells(e->s);
 
+  /* Cache the partners of the long-range gravity tasks */
+  if (e->policy & engine_policy_self_gravity)
+    engine_make_grav_long_range_lists(e);
+
 #ifdef SWIFT_DEBUG_CHECKS
   /* Check that all cells have been drifted to the current time.
    * That can include cells that have not
@@ -1401,7 +1465,6 @@ int engine_prepare(struct engine *e) {
   TIMER_TIC2;
   const ticks tic = getticks();
 
-  int drifted_all = 0;
   int repartitioned = 0;
 
   /* Unskip active tasks and check for rebuild */
@@ -1423,9 +1486,9 @@ int engine_prepare(struct engine *e) {
   if (e->policy & engine_policy_fof && e->forcerebuild && !e->forcerepart &&
       e->run_fof && e->fof_properties->seed_black_holes_enabled) {
 
-    /* Let's start by drifting everybody to the current time */
-    engine_drift_all(e, /*drift_mpole=*/0);
-    drifted_all = 1;
+    /* The FoF links the gparts and turns gas into black holes */
+    engine_drift_species(
+        e, engine_drift_gpart | engine_drift_part | engine_drift_bpart);
 
     engine_fof(e, e->dump_catalogue_when_seeding, /*dump_debug=*/0,
                /*seed_black_holes=*/1, /*foreign buffers allocated=*/1);
@@ -1437,9 +1500,8 @@ int engine_prepare(struct engine *e) {
      repartitioning. */
   if (!e->restarting && e->forcerebuild && !e->forcerepart && e->step > 1) {
 
-    /* Let's start by drifting everybody to the current time */
-    if (!drifted_all) engine_drift_all(e, /*drift_mpole=*/0);
-    drifted_all = 1;
+    /* The splitting only touches the gas and its gravity friends */
+    engine_drift_species(e, engine_drift_gpart | engine_drift_part);
 
     engine_split_gas_particles(e);
   }
@@ -1448,8 +1510,7 @@ int engine_prepare(struct engine *e) {
   if (e->forcerepart) {
 
     /* Let's start by drifting everybody to the current time */
-    engine_drift_all(e, /*drift_mpole=*/0);
-    drifted_all = 1;
+    engine_drift_species(e, engine_drift_all_species);
 
     /* Free the PM grid */
     if ((e->policy & engine_policy_self_gravity) && e->s->periodic)
@@ -1468,9 +1529,7 @@ int engine_prepare(struct engine *e) {
   if (e->forcerebuild) {
 
     /* Let's start by drifting everybody to the current time */
-    if (!e->restarting && !drifted_all) engine_drift_all(e, /*drift_mpole=*/0);
-
-    drifted_all = 1;
+    if (!e->restarting) engine_drift_species(e, engine_drift_all_species);
 
     /* And rebuild */
     engine_rebuild(e, repartitioned, 0);
@@ -1499,7 +1558,7 @@ int engine_prepare(struct engine *e) {
     message("took %.3f %s (including unskip, rebuild and reweight).",
             clocks_from_ticks(getticks() - tic), clocks_getunit());
 
-  return drifted_all;
+  return engine_all_drifted(e);
 }
 
 /**
@@ -1924,8 +1983,10 @@ void engine_init_particles(struct engine *e, int flag_entropy_ICs,
   /* Compute the mesh forces for the first time */
   if ((e->policy & engine_policy_self_gravity) && e->s->periodic) {
 
-    /* Compute mesh forces */
-    pm_mesh_compute_potential(e->mesh, e->s, &e->threadpool, e->verbose);
+    /* Compute mesh forces (the gravity tasks are skipped in this first
+     * step so the particles must be updated right away) */
+    pm_mesh_compute_potential(e->mesh, e->s, &e->threadpool,
+                              /*interpolate_in_tasks=*/0, e->verbose);
 
     /* Compute mesh time-step length */
     engine_recompute_displacement_constraint(e);
@@ -2482,7 +2543,7 @@ int engine_step(struct engine *e) {
 #endif
 
   /* Prepare the tasks to be launched, rebuild or repartition if needed. */
-  const int drifted_all = engine_prepare(e);
+  engine_prepare(e);
 
   /* Dump local cells and active particle counts. */
   // dumpCells("cells", 1, 0, 0, 0, e->s, e->nodeID, e->step);
@@ -2543,11 +2604,13 @@ int engine_step(struct engine *e) {
   if ((e->policy & engine_policy_self_gravity) && e->s->periodic &&
       e->mesh->ti_end_mesh_next == e->ti_current) {
 
-    /* We might need to drift things */
-    if (!drifted_all) engine_drift_all(e, /*drift_mpole=*/0);
+    /* The mesh only needs the gparts */
+    engine_drift_species(e, engine_drift_gpart);
 
-    /* ... and recompute */
-    pm_mesh_compute_potential(e->mesh, e->s, &e->threadpool, e->verbose);
+    /* ... and recompute. The forces are interpolated onto the particles by
+     * the long-range gravity tasks */
+    pm_mesh_compute_potential(e->mesh, e->s, &e->threadpool,
+                              /*interpolate_in_tasks=*/1, e->verbose);
 
     /* Check whether we need to update the mesh time-step length */
     engine_recompute_displacement_constraint(e);
@@ -2584,6 +2647,9 @@ int engine_step(struct engine *e) {
   engine_launch(e, "tasks");
   TIMER_TOC(timer_runners);
 
+  /* All the particles have now received their mesh forces */
+  e->mesh->interpolation_pending = 0;
+
   /* Now record the CPU times used by the tasks. */
 #ifdef WITH_MPI
   double end_usertime = 0.0;
@@ -3089,6 +3155,8 @@ void engine_init(
   e->ti_old = 0;
   e->ti_current = 0;
   e->ti_earliest_undrifted = 0;
+  e->drifted_species = 0;
+  e->ti_drifted_species = -1;
   e->time_step = 0.;
   e->time_base = 0.;
   e->time_base_inv = 0.;
@@ -3138,6 +3206,10 @@ void engine_init(
       parser_get_opt_param_int(params, "Snapshots:compression", 0);
   e->snapshot_distributed =
       parser_get_opt_param_int(params, "Snapshots:distributed", 0);
+  e->snapshot_distributed_nodes_per_file = parser_get_opt_param_int(
+      params, "Snapshots:distributed_nodes_per_file", 0);
+  if (e->snapshot_distributed_nodes_per_file < 0)
+    error("Snapshots:distributed_nodes_per_file must be >= 0.");
   e->snapshot_lustre_OST_count =
       parser_get_opt_param_int(params, "Snapshots:lustre_OST_count", 0);
   e->snapshot_invoke_stf =
@@ -3152,6 +3224,21 @@ void engine_init(
     e->snapshot_delta_from_edge =
         parser_get_param_double(params, "Snapshots:delta_from_edge");
   }
+  e->snapshot_delta_frames =
+      parser_get_opt_param_int(params, "Snapshots:delta_frames", 0);
+  if (e->snapshot_delta_frames > 0) {
+#ifdef WITH_MPI
+    error("Delta-encoded snapshots are not supported in MPI runs.");
+#endif
+    e->snapshot_delta_position_quantum =
+        parser_get_param_double(params, "Snapshots:delta_position_quantum");
+    e->snapshot_delta_velocity_quantum =
+        parser_get_param_double(params, "Snapshots:delta_velocity_quantum");
+    if (e->snapshot_delta_position_quantum <= 0. ||
+        e->snapshot_delta_velocity_quantum <= 0.)
+      error("The quanta of the delta-encoded snapshots must be positive.");
+  }
+  e->snapshot_delta = NULL;
   e->dump_catalogue_when_seeding =
       parser_get_opt_param_int(params, "FOF:dump_catalogue_when_seeding", 0);
   e->snapshot_units = (struct unit_system *)malloc(sizeof(struct unit_system));
@@ -3164,6 +3251,7 @@ void engine_init(
   e->stf_output_count = 0;
   e->los_output_count = 0;
   e->ps_output_count = 0;
+  e->image_maps_output_count = 0;
   e->dt_min = parser_get_param_double(params, "TimeIntegration:dt_min");
   e->dt_max = parser_get_param_double(params, "TimeIntegration:dt_max");
   e->max_nr_rt_subcycles = parser_get_opt_param_int(
@@ -3301,6 +3389,25 @@ void engine_init(
         parser_get_opt_param_double(params, "PowerSpectrum:delta_time", -1.);
   }
 
+  /* Initialise the image maps output. */
+  e->image_maps = NULL;
+  e->output_list_image_maps = NULL;
+  e->ti_next_image_maps = 0;
+  if (e->policy & engine_policy_image_maps) {
+    e->time_first_image_maps =
+        parser_get_opt_param_double(params, "ImageMaps:time_first", 0.);
+    e->a_first_image_maps = parser_get_opt_param_double(
+        params, "ImageMaps:scale_factor_first", 0.1);
+    e->delta_time_image_maps =
+        parser_get_opt_param_double(params, "ImageMaps:delta_time", -1.);
+
+    e->image_maps =
+        (struct image_maps_props *)malloc(sizeof(struct image_maps_props));
+    if (e->image_maps == NULL)
+      error("Failed to allocate memory for the image maps properties.");
+    image_maps_init(e->image_maps, e, params);
+  }
+
   /* Initialise FoF calls frequency. */
   if (e->policy & engine_policy_fof) {
 
@@ -3591,10 +3698,17 @@ void engine_clean(struct engine *e, const int fof, const int restart) {
   output_list_clean(&e->output_list_stf);
   output_list_clean(&e->output_list_los);
   output_list_clean(&e->output_list_ps);
+  output_list_clean(&e->output_list_image_maps);
 
   output_options_clean(e->output_options);
 
   ic_info_clean(e->ics_metadata);
+  snapshot_delta_clean(e->snapshot_delta);
+
+  if (e->image_maps) {
+    image_maps_clean(e->image_maps);
+    free(e->image_maps);
+  }
 
   swift_free("links", e->links);
 #if defined(WITH_CSDS)
@@ -3671,6 +3785,7 @@ void engine_clean(struct engine *e, const int fof, const int restart) {
     if (e->output_list_stf) free((void *)e->output_list_stf);
     if (e->output_list_los) free((void *)e->output_list_los);
     if (e->output_list_ps) free((void *)e->output_list_ps);
+    if (e->output_list_image_maps) free((void *)e->output_list_image_maps);
 #ifdef WITH_CSDS
     if (e->policy & engine_policy_csds) free((void *)e->csds);
 #endif
@@ -3727,6 +3842,8 @@ void engine_struct_dump(struct engine *e, FILE *stream) {
   fof_struct_dump(e->fof_properties, stream);
 #endif
   los_struct_dump(e->los_properties, stream);
+  if (e->policy & engine_policy_image_maps)
+    image_maps_struct_dump(e->image_maps, stream);
   lightcone_array_struct_dump(e->lightcone_array_properties, stream);
   ic_info_struct_dump(e->ics_metadata, stream);
   parser_struct_dump(e->parameter_file, stream);
@@ -3758,6 +3875,12 @@ void engine_struct_restore(struct engine *e, FILE *stream) {
   e->sched.tid_active = NULL;
   e->sched.size = 0;
 
+  /* The state of the last delta frame is not saved: start with a keyframe */
+  e->snapshot_delta = NULL;
+
+  /* The image maps output list is re-read from the parameter file */
+  e->output_list_image_maps = NULL;
+
   /* Now for the other pointers, these use their own restore functions. */
   /* Note all this memory leaks, but is used once. */
   struct space *s = (struct space *)malloc(sizeof(struct space));
@@ -3898,6 +4021,15 @@ void engine_struct_restore(struct engine *e, FILE *stream) {
   los_struct_restore(los_properties, stream);
   e->los_properties = los_properties;
 
+  if (e->policy & engine_policy_image_maps) {
+    struct image_maps_props *image_maps =
+        (struct image_maps_props *)malloc(sizeof(struct image_maps_props));
+    image_maps_struct_restore(image_maps, stream);
+    e->image_maps = image_maps;
+  } else {
+    e->image_maps = NULL;
+  }
+
   struct lightcone_array_props *lightcone_array_properties =
       (struct lightcone_array_props *)malloc(
           sizeof(struct lightcone_array_props));
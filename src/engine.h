@@ -54,6 +54,7 @@
 struct black_holes_properties;
 struct extra_io_properties;
 struct external_potential;
+struct image_maps_props;
 
 /**
  * @brief The different policies the #engine can follow.
@@ -88,8 +89,9 @@ enum engine_policy {
   engine_policy_sinks = (1 << 25),
   engine_policy_rt = (1 << 26),
   engine_policy_power_spectra = (1 << 27),
+  engine_policy_image_maps = (1 << 28),
 };
-#define engine_maxpolicy 28
+#define engine_maxpolicy 29
 extern const char *engine_policy_names[engine_maxpolicy + 1];
 
 /**
@@ -110,6 +112,23 @@ enum engine_step_properties {
   engine_step_prop_done = (1 << 10),
 };
 
+/**
+ * @brief The particle species that can be drifted on demand.
+ */
+enum engine_drift_species {
+  engine_drift_part = (1 << 0),
+  engine_drift_gpart = (1 << 1),
+  engine_drift_spart = (1 << 2),
+  engine_drift_sink = (1 << 3),
+  engine_drift_bpart = (1 << 4),
+  engine_drift_all_species = (1 << 5) - 1,
+};
+
+/**
+ * @brief Function applied to a top-level #cell just after it was drifted.
+ */
+typedef void (*engine_drift_cell_function)(struct cell *c, void *data);
+
 /* Some constants */
 #define engine_maxproxies 64
 #define engine_tasksreweight 1
@@ -191,6 +210,11 @@ struct engine {
   /* The earliest time any particle may still need to be drifted from */
   integertime_t ti_earliest_undrifted;
 
+  /* The species (#engine_drift_species) entirely drifted to the time
+   * ti_drifted_species */
+  int drifted_species;
+  integertime_t ti_drifted_species;
+
   /* The highest active bin at this time */
   timebin_t max_active_bin;
 
@@ -346,6 +370,7 @@ struct engine {
   float snapshot_subsample_fraction[swift_type_count];
   int snapshot_run_on_dump;
   int snapshot_distributed;
+  int snapshot_distributed_nodes_per_file;
   int snapshot_lustre_OST_count;
   int snapshot_compression;
   int snapshot_invoke_stf;
@@ -356,6 +381,13 @@ struct engine {
   double snapshot_delta_from_edge;
   int snapshot_output_count;
 
+  /* Delta-encoded snapshots: number of delta frames between keyframes, the
+   * quanta of the residuals and the state of the last frame */
+  int snapshot_delta_frames;
+  double snapshot_delta_position_quantum;
+  double snapshot_delta_velocity_quantum;
+  struct snapshot_delta *snapshot_delta;
+
   /* Snapshot recording trigger mechanism counters */
   double snapshot_recording_triggers_part[num_snapshot_triggers_part];
   double snapshot_recording_triggers_desired_part[num_snapshot_triggers_part];
@@ -617,6 +649,15 @@ struct engine {
   /* Time after which next dump will occur. */
   ticks restart_next;
 
+  /* Do we adapt the interval between dumps to their measured cost? */
+  int restart_adaptive;
+
+  /* Mean time between failures of the system (in seconds). */
+  double restart_mtbf;
+
+  /* Measured cost of writing a set of restart files (in seconds). */
+  double restart_cost;
+
   /* Maximum number of tasks needed for restarting. */
   int restart_max_tasks;
 
@@ -653,6 +694,17 @@ struct engine {
   integertime_t ti_next_los;
   int los_output_count;
 
+  /* Image maps properties. */
+  struct image_maps_props *image_maps;
+
+  /* Image maps outputs information. */
+  struct output_list *output_list_image_maps;
+  double a_first_image_maps;
+  double time_first_image_maps;
+  double delta_time_image_maps;
+  integertime_t ti_next_image_maps;
+  int image_maps_output_count;
+
   /* Lightcone information */
   int flush_lightcone_maps;
 
@@ -679,11 +731,17 @@ void engine_compute_next_stf_time(struct engine *e);
 void engine_compute_next_fof_time(struct engine *e);
 void engine_compute_next_statistics_time(struct engine *e);
 void engine_compute_next_los_time(struct engine *e);
+void engine_compute_next_image_maps_time(struct engine *e);
 void engine_compute_next_ps_time(struct engine *e);
 void engine_recompute_displacement_constraint(struct engine *e);
 void engine_unskip(struct engine *e);
 void engine_unskip_rt_sub_cycle(struct engine *e);
 void engine_drift_all(struct engine *e, const int drift_mpoles);
+void engine_drift_species(struct engine *e, const int species);
+void engine_drift_cells(struct engine *e, const int *cell_ids,
+                        const int num_cells, const int species,
+                        engine_drift_cell_function fn, void *data);
+int engine_all_drifted(const struct engine *e);
 void engine_drift_top_multipoles(struct engine *e);
 void engine_reconstruct_multipoles(struct engine *e);
 void engine_allocate_foreign_particles(struct engine *e, const int fof);
@@ -758,6 +816,7 @@ void engine_activate_gpart_comms(struct engine *e);
 
 /* Function prototypes, engine_maketasks.c. */
 void engine_maketasks(struct engine *e);
+void engine_make_grav_long_range_lists(struct engine *e);
 
 /* Function prototypes, engine_maketasks.c. */
 void engine_make_fof_tasks(struct engine *e);
@@ -777,5 +836,6 @@ void engine_numa_policies(int rank, int verbose);
 void engine_struct_dump(struct engine *e, FILE *stream);
 void engine_struct_restore(struct engine *e, FILE *stream);
 int engine_dump_restarts(struct engine *e, int drifted_all, int force);
+void engine_update_restart_interval(struct engine *e);
 
 #endif /* SWIFT_ENGINE_H */
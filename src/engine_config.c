@@ -39,6 +39,7 @@
 #include "fof.h"
 #include "mpiuse.h"
 #include "part.h"
+#include "power_spectrum.h"
 #include "pressure_floor.h"
 #include "proxy.h"
 #include "rt.h"
@@ -728,6 +729,11 @@ void engine_config(int restart, int fof, struct engine *e,
       engine_compute_next_los_time(e);
     }
 
+    /* Find the time of the first image maps output */
+    if (e->policy & engine_policy_image_maps) {
+      engine_compute_next_image_maps_time(e);
+    }
+
     /* Find the time of the first stf output */
     if (e->policy & engine_policy_structure_finding) {
       engine_compute_next_stf_time(e);
@@ -765,8 +771,30 @@ void engine_config(int restart, int fof, struct engine *e,
     /* Hours between restart dumps. Can be changed on restart. */
     float dhours =
         parser_get_opt_param_float(params, "Restarts:delta_hours", 5.0f);
+
+    /* Whether to adapt the interval between dumps to their cost and to the
+     * failure rate of the system. Can be changed on restart. */
+    e->restart_adaptive =
+        parser_get_opt_param_int(params, "Restarts:adaptive", 0);
+    if (e->restart_adaptive) {
+      const double mtbf_hours =
+          parser_get_param_double(params, "Restarts:mtbf_hours");
+      if (mtbf_hours <= 0.)
+        error("The mean time between failures must be positive!");
+      e->restart_mtbf = mtbf_hours * 60. * 60.;
+    }
+
+    /* The cost of the dumps is only known once we have written one (but
+     * survives a restart). */
+    if (!restart) e->restart_cost = 0.;
+
     if (e->nodeID == 0) {
-      if (e->restart_dump)
+      if (e->restart_dump && e->restart_adaptive)
+        message(
+            "Restarts will be dumped at an adaptive cadence (MTBF: %f hours, "
+            "first interval: %f hours)",
+            e->restart_mtbf / 3600., dhours);
+      else if (e->restart_dump)
         message("Restarts will be dumped every %f hours", dhours);
       else
         message("WARNING: restarts will not be dumped");
@@ -779,6 +807,10 @@ void engine_config(int restart, int fof, struct engine *e,
      * convert from ticks into milliseconds. */
     e->restart_dt = clocks_to_ticks(dhours * 60.0 * 60.0 * 1000.0);
 
+    /* Use the cost measured before the restart if we have one */
+    if (e->restart_adaptive && e->restart_cost > 0.)
+      engine_update_restart_interval(e);
+
     /* The first dump will happen no sooner than restart_dt ticks in the
      * future. */
     e->restart_next = getticks() + e->restart_dt;
@@ -954,6 +986,9 @@ void engine_config(int restart, int fof, struct engine *e,
     cache_init(&e->runners[k].ci_cache, CACHE_SIZE);
     cache_init(&e->runners[k].cj_cache, CACHE_SIZE);
 #endif
+#if defined(GIZMO_MFV_SPH) || defined(GIZMO_MFM_SPH)
+    e->runners[k].flux_batch.riemann.count = 0;
+#endif
 
     if (verbose) {
       if (with_aff)
@@ -977,6 +1012,12 @@ void engine_config(int restart, int fof, struct engine *e,
   if (e->policy & engine_policy_structure_finding) velociraptor_init(e);
 #endif
 
+  /* Re-use the FFTW plans measured by a previous run */
+  if (e->policy & engine_policy_self_gravity)
+    pm_mesh_import_fftw_wisdom(e->mesh, e->restart_dir, e->verbose);
+  if (restart && (e->policy & engine_policy_power_spectra))
+    power_import_fftw_wisdom(e->power_data, e->restart_dir, e->verbose);
+
     /* Free the affinity stuff */
 #if defined(HAVE_SETAFFINITY)
   if (with_aff) {
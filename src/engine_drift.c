@@ -313,6 +313,49 @@ void engine_do_drift_all_multipole_mapper(void *map_data, int num_elements,
   }
 }
 
+/**
+ * @brief Drift some species of all the local cells with tasks.
+ *
+ * @param e The #engine.
+ * @param species The species (#engine_drift_species) to drift.
+ * @param drift_mpoles Do we want to drift all the multipoles as well?
+ */
+static void engine_drift_local_cells(struct engine *e, const int species,
+                                     const int drift_mpoles) {
+
+  if ((species & engine_drift_part) && e->s->nr_parts > 0) {
+    threadpool_map(&e->threadpool, engine_do_drift_all_part_mapper,
+                   e->s->local_cells_top, e->s->nr_local_cells, sizeof(int),
+                   threadpool_auto_chunk_size, e);
+  }
+  if ((species & engine_drift_gpart) && e->s->nr_gparts > 0) {
+    threadpool_map(&e->threadpool, engine_do_drift_all_gpart_mapper,
+                   e->s->local_cells_top, e->s->nr_local_cells, sizeof(int),
+                   threadpool_auto_chunk_size, e);
+  }
+  if ((species & engine_drift_spart) && e->s->nr_sparts > 0) {
+    threadpool_map(&e->threadpool, engine_do_drift_all_spart_mapper,
+                   e->s->local_cells_top, e->s->nr_local_cells, sizeof(int),
+                   threadpool_auto_chunk_size, e);
+  }
+  if ((species & engine_drift_sink) && e->s->nr_sinks > 0) {
+    threadpool_map(&e->threadpool, engine_do_drift_all_sink_mapper,
+                   e->s->local_cells_top, e->s->nr_local_cells, sizeof(int),
+                   threadpool_auto_chunk_size, e);
+  }
+  if ((species & engine_drift_bpart) && e->s->nr_bparts > 0) {
+    threadpool_map(&e->threadpool, engine_do_drift_all_bpart_mapper,
+                   e->s->local_cells_top, e->s->nr_local_cells, sizeof(int),
+                   threadpool_auto_chunk_size, e);
+  }
+  if (drift_mpoles && (e->policy & engine_policy_self_gravity)) {
+    threadpool_map(&e->threadpool, engine_do_drift_all_multipole_mapper,
+                   e->s->local_cells_with_tasks_top,
+                   e->s->nr_local_cells_with_tasks, sizeof(int),
+                   threadpool_auto_chunk_size, e);
+  }
+}
+
 /**
  * @brief Drift *all* particles and multipoles at all levels
  * forward to the current time.
@@ -343,41 +386,9 @@ void engine_drift_all(struct engine *e, const int drift_mpoles) {
   if (!e->restarting) {
 
     /* Normal case: We have a list of local cells with tasks to play with */
-
-    if (e->s->nr_parts > 0) {
-      threadpool_map(&e->threadpool, engine_do_drift_all_part_mapper,
-                     e->s->local_cells_top, e->s->nr_local_cells, sizeof(int),
-                     threadpool_auto_chunk_size, e);
-    }
-    if (e->s->nr_gparts > 0) {
-      threadpool_map(&e->threadpool, engine_do_drift_all_gpart_mapper,
-                     e->s->local_cells_top, e->s->nr_local_cells, sizeof(int),
-                     threadpool_auto_chunk_size, e);
-    }
-    if (e->s->nr_sparts > 0) {
-      threadpool_map(&e->threadpool, engine_do_drift_all_spart_mapper,
-                     e->s->local_cells_top, e->s->nr_local_cells, sizeof(int),
-                     threadpool_auto_chunk_size, e);
-    }
-    if (e->s->nr_sinks > 0) {
-      threadpool_map(&e->threadpool, engine_do_drift_all_sink_mapper,
-                     e->s->local_cells_top, e->s->nr_local_cells, sizeof(int),
-                     threadpool_auto_chunk_size, e);
-    }
-    if (e->s->nr_bparts > 0) {
-      threadpool_map(&e->threadpool, engine_do_drift_all_bpart_mapper,
-                     e->s->local_cells_top, e->s->nr_local_cells, sizeof(int),
-                     threadpool_auto_chunk_size, e);
-    }
-    if (drift_mpoles && (e->policy & engine_policy_self_gravity)) {
-      threadpool_map(&e->threadpool, engine_do_drift_all_multipole_mapper,
-                     e->s->local_cells_with_tasks_top,
-                     e->s->nr_local_cells_with_tasks, sizeof(int),
-                     threadpool_auto_chunk_size, e);
-    }
+    engine_drift_local_cells(e, engine_drift_all_species, drift_mpoles);
 
   } else {
-
     /* When restarting, the list of local cells with tasks does not yet
        exist. We use the raw list of top-level cells instead */
 
@@ -429,6 +440,8 @@ void engine_drift_all(struct engine *e, const int drift_mpoles) {
 
   /* All particles have now been drifted to ti_current */
   e->ti_earliest_undrifted = e->ti_current;
+  e->drifted_species = engine_drift_all_species;
+  e->ti_drifted_species = e->ti_current;
 
   if (e->verbose)
     message("took %.3f %s.", clocks_from_ticks(getticks() - tic),
@@ -445,10 +458,248 @@ void engine_drift_all(struct engine *e, const int drift_mpoles) {
 }
 
 /**
- * @brief Mapper function to drift *all* top-level multipoles forward in
+ * @brief Have all the particles of all the species already been drifted to
+ * the current time?
+ *
+ * @param e The #engine.
+ */
+int engine_all_drifted(const struct engine *e) {
+
+  return e->ti_drifted_species == e->ti_current &&
+         e->drifted_species == engine_drift_all_species;
+}
+
+/**
+ * @brief Drift *all* the particles of some species forward to the current
  * time.
  *
- * @param map_data An array of #cell%s.
+ * Only the species that have not yet been drifted to the current time are
+ * touched. Consumers of the particle data (outputs, FoF, the PM mesh, ...)
+ * thus simply declare the species they need and the species they do not
+ * read are left to the next full drift or to the regular drift tasks.
+ *
+ * @param e The #engine.
+ * @param species The species (#engine_drift_species) to drift.
+ */
+void engine_drift_species(struct engine *e, const int species) {
+
+  /* Forget about drifts to other times */
+  if (e->ti_drifted_species != e->ti_current) e->drifted_species = 0;
+
+  /* Anything left to do? */
+  const int todo = species & ~e->drifted_species;
+  if (todo == 0) return;
+
+  /* When restarting or drifting everything, use the full drift */
+  if (e->restarting || todo == engine_drift_all_species) {
+    engine_drift_all(e, /*drift_mpole=*/0);
+    return;
+  }
+
+  const ticks tic = getticks();
+
+  if (e->nodeID == 0 && e->verbose) {
+    if (e->policy & engine_policy_cosmology)
+      message("Drifting species %#x to a=%15.12e", todo,
+              exp(e->ti_current * e->time_base) * e->cosmology->a_begin);
+    else
+      message("Drifting species %#x to t=%15.12e", todo,
+              e->ti_current * e->time_base + e->time_begin);
+  }
+
+#ifdef WITH_LIGHTCONE
+  lightcone_array_prepare_for_step(e->lightcone_array_properties, e->cosmology,
+                                   e->ti_earliest_undrifted, e->ti_current);
+#endif
+
+  engine_drift_local_cells(e, todo, /*drift_mpoles=*/0);
+
+  e->drifted_species |= todo;
+  e->ti_drifted_species = e->ti_current;
+
+  /* Synchronize the positions of the pairs of particles that are now both
+   * at the current time */
+  struct space *s = e->s;
+  const int drifted = e->drifted_species;
+  const int with_gparts = (drifted & engine_drift_gpart) && s->nr_gparts > 0;
+  const int new_gparts = (todo & engine_drift_gpart);
+
+  if (with_gparts && (drifted & engine_drift_part) &&
+      (new_gparts || (todo & engine_drift_part)) && s->nr_parts > 0)
+    threadpool_map(&e->threadpool, space_synchronize_part_positions_mapper,
+                   s->parts, s->nr_parts, sizeof(struct part),
+                   threadpool_auto_chunk_size, (void *)s);
+  if (with_gparts && (drifted & engine_drift_spart) &&
+      (new_gparts || (todo & engine_drift_spart)) && s->nr_sparts > 0)
+    threadpool_map(&e->threadpool, space_synchronize_spart_positions_mapper,
+                   s->sparts, s->nr_sparts, sizeof(struct spart),
+                   threadpool_auto_chunk_size, /*extra_data=*/NULL);
+  if (with_gparts && (drifted & engine_drift_bpart) &&
+      (new_gparts || (todo & engine_drift_bpart)) && s->nr_bparts > 0)
+    threadpool_map(&e->threadpool, space_synchronize_bpart_positions_mapper,
+                   s->bparts, s->nr_bparts, sizeof(struct bpart),
+                   threadpool_auto_chunk_size, /*extra_data=*/NULL);
+  if (with_gparts && (drifted & engine_drift_sink) &&
+      (new_gparts || (todo & engine_drift_sink)) && s->nr_sinks > 0)
+    threadpool_map(&e->threadpool, space_synchronize_sink_positions_mapper,
+                   s->sinks, s->nr_sinks, sizeof(struct sink),
+                   threadpool_auto_chunk_size, /*extra_data=*/NULL);
+
+  /* Did we just complete a full drift? */
+  if (drifted == engine_drift_all_species) {
+#ifdef SWIFT_DEBUG_CHECKS
+    space_check_drift_point(e->s, e->ti_current, /*check_mpole=*/0);
+#endif
+    e->ti_earliest_undrifted = e->ti_current;
+  }
+
+  if (e->verbose)
+    message("took %.3f %s.", clocks_from_ticks(getticks() - tic),
+            clocks_getunit());
+
+#ifdef WITH_LIGHTCONE
+  lightcone_array_flush(e->lightcone_array_properties, &e->threadpool,
+                        e->cosmology, e->internal_units, e->snapshot_units,
+                        /*flush_map_updates=*/1, /*flush_particles=*/1,
+                        /*end_file=*/0, /*dump_all_shells=*/0);
+#endif
+}
+
+/**
+ * @brief Data passed to #engine_do_drift_cells_mapper.
+ */
+struct engine_drift_cells_data {
+
+  /*! The #engine */
+  struct engine *e;
+
+  /*! The species to drift */
+  int species;
+
+  /*! The species at the current time once the cells are drifted */
+  int drifted;
+
+  /*! Function to apply to the cells once drifted (may be NULL) */
+  engine_drift_cell_function fn;
+
+  /*! Data passed to fn */
+  void *data;
+};
+
+/**
+ * @brief Mapper function to drift a list of top-level cells and hand them
+ * to a consumer.
+ *
+ * @param map_data An array of indices of top-level #cell%s.
+ * @param num_elements Chunk size.
+ * @param extra_data Pointer to an #engine_drift_cells_data.
+ */
+static void engine_do_drift_cells_mapper(void *map_data, int num_elements,
+                                         void *extra_data) {
+
+  const struct engine_drift_cells_data *data =
+      (const struct engine_drift_cells_data *)extra_data;
+  struct engine *e = data->e;
+  struct space *s = e->s;
+  const int *cell_ids = (const int *)map_data;
+  const int species = data->species;
+  const int drifted = data->drifted;
+  const int new_gparts = (species & engine_drift_gpart);
+
+  for (int ind = 0; ind < num_elements; ind++) {
+
+    struct cell *c = &s->cells_top[cell_ids[ind]];
+    if (c->nodeID != e->nodeID) continue;
+
+    /* Drift all the requested species of this cell */
+    if (species & engine_drift_part) cell_drift_part(c, e, 1, NULL);
+    if (species & engine_drift_gpart) cell_drift_gpart(c, e, 1, NULL);
+    if (species & engine_drift_spart) cell_drift_spart(c, e, 1, NULL);
+    if (species & engine_drift_sink) cell_drift_sink(c, e, 1);
+    if (species & engine_drift_bpart) cell_drift_bpart(c, e, 1, NULL);
+
+    /* Synchronize the positions of the pairs now both at the current time */
+    if (drifted & engine_drift_gpart) {
+      if ((drifted & engine_drift_part) &&
+          (new_gparts || (species & engine_drift_part)))
+        space_synchronize_part_positions_mapper(c->hydro.parts,
+                                                c->hydro.count, s);
+      if ((drifted & engine_drift_spart) &&
+          (new_gparts || (species & engine_drift_spart)))
+        space_synchronize_spart_positions_mapper(c->stars.parts,
+                                                 c->stars.count, NULL);
+      if ((drifted & engine_drift_bpart) &&
+          (new_gparts || (species & engine_drift_bpart)))
+        space_synchronize_bpart_positions_mapper(c->black_holes.parts,
+                                                 c->black_holes.count, NULL);
+      if ((drifted & engine_drift_sink) &&
+          (new_gparts || (species & engine_drift_sink)))
+        space_synchronize_sink_positions_mapper(c->sinks.parts, c->sinks.count,
+                                                NULL);
+    }
+
+    /* Hand the cell over while it is still hot in the cache */
+    if (data->fn != NULL) data->fn(c, data->data);
+  }
+}
+
+/**
+ * @brief Drift some species of a subset of the top-level cells forward to
+ * the current time and apply a function to each of them.
+ *
+ * This lets consumers that only need part of the volume (e.g. a slab) drift
+ * just the cells they read, with the drift fused into their own pass over
+ * the particles. The foreign cells of the list are skipped.
+ *
+ * @param e The #engine.
+ * @param cell_ids The indices of the top-level cells.
+ * @param num_cells The number of cells in the list.
+ * @param species The species (#engine_drift_species) to drift.
+ * @param fn Function to apply to each cell once drifted (can be NULL).
+ * @param data Data passed to fn.
+ */
+void engine_drift_cells(struct engine *e, const int *cell_ids,
+                        const int num_cells, const int species,
+                        engine_drift_cell_function fn, void *data) {
+
+  const ticks tic = getticks();
+
+#ifdef WITH_LIGHTCONE
+  lightcone_array_prepare_for_step(e->lightcone_array_properties, e->cosmology,
+                                   e->ti_earliest_undrifted, e->ti_current);
+#endif
+
+  const int done =
+      (e->ti_drifted_species == e->ti_current) ? e->drifted_species : 0;
+
+  struct engine_drift_cells_data drift_data;
+  drift_data.e = e;
+  drift_data.species = species & ~done;
+  drift_data.drifted = done | species;
+  drift_data.fn = fn;
+  drift_data.data = data;
+
+  threadpool_map(&e->threadpool, engine_do_drift_cells_mapper, (void *)cell_ids,
+                 num_cells, sizeof(int), threadpool_auto_chunk_size,
+                 &drift_data);
+
+  if (e->verbose)
+    message("took %.3f %s.", clocks_from_ticks(getticks() - tic),
+            clocks_getunit());
+
+#ifdef WITH_LIGHTCONE
+  lightcone_array_flush(e->lightcone_array_properties, &e->threadpool,
+                        e->cosmology, e->internal_units, e->snapshot_units,
+                        /*flush_map_updates=*/1, /*flush_particles=*/1,
+                        /*end_file=*/0, /*dump_all_shells=*/0);
+#endif
+}
+
+/**
+ * @brief Mapper function to drift *all* non-empty top-level multipoles
+ * forward in time.
+ *
+ * @param map_data An array of indices of top-level #cell%s.
  * @param num_elements Chunk size.
  * @param extra_data Pointer to an #engine.
  */
@@ -456,21 +707,23 @@ void engine_do_drift_top_multipoles_mapper(void *map_data, int num_elements,
                                            void *extra_data) {
 
   struct engine *e = (struct engine *)extra_data;
-  struct cell *cells = (struct cell *)map_data;
+  struct cell *cells = e->s->cells_top;
+  const int *cells_with_particles = (int *)map_data;
 
   for (int ind = 0; ind < num_elements; ind++) {
-    struct cell *c = &cells[ind];
-    if (c != NULL) {
+    struct cell *c = &cells[cells_with_particles[ind]];
 
-      /* Drift the multipole at this level only */
-      if (c->grav.ti_old_multipole != e->ti_current) cell_drift_multipole(c, e);
-    }
+    /* Drift the multipole at this level only */
+    if (c->grav.ti_old_multipole != e->ti_current) cell_drift_multipole(c, e);
   }
 }
 
 /**
  * @brief Drift *all* top-level multipoles forward to the current time.
  *
+ * Empty cells carry no information and are never used between rebuilds
+ * so we only loop over the (possibly few) occupied top-level cells.
+ *
  * @param e The #engine.
  */
 void engine_drift_top_multipoles(struct engine *e) {
@@ -478,8 +731,8 @@ void engine_drift_top_multipoles(struct engine *e) {
   const ticks tic = getticks();
 
   threadpool_map(&e->threadpool, engine_do_drift_top_multipoles_mapper,
-                 e->s->cells_top, e->s->nr_cells, sizeof(struct cell),
-                 threadpool_auto_chunk_size, e);
+                 e->s->cells_with_particles_top, e->s->nr_cells_with_particles,
+                 sizeof(int), threadpool_auto_chunk_size, e);
 
 #ifdef SWIFT_DEBUG_CHECKS
   /* Check that all cells have been drifted to the current time. */
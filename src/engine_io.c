@@ -37,11 +37,13 @@
 #include "kick.h"
 #include "lightcone/lightcone.h"
 #include "lightcone/lightcone_array.h"
+#include "image_maps.h"
 #include "line_of_sight.h"
 #include "parallel_io.h"
 #include "power_spectrum.h"
 #include "serial_io.h"
 #include "single_io.h"
+#include "snapshot_delta.h"
 #include "tracers.h"
 
 /* Standard includes */
@@ -164,6 +166,43 @@ void engine_finalize_trigger_recordings(struct engine *e) {
   }
 }
 
+/**
+ * @brief Set the interval between restart dumps from their measured cost and
+ * the mean time between failures of the system.
+ *
+ * We use the higher-order estimate of Daly (2006) of the interval minimising
+ * the expected wall-clock time lost to check-pointing and to the re-computation
+ * after a failure. The predicted fraction of the run lost is reported.
+ *
+ * @param e The #engine.
+ */
+void engine_update_restart_interval(struct engine *e) {
+
+  const double C = e->restart_cost;
+  const double M = e->restart_mtbf;
+
+  /* Optimal compute time between the end of a dump and the next one */
+  double tau;
+  if (C < 2. * M) {
+    const double x = C / (2. * M);
+    tau = sqrt(2. * C * M) * (1. + sqrt(x) / 3. + x / 9.) - C;
+  } else {
+    tau = M;
+  }
+
+  /* Fraction of the run spent writing the dumps or lost to failures */
+  const double overhead = C / (tau + C) + 0.5 * (tau + C) / M;
+
+  /* The interval is measured between the start of consecutive dumps */
+  e->restart_dt = clocks_to_ticks((tau + C) * 1000.);
+
+  if (e->nodeID == 0)
+    message(
+        "Restart dumps take %.3f s, next dump in %f hours (predicted "
+        "overhead: %.2f%%)",
+        C, (tau + C) / 3600., 100. * overhead);
+}
+
 /**
  * @brief dump restart files if it is time to do so and dumps are enabled.
  *
@@ -186,7 +225,14 @@ int engine_dump_restarts(struct engine *e, const int drifted_all,
   if (e->restart_dump) {
     ticks tic = getticks();
 
-    const int check_point_time = tic > e->restart_next;
+    int check_point_time = tic > e->restart_next;
+
+    /* When adapting the cadence, we prefer to dump at the end of a step that
+     * rebuilt the tree as the particles are then sorted in their cells.
+     * We do not wait for more than a tenth of the interval though. */
+    if (check_point_time && e->restart_adaptive &&
+        !(e->step_props & engine_step_prop_rebuild))
+      check_point_time = tic > e->restart_next + e->restart_dt / 10;
 
     /* Dump when the time has arrived, or we are told to. */
     int dump = (check_point_time || end_run_time || force || stop_file);
@@ -234,6 +280,12 @@ int engine_dump_restarts(struct engine *e, const int drifted_all,
 
       restart_write(e, e->restart_file);
 
+      /* Save the FFTW plans such that the restart does not measure them */
+      if (e->nodeID == 0 && (e->policy & engine_policy_self_gravity))
+        pm_mesh_export_fftw_wisdom(e->mesh, e->restart_dir);
+      if (e->nodeID == 0 && (e->policy & engine_policy_power_spectra))
+        power_export_fftw_wisdom(e->power_data, e->restart_dir);
+
 #ifdef WITH_MPI
       /* Make sure all ranks finished writing to avoid having incomplete
        * sets of restart files should the code crash before all the ranks
@@ -245,12 +297,30 @@ int engine_dump_restarts(struct engine *e, const int drifted_all,
         engine_allocate_foreign_particles(e, /*fof=*/0);
 #endif
 
+      const ticks toc = getticks();
       if (e->verbose)
         message("Dumping restart files took %.3f %s",
-                clocks_from_ticks(getticks() - tic), clocks_getunit());
+                clocks_from_ticks(toc - tic), clocks_getunit());
+
+      if (e->restart_adaptive) {
+
+        /* Update the interval from the cost of this dump (as measured on
+         * rank 0, which waited for all the others to finish) */
+        double cost = clocks_from_ticks(toc - tic) / 1000.;
+#ifdef WITH_MPI
+        MPI_Bcast(&cost, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+#endif
+        e->restart_cost = cost;
+        engine_update_restart_interval(e);
+
+        /* Time after which next dump will occur. */
+        e->restart_next = tic + e->restart_dt;
+
+      } else {
 
-      /* Time after which next dump will occur. */
-      e->restart_next += e->restart_dt;
+        /* Time after which next dump will occur. */
+        e->restart_next += e->restart_dt;
+      }
 
       /* Flag that we dumped the restarts */
       e->step_props |= engine_step_prop_restarts;
@@ -339,7 +409,13 @@ void engine_dump_snapshot(struct engine *e) {
 #endif
   }
 #else
-  write_output_single(e, e->internal_units, e->snapshot_units);
+  if (e->snapshot_delta_frames > 0 && !snapshot_delta_next_is_keyframe(e)) {
+    snapshot_delta_write_frame(e, e->internal_units, e->snapshot_units);
+  } else {
+    if (e->snapshot_delta_frames > 0)
+      snapshot_delta_record_keyframe(e, e->internal_units, e->snapshot_units);
+    write_output_single(e, e->internal_units, e->snapshot_units);
+  }
 #endif
 #endif
 
@@ -413,6 +489,7 @@ void engine_io(struct engine *e) {
   const int with_los = (e->policy & engine_policy_line_of_sight);
   const int with_fof = (e->policy & engine_policy_fof);
   const int with_power = (e->policy & engine_policy_power_spectra);
+  const int with_image_maps = (e->policy & engine_policy_image_maps);
 
   /* What kind of output are we getting? */
   enum output_type {
@@ -422,6 +499,7 @@ void engine_io(struct engine *e) {
     output_ps,
     output_stf,
     output_los,
+    output_image_maps,
   };
 
   /* What kind of output do we want? And at which time ?
@@ -475,6 +553,16 @@ void engine_io(struct engine *e) {
     }
   }
 
+  /* Do we want to write some image maps? */
+  if (with_image_maps) {
+    if (e->ti_end_min > e->ti_next_image_maps && e->ti_next_image_maps > 0) {
+      if (e->ti_next_image_maps < ti_output) {
+        ti_output = e->ti_next_image_maps;
+        type = output_image_maps;
+      }
+    }
+  }
+
   /* Store information before attempting extra dump-related drifts */
   const integertime_t ti_current = e->ti_current;
   const timebin_t max_active_bin = e->max_active_bin;
@@ -492,8 +580,23 @@ void engine_io(struct engine *e) {
       e->time = ti_output * e->time_base + e->time_begin;
     }
 
-    /* Drift everyone */
-    engine_drift_all(e, /*drift_mpole=*/0);
+    /* Drift the species this output reads */
+    switch (type) {
+      case output_ps:
+        engine_drift_species(e, engine_drift_gpart | engine_drift_part);
+        break;
+      case output_stf:
+        engine_drift_species(e, engine_drift_all_species & ~engine_drift_sink);
+        break;
+      case output_los:
+        engine_drift_species(e, engine_drift_part);
+        break;
+      case output_image_maps:
+        /* The images drift the cells they need themselves */
+        break;
+      default:
+        engine_drift_species(e, engine_drift_all_species);
+    }
 
     /* Write some form of output */
     switch (type) {
@@ -614,6 +717,16 @@ void engine_io(struct engine *e) {
 
         break;
 
+      case output_image_maps:
+
+        /* Project and write the images */
+        image_maps_write(e);
+
+        /* Move on */
+        engine_compute_next_image_maps_time(e);
+
+        break;
+
       case output_ps:
 
         /* Compute the PS */
@@ -678,6 +791,17 @@ void engine_io(struct engine *e) {
       }
     }
 
+    /* Do image maps ? */
+    if (with_image_maps) {
+      if (e->ti_end_min > e->ti_next_image_maps &&
+          e->ti_next_image_maps > 0) {
+        if (e->ti_next_image_maps < ti_output) {
+          ti_output = e->ti_next_image_maps;
+          type = output_image_maps;
+        }
+      }
+    }
+
   } /* While loop over output types */
 
   /* Restore the information we stored */
@@ -944,6 +1068,82 @@ void engine_compute_next_los_time(struct engine *e) {
   }
 }
 
+/**
+ * @brief Computes the next time (on the time line) for an image maps dump
+ *
+ * @param e The #engine.
+ */
+void engine_compute_next_image_maps_time(struct engine *e) {
+  /* Do output_list file case */
+  if (e->output_list_image_maps) {
+    output_list_read_next_time(e->output_list_image_maps, e, "image maps",
+                               &e->ti_next_image_maps);
+    return;
+  }
+
+  const int with_cosmology = (e->policy & engine_policy_cosmology);
+  if ((with_cosmology && e->delta_time_image_maps <= 1.) ||
+      (!with_cosmology && e->delta_time_image_maps <= 0.))
+    error("Invalid time between image maps (%e).", e->delta_time_image_maps);
+
+  /* Find upper-bound on last output */
+  double time_end;
+  if (with_cosmology)
+    time_end = e->cosmology->a_end * e->delta_time_image_maps;
+  else
+    time_end = e->time_end + e->delta_time_image_maps;
+
+  /* Find next image maps output above current time */
+  double time;
+  if (with_cosmology)
+    time = e->a_first_image_maps;
+  else
+    time = e->time_first_image_maps;
+
+  int found_image_maps_time = 0;
+  while (time < time_end) {
+
+    /* Output time on the integer timeline */
+    if (with_cosmology)
+      e->ti_next_image_maps = log(time / e->cosmology->a_begin) / e->time_base;
+    else
+      e->ti_next_image_maps = (time - e->time_begin) / e->time_base;
+
+    /* Found it? */
+    if (e->ti_next_image_maps > e->ti_current) {
+      found_image_maps_time = 1;
+      break;
+    }
+
+    if (with_cosmology)
+      time *= e->delta_time_image_maps;
+    else
+      time += e->delta_time_image_maps;
+  }
+
+  /* Deal with last image maps output */
+  if (!found_image_maps_time) {
+    e->ti_next_image_maps = -1;
+    if (e->verbose) message("No further image maps output time.");
+  } else {
+
+    /* Be nice, talk... */
+    if (with_cosmology) {
+      const double next_image_maps_time =
+          exp(e->ti_next_image_maps * e->time_base) * e->cosmology->a_begin;
+      if (e->verbose)
+        message("Next output time for image maps set to a=%e.",
+                next_image_maps_time);
+    } else {
+      const double next_image_maps_time =
+          e->ti_next_image_maps * e->time_base + e->time_begin;
+      if (e->verbose)
+        message("Next output time for image maps set to t=%e.",
+                next_image_maps_time);
+    }
+  }
+}
+
 /**
  * @brief Computes the next time (on the time line) for structure finding
  *
@@ -1225,6 +1425,25 @@ void engine_init_output_lists(struct engine *e, struct swift_params *params,
     }
   }
 
+  /* Deal with image maps */
+  if (e->policy & engine_policy_image_maps) {
+
+    e->output_list_image_maps = NULL;
+    output_list_init(&e->output_list_image_maps, e, "ImageMaps",
+                     &e->delta_time_image_maps);
+
+    if (e->output_list_image_maps) {
+      engine_compute_next_image_maps_time(e);
+
+      if (e->policy & engine_policy_cosmology)
+        e->a_first_image_maps =
+            exp(e->ti_next_image_maps * e->time_base) * e->cosmology->a_begin;
+      else
+        e->time_first_image_maps =
+            e->ti_next_image_maps * e->time_base + e->time_begin;
+    }
+  }
+
   /* Deal with power-spectra */
   if (e->policy & engine_policy_power_spectra) {
 
@@ -1985,6 +1985,108 @@ void engine_make_self_gravity_tasks_mapper(void *map_data, int num_elements,
   }
 }
 
+/**
+ * @brief Constructs the list of top-level cells each local top-level cell
+ * interacts with via M-M in its long-range gravity task.
+ *
+ * The decisions only depend on the rebuild-time multipoles and on the cell
+ * geometry, so they are identical to the ones used above to decide which
+ * pairs get a direct task and can be re-used until the next rebuild.
+ */
+void engine_make_grav_long_range_lists_mapper(void *map_data,
+                                              int num_elements,
+                                              void *extra_data) {
+
+  struct engine *e = (struct engine *)extra_data;
+  struct space *s = e->s;
+  const int periodic = e->mesh->periodic;
+  const double dim[3] = {e->mesh->dim[0], e->mesh->dim[1], e->mesh->dim[2]};
+  const double max_distance2 = e->mesh->r_cut_max * e->mesh->r_cut_max;
+  struct cell *cells = s->cells_top;
+  const int *cells_with_particles = s->cells_with_particles_top;
+  const int nr_cells_with_particles = s->nr_cells_with_particles;
+  const int *local_cells = (int *)map_data;
+
+  for (int ind = 0; ind < num_elements; ind++) {
+
+    struct cell *ci = &cells[local_cells[ind]];
+
+    /* Skip cells without gravity particles */
+    if (ci->grav.count == 0) continue;
+
+    int *list = (int *)swift_malloc("grav.long_range_list",
+                                    nr_cells_with_particles * sizeof(int));
+    if (list == NULL && nr_cells_with_particles > 0)
+      error("Failed to allocate long-range gravity list.");
+
+    int count = 0;
+    for (int n = 0; n < nr_cells_with_particles; ++n) {
+
+      const int cjd = cells_with_particles[n];
+      struct cell *cj = &cells[cjd];
+
+      /* Avoid self contributions */
+      if (ci == cj) continue;
+
+      /* Beyond the distance where the truncated forces are 0? */
+      if (periodic &&
+          cell_min_dist2_same_size(ci, cj, periodic, dim) > max_distance2) {
+        ci->grav.long_range_has_far = 1;
+        continue;
+      }
+
+      if (cell_can_use_pair_mm(ci, cj, e, s, /*use_rebuild_data=*/1,
+                               /*is_tree_walk=*/0))
+        list[count++] = cjd;
+    }
+
+    /* Trim the list down to its final size */
+    if (count == 0) {
+      swift_free("grav.long_range_list", list);
+      list = NULL;
+    } else if (count < nr_cells_with_particles) {
+      list = (int *)swift_realloc("grav.long_range_list", list,
+                                  count * sizeof(int));
+      if (list == NULL) error("Failed to trim long-range gravity list.");
+    }
+
+    ci->grav.long_range_list = list;
+    ci->grav.long_range_count = count;
+  }
+}
+
+/**
+ * @brief Constructs the lists of partners of the long-range gravity tasks.
+ *
+ * Needs to be called once the list of top-level cells with particles has
+ * been updated for this rebuild.
+ *
+ * Only the top-level partners of the long-range tasks are cached. The M2L,
+ * M2P and P-P decisions taken by runner_dopair_recursive_grav() below the
+ * top level are still made afresh at every step.
+ *
+ * @param e The #engine.
+ */
+void engine_make_grav_long_range_lists(struct engine *e) {
+
+  const ticks tic = getticks();
+  struct space *s = e->s;
+
+  /* Drop the lists of the cells that may no longer be local or have
+   * particles. The ones that still do are rebuilt below. */
+  for (int k = 0; k < s->nr_cells; ++k)
+    cell_free_grav_long_range_list(&s->cells_top[k]);
+
+  threadpool_map(&e->threadpool, engine_make_grav_long_range_lists_mapper,
+                 s->local_cells_with_particles_top,
+                 s->nr_local_cells_with_particles, sizeof(int),
+                 threadpool_auto_chunk_size, e);
+
+  if (e->verbose)
+    message("took %.3f %s.", clocks_from_ticks(getticks() - tic),
+            clocks_getunit());
+}
+
 /**
  * @brief Constructs the top-level tasks for the external gravity.
  *
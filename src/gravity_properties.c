@@ -41,6 +41,7 @@
 #define gravity_props_default_rebuild_frequency 0.01f
 #define gravity_props_default_rebuild_active_fraction 1.01f  // > 1 means never
 #define gravity_props_default_distributed_mesh 0
+#define gravity_props_default_distributed_mesh_pencils 1
 
 void gravity_props_init(struct gravity_props *p, struct swift_params *params,
                         const struct phys_const *phys_const,
@@ -69,8 +70,26 @@ void gravity_props_init(struct gravity_props *p, struct swift_params *params,
     p->distributed_mesh =
         parser_get_opt_param_int(params, "Gravity:distributed_mesh",
                                  gravity_props_default_distributed_mesh);
+    p->distributed_mesh_pencils = parser_get_opt_param_int(
+        params, "Gravity:distributed_mesh_pencils",
+        gravity_props_default_distributed_mesh_pencils);
     p->mesh_uses_local_patches =
         parser_get_opt_param_int(params, "Gravity:mesh_uses_local_patches", 1);
+
+    char planner[32] = {0};
+    parser_get_opt_param_string(params, "Gravity:mesh_fftw_planner", planner,
+                                "estimate");
+    if (strcmp(planner, "estimate") == 0)
+      p->mesh_fftw_planner = 0;
+    else if (strcmp(planner, "measure") == 0)
+      p->mesh_fftw_planner = 1;
+    else if (strcmp(planner, "patient") == 0)
+      p->mesh_fftw_planner = 2;
+    else
+      error(
+          "Invalid choice of FFTW planner: '%s'. Should be 'estimate', "
+          "'measure' or 'patient'",
+          planner);
     p->a_smooth = parser_get_opt_param_float(params, "Gravity:a_smooth",
                                              gravity_props_default_a_smooth);
     p->r_cut_max_ratio = parser_get_opt_param_float(
@@ -108,6 +127,8 @@ void gravity_props_init(struct gravity_props *p, struct swift_params *params,
   } else {
     p->mesh_size = 0;
     p->distributed_mesh = 0;
+    p->distributed_mesh_pencils = 0;
+    p->mesh_fftw_planner = 0;
     p->a_smooth = 0.f;
     p->r_s = FLT_MAX;
     p->r_s_inv = 0.f;
@@ -122,9 +143,20 @@ void gravity_props_init(struct gravity_props *p, struct swift_params *params,
   char buffer[32] = {0};
   parser_get_param_string(params, "Gravity:MAC", buffer);
 
+  p->use_MAC_error_budget = 0;
   if (strcmp(buffer, "adaptive") == 0) {
     p->use_adaptive_tolerance = 1;
     p->use_gadget_tolerance = 0;
+  } else if (strcmp(buffer, "budget") == 0) {
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+    p->use_adaptive_tolerance = 1;
+    p->use_gadget_tolerance = 0;
+    p->use_MAC_error_budget = 1;
+#else
+    error(
+        "SWIFT was not compiled with the error-budget MAC "
+        "(--enable-gravity-mac-error-budget).");
+#endif
   } else if (strcmp(buffer, "gadget") == 0) {
     p->use_adaptive_tolerance = 1;
     p->use_gadget_tolerance = 1;
@@ -133,7 +165,7 @@ void gravity_props_init(struct gravity_props *p, struct swift_params *params,
   } else {
     error(
         "Invalid choice of multipole acceptance criterion: '%s'. Should be "
-        "'adaptive', 'gadget', or 'geometric'",
+        "'adaptive', 'budget', 'gadget', or 'geometric'",
         buffer);
   }
 
@@ -149,6 +181,22 @@ void gravity_props_init(struct gravity_props *p, struct swift_params *params,
     p->adaptive_tolerance =
         parser_get_param_float(params, "Gravity:epsilon_fmm");
 
+  /* Error budget per particle and relative cost of the M2L kernel. The cost
+   * has not been calibrated: it depends on the multipole order, the compiler
+   * and the vector units, so the default is only a starting point that runs
+   * can tune by comparing the time spent in the gravity tasks. */
+  if (p->use_MAC_error_budget) {
+    p->MAC_error_budget = parser_get_opt_param_float(
+        params, "Gravity:MAC_error_budget", 10.f * p->adaptive_tolerance);
+    p->MAC_budget_M2L_cost =
+        parser_get_opt_param_float(params, "Gravity:MAC_budget_M2L_cost", 64.f);
+
+    if (p->MAC_error_budget <= 0.f)
+      error("The MAC error budget must be positive.");
+    if (p->MAC_budget_M2L_cost < 0.f)
+      error("The cost of the M2L kernel cannot be negative.");
+  }
+
   /* Consider truncated forces in the MAC? */
   if (p->use_adaptive_tolerance)
     p->consider_truncation_in_MAC =
@@ -303,6 +351,14 @@ void gravity_props_print(const struct gravity_props *p) {
       message("Self-gravity opening angle scheme:  Gadget");
       message("Self-gravity opening angle:  epsilon_fmm=%.6f",
               p->adaptive_tolerance);
+    } else if (p->use_MAC_error_budget) {
+      message("Self-gravity opening angle scheme:  error budget");
+      message("Self-gravity opening angle:  epsilon_fmm=%.6f",
+              p->adaptive_tolerance);
+      message("Self-gravity error budget:  MAC_error_budget=%.6f",
+              p->MAC_error_budget);
+      message("Self-gravity M2L cost:  MAC_budget_M2L_cost=%.2f",
+              p->MAC_budget_M2L_cost);
     } else {
       message("Self-gravity opening angle scheme:  adaptive");
       message("Self-gravity opening angle:  epsilon_fmm=%.6f",
@@ -358,6 +414,11 @@ void gravity_props_print(const struct gravity_props *p) {
   message("Self-gravity mesh side-length: N=%d", p->mesh_size);
   message("Self-gravity mesh smoothing-scale: a_smooth=%f", p->a_smooth);
   message("Self-gravity distributed mesh enabled: %d", p->distributed_mesh);
+  if (p->distributed_mesh)
+    message("Self-gravity distributed mesh uses pencils: %d",
+            p->distributed_mesh_pencils);
+  else
+    message("Self-gravity mesh FFTW planner rigour: %d", p->mesh_fftw_planner);
 
   message("Self-gravity tree cut-off ratio: r_cut_max=%f", p->r_cut_max_ratio);
   message("Self-gravity truncation cut-off ratio: r_cut_min=%f",
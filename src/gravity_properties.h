@@ -73,6 +73,15 @@ struct gravity_props {
   /*! Accuracy parameter of the advanced MAC */
   float adaptive_tolerance;
 
+  /*! Are we adapting the MAC tolerance of each cell to an error budget? */
+  int use_MAC_error_budget;
+
+  /*! Target relative force error per particle in the error-budget MAC */
+  float MAC_error_budget;
+
+  /*! Cost of one M2L kernel in units of a P-P interaction */
+  float MAC_budget_M2L_cost;
+
   /*! Tree opening angle (Multipole acceptance criterion) */
   double theta_crit;
 
@@ -128,10 +137,18 @@ struct gravity_props {
   /*! Whether mesh is distributed between MPI ranks when we use MPI  */
   int distributed_mesh;
 
+  /*! Whether the distributed mesh uses a pencil (1) or slab (0)
+   * decomposition */
+  int distributed_mesh_pencils;
+
   /*! Whether or not to use local patches rather than
    * direct atomic writes to the mesh when running without MPI */
   int mesh_uses_local_patches;
 
+  /*! Rigour of the FFTW planner for the mesh (0: estimate, 1: measure,
+   * 2: patient) */
+  int mesh_fftw_planner;
+
   /*! Mesh smoothing scale in units of top-level cell size */
   float a_smooth;
 
@@ -89,6 +89,22 @@ __attribute__((always_inline)) INLINE static void hydro_compute_flux(
   fluxes[4] *= Anorm;
 }
 
+/**
+ * @brief Compute the fluxes for a batch of Riemann problems with their
+ * interface surface areas.
+ *
+ * @param b The #riemann_batch (the fluxes are stored in it).
+ * @param Anorm Surface areas of the interfaces.
+ */
+__attribute__((always_inline)) INLINE static void hydro_compute_flux_batch(
+    struct riemann_batch* restrict b, const float* restrict Anorm) {
+
+  riemann_solve_for_flux_batch(b);
+
+  for (int k = 0; k < 5; k++)
+    for (int i = 0; i < b->count; i++) b->flux[k][i] *= Anorm[i];
+}
+
 /**
  * @brief Update the fluxes for the particle with the given contributions,
  * assuming the particle is to the left of the interparticle interface.
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#ifndef SWIFT_GIZMO_HYDRO_FLUX_BATCH_H
+#define SWIFT_GIZMO_HYDRO_FLUX_BATCH_H
+
+#include "riemann/riemann_batch.h"
+
+/* Avoid cyclic inclusions */
+struct part;
+
+/**
+ * @brief Flux exchanges of the force loop waiting for their Riemann problem
+ * to be solved.
+ *
+ * Each runner owns one of these. The force loop fills it with the reconstructed
+ * interface states and the whole batch is solved at once when full or at the
+ * end of the interaction function, before the cells are unlocked.
+ */
+struct hydro_flux_batch {
+
+  /*! The Riemann problems */
+  struct riemann_batch riemann;
+
+  /*! Surface areas of the interfaces */
+  float Anorm[RIEMANN_BATCH_SIZE];
+
+  /*! Distance vectors between the particles (pi->x - pj->x) */
+  float dx[3][RIEMANN_BATCH_SIZE];
+
+  /*! Particles on the left of the interfaces */
+  struct part *pi[RIEMANN_BATCH_SIZE];
+
+  /*! Particles on the right of the interfaces */
+  struct part *pj[RIEMANN_BATCH_SIZE];
+
+  /*! Interaction modes (1 for symmetric interactions) */
+  int mode[RIEMANN_BATCH_SIZE];
+};
+
+#endif /* SWIFT_GIZMO_HYDRO_FLUX_BATCH_H */
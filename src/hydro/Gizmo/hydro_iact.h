@@ -20,6 +20,7 @@
 #define SWIFT_GIZMO_HYDRO_IACT_H
 
 #include "hydro_flux.h"
+#include "hydro_flux_batch.h"
 #include "hydro_getters.h"
 #include "hydro_gradients.h"
 #include "hydro_setters.h"
@@ -188,22 +189,16 @@ __attribute__((always_inline)) INLINE static void runner_iact_nonsym_gradient(
 }
 
 /**
- * @brief Common part of the flux calculation between particle i and j
- *
- * Since the only difference between the symmetric and non-symmetric version
- * of the flux calculation  is in the update of the conserved variables at the
- * very end (which is not done for particle j if mode is 0), both
- * runner_iact_force and runner_iact_nonsym_force call this method, with an
- * appropriate mode.
+ * @brief Reconstruct the Riemann problem at the interface between particle i
+ * and particle j.
  *
  * This method calculates the surface area of the interface between particle i
  * and particle j, as well as the interface position and velocity. These are
- * then used to reconstruct and predict the primitive variables, which are then
- * fed to a Riemann solver that calculates a flux. This flux is used to update
- * the conserved variables of particle i or both particles.
+ * then used to reconstruct and predict the primitive variables, which are
+ * boosted to the frame of the interface, ready to be fed to a Riemann solver.
  *
  * This method also calculates the maximal velocity used to calculate the time
- * step.
+ * step and the SPH-like estimate of the smoothing length derivative.
  *
  * @param r2 Comoving squared distance between particle i and particle j.
  * @param dx Comoving distance vector between the particles (dx = pi->x -
@@ -212,13 +207,20 @@ __attribute__((always_inline)) INLINE static void runner_iact_nonsym_gradient(
  * @param hj Comoving smoothing-length of particle j.
  * @param pi Particle i.
  * @param pj Particle j.
- * @param a Current scale factor.
- * @param H Current Hubble parameter.
+ * @param mode 0 for non-symmetric interaction, 1 for symmetric interaction.
+ * @param Wi (return) Left state of the Riemann problem.
+ * @param Wj (return) Right state of the Riemann problem.
+ * @param n_unit (return) Unit vector of the interface.
+ * @param vij (return) Velocity of the interface.
+ * @param Anorm_out (return) Surface area of the interface.
+ * @return 0 if the interface has no area (and nothing is to be exchanged), 1
+ * otherwise.
  */
-__attribute__((always_inline)) INLINE static void runner_iact_fluxes_common(
+__attribute__((always_inline)) INLINE static int runner_iact_fluxes_interface(
     const float r2, const float dx[3], const float hi, const float hj,
-    struct part *restrict pi, struct part *restrict pj, int mode, const float a,
-    const float H) {
+    struct part *restrict pi, struct part *restrict pj, const int mode,
+    float Wi[5], float Wj[5], float n_unit[3], float vij[3],
+    float *Anorm_out) {
 
   /* Get r and 1/r. */
   const float r = sqrtf(r2);
@@ -238,7 +240,6 @@ __attribute__((always_inline)) INLINE static void runner_iact_fluxes_common(
   }
   const float Vi = pi->geometry.volume;
   const float Vj = pj->geometry.volume;
-  float Wi[5], Wj[5];
   hydro_part_get_primitive_variables(pi, Wi);
   hydro_part_get_primitive_variables(pj, Wj);
 
@@ -341,7 +342,7 @@ __attribute__((always_inline)) INLINE static void runner_iact_fluxes_common(
   /* if the interface has no area, nothing happens and we return */
   /* continuing results in dividing by zero and NaN's... */
   if (Anorm2 == 0.0f) {
-    return;
+    return 0;
   }
 
   /* Compute the area */
@@ -365,8 +366,9 @@ __attribute__((always_inline)) INLINE static void runner_iact_fluxes_common(
 #endif
 
   /* compute the normal vector of the interface */
-  const float n_unit[3] = {A[0] * Anorm_inv, A[1] * Anorm_inv,
-                           A[2] * Anorm_inv};
+  n_unit[0] = A[0] * Anorm_inv;
+  n_unit[1] = A[1] * Anorm_inv;
+  n_unit[2] = A[2] * Anorm_inv;
 
   /* Compute interface position (relative to pi, since we don't need the actual
    * position) eqn. (8) */
@@ -375,9 +377,9 @@ __attribute__((always_inline)) INLINE static void runner_iact_fluxes_common(
 
   /* Compute interface velocity */
   /* eqn. (9) */
-  const float vij[3] = {vi[0] + (vi[0] - vj[0]) * xfac,
-                        vi[1] + (vi[1] - vj[1]) * xfac,
-                        vi[2] + (vi[2] - vj[2]) * xfac};
+  vij[0] = vi[0] + (vi[0] - vj[0]) * xfac;
+  vij[1] = vi[1] + (vi[1] - vj[1]) * xfac;
+  vij[2] = vi[2] + (vi[2] - vj[2]) * xfac;
 
   /* complete calculation of position of interface */
   /* NOTE: dx is not necessarily just pi->x - pj->x but can also contain
@@ -403,8 +405,24 @@ __attribute__((always_inline)) INLINE static void runner_iact_fluxes_common(
   /* we don't need to rotate, we can use the unit vector in the Riemann problem
    * itself (see GIZMO) */
 
-  float totflux[5];
-  hydro_compute_flux(Wi, Wj, n_unit, vij, Anorm, totflux);
+  *Anorm_out = Anorm;
+  return 1;
+}
+
+/**
+ * @brief Exchange the fluxes across the interface between particle i and
+ * particle j.
+ *
+ * @param pi Particle i.
+ * @param pj Particle j.
+ * @param totflux Fluxes across the interface (times its surface area).
+ * @param dx Comoving distance vector between the particles (dx = pi->x -
+ * pj->x).
+ * @param mode 0 for non-symmetric interaction, 1 for symmetric interaction.
+ */
+__attribute__((always_inline)) INLINE static void runner_iact_fluxes_exchange(
+    struct part *restrict pi, struct part *restrict pj, const float totflux[5],
+    const float dx[3], const int mode) {
 
   /* get the time step for the flux exchange. This is always the smallest time
      step among the two particles */
@@ -426,6 +444,121 @@ __attribute__((always_inline)) INLINE static void runner_iact_fluxes_common(
   rt_part_update_mass_fluxes(pi, pj, totflux[0], mode);
 }
 
+/**
+ * @brief Common part of the flux calculation between particle i and j
+ *
+ * Since the only difference between the symmetric and non-symmetric version
+ * of the flux calculation  is in the update of the conserved variables at the
+ * very end (which is not done for particle j if mode is 0), both
+ * runner_iact_force and runner_iact_nonsym_force call this method, with an
+ * appropriate mode.
+ *
+ * The Riemann problem at the interface is reconstructed by
+ * runner_iact_fluxes_interface() and solved straight away.
+ *
+ * @param r2 Comoving squared distance between particle i and particle j.
+ * @param dx Comoving distance vector between the particles (dx = pi->x -
+ * pj->x).
+ * @param hi Comoving smoothing-length of particle i.
+ * @param hj Comoving smoothing-length of particle j.
+ * @param pi Particle i.
+ * @param pj Particle j.
+ * @param mode 0 for non-symmetric interaction, 1 for symmetric interaction.
+ * @param a Current scale factor.
+ * @param H Current Hubble parameter.
+ */
+__attribute__((always_inline)) INLINE static void runner_iact_fluxes_common(
+    const float r2, const float dx[3], const float hi, const float hj,
+    struct part *restrict pi, struct part *restrict pj, int mode, const float a,
+    const float H) {
+
+  float Wi[5], Wj[5], n_unit[3], vij[3], Anorm;
+  if (!runner_iact_fluxes_interface(r2, dx, hi, hj, pi, pj, mode, Wi, Wj,
+                                    n_unit, vij, &Anorm))
+    return;
+
+  float totflux[5];
+  hydro_compute_flux(Wi, Wj, n_unit, vij, Anorm, totflux);
+
+  runner_iact_fluxes_exchange(pi, pj, totflux, dx, mode);
+}
+
+/**
+ * @brief Solve all the Riemann problems of a batch and exchange the
+ * resulting fluxes.
+ *
+ * @param b The #hydro_flux_batch.
+ */
+__attribute__((always_inline)) INLINE static void runner_iact_force_batch_flush(
+    struct hydro_flux_batch *restrict b) {
+
+  if (b->riemann.count == 0) return;
+
+  hydro_compute_flux_batch(&b->riemann, b->Anorm);
+
+  for (int i = 0; i < b->riemann.count; i++) {
+    const float totflux[5] = {b->riemann.flux[0][i], b->riemann.flux[1][i],
+                              b->riemann.flux[2][i], b->riemann.flux[3][i],
+                              b->riemann.flux[4][i]};
+    const float dx[3] = {b->dx[0][i], b->dx[1][i], b->dx[2][i]};
+    runner_iact_fluxes_exchange(b->pi[i], b->pj[i], totflux, dx, b->mode[i]);
+  }
+
+  b->riemann.count = 0;
+}
+
+/**
+ * @brief Flux calculation between particle i and particle j, deferring the
+ * Riemann solve to a batch.
+ *
+ * The interface is reconstructed immediately but the Riemann problem is only
+ * added to the batch, which gets solved once full. The fluxes are hence
+ * exchanged later, which is fine as they are not read during the force loop,
+ * but runner_iact_force_batch_flush() must be called before the cells are
+ * released.
+ *
+ * @param b The #hydro_flux_batch.
+ * @param r2 Comoving squared distance between particle i and particle j.
+ * @param dx Comoving distance vector between the particles (dx = pi->x -
+ * pj->x).
+ * @param hi Comoving smoothing-length of particle i.
+ * @param hj Comoving smoothing-length of particle j.
+ * @param pi Particle i.
+ * @param pj Particle j.
+ * @param mode 0 for non-symmetric interaction, 1 for symmetric interaction.
+ * @param a Current scale factor.
+ * @param H Current Hubble parameter.
+ */
+__attribute__((always_inline)) INLINE static void runner_iact_force_batch(
+    struct hydro_flux_batch *restrict b, const float r2, const float dx[3],
+    const float hi, const float hj, struct part *restrict pi,
+    struct part *restrict pj, const int mode, const float a, const float H) {
+
+  float Wi[5], Wj[5], n_unit[3], vij[3], Anorm;
+  if (!runner_iact_fluxes_interface(r2, dx, hi, hj, pi, pj, mode, Wi, Wj,
+                                    n_unit, vij, &Anorm))
+    return;
+
+  struct riemann_batch *rb = &b->riemann;
+  const int i = rb->count;
+  for (int k = 0; k < 5; k++) {
+    rb->WL[k][i] = Wi[k];
+    rb->WR[k][i] = Wj[k];
+  }
+  for (int k = 0; k < 3; k++) {
+    rb->n[k][i] = n_unit[k];
+    rb->vij[k][i] = vij[k];
+    b->dx[k][i] = dx[k];
+  }
+  b->Anorm[i] = Anorm;
+  b->pi[i] = pi;
+  b->pj[i] = pj;
+  b->mode[i] = mode;
+  rb->count++;
+
+  if (rb->count == RIEMANN_BATCH_SIZE) runner_iact_force_batch_flush(b);
+}
+
 /**
  * @brief Flux calculation between particle i and particle j
  *
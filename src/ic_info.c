@@ -54,6 +54,21 @@ void ic_info_init(struct ic_info *ics, struct swift_params *params) {
   /* Store the name of the HDF5 group to copy */
   parser_get_opt_param_string(params, "InitialConditions:metadata_group_name",
                               ics->group_name, "ICs_parameters");
+
+  /* Are we only reading a region of the ICs? */
+  const int has_min = parser_get_opt_param_double_array(
+      params, "InitialConditions:region_min", 3, ics->region_min);
+  const int has_max = parser_get_opt_param_double_array(
+      params, "InitialConditions:region_max", 3, ics->region_max);
+  if (has_min != has_max)
+    error(
+        "InitialConditions:region_min and InitialConditions:region_max must "
+        "be given together.");
+  ics->region_read = has_min;
+  if (ics->region_read)
+    for (int k = 0; k < 3; ++k)
+      if (ics->region_min[k] > ics->region_max[k])
+        error("Invalid region to read from the ICs along axis %d.", k);
 }
 
 /**
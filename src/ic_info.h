@@ -34,6 +34,13 @@ struct ic_info {
   char group_name[PARSER_MAX_LINE_SIZE];
   size_t file_image_length;
   void *file_image_data;
+
+  /* Are we only reading the particles in a region of the ICs? */
+  int region_read;
+
+  /* Corners of the region to read (in the units of the ICs) */
+  double region_min[3];
+  double region_max[3];
 };
 
 void ic_info_init(struct ic_info *ics, struct swift_params *params);
@@ -0,0 +1,673 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+/* Config parameters. */
+#include <config.h>
+
+/* MPI headers. */
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+
+/* This object's header. */
+#include "image_maps.h"
+
+/* Local headers. */
+#include "atomic.h"
+#include "common_io.h"
+#include "cooling.h"
+#include "engine.h"
+#include "hydro.h"
+#include "kernel_hydro.h"
+#include "minmax.h"
+#include "periodic.h"
+#include "restart.h"
+#include "tools.h"
+#include "units.h"
+
+/* Standard headers. */
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+
+/*! Names of the fields as used in the parameter file and the output files */
+static const char *image_map_field_names[image_map_field_count] = {
+    "SurfaceDensities", "Temperatures", "MaterialIDs"};
+
+/*! Kernel footprints spanning fewer pixels than this along each axis are
+ * normalised by summing the kernel over the pixels rather than
+ * analytically. */
+#define image_maps_small_footprint 8
+
+/**
+ * @brief Data passed to the projection and reduction mappers.
+ */
+struct image_maps_mapper_data {
+
+  /*! The #engine */
+  const struct engine *e;
+
+  /*! The image maps properties */
+  const struct image_maps_props *props;
+
+  /*! The images of all the planes, shared by all the threads */
+  double *images;
+
+  /*! Offset of each plane in the set of images */
+  size_t offsets[IMAGE_MAPS_MAX_PLANES];
+};
+
+/**
+ * @brief Find the #image_map_field corresponding to a name.
+ *
+ * @param name The name of the field.
+ */
+static enum image_map_field image_maps_get_field(const char *name) {
+
+  for (int f = 0; f < image_map_field_count; ++f)
+    if (strcmp(name, image_map_field_names[f]) == 0)
+      return (enum image_map_field)f;
+
+  error("Unknown image map field '%s'", name);
+  return image_map_field_count;
+}
+
+/**
+ * @brief Reads the image maps properties from the parameter file.
+ *
+ * @param props The #image_maps_props to initialise.
+ * @param e The #engine (space and policies are used).
+ * @param params The parsed parameter file.
+ */
+void image_maps_init(struct image_maps_props *props, const struct engine *e,
+                     struct swift_params *params) {
+
+#ifndef HYDRO_DIMENSION_3D
+  error("Image maps are only available in 3D.");
+#endif
+
+  parser_get_param_string(params, "ImageMaps:basename", props->basename);
+
+  /* The surface density is always computed as it is the weight used by all
+   * the other maps. */
+  props->num_fields = 1;
+  props->fields[0] = image_map_surface_density;
+
+  int num_names = 0;
+  char **names = NULL;
+  const char *default_names[1] = {
+      image_map_field_names[image_map_surface_density]};
+  parser_get_opt_param_string_array(params, "ImageMaps:fields", &num_names,
+                                    &names, 1, default_names);
+
+  for (int i = 0; i < num_names; ++i) {
+
+    const enum image_map_field field = image_maps_get_field(names[i]);
+
+    /* Skip fields we already have */
+    int found = 0;
+    for (int f = 0; f < props->num_fields; ++f)
+      if (props->fields[f] == field) found = 1;
+    if (found) continue;
+
+    if (field == image_map_temperature &&
+        !(e->policy & (engine_policy_cooling | engine_policy_temperature)))
+      error(
+          "Temperature image maps require running with --cooling or "
+          "--temperature.");
+
+#ifndef PLANETARY_SPH
+    if (field == image_map_material_id)
+      error("Material ID image maps require the planetary hydro scheme.");
+#endif
+
+    props->fields[props->num_fields++] = field;
+  }
+  parser_free_param_string_array(num_names, names);
+
+  /* Now, the planes */
+  props->num_planes = parser_get_param_int(params, "ImageMaps:num_planes");
+  if (props->num_planes < 1 || props->num_planes > IMAGE_MAPS_MAX_PLANES)
+    error("The number of image planes must be between 1 and %d.",
+          IMAGE_MAPS_MAX_PLANES);
+
+  const double *dim = e->s->dim;
+  for (int n = 0; n < props->num_planes; ++n) {
+
+    struct image_plane *plane = &props->planes[n];
+    char name[PARSER_MAX_LINE_SIZE];
+
+    check_snprintf(name, PARSER_MAX_LINE_SIZE, "ImageMapPlane%d:axis", n);
+    plane->axis = parser_get_param_int(params, name);
+    if (plane->axis < 0 || plane->axis > 2)
+      error("Invalid projection axis %d for image plane %d.", plane->axis, n);
+    plane->xaxis = (plane->axis + 1) % 3;
+    plane->yaxis = (plane->axis + 2) % 3;
+
+    /* By default, the whole box is imaged */
+    for (int k = 0; k < 3; ++k) plane->centre[k] = 0.5 * dim[k];
+    check_snprintf(name, PARSER_MAX_LINE_SIZE, "ImageMapPlane%d:centre", n);
+    parser_get_opt_param_double_array(params, name, 3, plane->centre);
+
+    plane->width[0] = dim[plane->xaxis];
+    plane->width[1] = dim[plane->yaxis];
+    check_snprintf(name, PARSER_MAX_LINE_SIZE, "ImageMapPlane%d:width", n);
+    parser_get_opt_param_double_array(params, name, 2, plane->width);
+
+    check_snprintf(name, PARSER_MAX_LINE_SIZE, "ImageMapPlane%d:depth", n);
+    plane->depth = parser_get_opt_param_double(params, name, dim[plane->axis]);
+
+    plane->num_pixels[0] = 256;
+    plane->num_pixels[1] = 256;
+    check_snprintf(name, PARSER_MAX_LINE_SIZE, "ImageMapPlane%d:num_pixels",
+                   n);
+    parser_get_opt_param_int_array(params, name, 2, plane->num_pixels);
+
+    if (plane->width[0] <= 0. || plane->width[1] <= 0. || plane->depth <= 0.)
+      error("Image plane %d must have a positive width and depth.", n);
+    if (plane->num_pixels[0] < 1 || plane->num_pixels[1] < 1)
+      error("Image plane %d must have at least one pixel.", n);
+
+    /* Images covering the whole of a periodic box wrap around */
+    plane->periodic[0] =
+        e->s->periodic && plane->width[0] == dim[plane->xaxis];
+    plane->periodic[1] =
+        e->s->periodic && plane->width[1] == dim[plane->yaxis];
+  }
+
+  /* Tabulate the kernel we project with */
+  projected_kernel_init(&props->kernel_table);
+}
+
+/**
+ * @brief Return the quantity of a particle that is mass-weighted in a given
+ * map.
+ *
+ * @param field The map.
+ * @param e The #engine.
+ * @param p The #part.
+ * @param xp The #xpart.
+ */
+static double image_maps_get_value(const enum image_map_field field,
+                                   const struct engine *e,
+                                   const struct part *p,
+                                   const struct xpart *xp) {
+  switch (field) {
+    case image_map_surface_density:
+      return 1.;
+    case image_map_temperature:
+      return cooling_get_temperature(e->physical_constants,
+                                     e->hydro_properties, e->internal_units,
+                                     e->cosmology, e->cooling_func, p, xp);
+    case image_map_material_id:
+#ifdef PLANETARY_SPH
+      return (double)p->mat_id;
+#else
+      error("Material IDs are only defined for the planetary hydro scheme.");
+      return 0.;
+#endif
+    default:
+      error("Invalid image map field");
+      return 0.;
+  }
+}
+
+/**
+ * @brief Wrap a pixel index back into the image.
+ *
+ * @param i The pixel index.
+ * @param n The number of pixels along this axis.
+ */
+__attribute__((always_inline)) INLINE static int image_maps_wrap(int i,
+                                                                 const int n) {
+  i %= n;
+  return i < 0 ? i + n : i;
+}
+
+/**
+ * @brief Spread the contribution of one particle over the pixels of an
+ * image.
+ *
+ * The weights are normalised such that the particle's total contribution
+ * is conserved, including the part of its kernel falling outside the
+ * image. Images spanning the whole of a periodic box along one axis wrap
+ * around along that axis. Particles whose kernel does not cover any pixel
+ * centre are deposited in the pixel containing them.
+ *
+ * The images are shared by all the threads and are updated atomically.
+ *
+ * @param map The images of this plane (one per field).
+ * @param plane The #image_plane.
+ * @param tab The projected kernel table.
+ * @param num_fields The number of fields.
+ * @param values The quantity to deposit for each field.
+ * @param u The position of the particle along the first image axis.
+ * @param v The position of the particle along the second image axis.
+ * @param h The smoothing length of the particle.
+ */
+static void image_maps_deposit(double *map, const struct image_plane *plane,
+                               struct projected_kernel_table *tab,
+                               const int num_fields, const double *values,
+                               const double u, const double v,
+                               const double h) {
+
+  const int nx = plane->num_pixels[0];
+  const int ny = plane->num_pixels[1];
+  const size_t npix = (size_t)nx * ny;
+  const double px = plane->width[0] / nx;
+  const double py = plane->width[1] / ny;
+  const double H = kernel_gamma * h;
+
+  /* Range of pixels covered by the kernel (possibly outside the image) */
+  const int i_min = (int)floor((u - H) / px);
+  const int i_max = (int)floor((u + H) / px);
+  const int j_min = (int)floor((v - H) / py);
+  const int j_max = (int)floor((v + H) / py);
+  if (!plane->periodic[0] && (i_max < 0 || i_min >= nx)) return;
+  if (!plane->periodic[1] && (j_max < 0 || j_min >= ny)) return;
+
+  const double h_inv = 1. / h;
+  double norm = 0.;
+
+  if (i_max - i_min < image_maps_small_footprint &&
+      j_max - j_min < image_maps_small_footprint) {
+
+    /* Poorly resolved kernel: sum the weights over the footprint */
+    for (int i = i_min; i <= i_max; ++i) {
+      for (int j = j_min; j <= j_max; ++j) {
+        const double dx = (i + 0.5) * px - u;
+        const double dy = (j + 0.5) * py - v;
+        const double r = sqrt(dx * dx + dy * dy);
+        norm += projected_kernel_eval(tab, r * h_inv);
+      }
+    }
+
+    /* The kernel misses all the pixel centres */
+    if (norm == 0.) {
+      int i = (int)floor(u / px);
+      int j = (int)floor(v / py);
+      if (plane->periodic[0]) i = image_maps_wrap(i, nx);
+      if (plane->periodic[1]) j = image_maps_wrap(j, ny);
+      if (i < 0 || j < 0 || i >= nx || j >= ny) return;
+      for (int f = 0; f < num_fields; ++f)
+        atomic_add_d(&map[f * npix + (size_t)i * ny + j], values[f]);
+      return;
+    }
+    norm = 1. / norm;
+
+  } else {
+
+    /* Well resolved kernel: the projected kernel integrates to unity */
+    norm = px * py * h_inv * h_inv;
+  }
+
+  /* Periodic axes wrap around, the others are clipped to the image */
+  const int i_start = plane->periodic[0] ? i_min : max(i_min, 0);
+  const int i_end = plane->periodic[0] ? i_max : min(i_max, nx - 1);
+  const int j_start = plane->periodic[1] ? j_min : max(j_min, 0);
+  const int j_end = plane->periodic[1] ? j_max : min(j_max, ny - 1);
+
+  for (int i = i_start; i <= i_end; ++i) {
+    const size_t ii = (size_t)image_maps_wrap(i, nx) * ny;
+    for (int j = j_start; j <= j_end; ++j) {
+      const double dx = (i + 0.5) * px - u;
+      const double dy = (j + 0.5) * py - v;
+      const double r = sqrt(dx * dx + dy * dy);
+      const double w = projected_kernel_eval(tab, r * h_inv) * norm;
+      if (w == 0.) continue;
+      const size_t pix = ii + image_maps_wrap(j, ny);
+      for (int f = 0; f < num_fields; ++f)
+        atomic_add_d(&map[f * npix + pix], w * values[f]);
+    }
+  }
+}
+
+/**
+ * @brief Project a set of particles onto the images.
+ *
+ * @param map_data The #part.
+ * @param count The number of #part.
+ * @param extra_data The #image_maps_mapper_data.
+ */
+static void image_maps_mapper(void *map_data, int count, void *extra_data) {
+
+  struct image_maps_mapper_data *data =
+      (struct image_maps_mapper_data *)extra_data;
+  const struct engine *e = data->e;
+  const struct image_maps_props *props = data->props;
+  const struct space *s = e->s;
+  const struct part *parts = (const struct part *)map_data;
+  const struct xpart *xparts = s->xparts + (parts - s->parts);
+  const int periodic = s->periodic;
+  const double *dim = s->dim;
+
+  /* The kernel table is only read */
+  struct projected_kernel_table *tab =
+      (struct projected_kernel_table *)&props->kernel_table;
+
+  for (int k = 0; k < count; ++k) {
+
+    const struct part *p = &parts[k];
+
+    /* Skip the particles that do not exist */
+    if (p->time_bin == time_bin_inhibited ||
+        p->time_bin == time_bin_not_created)
+      continue;
+
+    /* Values to deposit, only computed once the particle is in a slab */
+    double values[image_map_field_count];
+    int have_values = 0;
+
+    for (int n = 0; n < props->num_planes; ++n) {
+
+      const struct image_plane *plane = &props->planes[n];
+
+      double dx[3];
+      for (int a = 0; a < 3; ++a) {
+        dx[a] = p->x[a] - plane->centre[a];
+        if (periodic) dx[a] = nearest(dx[a], dim[a]);
+      }
+
+      /* Is the particle in the slab? */
+      if (fabs(dx[plane->axis]) > 0.5 * plane->depth) continue;
+
+      if (!have_values) {
+        const double mass = hydro_get_mass(p);
+        for (int f = 0; f < props->num_fields; ++f)
+          values[f] =
+              mass * image_maps_get_value(props->fields[f], e, p, &xparts[k]);
+        have_values = 1;
+      }
+
+      image_maps_deposit(data->images + data->offsets[n], plane, tab,
+                         props->num_fields, values,
+                         dx[plane->xaxis] + 0.5 * plane->width[0],
+                         dx[plane->yaxis] + 0.5 * plane->width[1], p->h);
+    }
+  }
+}
+
+/**
+ * @brief Write the reduced images to a new HDF5 file.
+ *
+ * @param e The #engine.
+ * @param props The image maps properties.
+ * @param maps The summed images of all the planes.
+ * @param offsets The offset of each plane in the images.
+ */
+static void image_maps_write_file(const struct engine *e,
+                                  const struct image_maps_props *props,
+                                  const double *maps, const size_t *offsets) {
+
+  char fileName[FILENAME_BUFFER_SIZE];
+  check_snprintf(fileName, FILENAME_BUFFER_SIZE, "%s_%04i.hdf5",
+                 props->basename, e->image_maps_output_count);
+  if (e->verbose) message("Creating image maps file: %s", fileName);
+
+  const hid_t h_file =
+      H5Fcreate(fileName, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  if (h_file < 0) error("Error while opening file '%s'.", fileName);
+
+  /* Conversion factors to snapshot units */
+  const struct unit_system *internal_units = e->internal_units;
+  const struct unit_system *snapshot_units = e->snapshot_units;
+  const double factor_time =
+      units_conversion_factor(internal_units, snapshot_units, UNIT_CONV_TIME);
+  const double factor_length = units_conversion_factor(
+      internal_units, snapshot_units, UNIT_CONV_LENGTH);
+  const double factor_mass =
+      units_conversion_factor(internal_units, snapshot_units, UNIT_CONV_MASS);
+  const double factor_temp = units_conversion_factor(
+      internal_units, snapshot_units, UNIT_CONV_TEMPERATURE);
+
+  /* Write the header */
+  hid_t h_grp =
+      H5Gcreate(h_file, "/Header", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  if (h_grp < 0) error("Error while creating file header");
+
+  const double dim[3] = {e->s->dim[0] * factor_length,
+                         e->s->dim[1] * factor_length,
+                         e->s->dim[2] * factor_length};
+  io_write_attribute(h_grp, "BoxSize", DOUBLE, dim, 3);
+  io_write_attribute_d(h_grp, "Time", e->time * factor_time);
+  io_write_attribute_d(h_grp, "Redshift", e->cosmology->z);
+  io_write_attribute_d(h_grp, "Scale-factor", e->cosmology->a);
+  io_write_attribute_s(h_grp, "Code", "SWIFT");
+  io_write_attribute_s(h_grp, "RunName", e->run_name);
+  io_write_attribute_i(h_grp, "NumPlanes", props->num_planes);
+  io_write_attribute_s(h_grp, "OutputType", "ImageMaps");
+  H5Gclose(h_grp);
+
+  io_write_unit_system(h_file, snapshot_units, "Units");
+
+  for (int n = 0; n < props->num_planes; ++n) {
+
+    const struct image_plane *plane = &props->planes[n];
+    const int nx = plane->num_pixels[0];
+    const int ny = plane->num_pixels[1];
+    const size_t npix = (size_t)nx * ny;
+    const double pixel_area = plane->width[0] * plane->width[1] / npix;
+    const double *map = maps + offsets[n];
+
+    char groupName[32];
+    sprintf(groupName, "/Plane_%04i", n);
+    h_grp = H5Gcreate(h_file, groupName, H5P_DEFAULT, H5P_DEFAULT,
+                      H5P_DEFAULT);
+    if (h_grp < 0) error("Error while creating image plane group");
+
+    const int axes[2] = {plane->xaxis, plane->yaxis};
+    const double centre[3] = {plane->centre[0] * factor_length,
+                              plane->centre[1] * factor_length,
+                              plane->centre[2] * factor_length};
+    const double width[2] = {plane->width[0] * factor_length,
+                             plane->width[1] * factor_length};
+    io_write_attribute_i(h_grp, "ProjectionAxis", plane->axis);
+    io_write_attribute(h_grp, "ImageAxes", INT, axes, 2);
+    io_write_attribute(h_grp, "Centre", DOUBLE, centre, 3);
+    io_write_attribute(h_grp, "Width", DOUBLE, width, 2);
+    io_write_attribute_d(h_grp, "Depth", plane->depth * factor_length);
+    io_write_attribute(h_grp, "NumPixels", INT, plane->num_pixels, 2);
+
+    float *image = (float *)malloc(npix * sizeof(float));
+    if (image == NULL) error("Unable to allocate memory for an image");
+
+    /* The first map is always the projected mass */
+    const double *mass = map;
+
+    for (int f = 0; f < props->num_fields; ++f) {
+
+      const enum image_map_field field = props->fields[f];
+      const double *values = map + f * npix;
+
+      if (field == image_map_surface_density) {
+        const double factor =
+            factor_mass / (factor_length * factor_length * pixel_area);
+        for (size_t k = 0; k < npix; ++k) image[k] = values[k] * factor;
+      } else {
+        const double factor =
+            (field == image_map_temperature) ? factor_temp : 1.;
+        for (size_t k = 0; k < npix; ++k)
+          image[k] = mass[k] > 0. ? values[k] / mass[k] * factor : 0.f;
+      }
+
+      io_write_array(h_grp, nx, ny, image, FLOAT, image_map_field_names[field],
+                     "image map");
+    }
+
+    free(image);
+    H5Gclose(h_grp);
+  }
+
+  H5Fclose(h_file);
+}
+
+/**
+ * @brief Project the particles of a freshly drifted top-level cell.
+ *
+ * @param c The #cell.
+ * @param extra_data The #image_maps_mapper_data.
+ */
+static void image_maps_project_cell(struct cell *c, void *extra_data) {
+
+  if (c->hydro.count > 0)
+    image_maps_mapper(c->hydro.parts, c->hydro.count, extra_data);
+}
+
+/**
+ * @brief Could a top-level cell hold particles lying in one of the slabs?
+ *
+ * The particles of a top-level cell never stray further than one cell
+ * width from it before a rebuild is triggered, so we add this margin to
+ * the extent of the cell.
+ *
+ * @param props The image maps properties.
+ * @param s The #space.
+ * @param c The top-level #cell.
+ */
+static int image_maps_cell_in_slabs(const struct image_maps_props *props,
+                                    const struct space *s,
+                                    const struct cell *c) {
+
+  for (int n = 0; n < props->num_planes; ++n) {
+
+    const struct image_plane *plane = &props->planes[n];
+    const int axis = plane->axis;
+
+    double dx = c->loc[axis] + 0.5 * c->width[axis] - plane->centre[axis];
+    if (s->periodic) dx = nearest(dx, s->dim[axis]);
+
+    if (fabs(dx) <= 0.5 * plane->depth + 1.5 * c->width[axis]) return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Project the gas onto all the image planes and write the images.
+ *
+ * All the threads deposit the particles they process into a single set of
+ * images. These are then summed over the MPI ranks before rank 0 writes
+ * them. The surface density maps are in units of
+ * mass per unit area (co-moving) and the other maps are mass-weighted
+ * averages of the corresponding particle quantity.
+ *
+ * @param e The #engine.
+ */
+void image_maps_write(struct engine *e) {
+
+  const ticks tic = getticks();
+  const struct image_maps_props *props = e->image_maps;
+
+  struct image_maps_mapper_data data;
+  data.e = e;
+  data.props = props;
+
+  /* Lay out the images of all the planes one after the other */
+  size_t size = 0;
+  for (int n = 0; n < props->num_planes; ++n) {
+    data.offsets[n] = size;
+    size += (size_t)props->num_fields * props->planes[n].num_pixels[0] *
+            props->planes[n].num_pixels[1];
+  }
+
+  if (swift_memalign("image_maps", (void **)&data.images,
+                     SWIFT_STRUCT_ALIGNMENT, size * sizeof(double)) != 0)
+    error("Unable to allocate memory for the image maps");
+  bzero(data.images, size * sizeof(double));
+
+  /* Collect the cells that can contribute to the images */
+  const struct space *s = e->s;
+  int *cell_ids = NULL;
+  int num_cells = 0;
+  if (s->nr_local_cells_with_particles > 0) {
+    cell_ids = (int *)malloc(s->nr_local_cells_with_particles * sizeof(int));
+    if (cell_ids == NULL)
+      error("Unable to allocate the list of cells for the image maps");
+  }
+  for (int k = 0; k < s->nr_local_cells_with_particles; ++k) {
+    const int cid = s->local_cells_with_particles_top[k];
+    if (image_maps_cell_in_slabs(props, s, &s->cells_top[cid]))
+      cell_ids[num_cells++] = cid;
+  }
+
+  /* Drift the gas of these cells only and project it in the same pass */
+  engine_drift_cells(e, cell_ids, num_cells, engine_drift_part,
+                     image_maps_project_cell, &data);
+  free(cell_ids);
+
+#ifdef WITH_MPI
+  /* Sum the images of all the ranks, in pieces small enough for the int
+   * counts of MPI */
+  for (size_t offset = 0; offset < size; offset += INT_MAX) {
+    double *chunk = data.images + offset;
+    const int count = (int)min(size - offset, (size_t)INT_MAX);
+    if (MPI_Reduce(e->nodeID == 0 ? MPI_IN_PLACE : chunk, chunk, count,
+                   MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD) != MPI_SUCCESS)
+      error("Failed to reduce the image maps.");
+  }
+#endif
+
+  if (e->nodeID == 0)
+    image_maps_write_file(e, props, data.images, data.offsets);
+
+  swift_free("image_maps", data.images);
+
+  /* Up the image counter. */
+  e->image_maps_output_count++;
+
+  if (e->verbose)
+    message("took %.3f %s.", clocks_from_ticks(getticks() - tic),
+            clocks_getunit());
+}
+
+/**
+ * @brief Free the memory used by the image maps.
+ *
+ * @param props The image maps properties.
+ */
+void image_maps_clean(struct image_maps_props *props) {
+  projected_kernel_clean(&props->kernel_table);
+}
+
+/**
+ * @brief Write an image_maps_props struct to the given FILE as a stream of
+ * bytes.
+ *
+ * @param props the struct
+ * @param stream the file stream
+ */
+void image_maps_struct_dump(const struct image_maps_props *props,
+                            FILE *stream) {
+  restart_write_blocks((void *)props, sizeof(struct image_maps_props), 1,
+                       stream, "imagemaps", "image maps params");
+}
+
+/**
+ * @brief Restore an image_maps_props struct from the given FILE as a stream
+ * of bytes.
+ *
+ * The kernel table is re-computed.
+ *
+ * @param props the struct
+ * @param stream the file stream
+ */
+void image_maps_struct_restore(struct image_maps_props *props, FILE *stream) {
+  restart_read_blocks((void *)props, sizeof(struct image_maps_props), 1,
+                      stream, NULL, "image maps params");
+  projected_kernel_init(&props->kernel_table);
+}
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#ifndef SWIFT_IMAGE_MAPS_H
+#define SWIFT_IMAGE_MAPS_H
+
+/* Config parameters. */
+#include <config.h>
+
+/* Standard headers */
+#include <stdio.h>
+
+/* Local headers */
+#include "lightcone/projected_kernel.h"
+#include "parser.h"
+
+/* Avoid cyclic inclusions */
+struct engine;
+
+/*! Maximal number of image planes */
+#define IMAGE_MAPS_MAX_PLANES 16
+
+/**
+ * @brief The quantities that can be projected onto the image planes.
+ */
+enum image_map_field {
+  image_map_surface_density = 0,
+  image_map_temperature,
+  image_map_material_id,
+  image_map_field_count
+};
+
+/**
+ * @brief A Cartesian image plane.
+ *
+ * The image covers a slab of the simulation volume centred on a given point
+ * and the particles in the slab are projected along one of the simulation
+ * axes.
+ */
+struct image_plane {
+
+  /*! Simulation axis along which we project */
+  int axis;
+
+  /*! Simulation axes mapped onto the two axes of the image */
+  int xaxis, yaxis;
+
+  /*! Centre of the slab */
+  double centre[3];
+
+  /*! Extent of the image along its two axes */
+  double width[2];
+
+  /*! Thickness of the slab along the projection axis */
+  double depth;
+
+  /*! Number of pixels along the two axes of the image */
+  int num_pixels[2];
+
+  /*! Does the image wrap around along its two axes? */
+  int periodic[2];
+};
+
+/**
+ * @brief Properties of the on-the-fly image maps.
+ */
+struct image_maps_props {
+
+  /*! Number of image planes */
+  int num_planes;
+
+  /*! The image planes */
+  struct image_plane planes[IMAGE_MAPS_MAX_PLANES];
+
+  /*! Number of fields to project */
+  int num_fields;
+
+  /*! The fields to project */
+  enum image_map_field fields[image_map_field_count];
+
+  /*! Base name for the image files */
+  char basename[PARSER_MAX_LINE_SIZE];
+
+  /*! Tabulated projected SPH kernel */
+  struct projected_kernel_table kernel_table;
+};
+
+void image_maps_init(struct image_maps_props *props, const struct engine *e,
+                     struct swift_params *params);
+void image_maps_write(struct engine *e);
+void image_maps_clean(struct image_maps_props *props);
+void image_maps_struct_dump(const struct image_maps_props *props,
+                            FILE *stream);
+void image_maps_struct_restore(struct image_maps_props *props, FILE *stream);
+
+#endif /* SWIFT_IMAGE_MAPS_H */
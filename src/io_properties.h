@@ -138,6 +138,10 @@ struct io_props {
   /* The size of the particles */
   size_t partSize;
 
+  /* Indices of the particles to write in the arrays (NULL to write them
+   * all in order) */
+  const size_t *index;
+
   /* The particle arrays */
   const struct part *parts;
   const struct xpart *xparts;
@@ -1227,4 +1231,30 @@ INLINE static struct io_props io_make_output_field_convert_sink_LONGLONG(
   return r;
 }
 
+/**
+ * @brief Moves the #io_props forward by a number of particles.
+ *
+ * Used to process an array in consecutive chunks. When a list of indices
+ * is attached, the particles are read through it, so only the list is
+ * advanced and the particle arrays are left untouched.
+ *
+ * @param props The #io_props to move forward.
+ * @param n The number of particles to skip.
+ */
+INLINE static void io_props_skip(struct io_props *props, const size_t n) {
+
+  if (props->index != NULL) {
+    props->index += n;
+    return;
+  }
+
+  props->field += n * props->partSize; /* char* on the field */
+  props->parts += n;                   /* part* on the part */
+  props->xparts += n;                  /* xpart* on the xpart */
+  props->gparts += n;                  /* gpart* on the gpart */
+  props->sparts += n;                  /* spart* on the spart */
+  props->bparts += n;                  /* bpart* on the bpart */
+  props->sinks += n;                   /* sink* on the sink */
+}
+
 #endif /* SWIFT_IO_PROPERTIES_H */
@@ -26,6 +26,8 @@
 #include "const.h"
 #include "exp.h"
 #include "inline.h"
+#include "minmax.h"
+#include "vector.h"
 
 /* Standard headers */
 #include <float.h>
@@ -33,7 +35,27 @@
 
 #define GADGET2_LONG_RANGE_CORRECTION
 
+/* Uncomment this to use the piecewise polynomial tables of the truncation
+ * functions in the P-P interactions instead of the direct evaluation.
+ * The accuracy is set by GRAVITY_LONG_RANGE_TABLE_IVALS (16 or 32). When
+ * SWIFT is compiled with vectorization, kernel_long_grav_eval_vec()
+ * evaluates the tables for a whole vector of distances at once. */
+// #define GRAVITY_USE_TABULATED_LONG_RANGE
+
+#if defined(GRAVITY_USE_TABULATED_LONG_RANGE) && \
+    !defined(GADGET2_LONG_RANGE_CORRECTION)
+#error "The tabulated long-range truncation only exists for the Gadget one"
+#endif
+
 #ifdef GADGET2_LONG_RANGE_CORRECTION
+#include "kernel_long_gravity_table.h"
+#endif
+
+#if defined(GADGET2_LONG_RANGE_CORRECTION) && \
+    defined(GRAVITY_USE_TABULATED_LONG_RANGE)
+#define kernel_long_gravity_truncation_name \
+  "Gadget-like (using tabulated erfc())"
+#elif defined(GADGET2_LONG_RANGE_CORRECTION)
 #define kernel_long_gravity_truncation_name "Gadget-like (using erfc())"
 #else
 #define kernel_long_gravity_truncation_name "Exp-based Sigmoid"
@@ -186,6 +208,129 @@ kernel_long_grav_derivatives(const float r, const float r_s_inv,
 #endif
 }
 
+#ifdef GADGET2_LONG_RANGE_CORRECTION
+
+/**
+ * @brief Computes the long-range correction terms for the potential and
+ * force calculations due to the mesh truncation using the piecewise
+ * polynomial tables.
+ *
+ * See kernel_long_gravity_table.h for the accuracy of the tables.
+ *
+ * @param r_over_r_s The ratio of the distance to the FFT cell scale \f$u =
+ * r/r_s\f$.
+ * @param corr_f (return) The correction for the force term.
+ * @param corr_pot (return) The correction for the potential term.
+ */
+__attribute__((always_inline, nonnull)) INLINE static void
+kernel_long_grav_eval_tabulated(const float r_over_r_s,
+                                float *restrict corr_f,
+                                float *restrict corr_pot) {
+
+  /* Position in the table, the end of the last interval being used beyond
+   * the end. The result is masked out there anyway */
+  const float x = min(r_over_r_s * (kernel_long_grav_ivals /
+                                    kernel_long_grav_x_max),
+                      (float)kernel_long_grav_ivals * (1.f - FLT_EPSILON));
+  const int ind = (int)x;
+  const float t = x - (float)ind;
+
+  const float *const c_pot =
+      &kernel_long_grav_pot_coeffs[ind * (kernel_long_grav_degree + 1)];
+  const float *const c_f =
+      &kernel_long_grav_force_coeffs[ind * (kernel_long_grav_degree + 1)];
+
+  /* Horner's scheme */
+  float w_pot = c_pot[0];
+  float w_f = c_f[0];
+  for (int k = 1; k <= kernel_long_grav_degree; k++) {
+    w_pot = w_pot * t + c_pot[k];
+    w_f = w_f * t + c_f[k];
+  }
+
+  /* Beyond the table, the truncation is complete */
+  const float in_range = r_over_r_s < kernel_long_grav_x_max ? 1.f : 0.f;
+
+  *corr_pot = w_pot * in_range;
+  *corr_f = w_f * in_range;
+}
+
+#ifdef WITH_VECTORIZATION
+
+/**
+ * @brief Computes the long-range correction terms for the potential and
+ * force calculations due to the mesh truncation using the piecewise
+ * polynomial tables (Vectorised version).
+ *
+ * @param r_over_r_s The ratio of the distance to the FFT cell scale \f$u =
+ * r/r_s\f$.
+ * @param corr_f (return) The correction for the force term.
+ * @param corr_pot (return) The correction for the potential term.
+ */
+__attribute__((always_inline, nonnull)) INLINE static void
+kernel_long_grav_eval_vec(const vector *r_over_r_s, vector *corr_f,
+                          vector *corr_pot) {
+
+  /* Position in the table */
+  vector x;
+  x.v = vec_fmin(
+      vec_mul(r_over_r_s->v,
+              vec_set1(kernel_long_grav_ivals / kernel_long_grav_x_max)),
+      vec_set1((float)kernel_long_grav_ivals * (1.f - FLT_EPSILON)));
+
+  /* Get the interval id and the position within it */
+  const vector x_floor = {.v = vec_floor(x.v)};
+  vector t;
+  t.v = vec_sub(x.v, x_floor.v);
+
+  /* Load the coefficients */
+  vector c_pot[kernel_long_grav_degree + 1];
+  vector c_f[kernel_long_grav_degree + 1];
+
+#ifdef vec_gather
+
+  /* Byte offset of the start of each interval's coefficients */
+  vector offsets;
+  offsets.m = vec_ftoi(vec_mul(
+      x_floor.v, vec_set1(sizeof(float) * (kernel_long_grav_degree + 1))));
+
+  for (int j = 0; j < kernel_long_grav_degree + 1; j++) {
+    c_pot[j].v = vec_gather(&kernel_long_grav_pot_coeffs[j], offsets);
+    c_f[j].v = vec_gather(&kernel_long_grav_force_coeffs[j], offsets);
+  }
+#else
+
+  vector ind;
+  ind.m = vec_ftoi(x_floor.v);
+
+  for (int k = 0; k < VEC_SIZE; k++) {
+    const int offset = ind.i[k] * (kernel_long_grav_degree + 1);
+    for (int j = 0; j < kernel_long_grav_degree + 1; j++) {
+      c_pot[j].f[k] = kernel_long_grav_pot_coeffs[offset + j];
+      c_f[j].f[k] = kernel_long_grav_force_coeffs[offset + j];
+    }
+  }
+#endif
+
+  /* Horner's scheme */
+  corr_pot->v = c_pot[0].v;
+  corr_f->v = c_f[0].v;
+  for (int j = 1; j <= kernel_long_grav_degree; j++) {
+    corr_pot->v = vec_fma(corr_pot->v, t.v, c_pot[j].v);
+    corr_f->v = vec_fma(corr_f->v, t.v, c_f[j].v);
+  }
+
+  /* Beyond the table, the truncation is complete */
+  mask_t in_range;
+  vec_create_mask(in_range, vec_cmp_lt(r_over_r_s->v,
+                                       vec_set1(kernel_long_grav_x_max)));
+  corr_pot->v = vec_and_mask(corr_pot->v, in_range);
+  corr_f->v = vec_and_mask(corr_f->v, in_range);
+}
+
+#endif /* WITH_VECTORIZATION */
+#endif /* GADGET2_LONG_RANGE_CORRECTION */
+
 /**
  * @brief Computes the long-range correction terms for the potential and
  * force calculations due to the mesh truncation.
@@ -204,7 +349,11 @@ __attribute__((always_inline, nonnull)) INLINE static void
 kernel_long_grav_eval(const float r_over_r_s, float *restrict corr_f,
                       float *restrict corr_pot) {
 
-#ifdef GADGET2_LONG_RANGE_CORRECTION
+#if defined(GRAVITY_USE_TABULATED_LONG_RANGE)
+
+  kernel_long_grav_eval_tabulated(r_over_r_s, corr_f, corr_pot);
+
+#elif defined(GADGET2_LONG_RANGE_CORRECTION)
 
   const float two_over_sqrt_pi = ((float)M_2_SQRTPI);
 
@@ -0,0 +1,368 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#ifndef SWIFT_KERNEL_LONG_GRAVITY_TABLE_H
+#define SWIFT_KERNEL_LONG_GRAVITY_TABLE_H
+
+/**
+ * @file kernel_long_gravity_table.h
+ * @brief Piecewise polynomial tables of the Gadget-like long-range truncation
+ * functions.
+ *
+ * The potential term erfc(u) and the force term erfc(u) + 2u exp(-u^2)/sqrt(pi)
+ * (with u = r / 2r_s) are tabulated over 0 < r/r_s < 10 using polynomials of
+ * degree 5 in the position within each interval. The coefficients were
+ * obtained by interpolating the exact functions at the Chebyshev nodes of each
+ * interval and are stored highest power first, ready for Horner's scheme.
+ *
+ * The accuracy is controlled by the number of intervals
+ * (GRAVITY_LONG_RANGE_TABLE_IVALS):
+ *  - 16 intervals: relative error < 3.5e-6 (pot.) and 1.1e-6 (force),
+ *  - 32 intervals: relative error < 1.2e-7 (pot.) and 1.1e-7 (force),
+ * over 0 < r/r_s < 5. The absolute error is below 1.5e-7 everywhere.
+ */
+
+/* Config parameters. */
+#include <config.h>
+
+#ifndef GRAVITY_LONG_RANGE_TABLE_IVALS
+#define GRAVITY_LONG_RANGE_TABLE_IVALS 16
+#endif
+
+/*! Number of intervals in the table */
+#define kernel_long_grav_ivals GRAVITY_LONG_RANGE_TABLE_IVALS
+
+/*! Degree of the polynomial in each interval */
+#define kernel_long_grav_degree 5
+
+/*! Value of r/r_s beyond which the truncation functions are set to 0 */
+#define kernel_long_grav_x_max 10.f
+
+#if GRAVITY_LONG_RANGE_TABLE_IVALS == 16
+
+static const float kernel_long_grav_pot_coeffs
+    [kernel_long_grav_ivals * (kernel_long_grav_degree + 1)]
+    __attribute__((aligned(16))) = {
+        /* 0 < r/r_s < 0.625 */
+        -2.93948513e-04f, -6.25812681e-05f, 1.15144746e-02f,
+        -8.87024999e-06f, -3.52617711e-01f, 1.00000000e+00f,
+        /* 0.625 < r/r_s < 1.25 */
+        -5.03694500e-05f, -1.58441777e-03f, 8.45978130e-03f,
+        3.12121809e-02f, -3.19809437e-01f, 6.58531368e-01f,
+        /* 1.25 < r/r_s < 1.875 */
+        1.70506741e-04f, -1.77248032e-03f, 1.74288044e-03f,
+        4.65903394e-02f, -2.38592759e-01f, 3.76759112e-01f,
+        /* 1.875 < r/r_s < 2.5 */
+        1.89613973e-04f, -8.38836248e-04f, -3.62863601e-03f,
+        4.29006815e-02f, -1.46420553e-01f, 1.84897602e-01f,
+        /* 2.5 < r/r_s < 3.125 */
+        7.91972343e-05f, 1.27855485e-04f, -5.14854398e-03f,
+        2.88805719e-02f, -7.39135668e-02f, 7.70998821e-02f,
+        /* 3.125 < r/r_s < 3.75 */
+        -1.36854869e-05f, 4.97905305e-04f, -3.89833841e-03f,
+        1.49903819e-02f, -3.06917075e-02f, 2.71253921e-02f,
+        /* 3.75 < r/r_s < 4.375 */
+        -3.87407090e-05f, 4.05877276e-04f, -2.05909042e-03f,
+        6.14258461e-03f, -1.04830824e-02f, 8.00994225e-03f,
+        /* 4.375 < r/r_s < 5 */
+        -2.66463576e-05f, 2.05837743e-04f, -8.16730724e-04f,
+        2.01225793e-03f, -2.94525758e-03f, 1.97748980e-03f,
+        /* 5 < r/r_s < 5.625 */
+        -1.14307923e-05f, 7.49660176e-05f, -2.51154037e-04f,
+        5.30959223e-04f, -6.80641620e-04f, 4.06951003e-04f,
+        /* 5.625 < r/r_s < 6.25 */
+        -3.51289691e-06f, 2.06545519e-05f, -6.09051203e-05f,
+        1.13389920e-04f, -1.29380409e-04f, 6.96503412e-05f,
+        /* 6.25 < r/r_s < 6.875 */
+        -8.14411806e-07f, 4.41702878e-06f, -1.17677209e-05f,
+        1.96628716e-05f, -2.02286556e-05f, 9.89661748e-06f,
+        /* 6.875 < r/r_s < 7.5 */
+        -1.46176518e-07f, 7.44178124e-07f, -1.82387839e-06f,
+        2.77518507e-06f, -2.60140109e-06f, 1.16580065e-06f,
+        /* 7.5 < r/r_s < 8.125 */
+        -2.06245634e-08f, 9.97255896e-08f, -2.27832558e-07f,
+        3.19342575e-07f, -2.75158413e-07f, 1.13723260e-07f,
+        /* 8.125 < r/r_s < 8.75 */
+        -2.31022201e-09f, 1.06997087e-08f, -2.30170265e-08f,
+        2.99991747e-08f, -2.39379450e-08f, 9.17842335e-09f,
+        /* 8.75 < r/r_s < 9.375 */
+        -2.06849343e-10f, 9.23492949e-10f, -1.88550575e-09f,
+        2.30298736e-09f, -1.71282588e-09f, 6.12432882e-10f,
+        /* 9.375 < r/r_s < 10 */
+        -1.48779843e-11f, 6.43483183e-11f, -1.25496419e-10f,
+        1.44595697e-10f, -1.00798904e-10f, 3.37640089e-11f};
+
+static const float kernel_long_grav_force_coeffs
+    [kernel_long_grav_ivals * (kernel_long_grav_degree + 1)]
+    __attribute__((aligned(16))) = {
+        /* 0 < r/r_s < 0.625 */
+        1.09434465e-03f, 3.69821442e-04f, -2.31694076e-02f,
+        5.22940281e-05f, -4.58474369e-06f, 1.00000012e+00f,
+        /* 0.625 < r/r_s < 1.25 */
+        -2.20626665e-04f, 6.02607615e-03f, -1.14629501e-02f,
+        -5.62673360e-02f, -6.24712929e-02f, 9.78342593e-01f,
+        /* 1.25 < r/r_s < 1.875 */
+        -9.95458802e-04f, 4.39026579e-03f, 1.00005018e-02f,
+        -5.67812361e-02f, -1.86402261e-01f, 8.53946328e-01f,
+        /* 1.875 < r/r_s < 2.5 */
+        -5.02054405e-04f, -9.51210852e-04f, 1.78652871e-02f,
+        -1.04444446e-02f, -2.57374465e-01f, 6.24158084e-01f,
+        /* 2.5 < r/r_s < 3.125 */
+        2.24665971e-04f, -3.30840563e-03f, 9.44408402e-03f,
+        3.24450620e-02f, -2.30974600e-01f, 3.72751236e-01f,
+        /* 3.125 < r/r_s < 3.75 */
+        3.70806170e-04f, -1.94190885e-03f, -1.45001942e-03f,
+        4.32080254e-02f, -1.49860606e-01f, 1.80582076e-01f,
+        /* 3.75 < r/r_s < 4.375 */
+        1.48481879e-04f, -4.35567054e-05f, -5.62875718e-03f,
+        3.09210028e-02f, -7.37105459e-02f, 7.09083900e-02f,
+        /* 4.375 < r/r_s < 5 */
+        -2.29314992e-05f, 6.36653509e-04f, -4.41689044e-03f,
+        1.52494321e-02f, -2.81886011e-02f, 2.25950070e-02f,
+        /* 5 < r/r_s < 5.625 */
+        -5.37527230e-05f, 4.80814866e-04f, -2.11999915e-03f,
+        5.58349164e-03f, -8.50887690e-03f, 5.85266203e-03f,
+        /* 5.625 < r/r_s < 6.25 */
+        -3.01234759e-05f, 2.06852885e-04f, -7.21744262e-04f,
+        1.57009286e-03f, -2.04715109e-03f, 1.23433874e-03f,
+        /* 6.25 < r/r_s < 6.875 */
+        -1.03302928e-05f, 6.16249163e-05f, -1.84090954e-04f,
+        3.45503649e-04f, -3.95173935e-04f, 2.12266488e-04f,
+        /* 6.875 < r/r_s < 7.5 */
+        -2.50016024e-06f, 1.35798127e-05f, -3.61586062e-05f,
+        6.01923821e-05f, -6.14951277e-05f, 2.98005089e-05f,
+        /* 7.5 < r/r_s < 8.125 */
+        -4.50975392e-07f, 2.28530689e-06f, -5.55830502e-06f,
+        8.36717209e-06f, -7.74143336e-06f, 3.41902137e-06f,
+        /* 8.125 < r/r_s < 8.75 */
+        -6.23479508e-08f, 2.99183029e-07f, -6.75749845e-07f,
+        9.33171066e-07f, -7.90457591e-07f, 3.20835227e-07f,
+        /* 8.75 < r/r_s < 9.375 */
+        -6.71825262e-09f, 3.08348262e-08f, -6.54503083e-08f,
+        8.38411083e-08f, -6.55999841e-08f, 2.46416167e-08f,
+        /* 9.375 < r/r_s < 10 */
+        -5.70496428e-10f, 2.52251375e-09f, -5.07727993e-09f,
+        6.08712813e-09f, -4.43202630e-09f, 1.54995261e-09f};
+
+#elif GRAVITY_LONG_RANGE_TABLE_IVALS == 32
+
+static const float kernel_long_grav_pot_coeffs
+    [kernel_long_grav_ivals * (kernel_long_grav_degree + 1)]
+    __attribute__((aligned(16))) = {
+        /* 0 < r/r_s < 0.3125 */
+        -1.01685118e-05f, -5.05824516e-07f, 1.43510033e-03f,
+        -7.20696534e-08f, -1.76309243e-01f, 1.00000000e+00f,
+        /* 0.3125 < r/r_s < 0.625 */
+        -7.78673802e-06f, -5.21938819e-05f, 1.33276358e-03f,
+        4.20038821e-03f, -1.72056913e-01f, 8.25115144e-01f,
+        /* 0.625 < r/r_s < 0.9375 */
+        -3.79189419e-06f, -9.15436831e-05f, 1.04842288e-03f,
+        7.80758914e-03f, -1.59905523e-01f, 6.58531368e-01f,
+        /* 0.9375 < r/r_s < 1.25 */
+        5.92604522e-07f, -1.10399284e-04f, 6.46859349e-04f,
+        1.03656910e-02f, -1.41530156e-01f, 5.07386506e-01f,
+        /* 1.25 < r/r_s < 1.5625 */
+        4.16228022e-06f, -1.06914522e-04f, 2.13253123e-04f,
+        1.16498740e-02f, -1.19296782e-01f, 3.76759112e-01f,
+        /* 1.5625 < r/r_s < 1.875 */
+        6.14452210e-06f, -8.53929523e-05f, -1.71629043e-04f,
+        1.16898706e-02f, -9.57641006e-02f, 2.69222707e-01f,
+        /* 1.875 < r/r_s < 2.1875 */
+        6.38351685e-06f, -5.40194669e-05f, -4.51607193e-04f,
+        1.07241636e-02f, -7.32100978e-02f, 1.84897602e-01f,
+        /* 2.1875 < r/r_s < 2.5 */
+        5.25996848e-06f, -2.16808530e-05f, -6.04490051e-04f,
+        9.10911988e-03f, -5.33007607e-02f, 1.21912427e-01f,
+        /* 2.5 < r/r_s < 2.8125 */
+        3.43434158e-06f, 4.75900970e-06f, -6.39663893e-04f,
+        7.21818442e-03f, -3.69564369e-02f, 7.70998746e-02f,
+        /* 2.8125 < r/r_s < 3.125 */
+        1.55925648e-06f, 2.18419245e-05f, -5.87368326e-04f,
+        5.36207762e-03f, -2.44028736e-02f, 4.67301495e-02f,
+        /* 3.125 < r/r_s < 3.4375 */
+        8.12522600e-08f, 2.94251295e-05f, -4.85266442e-04f,
+        3.74658662e-03f, -1.53456759e-02f, 2.71253865e-02f,
+        /* 3.4375 < r/r_s < 3.75 */
+        -8.21245692e-07f, 2.95972422e-05f, -3.67280998e-04f,
+        2.46811705e-03f, -9.19020642e-03f, 1.50705362e-02f,
+        /* 3.75 < r/r_s < 4.0625 */
+        -1.18822072e-06f, 2.53041271e-05f, -2.57322245e-04f,
+        1.53561844e-03f, -5.24153654e-03f, 8.00994225e-03f,
+        /* 4.0625 < r/r_s < 4.375 */
+        -1.17697027e-06f, 1.92491116e-05f, -1.67985461e-04f,
+        9.03577951e-04f, -2.84699118e-03f, 4.07081749e-03f,
+        /* 4.375 < r/r_s < 4.6875 */
+        -9.66444759e-07f, 1.33169751e-05f, -1.02639053e-04f,
+        5.03339805e-04f, -1.47267769e-03f, 1.97749119e-03f,
+        /* 4.6875 < r/r_s < 5 */
+        -6.97875578e-07f, 8.48254876e-06f, -5.88807525e-05f,
+        2.65659706e-04f, -7.25476420e-04f, 9.17864789e-04f,
+        /* 5 < r/r_s < 5.3125 */
+        -4.55128628e-07f, 5.01327258e-06f, -3.17884042e-05f,
+        1.32936853e-04f, -3.40355618e-04f, 4.06951993e-04f,
+        /* 5.3125 < r/r_s < 5.625 */
+        -2.71994537e-07f, 2.76340575e-06f, -1.61797670e-05f,
+        6.31036601e-05f, -1.52067543e-04f, 1.72302971e-04f,
+        /* 5.625 < r/r_s < 5.9375 */
+        -1.50291655e-07f, 1.42592842e-06f, -7.77478817e-06f,
+        2.84280577e-05f, -6.47044290e-05f, 6.96507486e-05f,
+        /* 5.9375 < r/r_s < 6.25 */
+        -7.72395268e-08f, 6.90662432e-07f, -3.53101882e-06f,
+        1.21586572e-05f, -2.62195572e-05f, 2.68752265e-05f,
+        /* 6.25 < r/r_s < 6.5625 */
+        -3.70761910e-08f, 3.14669848e-07f, -1.51704467e-06f,
+        4.93863763e-06f, -1.01183696e-05f, 9.89673208e-06f,
+        /* 6.5625 < r/r_s < 6.875 */
+        -1.66741181e-08f, 1.35075510e-07f, -6.17030366e-07f,
+        1.90558774e-06f, -3.71868532e-06f, 3.47755076e-06f,
+        /* 6.875 < r/r_s < 7.1875 */
+        -7.04215886e-09f, 5.47016441e-08f, -2.37735534e-07f,
+        6.98637166e-07f, -1.30155343e-06f, 1.16582476e-06f,
+        /* 7.1875 < r/r_s < 7.5 */
+        -2.79824297e-09f, 2.09214495e-08f, -8.68138201e-08f,
+        2.43423528e-07f, -4.33838608e-07f, 3.72832744e-07f,
+        /* 7.5 < r/r_s < 7.8125 */
+        -1.04766851e-09f, 7.56373630e-09f, -3.00597307e-08f,
+        8.06190457e-08f, -1.37717123e-07f, 1.13727161e-07f,
+        /* 7.8125 < r/r_s < 8.125 */
+        -3.70037223e-10f, 2.58677124e-09f, -9.87301618e-09f,
+        2.53830379e-08f, -4.16333279e-08f, 3.30854739e-08f,
+        /* 8.125 < r/r_s < 8.4375 */
+        -1.23419719e-10f, 8.37397540e-10f, -3.07700465e-09f,
+        7.59869678e-09f, -1.19863719e-08f, 9.17891718e-09f,
+        /* 8.4375 < r/r_s < 8.75 */
+        -3.89050840e-11f, 2.56739796e-10f, -9.10220566e-10f,
+        2.16309881e-09f, -3.28645489e-09f, 2.42822162e-09f,
+        /* 8.75 < r/r_s < 9.0625 */
+        -1.15990178e-11f, 7.45841583e-11f, -2.55632848e-10f,
+        5.85600790e-10f, -8.58145277e-10f, 6.12482010e-10f,
+        /* 9.0625 < r/r_s < 9.375 */
+        -3.27261872e-12f, 2.05385535e-11f, -6.81767975e-11f,
+        1.50784413e-10f, -2.13396412e-10f, 1.47290555e-10f,
+        /* 9.375 < r/r_s < 9.6875 */
+        -8.74298409e-13f, 5.36313962e-12f, -1.72700656e-11f,
+        3.69298862e-11f, -5.05366547e-11f, 3.37679017e-11f,
+        /* 9.6875 < r/r_s < 10 */
+        -2.21266338e-13f, 1.32841091e-12f, -4.15591823e-12f,
+        8.60398471e-12f, -1.13977421e-11f, 7.37996816e-12f};
+
+static const float kernel_long_grav_force_coeffs
+    [kernel_long_grav_ivals * (kernel_long_grav_degree + 1)]
+    __attribute__((aligned(16))) = {
+        /* 0 < r/r_s < 0.3125 */
+        3.99998826e-05f, 3.02346734e-06f, -2.87136133e-03f,
+        4.30534584e-07f, -3.77961342e-08f, 1.00000000e+00f,
+        /* 0.3125 < r/r_s < 0.625 */
+        2.60639627e-05f, 2.07757563e-04f, -2.46725953e-03f,
+        -8.19483958e-03f, -8.40132684e-03f, 9.97172058e-01f,
+        /* 0.625 < r/r_s < 0.9375 */
+        4.13982070e-06f, 3.39551247e-04f, -1.38817239e-03f,
+        -1.40892230e-02f, -3.12316865e-02f, 9.78342474e-01f,
+        /* 0.9375 < r/r_s < 1.25 */
+        -1.68892693e-05f, 3.58140358e-04f, -6.62121636e-07f,
+        -1.61753353e-02f, -6.21959865e-02f, 9.31977034e-01f,
+        /* 1.25 < r/r_s < 1.5625 */
+        -2.94664496e-05f, 2.69316515e-04f, 1.25573878e-03f,
+        -1.41979950e-02f, -9.32006687e-02f, 8.53946328e-01f,
+        /* 1.5625 < r/r_s < 1.875 */
+        -3.05151625e-05f, 1.17448682e-04f, 2.03768024e-03f,
+        -9.11018997e-03f, -1.16899528e-01f, 7.48043239e-01f,
+        /* 1.875 < r/r_s < 2.1875 */
+        -2.20046441e-05f, -3.80424281e-05f, 2.20716721e-03f,
+        -2.59802397e-03f, -1.28689542e-01f, 6.24158144e-01f,
+        /* 2.1875 < r/r_s < 2.5 */
+        -9.08181482e-06f, -1.48658699e-04f, 1.84236409e-03f,
+        3.57509195e-03f, -1.27526134e-01f, 4.95017707e-01f,
+        /* 2.5 < r/r_s < 2.8125 */
+        2.80698191e-06f, -1.92763735e-04f, 1.16376800e-03f,
+        8.11959896e-03f, -1.15488768e-01f, 3.72751266e-01f,
+        /* 2.8125 < r/r_s < 3.125 */
+        1.01758033e-05f, -1.76579793e-04f, 4.25066188e-04f,
+        1.04826968e-02f, -9.65152010e-02f, 2.66355902e-01f,
+        /* 3.125 < r/r_s < 3.4375 */
+        1.22518004e-05f, -1.23741658e-04f, -1.78251925e-04f,
+        1.08004538e-02f, -7.49300271e-02f, 1.80582076e-01f,
+        /* 3.4375 < r/r_s < 3.75 */
+        1.03441416e-05f, -6.13062439e-05f, -5.51763689e-04f,
+        9.64593422e-03f, -5.42975999e-02f, 1.16162762e-01f,
+        /* 3.75 < r/r_s < 4.0625 */
+        6.58544604e-06f, -9.26685698e-06f, -6.95697847e-04f,
+        7.72629259e-03f, -3.68545726e-02f, 7.09083676e-02f,
+        /* 4.0625 < r/r_s < 4.375 */
+        2.83017312e-06f, 2.33855171e-05f, -6.69078669e-04f,
+        5.64941298e-03f, -2.34932639e-02f, 4.10817116e-02f,
+        /* 4.375 < r/r_s < 4.6875 */
+        1.18174150e-07f, 3.70232410e-05f, -5.48812503e-04f,
+        3.81071889e-03f, -1.40940119e-02f, 2.25949995e-02f,
+        /* 4.6875 < r/r_s < 5 */
+        -1.31442732e-06f, 3.71330825e-05f, -4.00380115e-04f,
+        2.38753413e-03f, -7.97034521e-03f, 1.18000349e-02f,
+        /* 5 < r/r_s < 5.3125 */
+        -1.73013734e-06f, 3.02385506e-05f, -2.65244395e-04f,
+        1.39600190e-03f, -4.25446173e-03f, 5.85266249e-03f,
+        /* 5.3125 < r/r_s < 5.625 */
+        -1.55353200e-06f, 2.14337761e-05f, -1.61496762e-04f,
+        7.64376658e-04f, -2.14588596e-03f, 2.75746663e-03f,
+        /* 5.625 < r/r_s < 5.9375 */
+        -1.15031060e-06f, 1.36314457e-05f, -9.10666568e-05f,
+        3.92948685e-04f, -1.02365087e-03f, 1.23434083e-03f,
+        /* 5.9375 < r/r_s < 6.25 */
+        -7.45370130e-07f, 7.90618287e-06f, -4.78097390e-05f,
+        1.90038001e-04f, -4.62174561e-04f, 5.25053067e-04f,
+        /* 6.25 < r/r_s < 6.5625 */
+        -4.34294606e-07f, 4.22365019e-06f, -2.34574400e-05f,
+        8.65984839e-05f, -1.97626272e-04f, 2.12267594e-04f,
+        /* 6.5625 < r/r_s < 6.875 */
+        -2.30979836e-07f, 2.09202972e-06f, -1.07866290e-05f,
+        3.72308023e-05f, -8.00761045e-05f, 8.15717285e-05f,
+        /* 6.875 < r/r_s < 7.1875 */
+        -1.13186886e-07f, 9.65216259e-07f, -4.65891981e-06f,
+        1.51173035e-05f, -3.07597693e-05f, 2.98008545e-05f,
+        /* 7.1875 < r/r_s < 7.5 */
+        -5.14258005e-08f, 4.16242671e-07f, -1.89336595e-06f,
+        5.80239657e-06f, -1.12062535e-05f, 1.03515004e-05f,
+        /* 7.5 < r/r_s < 7.8125 */
+        -2.17608545e-08f, 1.68217341e-07f, -7.25011091e-07f,
+        2.10679832e-06f, -3.87336013e-06f, 3.41909640e-06f,
+        /* 7.8125 < r/r_s < 8.125 */
+        -8.60459526e-09f, 6.38395932e-08f, -2.61889483e-07f,
+        7.24093809e-07f, -1.27057285e-06f, 1.07398046e-06f,
+        /* 8.125 < r/r_s < 8.4375 */
+        -3.18757665e-09f, 2.27888339e-08f, -8.93252121e-08f,
+        2.35699360e-07f, -3.95652449e-07f, 3.20847221e-07f,
+        /* 8.4375 < r/r_s < 8.75 */
+        -1.10853426e-09f, 7.66221131e-09f, -2.87916784e-08f,
+        7.26972047e-08f, -1.16986477e-07f, 9.11703069e-08f,
+        /* 8.75 < r/r_s < 9.0625 */
+        -3.62500918e-10f, 2.42926279e-09f, -8.77605810e-09f,
+        2.12545004e-08f, -3.28517444e-08f, 2.46430840e-08f,
+        /* 9.0625 < r/r_s < 9.375 */
+        -1.11616286e-10f, 7.26933735e-10f, -2.53123456e-09f,
+        5.89270277e-09f, -8.76326300e-09f, 6.33656283e-09f,
+        /* 9.375 < r/r_s < 9.6875 */
+        -3.23962489e-11f, 2.05478315e-10f, -6.91182112e-10f,
+        1.54969737e-09f, -2.22091989e-09f, 1.55009172e-09f,
+        /* 9.6875 < r/r_s < 10 */
+        -8.87208102e-12f, 5.49022459e-11f, -1.78763324e-10f,
+        3.86697202e-10f, -5.34844280e-10f, 3.60771163e-10f};
+
+#else
+#error "Invalid number of intervals for the long-range truncation table"
+#endif
+
+#endif /* SWIFT_KERNEL_LONG_GRAVITY_TABLE_H */
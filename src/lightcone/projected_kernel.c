@@ -95,8 +95,27 @@ double projected_kernel_integrate(double u) {
   return result;
 
 #else
-  error("Need GSL library to evaluate the projected kernel");
-  return 0.0;
+
+#ifndef HYDRO_DIMENSION_3D
+  error("projected_kernel_eval() is only defined for the 3D case.");
+#endif
+
+  /* Without GSL, use a composite Simpson rule. The kernel is smooth enough
+     for this to be far more accurate than the interpolation in the table. */
+  const int n = 1000;
+  const double qxy = u;
+  const double qz_max = sqrt(pow(kernel_gamma, 2.0) - pow(qxy, 2.0));
+  const double dqz = 2.0 * qz_max / n;
+  double result = 0.0;
+  for (int i = 0; i <= n; i += 1) {
+    const double qz = -qz_max + i * dqz;
+    const double q = sqrt(pow(qxy, 2.0) + pow(qz, 2.0));
+    double W;
+    kernel_eval_double(q, &W);
+    const double weight = (i == 0 || i == n) ? 1.0 : ((i % 2) ? 4.0 : 2.0);
+    result += weight * W;
+  }
+  return result * dqz / 3.0;
 #endif
 }
 
@@ -39,6 +39,7 @@
 #include "kernel_long_gravity.h"
 #include "mesh_gravity_mpi.h"
 #include "mesh_gravity_patch.h"
+#include "mesh_gravity_pencil.h"
 #include "neutrino.h"
 #include "part.h"
 #include "restart.h"
@@ -49,9 +50,30 @@
 
 /* Standard includes */
 #include <math.h>
+#include <unistd.h>
 
 #ifdef HAVE_FFTW
 
+/**
+ * @brief Convert the rigour of the planner to FFTW's flags.
+ *
+ * @param planner The rigour read from the parameter file (see #gravity_props).
+ */
+INLINE static unsigned pm_mesh_fftw_planner_flags(const int planner) {
+
+  switch (planner) {
+    case 0:
+      return FFTW_ESTIMATE;
+    case 1:
+      return FFTW_MEASURE;
+    case 2:
+      return FFTW_PATIENT;
+    default:
+      error("Invalid FFTW planner rigour %d", planner);
+      return FFTW_ESTIMATE;
+  }
+}
+
 /**
  * @brief Interpolate values from a the mesh using CIC.
  *
@@ -507,6 +529,8 @@ struct Green_function_data {
   double k_fac;
   int slice_offset;
   int slice_width;
+  int kz_offset;
+  int kz_width;
 };
 
 /**
@@ -533,6 +557,8 @@ void mesh_apply_Green_function_mapper(void* map_data, const int num,
 
   /* Find what slice of the full mesh is stored on this MPI rank */
   const int slice_offset = data->slice_offset;
+  const int kz_offset = data->kz_offset;
+  const int kz_width = data->kz_width;
 
   /* Range of x coordinates in the full mesh handled by this call */
   const int i_start = ((fftw_complex*)map_data - frho) + slice_offset;
@@ -555,7 +581,7 @@ void mesh_apply_Green_function_mapper(void* map_data, const int num,
       const double fy = k_fac * ky_d;
       const double sinc_ky_inv = (ky != 0) ? fy / sin(fy) : 1.;
 
-      for (int k = 0; k < N_half + 1; ++k) {
+      for (int k = kz_offset; k < kz_offset + kz_width; ++k) {
 
         /* kz component of vector in Fourier space and 1/sinc(kz) */
         const int kz = (k > N_half ? k - N : k);
@@ -583,8 +609,8 @@ void mesh_apply_Green_function_mapper(void* map_data, const int num,
         const double total_cor = green_cor * CIC_cor4;
 
         /* Apply to the mesh */
-        const int index =
-            N * (N_half + 1) * (i - slice_offset) + (N_half + 1) * j + k;
+        const int index = N * kz_width * (i - slice_offset) + kz_width * j +
+                          (k - kz_offset);
         frho[index][0] *= total_cor;
         frho[index][1] *= total_cor;
       }
@@ -604,12 +630,15 @@ void mesh_apply_Green_function_mapper(void* map_data, const int num,
  * @param slice_offset The x coordinate of the start of the slice on this MPI
  * rank
  * @param slice_width The width of the local slice on this MPI rank
+ * @param kz_offset The first kz stored on this MPI rank
+ * @param kz_width The number of kz stored on this MPI rank
  * @param N The dimension of the array.
  * @param r_s The Green function smoothing scale.
  * @param box_size The physical size of the simulation box.
  */
 void mesh_apply_Green_function(struct threadpool* tp, fftw_complex* frho,
                                const int slice_offset, const int slice_width,
+                               const int kz_offset, const int kz_width,
                                const int N, const double r_s,
                                const double box_size) {
 
@@ -622,6 +651,8 @@ void mesh_apply_Green_function(struct threadpool* tp, fftw_complex* frho,
   data.k_fac = M_PI / (double)N;
   data.slice_offset = slice_offset;
   data.slice_width = slice_width;
+  data.kz_offset = kz_offset;
+  data.kz_width = kz_width;
 
   /* Parallelize the Green function application using the threadpool
      to split the x-axis loop over the threads.
@@ -631,7 +662,8 @@ void mesh_apply_Green_function(struct threadpool* tp, fftw_complex* frho,
                  sizeof(fftw_complex), threadpool_auto_chunk_size, &data);
 
   /* Correct singularity at (0,0,0) */
-  if (slice_offset == 0 && slice_width > 0) {
+  if (slice_offset == 0 && slice_width > 0 && kz_offset == 0 &&
+      kz_width > 0) {
     frho[0][0] = 0.;
     frho[0][1] = 0.;
   }
@@ -723,7 +755,7 @@ void compute_potential_distributed(struct pm_mesh* mesh, const struct space* s,
    * patches.
    * Note: This cleans up the local_patches entries. */
   mpi_mesh_local_patches_to_slices(N, (int)local_n0, local_patches,
-                                   nr_local_cells, rho_slice, tp, verbose);
+                                   nr_local_cells, rho_slice, verbose);
   if (verbose)
     message("Assembling mesh slices took %.3f %s.",
             clocks_from_ticks(getticks() - tic), clocks_getunit());
@@ -758,7 +790,8 @@ void compute_potential_distributed(struct pm_mesh* mesh, const struct space* s,
   tic = getticks();
 
   /* Apply Green function to local slice of the MPI mesh */
-  mesh_apply_Green_function(tp, frho_slice, local_0_start, local_n0, N, r_s,
+  mesh_apply_Green_function(tp, frho_slice, local_0_start, local_n0,
+                            /*kz_offset=*/0, /*kz_width=*/N / 2 + 1, N, r_s,
                             box_size);
   if (verbose)
     message("Applying Green function took %.3f %s.",
@@ -769,6 +802,7 @@ void compute_potential_distributed(struct pm_mesh* mesh, const struct space* s,
   /* If using linear response neutrinos, apply to local slice of the MPI mesh */
   if (s->e->neutrino_properties->use_linear_response) {
     neutrino_response_compute(s, mesh, tp, frho_slice, local_0_start, local_n0,
+                              /*kz_offset=*/0, /*kz_width=*/N / 2 + 1,
                               verbose);
 
     if (verbose)
@@ -796,7 +830,7 @@ void compute_potential_distributed(struct pm_mesh* mesh, const struct space* s,
 
   /* Fetch MPI mesh entries we need on this rank from other ranks */
   mpi_mesh_fetch_potential(N, cell_fac, s, local_0_start, local_n0, rho_slice,
-                           local_patches, tp, verbose);
+                           local_patches, verbose);
 
   if (verbose)
     message("Fetching local potential took %.3f %s.",
@@ -824,6 +858,150 @@ void compute_potential_distributed(struct pm_mesh* mesh, const struct space* s,
 #endif
 }
 
+/**
+ * @brief Compute the mesh forces and potential, including periodic correction
+ *
+ * Same as compute_potential_distributed() but with the mesh decomposed in
+ * pencils rather than slabs. Each MPI rank then holds a block of lines along
+ * one of the axes and the 3D FFT is made of local 1D transforms separated by
+ * transpositions within sub-groups of ranks. This lets us use more than N
+ * ranks on an N^3 mesh.
+ *
+ * The particles mesh accelerations and potentials are also updated.
+ *
+ * @param mesh The #pm_mesh used to store the potential.
+ * @param s The #space containing the particles.
+ * @param tp The #threadpool object used for parallelisation.
+ * @param verbose Are we talkative?
+ */
+void compute_potential_distributed_pencils(struct pm_mesh* mesh,
+                                           const struct space* s,
+                                           struct threadpool* tp,
+                                           const int verbose) {
+
+#if defined(WITH_MPI) && defined(HAVE_MPI_FFTW)
+
+  const double r_s = mesh->r_s;
+  const double box_size = s->dim[0];
+  const double dim[3] = {s->dim[0], s->dim[1], s->dim[2]};
+  const int nr_local_cells = s->nr_local_cells;
+
+  if (r_s <= 0.) error("Invalid value of a_smooth");
+  if (mesh->dim[0] != dim[0] || mesh->dim[1] != dim[1] ||
+      mesh->dim[2] != dim[2])
+    error("Domain size does not match the value stored in the space.");
+
+  /* Some useful constants */
+  const int N = mesh->N;
+  const double cell_fac = N / box_size;
+
+  ticks tic = getticks();
+
+  /* Create an array of mesh patches. One per local top-level cell. */
+  struct pm_mesh_patch* local_patches = (struct pm_mesh_patch*)malloc(
+      nr_local_cells * sizeof(struct pm_mesh_patch));
+  if (local_patches == NULL)
+    error("Could not allocate array of local mesh patches!");
+  memset(local_patches, 0, nr_local_cells * sizeof(struct pm_mesh_patch));
+
+  /* Calculate contributions to density field on this MPI rank */
+  mpi_mesh_accumulate_gparts_to_local_patches(tp, N, cell_fac, s,
+                                              local_patches);
+  if (verbose)
+    message("Accumulating mass to local patches took %.3f %s.",
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+  tic = getticks();
+
+  /* Decompose the mesh and plan the transforms */
+  struct pm_mesh_pencils pencils;
+  pm_mesh_pencils_init(&pencils, N, verbose);
+  if (verbose)
+    message("Planning the FFT took %.3f %s.",
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+  tic = getticks();
+
+  /* Construct the density field pencils from the contributions stored in the
+   * local patches.
+   * Note: This cleans up the local_patches entries. */
+  mpi_mesh_local_patches_to_pencils(&pencils, local_patches, nr_local_cells,
+                                    verbose);
+  if (verbose)
+    message("Assembling mesh pencils took %.3f %s.",
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+  tic = getticks();
+
+  /* Carry out the forward Fourier transform. The output is stored as
+   * [ky][kx][kz] with the same layout as the transposed FFTW MPI output. */
+  pm_mesh_pencils_forward(&pencils);
+  if (verbose)
+    message("MPI Forward Fourier transform took %.3f %s.",
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+  tic = getticks();
+
+  /* Apply Green function to the local pencils */
+  mesh_apply_Green_function(tp, pencils.data, pencils.ky_start,
+                            pencils.ky_count, pencils.kz_start,
+                            pencils.kz_count, N, r_s, box_size);
+  if (verbose)
+    message("Applying Green function took %.3f %s.",
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+  tic = getticks();
+
+  /* If using linear response neutrinos, apply to the local pencils */
+  if (s->e->neutrino_properties->use_linear_response) {
+    neutrino_response_compute(s, mesh, tp, pencils.data, pencils.ky_start,
+                              pencils.ky_count, pencils.kz_start,
+                              pencils.kz_count, verbose);
+
+    if (verbose)
+      message("Applying neutrino response took %.3f %s.",
+              clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+    tic = getticks();
+  }
+
+  /* Carry out the reverse Fourier transform */
+  pm_mesh_pencils_inverse(&pencils);
+  if (verbose)
+    message("MPI Reverse Fourier transform took %.3f %s.",
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+  tic = getticks();
+
+  /* Fetch MPI mesh entries we need on this rank from other ranks */
+  mpi_mesh_fetch_potential_pencils(&pencils, cell_fac, s, local_patches,
+                                   verbose);
+  if (verbose)
+    message("Fetching local potential took %.3f %s.",
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+  /* Free the pencils of the potential */
+  pm_mesh_pencils_clean(&pencils);
+
+  tic = getticks();
+
+  /* Compute accelerations and potentials for the gparts */
+  mpi_mesh_update_gparts(local_patches, s, tp, N, cell_fac);
+
+  /* Clean the local patches array */
+  for (int i = 0; i < nr_local_cells; ++i)
+    pm_mesh_patch_clean(&local_patches[i]);
+  free(local_patches);
+
+  if (verbose)
+    message("Computing mesh accelerations took %.3f %s.",
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+#else
+  error("No FFTW MPI library available. Cannot compute distributed mesh.");
+#endif
+}
+
 /**
  * @brief Compute the mesh forces and potential, including periodic correction.
  *
@@ -834,15 +1012,20 @@ void compute_potential_distributed(struct pm_mesh* mesh, const struct space* s,
  * This version stores the full N*N*N mesh on each MPI rank and uses the
  * non-MPI version of FFTW.
  *
- * The particles mesh accelerations and potentials are also updated.
+ * The particles mesh accelerations and potentials are also updated, either
+ * here or later by the long-range gravity tasks.
  *
  * @param mesh The #pm_mesh used to store the potential.
  * @param s The #space containing the particles.
  * @param tp The #threadpool object used for parallelisation.
+ * @param interpolate_in_tasks Leave the interpolation onto the #gpart to the
+ * long-range gravity tasks?
  * @param verbose Are we talkative?
  */
 void compute_potential_global(struct pm_mesh* mesh, const struct space* s,
-                              struct threadpool* tp, const int verbose) {
+                              struct threadpool* tp,
+                              const int interpolate_in_tasks,
+                              const int verbose) {
 
 #ifdef HAVE_FFTW
 
@@ -874,14 +1057,25 @@ void compute_potential_global(struct pm_mesh* mesh, const struct space* s,
   memuse_log_allocation("fftw_frho", frho, 1,
                         sizeof(fftw_complex) * N * N * (N_half + 1));
 
-  /* Prepare the FFT library */
-  fftw_plan forward_plan = fftw_plan_dft_r2c_3d(
-      N, N, N, rho, frho, FFTW_ESTIMATE | FFTW_DESTROY_INPUT);
-  fftw_plan inverse_plan = fftw_plan_dft_c2r_3d(
-      N, N, N, frho, rho, FFTW_ESTIMATE | FFTW_DESTROY_INPUT);
-
   ticks tic = getticks();
 
+  /* Prepare the FFT library. The plans only depend on the size and the
+   * alignment of the arrays so they are kept for all the following steps.
+   * Note that measuring the plans overwrites the arrays. */
+  if (mesh->forward_plan == NULL) {
+
+    const unsigned flags =
+        pm_mesh_fftw_planner_flags(mesh->fftw_planner) | FFTW_DESTROY_INPUT;
+    mesh->forward_plan = fftw_plan_dft_r2c_3d(N, N, N, rho, frho, flags);
+    mesh->inverse_plan = fftw_plan_dft_c2r_3d(N, N, N, frho, rho, flags);
+
+    if (verbose)
+      message("Planning the Fourier transforms took %.3f %s.",
+              clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+    tic = getticks();
+  }
+
   /* Zero everything */
   bzero(rho, N * N * N * sizeof(double));
 
@@ -946,7 +1140,7 @@ void compute_potential_global(struct pm_mesh* mesh, const struct space* s,
   tic = getticks();
 
   /* Fourier transform to go to magic-land */
-  fftw_execute(forward_plan);
+  fftw_execute_dft_r2c(mesh->forward_plan, rho, frho);
 
   if (verbose)
     message("Forward Fourier transform took %.3f %s.",
@@ -959,6 +1153,7 @@ void compute_potential_global(struct pm_mesh* mesh, const struct space* s,
 
   /* Now de-convolve the CIC kernel and apply the Green function */
   mesh_apply_Green_function(tp, frho, /*slice_offset=*/0, /*slice_width=*/N,
+                            /*kz_offset=*/0, /*kz_width=*/N_half + 1,
                             /* mesh_size=*/N, r_s, box_size);
 
   if (verbose)
@@ -970,7 +1165,8 @@ void compute_potential_global(struct pm_mesh* mesh, const struct space* s,
   /* If using linear response neutrinos, apply the response to the mesh */
   if (s->e->neutrino_properties->use_linear_response) {
     neutrino_response_compute(s, mesh, tp, frho, /*slice_offset=*/0,
-                              /*slice_width=*/N, verbose);
+                              /*slice_width=*/N, /*kz_offset=*/0,
+                              /*kz_width=*/N_half + 1, verbose);
 
     if (verbose)
       message("Applying neutrino response took %.3f %s.",
@@ -980,7 +1176,7 @@ void compute_potential_global(struct pm_mesh* mesh, const struct space* s,
   }
 
   /* Fourier transform to come back from magic-land */
-  fftw_execute(inverse_plan);
+  fftw_execute_dft_c2r(mesh->inverse_plan, frho, rho);
 
   if (verbose)
     message("Reverse Fourier transform took %.3f %s.",
@@ -1016,6 +1212,12 @@ void compute_potential_global(struct pm_mesh* mesh, const struct space* s,
                    sizeof(struct gpart), threadpool_auto_chunk_size,
                    (void*)&data);
 
+  } else if (interpolate_in_tasks) {
+
+    /* Leave it to the long-range gravity task of each cell to read the
+     * forces from the mesh when it runs (see pm_mesh_interpolate_forces()) */
+    mesh->interpolation_pending = 1;
+
   } else { /* Normal case */
 
     /* Do a parallel CIC mesh interpolation onto the gparts but only using
@@ -1030,8 +1232,6 @@ void compute_potential_global(struct pm_mesh* mesh, const struct space* s,
             clocks_from_ticks(getticks() - tic), clocks_getunit());
 
   /* Clean-up the mess */
-  fftw_destroy_plan(forward_plan);
-  fftw_destroy_plan(inverse_plan);
   memuse_log_allocation("fftw_frho", frho, 0, 0);
   fftw_free(frho);
 
@@ -1053,17 +1253,65 @@ void compute_potential_global(struct pm_mesh* mesh, const struct space* s,
  * @param mesh The #pm_mesh used to store the potential.
  * @param s The #space containing the particles.
  * @param tp The #threadpool object used for parallelisation.
+ * @param interpolate_in_tasks Can the interpolation of the forces onto the
+ * #gpart be left to the long-range gravity tasks? Only used by the global mesh.
  * @param verbose Are we talkative?
  */
 void pm_mesh_compute_potential(struct pm_mesh* mesh, const struct space* s,
-                               struct threadpool* tp, const int verbose) {
-  if (mesh->distributed_mesh) {
+                               struct threadpool* tp,
+                               const int interpolate_in_tasks,
+                               const int verbose) {
+  if (mesh->distributed_mesh && mesh->distributed_mesh_pencils) {
+    compute_potential_distributed_pencils(mesh, s, tp, verbose);
+  } else if (mesh->distributed_mesh) {
     compute_potential_distributed(mesh, s, tp, verbose);
   } else {
-    compute_potential_global(mesh, s, tp, verbose);
+    compute_potential_global(mesh, s, tp, interpolate_in_tasks, verbose);
   }
 }
 
+/**
+ * @brief Interpolate the forces and potential from the global mesh to the
+ * #gpart of a #cell.
+ *
+ * Called by the long-range gravity task of the cell on the steps where the
+ * mesh was recomputed. The part of the mesh covered by the particles is
+ * copied once to a #pm_mesh_patch such that the CIC stencils are then read
+ * from a small block rather than from the whole periodic mesh.
+ *
+ * @param mesh The #pm_mesh containing the potential.
+ * @param c The #cell containing the #gpart to update.
+ * @param const_G Gravitional constant.
+ */
+void pm_mesh_interpolate_forces(const struct pm_mesh* mesh,
+                                const struct cell* c, const float const_G) {
+
+#ifdef HAVE_FFTW
+
+  /* Check for empty cell as this would cause problems finding the extent */
+  if (c->grav.count == 0) return;
+
+#ifdef SWIFT_DEBUG_CHECKS
+  if (mesh->distributed_mesh)
+    error("Interpolating the forces of a distributed mesh in the tasks!");
+#endif
+
+  /* Copy the potential around the particles, including the stencils */
+  struct pm_mesh_patch patch;
+  pm_mesh_patch_init(&patch, c, mesh->N, mesh->cell_fac, mesh->dim,
+                     /*boundary_size=*/2);
+  pm_mesh_patch_set_from_global_mesh(&patch, mesh->potential_global);
+
+  /* Interpolate onto the particles */
+  cell_mesh_patch_to_gpart_CIC(c, &patch, const_G);
+
+  pm_mesh_patch_clean(&patch);
+
+#else
+  error("No FFTW library found. Cannot compute periodic long-range forces.");
+#endif
+}
+
 /**
  * @brief Allocates the potential grid to be ready for an FFT calculation
  *
@@ -1131,6 +1379,82 @@ void initialise_fftw(int N, int nr_threads) {
 #endif
 }
 
+#ifdef HAVE_FFTW
+
+/**
+ * @brief Name of the file storing the FFTW wisdom of a mesh.
+ *
+ * The file lives next to the restart files and is specific to the size of
+ * the mesh and to the number of threads FFTW uses.
+ *
+ * @param mesh The #pm_mesh.
+ * @param dir The directory of the restart files.
+ * @param filename (return) The name of the file.
+ * @param size The size of the filename buffer.
+ */
+static void pm_mesh_fftw_wisdom_name(const struct pm_mesh* mesh,
+                                     const char* dir, char* filename,
+                                     const size_t size) {
+
+  const int nr_threads = mesh->N >= 64 ? mesh->nr_threads : 1;
+  const int n = snprintf(filename, size, "%s/fftw_wisdom_N%d_threads%d.txt",
+                         dir, mesh->N, nr_threads);
+  if (n < 0 || (size_t)n >= size)
+    error("FFTW wisdom file name too long for directory '%s'", dir);
+}
+
+#endif /* HAVE_FFTW */
+
+/**
+ * @brief Read the FFTW wisdom stored by a previous run, if any.
+ *
+ * Must be called after FFTW was initialised and before the plans are made
+ * such that they can be re-used instead of being measured again.
+ *
+ * @param mesh The #pm_mesh.
+ * @param dir The directory of the restart files.
+ * @param verbose Are we talkative?
+ */
+void pm_mesh_import_fftw_wisdom(const struct pm_mesh* mesh, const char* dir,
+                                const int verbose) {
+
+#ifdef HAVE_FFTW
+  if (!mesh->periodic || mesh->distributed_mesh) return;
+
+  char filename[PARSER_MAX_LINE_SIZE];
+  pm_mesh_fftw_wisdom_name(mesh, dir, filename, PARSER_MAX_LINE_SIZE);
+
+  if (access(filename, R_OK) != 0) return;
+
+  if (!fftw_import_wisdom_from_filename(filename))
+    message("WARNING: Could not read the FFTW wisdom from '%s'.", filename);
+  else if (verbose)
+    message("Read the FFTW wisdom from '%s'.", filename);
+#endif
+}
+
+/**
+ * @brief Store the FFTW wisdom gathered so far next to the restart files.
+ *
+ * @param mesh The #pm_mesh.
+ * @param dir The directory of the restart files.
+ */
+void pm_mesh_export_fftw_wisdom(const struct pm_mesh* mesh, const char* dir) {
+
+#ifdef HAVE_FFTW
+  if (!mesh->periodic || mesh->distributed_mesh) return;
+
+  /* Nothing learnt if the plans have not been made yet */
+  if (mesh->forward_plan == NULL) return;
+
+  char filename[PARSER_MAX_LINE_SIZE];
+  pm_mesh_fftw_wisdom_name(mesh, dir, filename, PARSER_MAX_LINE_SIZE);
+
+  if (!fftw_export_wisdom_to_filename(filename))
+    message("WARNING: Could not write the FFTW wisdom to '%s'.", filename);
+#endif
+}
+
 /**
  * @brief Initialises the mesh used for the long-range periodic forces
  *
@@ -1154,7 +1478,9 @@ void pm_mesh_init(struct pm_mesh* mesh, const struct gravity_props* props,
   mesh->periodic = 1;
   mesh->N = N;
   mesh->distributed_mesh = props->distributed_mesh;
+  mesh->distributed_mesh_pencils = props->distributed_mesh_pencils;
   mesh->use_local_patches = props->mesh_uses_local_patches;
+  mesh->fftw_planner = props->mesh_fftw_planner;
   mesh->dim[0] = dim[0];
   mesh->dim[1] = dim[1];
   mesh->dim[2] = dim[2];
@@ -1164,6 +1490,9 @@ void pm_mesh_init(struct pm_mesh* mesh, const struct gravity_props* props,
   mesh->r_cut_max = mesh->r_s * props->r_cut_max_ratio;
   mesh->r_cut_min = mesh->r_s * props->r_cut_min_ratio;
   mesh->potential_global = NULL;
+  mesh->interpolation_pending = 0;
+  mesh->forward_plan = NULL;
+  mesh->inverse_plan = NULL;
   mesh->ti_beg_mesh_last = -1;
   mesh->ti_end_mesh_last = -1;
   mesh->ti_beg_mesh_next = -1;
@@ -1219,6 +1548,13 @@ void pm_mesh_init_no_mesh(struct pm_mesh* mesh, double dim[3]) {
  */
 void pm_mesh_clean(struct pm_mesh* mesh) {
 
+#ifdef HAVE_FFTW
+  if (mesh->forward_plan) fftw_destroy_plan(mesh->forward_plan);
+  if (mesh->inverse_plan) fftw_destroy_plan(mesh->inverse_plan);
+  mesh->forward_plan = NULL;
+  mesh->inverse_plan = NULL;
+#endif
+
 #ifdef HAVE_THREADED_FFTW
   fftw_cleanup_threads();
 #endif
@@ -1252,11 +1588,18 @@ void pm_mesh_struct_restore(struct pm_mesh* mesh, FILE* stream) {
   restart_read_blocks((void*)mesh, sizeof(struct pm_mesh), 1, stream, NULL,
                       "gravity props");
 
+  /* The potential itself is not part of the dump */
+  mesh->interpolation_pending = 0;
+
   if (mesh->periodic) {
 
 #ifdef HAVE_FFTW
     const int N = mesh->N;
 
+    /* The plans will be re-made (or read from the wisdom) at their first use */
+    mesh->forward_plan = NULL;
+    mesh->inverse_plan = NULL;
+
     initialise_fftw(N, mesh->nr_threads);
     pm_mesh_allocate(mesh);
 
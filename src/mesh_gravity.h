@@ -26,6 +26,10 @@
 #include "gravity_properties.h"
 #include "timeline.h"
 
+#ifdef HAVE_FFTW
+#include <fftw3.h>
+#endif
+
 /* Forward declarations */
 struct engine;
 struct space;
@@ -50,10 +54,16 @@ struct pm_mesh {
   /*! Whether mesh is distributed between MPI ranks */
   int distributed_mesh;
 
+  /*! Whether the distributed mesh uses pencils rather than slabs */
+  int distributed_mesh_pencils;
+
   /*! Whether or not to use local patches rather than
    * direct atomic writes to the mesh when running without MPI */
   int use_local_patches;
 
+  /*! Rigour of the FFTW planner (see #gravity_props) */
+  int fftw_planner;
+
   /*! Integer time-step end of the mesh force for the last step */
   integertime_t ti_end_mesh_last;
 
@@ -86,18 +96,43 @@ struct pm_mesh {
 
   /*! Full N*N*N potential field */
   double *potential_global;
+
+  /*! Do the long-range gravity tasks still have to interpolate the forces
+   * from #potential_global onto the #gpart? */
+  int interpolation_pending;
+
+#ifdef HAVE_FFTW
+  /*! FFTW plans for the full N*N*N mesh, made at their first use */
+  fftw_plan forward_plan;
+  fftw_plan inverse_plan;
+#endif
 };
 
 void pm_mesh_init(struct pm_mesh *mesh, const struct gravity_props *props,
                   const double dim[3], int nr_threads);
 void pm_mesh_init_no_mesh(struct pm_mesh *mesh, double dim[3]);
 void pm_mesh_compute_potential(struct pm_mesh *mesh, const struct space *s,
-                               struct threadpool *tp, int verbose);
+                               struct threadpool *tp, int interpolate_in_tasks,
+                               int verbose);
+void pm_mesh_interpolate_forces(const struct pm_mesh *mesh,
+                                const struct cell *c, const float const_G);
 void pm_mesh_clean(struct pm_mesh *mesh);
 
+void pm_mesh_import_fftw_wisdom(const struct pm_mesh *mesh, const char *dir,
+                                const int verbose);
+void pm_mesh_export_fftw_wisdom(const struct pm_mesh *mesh, const char *dir);
+
 void pm_mesh_allocate(struct pm_mesh *mesh);
 void pm_mesh_free(struct pm_mesh *mesh);
 
+#ifdef HAVE_FFTW
+void mesh_apply_Green_function(struct threadpool *tp, fftw_complex *frho,
+                               const int slice_offset, const int slice_width,
+                               const int kz_offset, const int kz_width,
+                               const int N, const double r_s,
+                               const double box_size);
+#endif
+
 /* Dump/restore. */
 void pm_mesh_struct_dump(const struct pm_mesh *p, FILE *stream);
 void pm_mesh_struct_restore(struct pm_mesh *p, FILE *stream);
@@ -36,11 +36,9 @@
 #include "exchange_structs.h"
 #include "lock.h"
 #include "mesh_gravity_patch.h"
-#include "mesh_gravity_sort.h"
 #include "neutrino.h"
 #include "part.h"
 #include "periodic.h"
-#include "row_major_id.h"
 #include "space.h"
 #include "threadpool.h"
 
@@ -218,46 +216,163 @@ void mpi_mesh_accumulate_gparts_to_local_patches(
 #endif
 }
 
-void mesh_patches_to_sorted_array(const struct pm_mesh_patch *local_patches,
-                                  const int nr_patches,
-                                  struct mesh_key_value_rho *array,
-                                  const size_t size) {
+#if defined(WITH_MPI) && defined(HAVE_MPI_FFTW)
 
-  size_t count = 0;
-  for (int p = 0; p < nr_patches; ++p) {
-    const struct pm_mesh_patch *patch = &local_patches[p];
+/**
+ * @brief Description of the slab decomposition of the mesh used by FFTW.
+ */
+struct mesh_slabs {
+
+  /*! Number of MPI ranks */
+  int nr_nodes;
+
+  /*! First x coordinate of the slab of each rank */
+  int *slice_offset;
+
+  /*! Thickness of the slab of each rank */
+  int *slice_width;
 
-    /* Loop over all cells in the patch */
-    for (int i = 0; i < patch->mesh_size[0]; i++) {
-      for (int j = 0; j < patch->mesh_size[1]; j++) {
-        for (int k = 0; k < patch->mesh_size[2]; k++) {
+  /*! Rank holding each x coordinate */
+  int *x_owner;
+};
+
+/**
+ * @brief Gather the slab decomposition of the mesh from all the ranks.
+ *
+ * @param slabs The #mesh_slabs to fill.
+ * @param N The size of the mesh.
+ * @param local_n0 The thickness of the slab on this rank.
+ */
+static void mesh_slabs_init(struct mesh_slabs *slabs, const int N,
+                            const int local_n0) {
 
-          /* Find array index in the mesh patch */
-          const int local_index = pm_mesh_patch_index(patch, i, j, k);
+  MPI_Comm_size(MPI_COMM_WORLD, &slabs->nr_nodes);
+  const int nr_nodes = slabs->nr_nodes;
 
-          /* Find index in the full mesh */
-          const size_t global_index = row_major_id_periodic_size_t_padded(
-              i + patch->mesh_min[0], j + patch->mesh_min[1],
-              k + patch->mesh_min[2], patch->N);
+  /* Get width of the slice on each rank */
+  slabs->slice_width = (int *)malloc(sizeof(int) * nr_nodes);
+  slabs->slice_offset = (int *)malloc(sizeof(int) * nr_nodes);
+  slabs->x_owner = (int *)malloc(sizeof(int) * N);
+  if (slabs->slice_width == NULL || slabs->slice_offset == NULL ||
+      slabs->x_owner == NULL)
+    error("Failed to allocate the description of the mesh slabs.");
+  MPI_Allgather(&local_n0, 1, MPI_INT, slabs->slice_width, 1, MPI_INT,
+                MPI_COMM_WORLD);
+
+  /* Determine offset to the slice on each rank */
+  slabs->slice_offset[0] = 0;
+  for (int i = 1; i < nr_nodes; i++)
+    slabs->slice_offset[i] =
+        slabs->slice_offset[i - 1] + slabs->slice_width[i - 1];
+
+  /* And the rank holding each x coordinate */
+  for (int i = 0; i < nr_nodes; i++)
+    for (int x = 0; x < slabs->slice_width[i]; x++)
+      slabs->x_owner[slabs->slice_offset[i] + x] = i;
+}
+
+/**
+ * @brief Free the memory allocated by mesh_slabs_init().
+ *
+ * @param slabs The #mesh_slabs.
+ */
+static void mesh_slabs_clean(struct mesh_slabs *slabs) {
+  free(slabs->slice_width);
+  free(slabs->slice_offset);
+  free(slabs->x_owner);
+}
+
+/**
+ * @brief Construct the fragment of a patch starting at a given x coordinate
+ * and contained in a single slab.
+ *
+ * The fragment covers the full y and z extent of the patch such that its
+ * values are contiguous in the patch.
+ *
+ * @param slabs The #mesh_slabs.
+ * @param patch The #pm_mesh_patch.
+ * @param i The first x coordinate of the fragment in the patch.
+ * @param b (return) The fragment.
+ * @return The rank holding the fragment.
+ */
+static int mesh_patch_slab_fragment(const struct mesh_slabs *slabs,
+                                    const struct pm_mesh_patch *patch,
+                                    const int i, struct pm_mesh_block *b) {
+
+  const int N = patch->N;
+
+  /* Wrapped coordinates of the first cell */
+  const int x = ((patch->mesh_min[0] + i) % N + N) % N;
+  const int y = (patch->mesh_min[1] % N + N) % N;
+  const int z = (patch->mesh_min[2] % N + N) % N;
+
+  /* Extend along x up to the end of the patch or of the slab */
+  const int owner = slabs->x_owner[x];
+  const int slab_end = slabs->slice_offset[owner] + slabs->slice_width[owner];
+
+  b->offset[0] = x;
+  b->offset[1] = y;
+  b->offset[2] = z;
+  b->size[0] = min(patch->mesh_size[0] - i, slab_end - x);
+  b->size[1] = patch->mesh_size[1];
+  b->size[2] = patch->mesh_size[2];
+  return owner;
+}
+
+/**
+ * @brief Number of mesh cells in a #pm_mesh_block.
+ */
+static size_t mesh_block_count(const struct pm_mesh_block *b) {
+  return (size_t)b->size[0] * b->size[1] * b->size[2];
+}
+
+/**
+ * @brief Add or read the values of a fragment to or from the local slab.
+ *
+ * @param N The size of the mesh.
+ * @param local_0_start The first x coordinate of the local slab.
+ * @param local_n0 The thickness of the local slab.
+ * @param slab The local slab (padded along z).
+ * @param b The fragment.
+ * @param values The values of the fragment, stored as [x][y][z].
+ * @param add Do we add the values to the slab (1) or read them (0)?
+ */
+static void mesh_slab_fragment(const int N, const int local_0_start,
+                               const int local_n0, double *slab,
+                               const struct pm_mesh_block *b, double *values,
+                               const int add) {
 
-          /* Get the value */
-          const double value = patch->mesh[local_index];
+  const size_t Nk = 2 * (N / 2 + 1);
 
-          /* Store everything in the flattened array using
-           * the global index as a key */
-          array[count].value = value;
-          array[count].key = global_index;
+  if (b->offset[0] < local_0_start ||
+      b->offset[0] + b->size[0] > local_0_start + local_n0)
+    error("Mesh fragment is not in the local slice!");
 
-          ++count;
+  size_t count = 0;
+  for (int i = 0; i < b->size[0]; ++i) {
+    const size_t x = b->offset[0] + i - local_0_start;
+    int y = b->offset[1];
+    for (int j = 0; j < b->size[1]; ++j) {
+      double *line = slab + (x * N + y) * Nk;
+      int z = b->offset[2];
+      if (add) {
+        for (int k = 0; k < b->size[2]; ++k) {
+          line[z] += values[count++];
+          if (++z == N) z = 0;
+        }
+      } else {
+        for (int k = 0; k < b->size[2]; ++k) {
+          values[count++] = line[z];
+          if (++z == N) z = 0;
         }
       }
+      if (++y == N) y = 0;
     }
   }
-
-  /* quick check... */
-  if (count != size) error("Error flattening the mesh patches!");
 }
 
+#endif /* WITH_MPI && HAVE_MPI_FFTW */
+
 /**
  * @brief Convert the array of local patches to a slab-distributed 3D mesh
  *
@@ -265,6 +380,11 @@ void mesh_patches_to_sorted_array(const struct pm_mesh_patch *local_patches,
  * This routine does the necessary communication to convert
  * the per-rank local patches into a slab-distributed mesh.
  *
+ * Each patch is cut along x into fragments that each fit in one slab.
+ * A fragment spans the whole y and z extent of the patch, so its values
+ * are a contiguous part of the patch and are sent as they are, after
+ * a #pm_mesh_block giving their position in the mesh.
+ *
  * This function will clean the memory allocated by each of the entry
  * in the local_patches array.
  *
@@ -273,13 +393,11 @@ void mesh_patches_to_sorted_array(const struct pm_mesh_patch *local_patches,
  * @param local_patches The array of local patches.
  * @param nr_patches The number of local patches.
  * @param mesh Pointer to the output data buffer.
- * @param tp The #threadpool object.
  * @param verbose Are we talkative?
  */
 void mpi_mesh_local_patches_to_slices(const int N, const int local_n0,
                                       struct pm_mesh_patch *local_patches,
                                       const int nr_patches, double *mesh,
-                                      struct threadpool *tp,
                                       const int verbose) {
 
 #if defined(WITH_MPI) && defined(HAVE_MPI_FFTW)
@@ -291,32 +409,78 @@ void mpi_mesh_local_patches_to_slices(const int N, const int local_n0,
 
   ticks tic = getticks();
 
-  /* Count the total number of mesh cells we have.
+  struct mesh_slabs slabs;
+  mesh_slabs_init(&slabs, N, local_n0);
+  const int local_0_start = slabs.slice_offset[nodeID];
+
+  /* Count the fragments and the values to send to each rank.
    *
    * Note: There might be duplicates. We don't care at this point. */
-  size_t count = 0;
-  for (int i = 0; i < nr_patches; ++i) {
-    const struct pm_mesh_patch *p = &local_patches[i];
-    count += p->mesh_size[0] * p->mesh_size[1] * p->mesh_size[2];
+  size_t *nr_send = (size_t *)calloc(2 * nr_nodes, sizeof(size_t));
+  size_t *nr_recv = (size_t *)malloc(2 * nr_nodes * sizeof(size_t));
+  if (nr_send == NULL || nr_recv == NULL)
+    error("Failed to allocate the mesh message counts.");
+  size_t *nr_send_blocks = nr_send;
+  size_t *nr_send_values = nr_send + nr_nodes;
+  size_t *nr_recv_blocks = nr_recv;
+  size_t *nr_recv_values = nr_recv + nr_nodes;
+
+  for (int p = 0; p < nr_patches; ++p) {
+    const struct pm_mesh_patch *patch = &local_patches[p];
+    if (patch->mesh == NULL) continue;
+
+    struct pm_mesh_block b;
+    for (int i = 0; i < patch->mesh_size[0]; i += b.size[0]) {
+      const int dest = mesh_patch_slab_fragment(&slabs, patch, i, &b);
+      nr_send_blocks[dest]++;
+      nr_send_values[dest] += mesh_block_count(&b);
+    }
   }
 
-  /* Create an array to contain all the individual mesh cells we have
-   * on this node. For now, this is in random order */
-  struct mesh_key_value_rho *mesh_sendbuf_unsorted;
-  if (swift_memalign("mesh_sendbuf_unsorted", (void **)&mesh_sendbuf_unsorted,
+  /* Offsets of the data for each rank in the send buffers */
+  size_t *send_offset = (size_t *)malloc(2 * nr_nodes * sizeof(size_t));
+  if (send_offset == NULL) error("Failed to allocate the mesh send offsets.");
+  size_t *blocks_offset = send_offset;
+  size_t *values_offset = send_offset + nr_nodes;
+  size_t nr_send_blocks_tot = 0, nr_send_values_tot = 0;
+  for (int i = 0; i < nr_nodes; i++) {
+    blocks_offset[i] = nr_send_blocks_tot;
+    values_offset[i] = nr_send_values_tot;
+    nr_send_blocks_tot += nr_send_blocks[i];
+    nr_send_values_tot += nr_send_values[i];
+  }
+
+  /* Allocate the send buffers */
+  struct pm_mesh_block *send_blocks;
+  double *send_values;
+  if (swift_memalign("mesh_send_blocks", (void **)&send_blocks,
+                     SWIFT_CACHE_ALIGNMENT,
+                     nr_send_blocks_tot * sizeof(struct pm_mesh_block)) != 0 ||
+      swift_memalign("mesh_send_values", (void **)&send_values,
                      SWIFT_CACHE_ALIGNMENT,
-                     count * sizeof(struct mesh_key_value_rho)) != 0)
-    error("Failed to allocate array for unsorted mesh send buffer!");
+                     nr_send_values_tot * sizeof(double)) != 0)
+    error("Failed to allocate the mesh send buffers!");
 
-  /* Make an array with the (key, value) pairs from the mesh patches.
-   *
-   * We're going to distribute them between ranks according to their
-   * x coordinate, so we later need to put them in order of destination rank. */
-  mesh_patches_to_sorted_array(local_patches, nr_patches, mesh_sendbuf_unsorted,
-                               count);
+  /* Copy the fragments to the send buffers, grouped by destination */
+  for (int p = 0; p < nr_patches; ++p) {
+    const struct pm_mesh_patch *patch = &local_patches[p];
+    if (patch->mesh == NULL) continue;
+
+    struct pm_mesh_block b;
+    for (int i = 0; i < patch->mesh_size[0]; i += b.size[0]) {
+      const int dest = mesh_patch_slab_fragment(&slabs, patch, i, &b);
+      const size_t count = mesh_block_count(&b);
+      send_blocks[blocks_offset[dest]++] = b;
+      memcpy(send_values + values_offset[dest],
+             patch->mesh + pm_mesh_patch_index(patch, i, 0, 0),
+             count * sizeof(double));
+      values_offset[dest] += count;
+    }
+  }
+  free(send_offset);
 
   if (verbose)
-    message(" - Converting mesh patches to array took %.3f %s.",
+    message(" - Cutting mesh patches into fragments took %.3f %s.",
             clocks_from_ticks(getticks() - tic), clocks_getunit());
 
   /* Clean the local patches array */
@@ -324,111 +488,26 @@ void mpi_mesh_local_patches_to_slices(const int N, const int local_n0,
 
   tic = getticks();
 
-  /* Now, create space for a sorted version of the array of mesh cells */
-  struct mesh_key_value_rho *mesh_sendbuf;
-  if (swift_memalign("mesh_sendbuf", (void **)&mesh_sendbuf,
-                     SWIFT_CACHE_ALIGNMENT,
-                     count * sizeof(struct mesh_key_value_rho)) != 0)
-    error("Failed to allocate array for unsorted mesh send buffer!");
-
-  size_t *sorted_offsets = (size_t *)malloc(N * sizeof(size_t));
-
-  /* Do a bucket sort of the mesh elements to have them sorted
-   * by global x-coordinate (note we don't care about y,z at this stage)
-   * Also reover the offsets where we switch from one bin to the next */
-  bucket_sort_mesh_key_value_rho(mesh_sendbuf_unsorted, count, N, tp,
-                                 mesh_sendbuf, sorted_offsets);
-
-  /* Let's free the unsorted array to keep things lean */
-  swift_free("mesh_sendbuf_unsorted", mesh_sendbuf_unsorted);
-  mesh_sendbuf_unsorted = NULL;
-
-  if (verbose)
-    message(" - Sorting of mesh cells took %.3f %s.",
-            clocks_from_ticks(getticks() - tic), clocks_getunit());
-
-  tic = getticks();
-
-  /* Get width of the slice on each rank */
-  int *slice_width = (int *)malloc(sizeof(int) * nr_nodes);
-  MPI_Allgather(&local_n0, 1, MPI_INT, slice_width, 1, MPI_INT, MPI_COMM_WORLD);
-
-  /* Determine offset to the slice on each rank */
-  int *slice_offset = (int *)malloc(sizeof(int) * nr_nodes);
-  slice_offset[0] = 0;
-  for (int i = 1; i < nr_nodes; i++) {
-    slice_offset[i] = slice_offset[i - 1] + slice_width[i - 1];
-  }
-
-  /* Compute how many elements are to be sent to each rank */
-  size_t *nr_send = (size_t *)calloc(nr_nodes, sizeof(size_t));
-
-  /* Loop over the offsets */
-  int dest_node = 0;
-  for (int i = 0; i < N; ++i) {
-
-    /* Find the first mesh cell in that bucket */
-    const size_t j = sorted_offsets[i];
-
-    /* Get the x coordinate of this mesh cell in the global mesh */
-    const int mesh_x =
-        get_xcoord_from_padded_row_major_id((size_t)mesh_sendbuf[j].key, N);
-
-    /* Advance to the destination node that is to contain this x coordinate */
-    while ((mesh_x >= slice_offset[dest_node] + slice_width[dest_node]) ||
-           (slice_width[dest_node] == 0)) {
-      dest_node++;
-    }
-
-    /* Add all the mesh cells in this bucket */
-    if (i < N - 1)
-      nr_send[dest_node] += sorted_offsets[i + 1] - sorted_offsets[i];
-    else
-      nr_send[dest_node] += count - sorted_offsets[i];
-  }
-
-#ifdef SWIFT_DEBUG_CHECKS
-  size_t *nr_send_check = (size_t *)calloc(nr_nodes, sizeof(size_t));
-
-  /* Brute-force list without using the offsets */
-  int dest_node_check = 0;
-  for (size_t i = 0; i < count; i++) {
-    /* Get the x coordinate of this mesh cell in the global mesh */
-    const int mesh_x =
-        get_xcoord_from_padded_row_major_id((size_t)mesh_sendbuf[i].key, N);
-    /* Advance to the destination node that is to contain this x coordinate */
-    while ((mesh_x >=
-            slice_offset[dest_node_check] + slice_width[dest_node_check]) ||
-           (slice_width[dest_node_check] == 0)) {
-      dest_node_check++;
-    }
-    nr_send_check[dest_node_check]++;
-  }
-
-  /* Verify the "smart" list is as good as the brute-force one */
-  for (int i = 0; i < nr_nodes; ++i) {
-    if (nr_send[i] != nr_send_check[i]) error("Invalid send list!");
-  }
-  free(nr_send_check);
-#endif
-
-  /* We don't need the sorted offsets any more from here onwards */
-  free(sorted_offsets);
-
-  /* Determine how many requests we'll receive from each MPI rank */
-  size_t *nr_recv = (size_t *)malloc(sizeof(size_t) * nr_nodes);
-  MPI_Alltoall(nr_send, sizeof(size_t), MPI_BYTE, nr_recv, sizeof(size_t),
-               MPI_BYTE, MPI_COMM_WORLD);
-  size_t nr_recv_tot = 0;
+  /* Determine how much we'll receive from each MPI rank */
+  MPI_Alltoall(nr_send_blocks, sizeof(size_t), MPI_BYTE, nr_recv_blocks,
+               sizeof(size_t), MPI_BYTE, MPI_COMM_WORLD);
+  MPI_Alltoall(nr_send_values, sizeof(size_t), MPI_BYTE, nr_recv_values,
+               sizeof(size_t), MPI_BYTE, MPI_COMM_WORLD);
+  size_t nr_recv_blocks_tot = 0, nr_recv_values_tot = 0;
   for (int i = 0; i < nr_nodes; i++) {
-    nr_recv_tot += nr_recv[i];
+    nr_recv_blocks_tot += nr_recv_blocks[i];
+    nr_recv_values_tot += nr_recv_values[i];
   }
 
-  /* Allocate the receive buffer */
-  struct mesh_key_value_rho *mesh_recvbuf;
-  if (swift_memalign("mesh_recvbuf", (void **)&mesh_recvbuf,
+  /* Allocate the receive buffers */
+  struct pm_mesh_block *recv_blocks;
+  double *recv_values;
+  if (swift_memalign("mesh_recv_blocks", (void **)&recv_blocks,
                      SWIFT_CACHE_ALIGNMENT,
-                     nr_recv_tot * sizeof(struct mesh_key_value_rho)) != 0)
+                     nr_recv_blocks_tot * sizeof(struct pm_mesh_block)) != 0 ||
+      swift_memalign("mesh_recv_values", (void **)&recv_values,
+                     SWIFT_CACHE_ALIGNMENT,
+                     nr_recv_values_tot * sizeof(double)) != 0)
     error("Failed to allocate receive buffer for constructing MPI FFT mesh");
 
   if (verbose)
@@ -438,305 +517,58 @@ void mpi_mesh_local_patches_to_slices(const int N, const int local_n0,
   tic = getticks();
 
   /* Carry out the communication */
-  exchange_structs(nr_send, (char *)mesh_sendbuf, nr_recv, (char *)mesh_recvbuf,
-                   sizeof(struct mesh_key_value_rho));
+  exchange_structs(nr_send_blocks, send_blocks, nr_recv_blocks, recv_blocks,
+                   sizeof(struct pm_mesh_block));
+  exchange_structs(nr_send_values, send_values, nr_recv_values, recv_values,
+                   sizeof(double));
 
   if (verbose)
     message(" - MPI exchange took %.3f %s.",
             clocks_from_ticks(getticks() - tic), clocks_getunit());
 
-  tic = getticks();
+  swift_free("mesh_send_blocks", send_blocks);
+  swift_free("mesh_send_values", send_values);
 
-  /* Copy received data to the output buffer.
-   * This is now a local slice of the global mesh. */
-  for (size_t i = 0; i < nr_recv_tot; i++) {
-
-#ifdef SWIFT_DEBUG_CHECKS
-    /* Verify that we indeed got a cell that should be in the local mesh slice
-     */
-    const int xcoord =
-        get_xcoord_from_padded_row_major_id(mesh_recvbuf[i].key, N);
-    if (xcoord < slice_offset[nodeID])
-      error("Received mesh cell is not in the local slice (xcoord too small)");
-    if (xcoord >= slice_offset[nodeID] + slice_width[nodeID])
-      error("Received mesh cell is not in the local slice (xcoord too large)");
-#endif
-
-    /* What cell are we looking at? */
-    const size_t local_index = get_index_in_local_slice(
-        (size_t)mesh_recvbuf[i].key, N, slice_offset[nodeID]);
+  tic = getticks();
 
-    /* Add to the cell*/
-    mesh[local_index] += mesh_recvbuf[i].value;
+  /* Add the received fragments to the output buffer.
+   * This is now a local slice of the global mesh. The values arrive in the
+   * same order as the fragments. */
+  size_t count = 0;
+  for (size_t i = 0; i < nr_recv_blocks_tot; i++) {
+    mesh_slab_fragment(N, local_0_start, local_n0, mesh, &recv_blocks[i],
+                       recv_values + count, /*add=*/1);
+    count += mesh_block_count(&recv_blocks[i]);
   }
+  if (count != nr_recv_values_tot)
+    error("Received fragments and values do not match!");
 
   if (verbose)
     message(" - Filling of the density values took %.3f %s.",
             clocks_from_ticks(getticks() - tic), clocks_getunit());
 
   /* Tidy up */
-  free(slice_width);
-  free(slice_offset);
+  mesh_slabs_clean(&slabs);
   free(nr_send);
   free(nr_recv);
-  swift_free("mesh_recvbuf", mesh_recvbuf);
-  swift_free("mesh_sendbuf", mesh_sendbuf);
+  swift_free("mesh_recv_blocks", recv_blocks);
+  swift_free("mesh_recv_values", recv_values);
 #else
   error("FFTW MPI not found - unable to use distributed mesh");
 #endif
 }
 
-/**
- * @brief Count the number of mesh cells we will need to request from other
- * nodes
- *
- * @param N the mesh size.
- * @param fac Inverse of the FFT mesh cell size
- * @param s The #space containing the particles.
- */
-size_t count_required_mesh_cells(const int N, const double fac,
-                                 const struct space *s) {
-
-  const int *local_cells = s->local_cells_top;
-  const int nr_local_cells = s->nr_local_cells;
-
-  size_t count = 0;
-
-  /* Loop over our local top level cells */
-  for (int icell = 0; icell < nr_local_cells; icell++) {
-
-    struct cell *cell = &(s->cells_top[local_cells[icell]]);
-
-    /* Skip empty cells */
-    if (cell->grav.count == 0) continue;
-
-    /* Determine range of FFT mesh cells we need for particles in this top
-     * level cell. The 5 point stencil used for accelerations requires
-     * 2 neighbouring FFT mesh cells in each direction and for CIC
-     * evaluation of the accelerations we need one extra FFT mesh cell
-     * in the +ve direction.
-     *
-     * We also have to add a small buffer to avoid problems with rounding
-     *
-     * TODO: can we calculate exactly how big the rounding error can be?
-     * Will just assume that 1% of a mesh cell is enough for now.*/
-    int ixmin[3];
-    int ixmax[3];
-    for (int idim = 0; idim < 3; idim++) {
-      const double xmin = cell->loc[idim] - 2.01 / fac;
-      const double xmax = cell->loc[idim] + cell->width[idim] + 3.01 / fac;
-      ixmin[idim] = (int)floor(xmin * fac);
-      ixmax[idim] = (int)floor(xmax * fac);
-    }
-
-    const int delta_i = (ixmax[0] - ixmin[0]) + 1;
-    const int delta_j = (ixmax[1] - ixmin[1]) + 1;
-    const int delta_k = (ixmax[2] - ixmin[2]) + 1;
-
-#ifdef SWIFT_DEBUG_CHECKS
-    if (delta_i > (1 << 12))
-      error("Not enough bits to store local x-axis index");
-    if (delta_j > (1 << 12))
-      error("Not enough bits to store local y-axis index");
-    if (delta_k > (1 << 12))
-      error("Not enough bits to store local z-axis index");
-#endif
-
-    count += delta_i * delta_j * delta_k;
-  }
-  return count;
-}
-
-size_t init_required_mesh_cells(const int N, const double fac,
-                                const struct space *s,
-                                struct mesh_key_value_pot *send_cells) {
-
-  const int *local_cells = s->local_cells_top;
-  const int nr_local_cells = s->nr_local_cells;
-
-  size_t count = 0;
-
-  /* Loop over our local top level cells */
-  for (int icell = 0; icell < nr_local_cells; icell++) {
-
-    struct cell *cell = &(s->cells_top[local_cells[icell]]);
-
-    /* Skip empty cells */
-    if (cell->grav.count == 0) continue;
-
-    /* Determine range of FFT mesh cells we need for particles in this top
-       level cell. The 5 point stencil used for accelerations requires
-       2 neighbouring FFT mesh cells in each direction and for CIC
-       evaluation of the accelerations we need one extra FFT mesh cell
-       in the +ve direction.
-
-       We also have to add a small buffer to avoid problems with rounding
-
-       TODO: can we calculate exactly how big the rounding error can be?
-       Will just assume that 1% of a mesh cell is enough for now.
-    */
-    int ixmin[3];
-    int ixmax[3];
-    for (int idim = 0; idim < 3; idim++) {
-      const double xmin = cell->loc[idim] - 2.01 / fac;
-      const double xmax = cell->loc[idim] + cell->width[idim] + 3.01 / fac;
-      ixmin[idim] = (int)floor(xmin * fac);
-      ixmax[idim] = (int)floor(xmax * fac);
-    }
-
-#ifdef SWIFT_DEBUG_CHECKS
-    const int delta_i = (ixmax[0] - ixmin[0]) + 1;
-    const int delta_j = (ixmax[1] - ixmin[1]) + 1;
-    const int delta_k = (ixmax[2] - ixmin[2]) + 1;
-
-    if (delta_i > (1 << 12))
-      error("Not enough bits to store local x-axis index");
-    if (delta_j > (1 << 12))
-      error("Not enough bits to store local y-axis index");
-    if (delta_k > (1 << 12))
-      error("Not enough bits to store local z-axis index");
-#endif
-
-    /* Add the required cells to the map */
-    for (int i = ixmin[0]; i <= ixmax[0]; i++) {
-      for (int j = ixmin[1]; j <= ixmax[1]; j++) {
-        for (int k = ixmin[2]; k <= ixmax[2]; k++) {
-          const size_t index = row_major_id_periodic_size_t_padded(i, j, k, N);
-
-          /* Indices relative to the patch */
-          const int ii = i - ixmin[0];
-          const int jj = j - ixmin[1];
-          const int kk = k - ixmin[2];
-
-          /* Generate a combined index */
-          const size_t cell_index =
-              cell_index_from_patch_index(icell, ii, jj, kk);
-
-          send_cells[count].cell_index = cell_index;
-          send_cells[count].value = 0.;
-          send_cells[count].key = index;
-
-#ifdef SWIFT_DEBUG_CHECKS
-          int test_ci, test_ii, test_jj, test_kk;
-          patch_index_from_cell_index(cell_index, &test_ci, &test_ii, &test_jj,
-                                      &test_kk);
-          if (icell != test_ci) error("Invalid cell_index!");
-          if (ii != test_ii) error("Invalid ii!");
-          if (jj != test_jj) error("Invalid jj!");
-          if (kk != test_kk) error("Invalid kk!");
-#endif
-
-          ++count;
-        }
-      }
-    }
-  }
-
-  return count;
-}
-
-void fill_local_patches_from_mesh_cells(
-    const int N, const double fac, const struct space *s,
-    const struct mesh_key_value_pot *mesh_cells,
-    struct pm_mesh_patch *local_patches, const size_t nr_send_tot) {
-
-  const int *local_cells = s->local_cells_top;
-  const int nr_local_cells = s->nr_local_cells;
-  const double dim[3] = {s->dim[0], s->dim[1], s->dim[2]};
-
-  size_t offset = 0;
-
-  /* Loop over our local top level cells */
-  for (int icell = 0; icell < nr_local_cells; icell++) {
-
-    const struct cell *cell = &(s->cells_top[local_cells[icell]]);
-    struct pm_mesh_patch *patch = &local_patches[icell];
-
-    /* Skip empty cells */
-    if (cell->grav.count == 0) continue;
-
-    patch->N = N;
-    patch->fac = fac;
-
-    /* Will need to wrap particles to position nearest the cell centre */
-    for (int i = 0; i < 3; i++) {
-      patch->wrap_min[i] = cell->loc[i] + 0.5 * cell->width[i] - 0.5 * dim[i];
-      patch->wrap_max[i] = cell->loc[i] + 0.5 * cell->width[i] + 0.5 * dim[i];
-    }
-
-    int num_cells = 1;
-    for (int i = 0; i < 3; i++) {
-      const double xmin = cell->loc[i] - 2.01 / fac;
-      const double xmax = cell->loc[i] + cell->width[i] + 3.01 / fac;
-      patch->mesh_min[i] = (int)floor(xmin * fac);
-      patch->mesh_max[i] = (int)floor(xmax * fac);
-      patch->mesh_size[i] = patch->mesh_max[i] - patch->mesh_min[i] + 1;
-      num_cells *= patch->mesh_size[i];
-    }
-
-    /* Allocate the mesh */
-    if (swift_memalign("mesh_patch", (void **)&patch->mesh,
-                       SWIFT_CACHE_ALIGNMENT, num_cells * sizeof(double)) != 0)
-      error("Failed to allocate array for mesh patch!");
-
-#ifdef SWIFT_DEBUG_CHECKS
-    int count = 0;
-    for (size_t imesh = 0; imesh < nr_send_tot; ++imesh) {
-
-      const size_t cell_index = mesh_cells[imesh].cell_index;
-      const int temp = cell_index_extract_patch_index(cell_index);
-      if (temp == icell) ++count;
-    }
-    if (count != num_cells)
-      error(
-          "Invalide number of cells to fill the patch! icell=%d count=%d "
-          "num_cells=%d",
-          icell, count, num_cells);
-#endif
-
-    /* Now, we can start filling the mesh patch cells from the array of
-     * key-index-value tuples */
-    for (size_t imesh = offset; imesh < offset + num_cells; ++imesh) {
-
-      const size_t cell_index = mesh_cells[imesh].cell_index;
-      const double pot = mesh_cells[imesh].value;
-
-      /* Recover the patch index (should be icell) and the i,j,k indices */
-      int patch_index, i, j, k;
-      patch_index_from_cell_index(cell_index, &patch_index, &i, &j, &k);
-
-#ifdef SWIFT_DEBUG_CHECKS
-      const int temp = cell_index_extract_patch_index(cell_index);
-
-      if (patch_index != icell)
-        error(
-            "mesh cell not sorted in the right order icell=%d patch_index=%d "
-            "cell_index=%zd i=%d j=%d k=%d imesh=%zd temp=%d",
-            icell, patch_index, cell_index, i, j, k, imesh, temp);
-#endif
-
-      /* Flatten out the i,j,k index */
-      const int local_index = i * (patch->mesh_size[1] * patch->mesh_size[2]) +
-                              j * patch->mesh_size[2] + k;
-
-      /* Store the potential */
-      patch->mesh[local_index] = pot;
-    }
-
-    /* Move to the next cell */
-    offset += num_cells;
-  }
-}
-
 /**
  * @brief Retrieve the potential in the mesh cells we need to
- * compute the force on particles on this MPI rank. Result is
- * returned in the supplied hashmap, which should be initially
- * empty.
+ * compute the force on particles on this MPI rank.
  *
  * We need all cells containing points -2 and +3 mesh cell widths
  * away from each particle along each axis to compute the
- * potential gradient.
+ * potential gradient. Each local top-level cell gets a patch covering
+ * that range. The patches are cut into fragments that each fit in one
+ * slab and we request the fragments from the ranks holding them. These
+ * reply with the dense values of each fragment, which we copy straight
+ * into the patches.
  *
  * @param N The size of the mesh
  * @param fac Inverse of the FFT mesh cell size
@@ -745,14 +577,14 @@ void fill_local_patches_from_mesh_cells(
  * @param local_n0 Width of the mesh slab on this rank
  * @param potential_slice Array with the potential on the local slice of the
  * mesh
- * @param tp The #threadpool object.
+ * @param local_patches The array of *local* mesh patches to fill.
  * @param verbose Are we talkative?
  */
 void mpi_mesh_fetch_potential(const int N, const double fac,
                               const struct space *s, const int local_0_start,
                               const int local_n0, double *potential_slice,
                               struct pm_mesh_patch *local_patches,
-                              struct threadpool *tp, const int verbose) {
+                              const int verbose) {
 
 #if defined(WITH_MPI) && defined(HAVE_MPI_FFTW)
 
@@ -761,145 +593,95 @@ void mpi_mesh_fetch_potential(const int N, const double fac,
   MPI_Comm_size(MPI_COMM_WORLD, &nr_nodes);
   MPI_Comm_rank(MPI_COMM_WORLD, &nodeID);
 
-  ticks tic = getticks();
-
-  /* Determine how many mesh cells we will need to request */
-  const size_t nr_send_tot = count_required_mesh_cells(N, fac, s);
-
-  if (verbose)
-    message(" - Counting required mesh patches took %.3f %s.",
-            clocks_from_ticks(getticks() - tic), clocks_getunit());
-
-  struct mesh_key_value_pot *send_cells_unsorted;
-  if (swift_memalign("send_cells_unsorted", (void **)&send_cells_unsorted,
-                     SWIFT_CACHE_ALIGNMENT,
-                     nr_send_tot * sizeof(struct mesh_key_value_pot)) != 0)
-    error("Failed to allocate array for cells to request!");
-
-  tic = getticks();
-
-  /* Initialise the mesh cells we will request */
-  const size_t check_count =
-      init_required_mesh_cells(N, fac, s, send_cells_unsorted);
-
-  if (nr_send_tot != check_count)
-    error("Count and initialisation incompatible!");
-
-  if (verbose)
-    message(" - Init required mesh patches took %.3f %s.",
-            clocks_from_ticks(getticks() - tic), clocks_getunit());
-
-  tic = getticks();
-
-  struct mesh_key_value_pot *send_cells;
-  if (swift_memalign("send_cells", (void **)&send_cells, SWIFT_CACHE_ALIGNMENT,
-                     nr_send_tot * sizeof(struct mesh_key_value_pot)) != 0)
-    error("Failed to allocate array for cells to request!");
-
-  size_t *sorted_offsets = (size_t *)malloc(N * sizeof(size_t));
-
-  /* Do a bucket sort of the mesh elements to have them sorted
-   * by global x-coordinate (note we don't care about y,z at this stage) */
-  bucket_sort_mesh_key_value_pot(send_cells_unsorted, nr_send_tot, N, tp,
-                                 send_cells, sorted_offsets);
-
-  swift_free("send_cells_unsorted", send_cells_unsorted);
-  send_cells_unsorted = NULL;
-
-  if (verbose)
-    message(" - 1st mesh patches sort took %.3f %s.",
-            clocks_from_ticks(getticks() - tic), clocks_getunit());
+  const int *local_cells = s->local_cells_top;
+  const int nr_local_cells = s->nr_local_cells;
 
-  tic = getticks();
+  ticks tic = getticks();
 
-  /* Get width of the mesh slice on each rank */
-  int *slice_width = (int *)malloc(sizeof(int) * nr_nodes);
-  MPI_Allgather(&local_n0, 1, MPI_INT, slice_width, 1, MPI_INT, MPI_COMM_WORLD);
+  struct mesh_slabs slabs;
+  mesh_slabs_init(&slabs, N, local_n0);
 
-  /* Determine first mesh x coordinate stored on each rank */
-  int *slice_offset = (int *)malloc(sizeof(int) * nr_nodes);
-  slice_offset[0] = 0;
-  for (int i = 1; i < nr_nodes; i++) {
-    slice_offset[i] = slice_offset[i - 1] + slice_width[i - 1];
+  /* Create the patches we want to fill */
+  for (int icell = 0; icell < nr_local_cells; icell++) {
+    const struct cell *cell = &s->cells_top[local_cells[icell]];
+    if (cell->grav.count == 0) continue;
+    pm_mesh_patch_init_stencil(&local_patches[icell], cell, N, fac, s->dim);
   }
 
-  /* Count how many mesh cells we need to request from each MPI rank */
-  size_t *nr_send = (size_t *)calloc(nr_nodes, sizeof(size_t));
-
-  /* Loop over the offsets */
-  int dest_node = 0;
-  for (int i = 0; i < N; ++i) {
-
-    /* Find the first mesh cell in that bucket */
-    const size_t j = sorted_offsets[i];
+  /* Count the fragments and values we need from each rank */
+  size_t *nr_send = (size_t *)calloc(2 * nr_nodes, sizeof(size_t));
+  size_t *nr_recv = (size_t *)calloc(2 * nr_nodes, sizeof(size_t));
+  if (nr_send == NULL || nr_recv == NULL)
+    error("Failed to allocate the mesh message counts.");
+  size_t *nr_send_blocks = nr_send;
+  size_t *nr_send_values = nr_send + nr_nodes;
+  size_t *nr_recv_blocks = nr_recv;
+  size_t *nr_recv_values = nr_recv + nr_nodes;
 
-    /* Get the x coordinate of this mesh cell in the global mesh */
-    const int mesh_x =
-        get_xcoord_from_padded_row_major_id((size_t)send_cells[j].key, N);
-
-    /* Advance to the destination node that is to contain this x coordinate */
-    while ((mesh_x >= slice_offset[dest_node] + slice_width[dest_node]) ||
-           (slice_width[dest_node] == 0)) {
-      dest_node++;
+  for (int icell = 0; icell < nr_local_cells; icell++) {
+    const struct pm_mesh_patch *patch = &local_patches[icell];
+    if (patch->mesh == NULL) continue;
+
+    struct pm_mesh_block b;
+    for (int i = 0; i < patch->mesh_size[0]; i += b.size[0]) {
+      const int dest = mesh_patch_slab_fragment(&slabs, patch, i, &b);
+      nr_send_blocks[dest]++;
+      nr_send_values[dest] += mesh_block_count(&b);
     }
+  }
 
-    /* Add all the mesh cells in this bucket */
-    if (i < N - 1)
-      nr_send[dest_node] += sorted_offsets[i + 1] - sorted_offsets[i];
-    else
-      nr_send[dest_node] += nr_send_tot - sorted_offsets[i];
+  size_t *send_offset = (size_t *)malloc(2 * nr_nodes * sizeof(size_t));
+  if (send_offset == NULL) error("Failed to allocate the mesh send offsets.");
+  size_t *blocks_offset = send_offset;
+  size_t *values_offset = send_offset + nr_nodes;
+  size_t nr_send_blocks_tot = 0, nr_send_values_tot = 0;
+  for (int i = 0; i < nr_nodes; i++) {
+    blocks_offset[i] = nr_send_blocks_tot;
+    values_offset[i] = nr_send_values_tot;
+    nr_send_blocks_tot += nr_send_blocks[i];
+    nr_send_values_tot += nr_send_values[i];
   }
 
-#ifdef SWIFT_DEBUG_CHECKS
-  size_t *nr_send_check = (size_t *)calloc(nr_nodes, sizeof(size_t));
+  /* List the fragments we need, grouped by the rank holding them */
+  struct pm_mesh_block *send_blocks;
+  if (swift_memalign("mesh_send_blocks", (void **)&send_blocks,
+                     SWIFT_CACHE_ALIGNMENT,
+                     nr_send_blocks_tot * sizeof(struct pm_mesh_block)) != 0)
+    error("Failed to allocate array for fragments to request!");
 
-  /* Brute-force list without using the offsets */
-  int dest_node_check = 0;
-  for (size_t i = 0; i < nr_send_tot; i++) {
-    while (get_xcoord_from_padded_row_major_id(send_cells[i].key, N) >=
-               (slice_offset[dest_node_check] + slice_width[dest_node_check]) ||
-           slice_width[dest_node_check] == 0) {
-      dest_node_check++;
-    }
-    if (dest_node_check >= nr_nodes || dest_node_check < 0)
-      error("Destination node out of range");
-    nr_send_check[dest_node_check]++;
-  }
+  for (int icell = 0; icell < nr_local_cells; icell++) {
+    const struct pm_mesh_patch *patch = &local_patches[icell];
+    if (patch->mesh == NULL) continue;
 
-  /* Verify the "smart" list is as good as the brute-force one */
-  for (int i = 0; i < nr_nodes; ++i) {
-    if (nr_send[i] != nr_send_check[i]) error("Invalid send list!");
+    struct pm_mesh_block b;
+    for (int i = 0; i < patch->mesh_size[0]; i += b.size[0]) {
+      const int dest = mesh_patch_slab_fragment(&slabs, patch, i, &b);
+      send_blocks[blocks_offset[dest]++] = b;
+    }
   }
-  free(nr_send_check);
-#endif
 
-  /* We don't need the sorted offsets any more from here onwards */
-  free(sorted_offsets);
+  /* Determine how many fragments we'll be asked for by each MPI rank */
+  MPI_Alltoall(nr_send_blocks, sizeof(size_t), MPI_BYTE, nr_recv_blocks,
+               sizeof(size_t), MPI_BYTE, MPI_COMM_WORLD);
+  size_t nr_recv_blocks_tot = 0;
+  for (int i = 0; i < nr_nodes; i++) nr_recv_blocks_tot += nr_recv_blocks[i];
 
-  /* Determine how many requests we'll receive from each MPI rank */
-  size_t *nr_recv = (size_t *)malloc(sizeof(size_t) * nr_nodes);
-  MPI_Alltoall(nr_send, sizeof(size_t), MPI_BYTE, nr_recv, sizeof(size_t),
-               MPI_BYTE, MPI_COMM_WORLD);
-  size_t nr_recv_tot = 0;
-  for (int i = 0; i < nr_nodes; i++) {
-    nr_recv_tot += nr_recv[i];
-  }
+  struct pm_mesh_block *recv_blocks;
+  if (swift_memalign("mesh_recv_blocks", (void **)&recv_blocks,
+                     SWIFT_CACHE_ALIGNMENT,
+                     nr_recv_blocks_tot * sizeof(struct pm_mesh_block)) != 0)
+    error("Failed to allocate array for mesh receive buffer!");
 
   if (verbose)
-    message(" - Preparing comms buffers took %.3f %s.",
+    message(" - Preparing the mesh requests took %.3f %s.",
             clocks_from_ticks(getticks() - tic), clocks_getunit());
 
   tic = getticks();
 
-  /* Allocate buffer to receive requests */
-  struct mesh_key_value_pot *recv_cells;
-  if (swift_memalign("recv_cells", (void **)&recv_cells, SWIFT_CACHE_ALIGNMENT,
-                     nr_recv_tot * sizeof(struct mesh_key_value_pot)) != 0)
-    error("Failed to allocate array for mesh receive buffer!");
-
-  /* Send requests for cells to other ranks */
-  exchange_structs(nr_send, (char *)send_cells, nr_recv, (char *)recv_cells,
-                   sizeof(struct mesh_key_value_pot));
+  /* Send requests for fragments to other ranks */
+  exchange_structs(nr_send_blocks, send_blocks, nr_recv_blocks, recv_blocks,
+                   sizeof(struct pm_mesh_block));
+  swift_free("mesh_send_blocks", send_blocks);
 
   if (verbose)
     message(" - 1st exchange took %.3f %s.",
@@ -907,25 +689,29 @@ void mpi_mesh_fetch_potential(const int N, const double fac,
 
   tic = getticks();
 
-  /* Look up potential in the requested cells */
-  for (size_t i = 0; i < nr_recv_tot; i++) {
-#ifdef SWIFT_DEBUG_CHECKS
-    const size_t cells_in_slab = ((size_t)N) * (2 * (N / 2 + 1));
-    const size_t first_local_id = local_0_start * cells_in_slab;
-    const size_t num_local_ids = local_n0 * cells_in_slab;
-    if (recv_cells[i].key < first_local_id ||
-        recv_cells[i].key >= first_local_id + num_local_ids) {
-      error("Requested potential mesh cell ID is out of range");
-    }
-#endif
-    const size_t local_id =
-        get_index_in_local_slice(recv_cells[i].key, N, local_0_start);
-#ifdef SWIFT_DEBUG_CHECKS
-    const size_t Ns = N;
-    if (local_id >= Ns * (2 * (Ns / 2 + 1)) * local_n0)
-      error("Local potential mesh cell ID is out of range");
-#endif
-    recv_cells[i].value = potential_slice[local_id];
+  /* Count the values requested by each rank */
+  size_t nr_recv_values_tot = 0;
+  size_t ib = 0;
+  for (int i = 0; i < nr_nodes; i++) {
+    for (size_t j = 0; j < nr_recv_blocks[i]; ++j, ++ib)
+      nr_recv_values[i] += mesh_block_count(&recv_blocks[ib]);
+    nr_recv_values_tot += nr_recv_values[i];
+  }
+
+  double *reply_values, *values;
+  if (swift_memalign("mesh_reply_values", (void **)&reply_values,
+                     SWIFT_CACHE_ALIGNMENT,
+                     nr_recv_values_tot * sizeof(double)) != 0 ||
+      swift_memalign("mesh_values", (void **)&values, SWIFT_CACHE_ALIGNMENT,
+                     nr_send_values_tot * sizeof(double)) != 0)
+    error("Failed to allocate arrays for the potential values!");
+
+  /* Look up potential in the requested fragments */
+  size_t count = 0;
+  for (size_t i = 0; i < nr_recv_blocks_tot; i++) {
+    mesh_slab_fragment(N, local_0_start, local_n0, potential_slice,
+                       &recv_blocks[i], reply_values + count, /*add=*/0);
+    count += mesh_block_count(&recv_blocks[i]);
   }
 
   if (verbose)
@@ -935,8 +721,8 @@ void mpi_mesh_fetch_potential(const int N, const double fac,
   tic = getticks();
 
   /* Return the results */
-  exchange_structs(nr_recv, (char *)recv_cells, nr_send, (char *)send_cells,
-                   sizeof(struct mesh_key_value_pot));
+  exchange_structs(nr_recv_values, reply_values, nr_send_values, values,
+                   sizeof(double));
 
   if (verbose)
     message(" - 2nd exchange took %.3f %s.",
@@ -944,137 +730,46 @@ void mpi_mesh_fetch_potential(const int N, const double fac,
 
   tic = getticks();
 
-  /* Tidy up */
-  swift_free("recv_cells", recv_cells);
-  free(slice_width);
-  free(slice_offset);
-  free(nr_send);
-  free(nr_recv);
-
-  struct mesh_key_value_pot *send_cells_sorted;
-  if (swift_memalign("send_cells_sorted", (void **)&send_cells_sorted,
-                     SWIFT_CACHE_ALIGNMENT,
-                     nr_send_tot * sizeof(struct mesh_key_value_pot)) != 0)
-    error("Failed to allocate array for cells to request!");
-
-  /* Now sort the mesh cells by top-level cell index (i.e. by the patch they
-   * belong to) */
-  bucket_sort_mesh_key_value_pot_index(
-      send_cells, nr_send_tot, s->nr_local_cells, tp, send_cells_sorted);
-
-  swift_free("send_cells", send_cells);
-  send_cells = NULL;
-
-  if (verbose)
-    message(" - 2nd mesh patches sort took %.3f %s.",
-            clocks_from_ticks(getticks() - tic), clocks_getunit());
-
-  tic = getticks();
+  /* Copy the values to the patches, walking through them in the same order
+   * as when we listed the fragments */
+  count = 0;
+  for (int i = 0; i < nr_nodes; i++) {
+    values_offset[i] = count;
+    count += nr_send_values[i];
+  }
 
-  /* Initialise the local patches with the data we just received */
-  fill_local_patches_from_mesh_cells(N, fac, s, send_cells_sorted,
-                                     local_patches, nr_send_tot);
+  for (int icell = 0; icell < nr_local_cells; icell++) {
+    struct pm_mesh_patch *patch = &local_patches[icell];
+    if (patch->mesh == NULL) continue;
+
+    struct pm_mesh_block b;
+    for (int i = 0; i < patch->mesh_size[0]; i += b.size[0]) {
+      const int dest = mesh_patch_slab_fragment(&slabs, patch, i, &b);
+      const size_t nr_values = mesh_block_count(&b);
+      memcpy(patch->mesh + pm_mesh_patch_index(patch, i, 0, 0),
+             values + values_offset[dest], nr_values * sizeof(double));
+      values_offset[dest] += nr_values;
+    }
+  }
 
   if (verbose)
     message(" - Filling the local patches took %.3f %s.",
             clocks_from_ticks(getticks() - tic), clocks_getunit());
 
-  swift_free("send_cells_sorted", send_cells_sorted);
+  /* Tidy up */
+  mesh_slabs_clean(&slabs);
+  swift_free("mesh_recv_blocks", recv_blocks);
+  swift_free("mesh_reply_values", reply_values);
+  swift_free("mesh_values", values);
+  free(send_offset);
+  free(nr_send);
+  free(nr_recv);
 
 #else
   error("FFTW MPI not found - unable to use distributed mesh");
 #endif
 }
 
-/**
- * @brief Computes the potential on a gpart from a given mesh using the CIC
- * method.
- *
- * @param gp The #gpart.
- * @param patch The local mesh patch
- */
-#if defined(WITH_MPI) && defined(HAVE_MPI_FFTW)
-void mesh_patch_to_gparts_CIC(struct gpart *gp,
-                              const struct pm_mesh_patch *patch) {
-
-  const double fac = patch->fac;
-
-  /* Box wrap the gpart's position to the copy nearest the cell centre */
-  const double pos_x =
-      box_wrap(gp->x[0], patch->wrap_min[0], patch->wrap_max[0]);
-  const double pos_y =
-      box_wrap(gp->x[1], patch->wrap_min[1], patch->wrap_max[1]);
-  const double pos_z =
-      box_wrap(gp->x[2], patch->wrap_min[2], patch->wrap_max[2]);
-
-  /* Workout the CIC coefficients */
-  int i = (int)floor(fac * pos_x);
-  const double dx = fac * pos_x - i;
-  const double tx = 1. - dx;
-
-  int j = (int)floor(fac * pos_y);
-  const double dy = fac * pos_y - j;
-  const double ty = 1. - dy;
-
-  int k = (int)floor(fac * pos_z);
-  const double dz = fac * pos_z - k;
-  const double tz = 1. - dz;
-
-#ifdef SWIFT_GRAVITY_FORCE_CHECKS
-  if (gp->a_grav_mesh[0] != 0.) error("Particle with non-initalised stuff");
-#ifndef SWIFT_GRAVITY_NO_POTENTIAL
-  if (gp->potential_mesh != 0.) error("Particle with non-initalised stuff");
-#endif
-#endif
-
-  /* Some local accumulators */
-  double p = 0.;
-  double a[3] = {0.};
-
-  /* Get coordinates within the mesh patch */
-  const int ii = i - patch->mesh_min[0];
-  const int jj = j - patch->mesh_min[1];
-  const int kk = k - patch->mesh_min[2];
-
-  /* Simple CIC for the potential itself */
-  p += pm_mesh_patch_CIC_get(patch, ii, jj, kk, tx, ty, tz, dx, dy, dz);
-
-  /* 5-point stencil along each axis for the accelerations */
-  a[0] += (1. / 12.) *
-          pm_mesh_patch_CIC_get(patch, ii + 2, jj, kk, tx, ty, tz, dx, dy, dz);
-  a[0] -= (2. / 3.) *
-          pm_mesh_patch_CIC_get(patch, ii + 1, jj, kk, tx, ty, tz, dx, dy, dz);
-  a[0] += (2. / 3.) *
-          pm_mesh_patch_CIC_get(patch, ii - 1, jj, kk, tx, ty, tz, dx, dy, dz);
-  a[0] -= (1. / 12.) *
-          pm_mesh_patch_CIC_get(patch, ii - 2, jj, kk, tx, ty, tz, dx, dy, dz);
-
-  a[1] += (1. / 12.) *
-          pm_mesh_patch_CIC_get(patch, ii, jj + 2, kk, tx, ty, tz, dx, dy, dz);
-  a[1] -= (2. / 3.) *
-          pm_mesh_patch_CIC_get(patch, ii, jj + 1, kk, tx, ty, tz, dx, dy, dz);
-  a[1] += (2. / 3.) *
-          pm_mesh_patch_CIC_get(patch, ii, jj - 1, kk, tx, ty, tz, dx, dy, dz);
-  a[1] -= (1. / 12.) *
-          pm_mesh_patch_CIC_get(patch, ii, jj - 2, kk, tx, ty, tz, dx, dy, dz);
-
-  a[2] += (1. / 12.) *
-          pm_mesh_patch_CIC_get(patch, ii, jj, kk + 2, tx, ty, tz, dx, dy, dz);
-  a[2] -= (2. / 3.) *
-          pm_mesh_patch_CIC_get(patch, ii, jj, kk + 1, tx, ty, tz, dx, dy, dz);
-  a[2] += (2. / 3.) *
-          pm_mesh_patch_CIC_get(patch, ii, jj, kk - 1, tx, ty, tz, dx, dy, dz);
-  a[2] -= (1. / 12.) *
-          pm_mesh_patch_CIC_get(patch, ii, jj, kk - 2, tx, ty, tz, dx, dy, dz);
-
-  /* Store things back */
-  gp->a_grav_mesh[0] = fac * a[0];
-  gp->a_grav_mesh[1] = fac * a[1];
-  gp->a_grav_mesh[2] = fac * a[2];
-  gravity_add_comoving_mesh_potential(gp, p);
-}
-#endif
-
 /**
  * @brief Interpolate the forces and potential from the mesh to the #gpart.
  *
@@ -1096,36 +791,7 @@ void cell_distributed_mesh_to_gpart_CIC(const struct cell *c,
                                         const double dim[3]) {
 
 #if defined(WITH_MPI) && defined(HAVE_MPI_FFTW)
-
-  const int gcount = c->grav.count;
-  struct gpart *gparts = c->grav.parts;
-
-  /* Check for empty cell as this would cause problems finding the extent */
-  if (gcount == 0) return;
-
-  /* Get the potential from the mesh patch to the active gparts using CIC */
-  for (int i = 0; i < gcount; ++i) {
-    struct gpart *gp = &gparts[i];
-
-    if (gp->time_bin == time_bin_inhibited) continue;
-
-    gp->a_grav_mesh[0] = 0.f;
-    gp->a_grav_mesh[1] = 0.f;
-    gp->a_grav_mesh[2] = 0.f;
-#ifndef SWIFT_GRAVITY_NO_POTENTIAL
-    gp->potential_mesh = 0.f;
-#endif
-
-    mesh_patch_to_gparts_CIC(gp, patch);
-
-    gp->a_grav_mesh[0] *= const_G;
-    gp->a_grav_mesh[1] *= const_G;
-    gp->a_grav_mesh[2] *= const_G;
-#ifndef SWIFT_GRAVITY_NO_POTENTIAL
-    gp->potential_mesh *= const_G;
-#endif
-  }
-
+  cell_mesh_patch_to_gpart_CIC(c, patch, const_G);
 #else
   error("FFTW MPI not found - unable to use distributed mesh");
 #endif
@@ -42,13 +42,13 @@ void mpi_mesh_accumulate_gparts_to_local_patches(
 void mpi_mesh_local_patches_to_slices(const int N, const int local_n0,
                                       struct pm_mesh_patch *local_patches,
                                       const int nr_patches, double *mesh,
-                                      struct threadpool *tp, const int verbose);
+                                      const int verbose);
 
 void mpi_mesh_fetch_potential(const int N, const double fac,
                               const struct space *s, int local_0_start,
                               int local_n0, double *potential_slice,
                               struct pm_mesh_patch *local_patches,
-                              struct threadpool *tp, const int verbose);
+                              const int verbose);
 
 void mpi_mesh_update_gparts(struct pm_mesh_patch *local_patches,
                             const struct space *s, struct threadpool *tp,
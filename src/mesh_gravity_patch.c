@@ -30,6 +30,7 @@
 #include "atomic.h"
 #include "cell.h"
 #include "error.h"
+#include "gravity.h"
 #include "row_major_id.h"
 
 /**
@@ -101,6 +102,50 @@ void pm_mesh_patch_init(struct pm_mesh_patch *patch, const struct cell *cell,
     error("Failed to allocate array for mesh patch!");
 }
 
+/**
+ * @brief Initialize a mesh patch to cover a cell and the stencil used to
+ * compute the mesh forces of its particles.
+ *
+ * The 5 point stencil used for accelerations requires 2 neighbouring FFT mesh
+ * cells in each direction and for CIC evaluation of the accelerations we need
+ * one extra FFT mesh cell in the +ve direction. We also add 1% of a mesh cell
+ * to avoid problems with rounding.
+ *
+ * @param patch A pointer to the mesh patch
+ * @param cell The cell which the mesh should cover
+ * @param N Size of the full mesh
+ * @param fac Inverse of the FFT mesh size
+ * @param dim Size of the full volume in each dimension
+ */
+void pm_mesh_patch_init_stencil(struct pm_mesh_patch *patch,
+                                const struct cell *cell, const int N,
+                                const double fac, const double dim[3]) {
+
+  patch->N = N;
+  patch->fac = fac;
+
+  /* Will need to wrap particles to position nearest the cell centre */
+  for (int i = 0; i < 3; i++) {
+    patch->wrap_min[i] = cell->loc[i] + 0.5 * cell->width[i] - 0.5 * dim[i];
+    patch->wrap_max[i] = cell->loc[i] + 0.5 * cell->width[i] + 0.5 * dim[i];
+  }
+
+  int num_cells = 1;
+  for (int i = 0; i < 3; i++) {
+    const double xmin = cell->loc[i] - 2.01 / fac;
+    const double xmax = cell->loc[i] + cell->width[i] + 3.01 / fac;
+    patch->mesh_min[i] = (int)floor(xmin * fac);
+    patch->mesh_max[i] = (int)floor(xmax * fac);
+    patch->mesh_size[i] = patch->mesh_max[i] - patch->mesh_min[i] + 1;
+    num_cells *= patch->mesh_size[i];
+  }
+
+  /* Allocate the mesh */
+  if (swift_memalign("mesh_patch", (void **)&patch->mesh, SWIFT_CACHE_ALIGNMENT,
+                     num_cells * sizeof(double)) != 0)
+    error("Failed to allocate array for mesh patch!");
+}
+
 /**
  * @brief Write the content of a mesh patch back to the global mesh
  * using atomic operations.
@@ -140,6 +185,175 @@ void pm_add_patch_to_global_mesh(double *const global_mesh,
   }
 }
 
+/**
+ * @brief Copy the values covered by a mesh patch from the full periodic mesh.
+ *
+ * @param patch The #pm_mesh_patch object to fill.
+ * @param global_mesh The full N*N*N mesh to read from.
+ */
+void pm_mesh_patch_set_from_global_mesh(struct pm_mesh_patch *patch,
+                                        const double *const global_mesh) {
+
+  const int N = patch->N;
+  const int size_i = patch->mesh_size[0];
+  const int size_j = patch->mesh_size[1];
+  const int size_k = patch->mesh_size[2];
+  const int mesh_min_i = patch->mesh_min[0];
+  const int mesh_min_j = patch->mesh_min[1];
+  const int mesh_min_k = patch->mesh_min[2];
+
+  /* Remind the compiler that the arrays are nicely aligned */
+  swift_declare_aligned_ptr(double, mesh, patch->mesh, SWIFT_CACHE_ALIGNMENT);
+
+  for (int i = 0; i < size_i; ++i) {
+    for (int j = 0; j < size_j; ++j) {
+      for (int k = 0; k < size_k; ++k) {
+
+        const int ii = i + mesh_min_i;
+        const int jj = j + mesh_min_j;
+        const int kk = k + mesh_min_k;
+
+        const int patch_index = pm_mesh_patch_index(patch, i, j, k);
+        const int mesh_index = row_major_id_periodic(ii, jj, kk, N);
+
+        mesh[patch_index] = global_mesh[mesh_index];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Computes the potential on a gpart from a given mesh using the CIC
+ * method.
+ *
+ * @param gp The #gpart.
+ * @param patch The local mesh patch
+ */
+void mesh_patch_to_gparts_CIC(struct gpart *gp,
+                              const struct pm_mesh_patch *patch) {
+
+  const double fac = patch->fac;
+
+  /* Box wrap the gpart's position to the copy nearest the cell centre */
+  const double pos_x =
+      box_wrap(gp->x[0], patch->wrap_min[0], patch->wrap_max[0]);
+  const double pos_y =
+      box_wrap(gp->x[1], patch->wrap_min[1], patch->wrap_max[1]);
+  const double pos_z =
+      box_wrap(gp->x[2], patch->wrap_min[2], patch->wrap_max[2]);
+
+  /* Workout the CIC coefficients */
+  int i = (int)floor(fac * pos_x);
+  const double dx = fac * pos_x - i;
+  const double tx = 1. - dx;
+
+  int j = (int)floor(fac * pos_y);
+  const double dy = fac * pos_y - j;
+  const double ty = 1. - dy;
+
+  int k = (int)floor(fac * pos_z);
+  const double dz = fac * pos_z - k;
+  const double tz = 1. - dz;
+
+#ifdef SWIFT_GRAVITY_FORCE_CHECKS
+  if (gp->a_grav_mesh[0] != 0.) error("Particle with non-initalised stuff");
+#ifndef SWIFT_GRAVITY_NO_POTENTIAL
+  if (gp->potential_mesh != 0.) error("Particle with non-initalised stuff");
+#endif
+#endif
+
+  /* Some local accumulators */
+  double p = 0.;
+  double a[3] = {0.};
+
+  /* Get coordinates within the mesh patch */
+  const int ii = i - patch->mesh_min[0];
+  const int jj = j - patch->mesh_min[1];
+  const int kk = k - patch->mesh_min[2];
+
+  /* Simple CIC for the potential itself */
+  p += pm_mesh_patch_CIC_get(patch, ii, jj, kk, tx, ty, tz, dx, dy, dz);
+
+  /* 5-point stencil along each axis for the accelerations */
+  a[0] += (1. / 12.) *
+          pm_mesh_patch_CIC_get(patch, ii + 2, jj, kk, tx, ty, tz, dx, dy, dz);
+  a[0] -= (2. / 3.) *
+          pm_mesh_patch_CIC_get(patch, ii + 1, jj, kk, tx, ty, tz, dx, dy, dz);
+  a[0] += (2. / 3.) *
+          pm_mesh_patch_CIC_get(patch, ii - 1, jj, kk, tx, ty, tz, dx, dy, dz);
+  a[0] -= (1. / 12.) *
+          pm_mesh_patch_CIC_get(patch, ii - 2, jj, kk, tx, ty, tz, dx, dy, dz);
+
+  a[1] += (1. / 12.) *
+          pm_mesh_patch_CIC_get(patch, ii, jj + 2, kk, tx, ty, tz, dx, dy, dz);
+  a[1] -= (2. / 3.) *
+          pm_mesh_patch_CIC_get(patch, ii, jj + 1, kk, tx, ty, tz, dx, dy, dz);
+  a[1] += (2. / 3.) *
+          pm_mesh_patch_CIC_get(patch, ii, jj - 1, kk, tx, ty, tz, dx, dy, dz);
+  a[1] -= (1. / 12.) *
+          pm_mesh_patch_CIC_get(patch, ii, jj - 2, kk, tx, ty, tz, dx, dy, dz);
+
+  a[2] += (1. / 12.) *
+          pm_mesh_patch_CIC_get(patch, ii, jj, kk + 2, tx, ty, tz, dx, dy, dz);
+  a[2] -= (2. / 3.) *
+          pm_mesh_patch_CIC_get(patch, ii, jj, kk + 1, tx, ty, tz, dx, dy, dz);
+  a[2] += (2. / 3.) *
+          pm_mesh_patch_CIC_get(patch, ii, jj, kk - 1, tx, ty, tz, dx, dy, dz);
+  a[2] -= (1. / 12.) *
+          pm_mesh_patch_CIC_get(patch, ii, jj, kk - 2, tx, ty, tz, dx, dy, dz);
+
+  /* Store things back */
+  gp->a_grav_mesh[0] = fac * a[0];
+  gp->a_grav_mesh[1] = fac * a[1];
+  gp->a_grav_mesh[2] = fac * a[2];
+  gravity_add_comoving_mesh_potential(gp, p);
+}
+
+/**
+ * @brief Interpolate the forces and potential from a mesh patch to all the
+ * #gpart of a #cell.
+ *
+ * The patch must cover the particles of the cell plus the 2 elements
+ * required on each side by the 5-point stencils.
+ *
+ * @param c The #cell containing the #gpart to update.
+ * @param patch The #pm_mesh_patch covering the cell.
+ * @param const_G Gravitional constant.
+ */
+void cell_mesh_patch_to_gpart_CIC(const struct cell *c,
+                                  const struct pm_mesh_patch *patch,
+                                  const float const_G) {
+
+  const int gcount = c->grav.count;
+  struct gpart *gparts = c->grav.parts;
+
+  /* Check for empty cell as this would cause problems finding the extent */
+  if (gcount == 0) return;
+
+  /* Get the potential from the mesh patch to the active gparts using CIC */
+  for (int i = 0; i < gcount; ++i) {
+    struct gpart *gp = &gparts[i];
+
+    if (gp->time_bin == time_bin_inhibited) continue;
+
+    gp->a_grav_mesh[0] = 0.f;
+    gp->a_grav_mesh[1] = 0.f;
+    gp->a_grav_mesh[2] = 0.f;
+#ifndef SWIFT_GRAVITY_NO_POTENTIAL
+    gp->potential_mesh = 0.f;
+#endif
+
+    mesh_patch_to_gparts_CIC(gp, patch);
+
+    gp->a_grav_mesh[0] *= const_G;
+    gp->a_grav_mesh[1] *= const_G;
+    gp->a_grav_mesh[2] *= const_G;
+#ifndef SWIFT_GRAVITY_NO_POTENTIAL
+    gp->potential_mesh *= const_G;
+#endif
+  }
+}
+
 /**
  * @brief Set all values in a mesh patch to zero
  *
@@ -30,6 +30,7 @@
 
 /* Forward declarations */
 struct cell;
+struct gpart;
 
 /**
  * @brief Data structure for a patch of mesh covering a cell
@@ -61,10 +62,30 @@ struct pm_mesh_patch {
   double *mesh;
 };
 
+/**
+ * @brief A box of the full mesh exchanged between MPI ranks.
+ *
+ * The values of the box travel separately or right after it, as a dense
+ * [x][y][z] array. The coordinates may wrap around the periodic mesh along
+ * the axes that are not split between the ranks.
+ */
+struct pm_mesh_block {
+
+  /*! Coordinates of the first mesh cell of the box */
+  int offset[3];
+
+  /*! Number of mesh cells along each axis */
+  int size[3];
+};
+
 void pm_mesh_patch_init(struct pm_mesh_patch *patch, const struct cell *cell,
                         const int N, const double fac, const double dim[3],
                         const int boundary_size);
 
+void pm_mesh_patch_init_stencil(struct pm_mesh_patch *patch,
+                                const struct cell *cell, const int N,
+                                const double fac, const double dim[3]);
+
 void pm_mesh_patch_zero(struct pm_mesh_patch *patch);
 
 void pm_mesh_patch_clean(struct pm_mesh_patch *patch);
@@ -170,4 +191,14 @@ __attribute__((always_inline)) INLINE static void pm_mesh_patch_CIC_set(
 void pm_add_patch_to_global_mesh(double *const global_mesh,
                                  const struct pm_mesh_patch *patch);
 
+void pm_mesh_patch_set_from_global_mesh(struct pm_mesh_patch *patch,
+                                        const double *const global_mesh);
+
+void mesh_patch_to_gparts_CIC(struct gpart *gp,
+                              const struct pm_mesh_patch *patch);
+
+void cell_mesh_patch_to_gpart_CIC(const struct cell *c,
+                                  const struct pm_mesh_patch *patch,
+                                  const float const_G);
+
 #endif
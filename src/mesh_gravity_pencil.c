@@ -0,0 +1,1306 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+/* Config parameters. */
+#include <config.h>
+
+/* Standard includes. */
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* This object's header. */
+#include "mesh_gravity_pencil.h"
+
+/* Local includes. */
+#include "cell.h"
+#include "clocks.h"
+#include "error.h"
+#include "memuse.h"
+#include "mesh_gravity_patch.h"
+#include "space.h"
+
+#if defined(WITH_MPI) && defined(HAVE_MPI_FFTW)
+
+/**
+ * @brief A box of the local mesh, seen as an array of complex numbers.
+ *
+ * The three axes are always given in the (x, y, z) order of the mesh, or
+ * (ky, kx, kz) in Fourier space, such that the two ends of a transposition
+ * walk through the data in the same order.
+ */
+struct pencil_block {
+
+  /*! Position of the first element of the box in the local mesh */
+  size_t offset;
+
+  /*! Distance between two consecutive elements along each axis */
+  size_t stride[3];
+
+  /*! Number of elements along each axis */
+  int size[3];
+};
+
+/*! Number of doubles used by a #pm_mesh_block in a message */
+#define pm_mesh_block_header_size \
+  ((sizeof(struct pm_mesh_block) + sizeof(double) - 1) / sizeof(double))
+
+/**
+ * @brief A range of coordinates along one axis of a mesh patch stored on a
+ * single rank.
+ */
+struct pencil_run {
+
+  /*! First coordinate in the patch */
+  int patch_start;
+
+  /*! First coordinate in the full mesh */
+  int mesh_start;
+
+  /*! Number of coordinates */
+  int count;
+
+  /*! Position along the axis of the rank storing this range */
+  int owner;
+};
+
+/**
+ * @brief Where the values of a #pm_mesh_block requested from another rank
+ * will go.
+ */
+struct pencil_target {
+
+  /*! Index of the patch */
+  int patch;
+
+  /*! First x and y coordinates in the patch */
+  int patch_start[2];
+};
+
+/**
+ * @brief Range of coordinates stored by one of the ranks along an axis.
+ *
+ * @param n The number of coordinates along the axis.
+ * @param nr_parts The number of ranks along the axis.
+ * @param i The position of the rank along the axis.
+ * @param start (return) The first coordinate on that rank.
+ * @param count (return) The number of coordinates on that rank.
+ */
+static void pencil_range(const int n, const int nr_parts, const int i,
+                         int *start, int *count) {
+
+  const int first = (int)(((long long)i * n) / nr_parts);
+  const int last = (int)(((long long)(i + 1) * n) / nr_parts);
+  *start = first;
+  *count = last - first;
+}
+
+/**
+ * @brief Position along an axis of the rank storing a given coordinate.
+ *
+ * This is the inverse of pencil_range().
+ *
+ * @param g The coordinate in [0, n[.
+ * @param n The number of coordinates along the axis.
+ * @param nr_parts The number of ranks along the axis.
+ */
+static int pencil_owner(const int g, const int n, const int nr_parts) {
+  return (int)((((long long)g + 1) * nr_parts - 1) / n);
+}
+
+/**
+ * @brief Split the range of a patch along an axis into the parts stored on
+ * the different ranks.
+ *
+ * @param mesh_min The first (unwrapped) coordinate of the patch.
+ * @param mesh_size The size of the patch.
+ * @param N The size of the full mesh.
+ * @param nr_parts The number of ranks along the axis.
+ * @param runs (return) The parts of the range.
+ * @return The number of parts.
+ */
+static int pencil_patch_runs(const int mesh_min, const int mesh_size,
+                             const int N, const int nr_parts,
+                             struct pencil_run *runs) {
+
+  int count = 0;
+  int i = 0;
+  while (i < mesh_size) {
+
+    /* Coordinate in the full mesh and the rank it lives on */
+    const int g = ((mesh_min + i) % N + N) % N;
+    const int owner = pencil_owner(g, N, nr_parts);
+
+    /* Extend up to the end of that rank's range */
+    int start, width;
+    pencil_range(N, nr_parts, owner, &start, &width);
+    const int len = min(mesh_size - i, start + width - g);
+
+    runs[count].patch_start = i;
+    runs[count].mesh_start = g;
+    runs[count].count = len;
+    runs[count].owner = owner;
+    ++count;
+    i += len;
+  }
+  return count;
+}
+
+/**
+ * @brief Choose the grid of ranks of the pencil decomposition.
+ *
+ * We pick the factorisation of the number of ranks that minimises the size
+ * of the largest local mesh, in real or Fourier space. Ties favour fewer
+ * ranks along y such that the decomposition reduces to slabs, and a single
+ * transposition, whenever that is as good.
+ *
+ * @param N The size of the mesh.
+ * @param nr_nodes The number of MPI ranks.
+ * @param grid (return) The number of ranks along x and along y.
+ */
+static void pm_mesh_pencils_grid(const int N, const int nr_nodes,
+                                 int grid[2]) {
+
+  const int N_half_1 = N / 2 + 1;
+  size_t best = SIZE_MAX;
+
+  for (int g1 = 1; g1 <= nr_nodes; ++g1) {
+    if (nr_nodes % g1 != 0) continue;
+    const int g0 = nr_nodes / g1;
+
+    /* Largest local meshes in real and Fourier space */
+    const size_t nx = (N + g0 - 1) / g0;
+    const size_t ny = (N + g1 - 1) / g1;
+    const size_t nkz = (N_half_1 + g1 - 1) / g1;
+    const size_t real_size = nx * ny * N_half_1;
+    const size_t fourier_size = nx * nkz * N;
+    const size_t size = max(real_size, fourier_size);
+
+    if (size < best) {
+      best = size;
+      grid[0] = g0;
+      grid[1] = g1;
+    }
+  }
+}
+
+/**
+ * @brief Plan the 1D FFTs along the middle axis of a local mesh of
+ * size n_outer x N x n_inner.
+ *
+ * @param data The local mesh.
+ * @param N The size of the middle axis.
+ * @param n_outer The size of the first axis.
+ * @param n_inner The size of the last axis.
+ * @param sign The direction of the transform.
+ * @return The plan or NULL if the local mesh is empty.
+ */
+static fftw_plan pencil_plan_middle_axis(fftw_complex *data, const int N,
+                                         const int n_outer, const int n_inner,
+                                         const int sign) {
+
+  if (n_outer == 0 || n_inner == 0) return NULL;
+
+  fftw_iodim dim;
+  dim.n = N;
+  dim.is = n_inner;
+  dim.os = n_inner;
+
+  fftw_iodim howmany[2];
+  howmany[0].n = n_outer;
+  howmany[0].is = N * n_inner;
+  howmany[0].os = N * n_inner;
+  howmany[1].n = n_inner;
+  howmany[1].is = 1;
+  howmany[1].os = 1;
+
+  return fftw_plan_guru_dft(1, &dim, 2, howmany, data, data, sign,
+                            FFTW_ESTIMATE);
+}
+
+/**
+ * @brief Execute a plan unless the local mesh it acts on is empty.
+ *
+ * @param plan The plan (or NULL).
+ */
+static void pencil_execute(const fftw_plan plan) {
+  if (plan != NULL) fftw_execute(plan);
+}
+
+/**
+ * @brief Set up the pencil decomposition of the mesh over all the ranks.
+ *
+ * This creates the communicators, allocates the local mesh and plans the
+ * transforms. All the ranks must call this function.
+ *
+ * @param p The #pm_mesh_pencils to initialise.
+ * @param N The size of the mesh.
+ * @param verbose Are we talkative?
+ */
+void pm_mesh_pencils_init(struct pm_mesh_pencils *p, const int N,
+                          const int verbose) {
+
+  int nr_nodes, nodeID;
+  MPI_Comm_size(MPI_COMM_WORLD, &nr_nodes);
+  MPI_Comm_rank(MPI_COMM_WORLD, &nodeID);
+
+  const int N_half_1 = N / 2 + 1;
+
+  p->N = N;
+  p->nodeID = nodeID;
+
+  /* Arrange the ranks on a grid */
+  pm_mesh_pencils_grid(N, nr_nodes, p->grid);
+  p->coord[0] = nodeID / p->grid[1];
+  p->coord[1] = nodeID % p->grid[1];
+
+  if (verbose)
+    message("Distributing the mesh over a %d x %d grid of pencils.",
+            p->grid[0], p->grid[1]);
+
+  /* Communicators for the patches and for the rows and columns of the grid */
+  if (MPI_Comm_dup(MPI_COMM_WORLD, &p->comm) != MPI_SUCCESS ||
+      MPI_Comm_split(MPI_COMM_WORLD, p->coord[0], p->coord[1],
+                     &p->row_comm) != MPI_SUCCESS ||
+      MPI_Comm_split(MPI_COMM_WORLD, p->coord[1], p->coord[0],
+                     &p->col_comm) != MPI_SUCCESS)
+    error("Failed to create the communicators of the mesh pencils.");
+
+  /* What part of the mesh do we hold? */
+  pencil_range(N, p->grid[0], p->coord[0], &p->x_start, &p->x_count);
+  pencil_range(N, p->grid[1], p->coord[1], &p->y_start, &p->y_count);
+  pencil_range(N, p->grid[0], p->coord[0], &p->ky_start, &p->ky_count);
+  pencil_range(N_half_1, p->grid[1], p->coord[1], &p->kz_start,
+               &p->kz_count);
+
+  /* Room for the largest of the local meshes along the way */
+  const size_t size_z = (size_t)p->x_count * p->y_count * N_half_1;
+  const size_t size_y = (size_t)p->x_count * N * p->kz_count;
+  const size_t size_x = (size_t)p->ky_count * N * p->kz_count;
+  p->alloc = max4(size_z, size_y, size_x, (size_t)1);
+
+  p->data = (fftw_complex *)fftw_malloc(p->alloc * sizeof(fftw_complex));
+  if (p->data == NULL) error("Failed to allocate the mesh pencils.");
+
+  /* The real to complex transforms along z work in place on the padded
+   * lines. The complex transforms along y and x are on the middle axis of
+   * the local mesh. */
+  const int nr_lines = p->x_count * p->y_count;
+  if (nr_lines > 0) {
+    p->forward_z = fftw_plan_many_dft_r2c(
+        1, &p->N, nr_lines, (double *)p->data, NULL, 1, 2 * N_half_1, p->data,
+        NULL, 1, N_half_1, FFTW_ESTIMATE | FFTW_DESTROY_INPUT);
+    p->inverse_z = fftw_plan_many_dft_c2r(
+        1, &p->N, nr_lines, p->data, NULL, 1, N_half_1, (double *)p->data,
+        NULL, 1, 2 * N_half_1, FFTW_ESTIMATE | FFTW_DESTROY_INPUT);
+  } else {
+    p->forward_z = NULL;
+    p->inverse_z = NULL;
+  }
+  p->forward_y = pencil_plan_middle_axis(p->data, N, p->x_count, p->kz_count,
+                                         FFTW_FORWARD);
+  p->inverse_y = pencil_plan_middle_axis(p->data, N, p->x_count, p->kz_count,
+                                         FFTW_BACKWARD);
+  p->forward_x = pencil_plan_middle_axis(p->data, N, p->ky_count,
+                                         p->kz_count, FFTW_FORWARD);
+  p->inverse_x = pencil_plan_middle_axis(p->data, N, p->ky_count,
+                                         p->kz_count, FFTW_BACKWARD);
+}
+
+/**
+ * @brief Free everything allocated by pm_mesh_pencils_init().
+ *
+ * @param p The #pm_mesh_pencils.
+ */
+void pm_mesh_pencils_clean(struct pm_mesh_pencils *p) {
+
+  fftw_plan plans[6] = {p->forward_x, p->forward_y, p->forward_z,
+                        p->inverse_x, p->inverse_y, p->inverse_z};
+  for (int i = 0; i < 6; ++i)
+    if (plans[i] != NULL) fftw_destroy_plan(plans[i]);
+
+  fftw_free(p->data);
+
+  MPI_Comm_free(&p->comm);
+  MPI_Comm_free(&p->row_comm);
+  MPI_Comm_free(&p->col_comm);
+
+  bzero(p, sizeof(struct pm_mesh_pencils));
+}
+
+/**
+ * @brief Number of complex numbers in a #pencil_block.
+ */
+static size_t pencil_block_count(const struct pencil_block *b) {
+  return (size_t)b->size[0] * b->size[1] * b->size[2];
+}
+
+/**
+ * @brief Copy a box of the local mesh to a contiguous buffer.
+ *
+ * @param data The local mesh.
+ * @param b The box to copy.
+ * @param buf The buffer.
+ */
+static void pencil_block_pack(const fftw_complex *data,
+                              const struct pencil_block *b,
+                              fftw_complex *buf) {
+
+  size_t count = 0;
+  for (int i = 0; i < b->size[0]; ++i) {
+    for (int j = 0; j < b->size[1]; ++j) {
+      const fftw_complex *row =
+          data + b->offset + i * b->stride[0] + j * b->stride[1];
+      for (int k = 0; k < b->size[2]; ++k) {
+        buf[count][0] = row[k * b->stride[2]][0];
+        buf[count][1] = row[k * b->stride[2]][1];
+        ++count;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Copy a contiguous buffer to a box of the local mesh.
+ *
+ * @param data The local mesh.
+ * @param b The box to fill.
+ * @param buf The buffer.
+ */
+static void pencil_block_unpack(fftw_complex *data,
+                                const struct pencil_block *b,
+                                const fftw_complex *buf) {
+
+  size_t count = 0;
+  for (int i = 0; i < b->size[0]; ++i) {
+    for (int j = 0; j < b->size[1]; ++j) {
+      fftw_complex *row =
+          data + b->offset + i * b->stride[0] + j * b->stride[1];
+      for (int k = 0; k < b->size[2]; ++k) {
+        row[k * b->stride[2]][0] = buf[count][0];
+        row[k * b->stride[2]][1] = buf[count][1];
+        ++count;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Exchange boxes of the local mesh between the ranks of a
+ * communicator.
+ *
+ * The boxes leaving this rank are packed and sent one peer at a time, such
+ * that the first messages are on their way while we pack the next ones.
+ * The incoming boxes are then unpacked in the order in which they arrive.
+ *
+ * The buffers only exist for the duration of the exchange. As the boxes are
+ * unpacked over the local mesh, all of them have to be packed first, but the
+ * receive buffer only needs room for the boxes of the other ranks.
+ *
+ * @param p The #pm_mesh_pencils.
+ * @param comm The communicator (a row or a column of the grid).
+ * @param send The box to send to each rank of the communicator.
+ * @param recv The box to fill with the data of each rank of the
+ * communicator.
+ */
+static void pencil_transpose(struct pm_mesh_pencils *p, MPI_Comm comm,
+                             const struct pencil_block *send,
+                             const struct pencil_block *recv) {
+
+  int nr_peers, rank;
+  MPI_Comm_size(comm, &nr_peers);
+  MPI_Comm_rank(comm, &rank);
+
+  size_t *send_offset = (size_t *)malloc(nr_peers * sizeof(size_t));
+  size_t *recv_offset = (size_t *)malloc(nr_peers * sizeof(size_t));
+  MPI_Request *requests =
+      (MPI_Request *)malloc(2 * nr_peers * sizeof(MPI_Request));
+  if (send_offset == NULL || recv_offset == NULL || requests == NULL)
+    error("Failed to allocate the transposition metadata.");
+  MPI_Request *send_requests = requests;
+  MPI_Request *recv_requests = requests + nr_peers;
+
+  /* Where the boxes go in the buffers, our own box being received from the
+   * send buffer directly */
+  size_t send_size = 0, recv_size = 0;
+  for (int q = 0; q < nr_peers; ++q) {
+    send_offset[q] = send_size;
+    recv_offset[q] = recv_size;
+    send_size += pencil_block_count(&send[q]);
+    if (q != rank) recv_size += pencil_block_count(&recv[q]);
+  }
+
+  fftw_complex *sendbuf = NULL, *recvbuf = NULL;
+  if (swift_memalign("mesh_pencils_send", (void **)&sendbuf,
+                     SWIFT_CACHE_ALIGNMENT,
+                     max(send_size, (size_t)1) * sizeof(fftw_complex)) != 0 ||
+      swift_memalign("mesh_pencils_recv", (void **)&recvbuf,
+                     SWIFT_CACHE_ALIGNMENT,
+                     max(recv_size, (size_t)1) * sizeof(fftw_complex)) != 0)
+    error("Failed to allocate the buffers of the mesh pencils.");
+
+  /* Post the receives */
+  for (int q = 0; q < nr_peers; ++q) {
+    const size_t count = pencil_block_count(&recv[q]);
+    if (q == rank || count == 0) {
+      recv_requests[q] = MPI_REQUEST_NULL;
+      continue;
+    }
+    if (2 * count > INT_MAX) error("Mesh pencils too large for MPI!");
+    MPI_Irecv(recvbuf + recv_offset[q], (int)(2 * count), MPI_DOUBLE, q, 0,
+              comm, &recv_requests[q]);
+  }
+
+  /* Pack and send the data for each peer */
+  for (int q = 0; q < nr_peers; ++q) {
+    const size_t count = pencil_block_count(&send[q]);
+    pencil_block_pack(p->data, &send[q], sendbuf + send_offset[q]);
+    if (q == rank || count == 0) {
+      send_requests[q] = MPI_REQUEST_NULL;
+      continue;
+    }
+    if (2 * count > INT_MAX) error("Mesh pencils too large for MPI!");
+    MPI_Isend(sendbuf + send_offset[q], (int)(2 * count), MPI_DOUBLE, q, 0,
+              comm, &send_requests[q]);
+  }
+
+  /* Our own data does not need to travel */
+  pencil_block_unpack(p->data, &recv[rank], sendbuf + send_offset[rank]);
+
+  /* Unpack the rest as it arrives */
+  while (1) {
+    int q;
+    MPI_Waitany(nr_peers, recv_requests, &q, MPI_STATUS_IGNORE);
+    if (q == MPI_UNDEFINED) break;
+    pencil_block_unpack(p->data, &recv[q], recvbuf + recv_offset[q]);
+  }
+  MPI_Waitall(nr_peers, send_requests, MPI_STATUSES_IGNORE);
+
+  swift_free("mesh_pencils_send", sendbuf);
+  swift_free("mesh_pencils_recv", recvbuf);
+  free(send_offset);
+  free(recv_offset);
+  free(requests);
+}
+
+/**
+ * @brief Transpose between the pencils along z and the pencils along y.
+ *
+ * The ranks of a row of the grid share the same x range. Along z, each of
+ * them holds all the kz for its y range. Along y, each holds all the y for
+ * its kz range.
+ *
+ * @param p The #pm_mesh_pencils.
+ * @param forward Are we going from z to y (1) or from y to z (0)?
+ */
+static void pencil_transpose_zy(struct pm_mesh_pencils *p,
+                                const int forward) {
+
+  const int N = p->N;
+  const int N_half_1 = N / 2 + 1;
+  const int nr_peers = p->grid[1];
+
+  struct pencil_block *z_blocks =
+      (struct pencil_block *)malloc(nr_peers * sizeof(struct pencil_block));
+  struct pencil_block *y_blocks =
+      (struct pencil_block *)malloc(nr_peers * sizeof(struct pencil_block));
+  if (z_blocks == NULL || y_blocks == NULL)
+    error("Failed to allocate the transposition blocks.");
+
+  for (int q = 0; q < nr_peers; ++q) {
+
+    int y_start, y_count, kz_start, kz_count;
+    pencil_range(N, nr_peers, q, &y_start, &y_count);
+    pencil_range(N_half_1, nr_peers, q, &kz_start, &kz_count);
+
+    /* The kz of peer q in our [x][y][kz] pencils */
+    z_blocks[q].offset = kz_start;
+    z_blocks[q].stride[0] = (size_t)p->y_count * N_half_1;
+    z_blocks[q].stride[1] = N_half_1;
+    z_blocks[q].stride[2] = 1;
+    z_blocks[q].size[0] = p->x_count;
+    z_blocks[q].size[1] = p->y_count;
+    z_blocks[q].size[2] = kz_count;
+
+    /* The y of peer q in our [x][y][kz] pencils */
+    y_blocks[q].offset = (size_t)y_start * p->kz_count;
+    y_blocks[q].stride[0] = (size_t)N * p->kz_count;
+    y_blocks[q].stride[1] = p->kz_count;
+    y_blocks[q].stride[2] = 1;
+    y_blocks[q].size[0] = p->x_count;
+    y_blocks[q].size[1] = y_count;
+    y_blocks[q].size[2] = p->kz_count;
+  }
+
+  if (forward)
+    pencil_transpose(p, p->row_comm, z_blocks, y_blocks);
+  else
+    pencil_transpose(p, p->row_comm, y_blocks, z_blocks);
+
+  free(z_blocks);
+  free(y_blocks);
+}
+
+/**
+ * @brief Transpose between the pencils along y and the pencils along x.
+ *
+ * The ranks of a column of the grid share the same kz range. Along y, each
+ * of them holds all the ky for its x range. Along x, each holds all the x
+ * for its ky range.
+ *
+ * @param p The #pm_mesh_pencils.
+ * @param forward Are we going from y to x (1) or from x to y (0)?
+ */
+static void pencil_transpose_yx(struct pm_mesh_pencils *p,
+                                const int forward) {
+
+  const int N = p->N;
+  const int nr_peers = p->grid[0];
+
+  struct pencil_block *y_blocks =
+      (struct pencil_block *)malloc(nr_peers * sizeof(struct pencil_block));
+  struct pencil_block *x_blocks =
+      (struct pencil_block *)malloc(nr_peers * sizeof(struct pencil_block));
+  if (y_blocks == NULL || x_blocks == NULL)
+    error("Failed to allocate the transposition blocks.");
+
+  for (int q = 0; q < nr_peers; ++q) {
+
+    int x_start, x_count, ky_start, ky_count;
+    pencil_range(N, nr_peers, q, &x_start, &x_count);
+    pencil_range(N, nr_peers, q, &ky_start, &ky_count);
+
+    /* The ky of peer q in our [x][ky][kz] pencils */
+    y_blocks[q].offset = (size_t)ky_start * p->kz_count;
+    y_blocks[q].stride[0] = (size_t)N * p->kz_count;
+    y_blocks[q].stride[1] = p->kz_count;
+    y_blocks[q].stride[2] = 1;
+    y_blocks[q].size[0] = p->x_count;
+    y_blocks[q].size[1] = ky_count;
+    y_blocks[q].size[2] = p->kz_count;
+
+    /* The x of peer q in our [ky][x][kz] pencils */
+    x_blocks[q].offset = (size_t)x_start * p->kz_count;
+    x_blocks[q].stride[0] = p->kz_count;
+    x_blocks[q].stride[1] = (size_t)N * p->kz_count;
+    x_blocks[q].stride[2] = 1;
+    x_blocks[q].size[0] = x_count;
+    x_blocks[q].size[1] = p->ky_count;
+    x_blocks[q].size[2] = p->kz_count;
+  }
+
+  if (forward)
+    pencil_transpose(p, p->col_comm, y_blocks, x_blocks);
+  else
+    pencil_transpose(p, p->col_comm, x_blocks, y_blocks);
+
+  free(y_blocks);
+  free(x_blocks);
+}
+
+/**
+ * @brief Real to complex FFT of the distributed mesh.
+ *
+ * On entry, the local mesh contains the real-space pencils. On exit, it
+ * contains the Fourier-space pencils. The transform is not normalised.
+ *
+ * @param p The #pm_mesh_pencils.
+ */
+void pm_mesh_pencils_forward(struct pm_mesh_pencils *p) {
+
+  pencil_execute(p->forward_z);
+  pencil_transpose_zy(p, /*forward=*/1);
+  pencil_execute(p->forward_y);
+  pencil_transpose_yx(p, /*forward=*/1);
+  pencil_execute(p->forward_x);
+}
+
+/**
+ * @brief Complex to real FFT of the distributed mesh.
+ *
+ * On entry, the local mesh contains the Fourier-space pencils. On exit, it
+ * contains the real-space pencils. The transform is not normalised.
+ *
+ * @param p The #pm_mesh_pencils.
+ */
+void pm_mesh_pencils_inverse(struct pm_mesh_pencils *p) {
+
+  pencil_execute(p->inverse_x);
+  pencil_transpose_yx(p, /*forward=*/0);
+  pencil_execute(p->inverse_y);
+  pencil_transpose_zy(p, /*forward=*/0);
+  pencil_execute(p->inverse_z);
+}
+
+/**
+ * @brief Pointer to the z line of the local real-space mesh at given
+ * x and y.
+ *
+ * @param p The #pm_mesh_pencils.
+ * @param x The x coordinate in the full mesh.
+ * @param y The y coordinate in the full mesh.
+ */
+static double *pencil_real_line(const struct pm_mesh_pencils *p, const int x,
+                                const int y) {
+
+#ifdef SWIFT_DEBUG_CHECKS
+  if (x < p->x_start || x >= p->x_start + p->x_count)
+    error("x coordinate not in the local mesh pencils!");
+  if (y < p->y_start || y >= p->y_start + p->y_count)
+    error("y coordinate not in the local mesh pencils!");
+#endif
+
+  const size_t line =
+      (size_t)(x - p->x_start) * p->y_count + (size_t)(y - p->y_start);
+  return (double *)p->data + line * 2 * (p->N / 2 + 1);
+}
+
+/**
+ * @brief Add the values of a box of the mesh to the local real-space mesh.
+ *
+ * @param p The #pm_mesh_pencils.
+ * @param b The box.
+ * @param values The values, stored as [x][y][z].
+ */
+static void pencil_add_block(const struct pm_mesh_pencils *p,
+                             const struct pm_mesh_block *b,
+                             const double *values) {
+
+  const int N = p->N;
+  size_t count = 0;
+  for (int i = 0; i < b->size[0]; ++i) {
+    for (int j = 0; j < b->size[1]; ++j) {
+      double *line = pencil_real_line(p, b->offset[0] + i, b->offset[1] + j);
+      int z = b->offset[2];
+      for (int k = 0; k < b->size[2]; ++k) {
+        line[z] += values[count++];
+        if (++z == N) z = 0;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Read the values of a box of the mesh from the local real-space
+ * mesh.
+ *
+ * @param p The #pm_mesh_pencils.
+ * @param b The box.
+ * @param values (return) The values, stored as [x][y][z].
+ */
+static void pencil_get_block(const struct pm_mesh_pencils *p,
+                             const struct pm_mesh_block *b, double *values) {
+
+  const int N = p->N;
+  size_t count = 0;
+  for (int i = 0; i < b->size[0]; ++i) {
+    for (int j = 0; j < b->size[1]; ++j) {
+      const double *line =
+          pencil_real_line(p, b->offset[0] + i, b->offset[1] + j);
+      int z = b->offset[2];
+      for (int k = 0; k < b->size[2]; ++k) {
+        values[count++] = line[z];
+        if (++z == N) z = 0;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Copy the values of a box of the mesh between a patch and a buffer.
+ *
+ * @param patch The #pm_mesh_patch.
+ * @param b The box.
+ * @param patch_start The first x and y coordinates of the box in the patch.
+ * @param values The values, stored as [x][y][z].
+ * @param to_patch Do we copy from the buffer to the patch (1) or the other
+ * way around (0)?
+ */
+static void pencil_patch_block_copy(struct pm_mesh_patch *patch,
+                                    const struct pm_mesh_block *b,
+                                    const int patch_start[2], double *values,
+                                    const int to_patch) {
+
+  const size_t line_size = b->size[2] * sizeof(double);
+  size_t count = 0;
+  for (int i = 0; i < b->size[0]; ++i) {
+    for (int j = 0; j < b->size[1]; ++j) {
+      double *line = patch->mesh + pm_mesh_patch_index(patch,
+                                                       patch_start[0] + i,
+                                                       patch_start[1] + j, 0);
+      if (to_patch)
+        memcpy(line, values + count, line_size);
+      else
+        memcpy(values + count, line, line_size);
+      count += b->size[2];
+    }
+  }
+}
+
+/**
+ * @brief Split a patch into the boxes stored on each rank.
+ *
+ * @param p The #pm_mesh_pencils.
+ * @param patch The #pm_mesh_patch.
+ * @param runs_x Scratch space for the runs along x.
+ * @param runs_y Scratch space for the runs along y.
+ * @param nr_runs (return) The number of runs along x and y.
+ */
+static void pencil_patch_split(const struct pm_mesh_pencils *p,
+                               const struct pm_mesh_patch *patch,
+                               struct pencil_run *runs_x,
+                               struct pencil_run *runs_y, int nr_runs[2]) {
+
+  nr_runs[0] = pencil_patch_runs(patch->mesh_min[0], patch->mesh_size[0],
+                                 p->N, p->grid[0], runs_x);
+  nr_runs[1] = pencil_patch_runs(patch->mesh_min[1], patch->mesh_size[1],
+                                 p->N, p->grid[1], runs_y);
+}
+
+/**
+ * @brief Construct one of the boxes of a patch.
+ *
+ * @param p The #pm_mesh_pencils.
+ * @param patch The #pm_mesh_patch.
+ * @param rx The run along x.
+ * @param ry The run along y.
+ * @param b (return) The box.
+ * @return The rank storing the box.
+ */
+static int pencil_patch_block(const struct pm_mesh_pencils *p,
+                              const struct pm_mesh_patch *patch,
+                              const struct pencil_run *rx,
+                              const struct pencil_run *ry,
+                              struct pm_mesh_block *b) {
+
+  const int N = p->N;
+  b->offset[0] = rx->mesh_start;
+  b->offset[1] = ry->mesh_start;
+  b->offset[2] = (patch->mesh_min[2] % N + N) % N;
+  b->size[0] = rx->count;
+  b->size[1] = ry->count;
+  b->size[2] = patch->mesh_size[2];
+  return rx->owner * p->grid[1] + ry->owner;
+}
+
+/**
+ * @brief Allocate the scratch space for the runs of the largest patch.
+ *
+ * @param local_patches The array of local patches.
+ * @param nr_patches The number of local patches.
+ * @param runs_x (return) The scratch space for the runs along x.
+ * @param runs_y (return) The scratch space for the runs along y.
+ */
+static void pencil_alloc_runs(const struct pm_mesh_patch *local_patches,
+                              const int nr_patches, struct pencil_run **runs_x,
+                              struct pencil_run **runs_y) {
+
+  int max_size = 1;
+  for (int i = 0; i < nr_patches; ++i) {
+    if (local_patches[i].mesh == NULL) continue;
+    max_size = max(max_size, local_patches[i].mesh_size[0]);
+    max_size = max(max_size, local_patches[i].mesh_size[1]);
+  }
+  *runs_x = (struct pencil_run *)malloc(max_size * sizeof(struct pencil_run));
+  *runs_y = (struct pencil_run *)malloc(max_size * sizeof(struct pencil_run));
+  if (*runs_x == NULL || *runs_y == NULL)
+    error("Failed to allocate the patch runs.");
+}
+
+/**
+ * @brief Convert the array of local patches to the real-space pencils of
+ * the distributed mesh.
+ *
+ * Each patch is cut into the boxes stored on each rank. The boxes of all the
+ * patches going to the same rank are sent in a single message made of a
+ * #pm_mesh_block header followed by the values of each box. The boxes that
+ * stay on this rank are added to the mesh while the messages travel and the
+ * others are added as they arrive.
+ *
+ * This function will clean the memory allocated by each of the entry
+ * in the local_patches array.
+ *
+ * @param p The #pm_mesh_pencils.
+ * @param local_patches The array of local patches.
+ * @param nr_patches The number of local patches.
+ * @param verbose Are we talkative?
+ */
+void mpi_mesh_local_patches_to_pencils(struct pm_mesh_pencils *p,
+                                       struct pm_mesh_patch *local_patches,
+                                       const int nr_patches,
+                                       const int verbose) {
+
+  const int nr_nodes = p->grid[0] * p->grid[1];
+  const int nodeID = p->nodeID;
+  const size_t header_size = pm_mesh_block_header_size;
+
+  ticks tic = getticks();
+
+  /* Start from an empty mesh */
+  memset(p->data, 0, p->alloc * sizeof(fftw_complex));
+
+  struct pencil_run *runs_x, *runs_y;
+  pencil_alloc_runs(local_patches, nr_patches, &runs_x, &runs_y);
+
+  /* Count the number of doubles to send to each rank */
+  size_t *nr_send = (size_t *)calloc(nr_nodes, sizeof(size_t));
+  size_t *nr_recv = (size_t *)malloc(nr_nodes * sizeof(size_t));
+  if (nr_send == NULL || nr_recv == NULL)
+    error("Failed to allocate the mesh message counts.");
+
+  for (int ip = 0; ip < nr_patches; ++ip) {
+    const struct pm_mesh_patch *patch = &local_patches[ip];
+    if (patch->mesh == NULL) continue;
+
+    int nr_runs[2];
+    pencil_patch_split(p, patch, runs_x, runs_y, nr_runs);
+    for (int a = 0; a < nr_runs[0]; ++a) {
+      for (int c = 0; c < nr_runs[1]; ++c) {
+        struct pm_mesh_block b;
+        const int dest =
+            pencil_patch_block(p, patch, &runs_x[a], &runs_y[c], &b);
+        if (dest == nodeID) continue;
+        nr_send[dest] +=
+            header_size + (size_t)b.size[0] * b.size[1] * b.size[2];
+      }
+    }
+  }
+
+  MPI_Alltoall(nr_send, sizeof(size_t), MPI_BYTE, nr_recv, sizeof(size_t),
+               MPI_BYTE, p->comm);
+
+  size_t *send_offset = (size_t *)malloc((nr_nodes + 1) * sizeof(size_t));
+  size_t *recv_offset = (size_t *)malloc((nr_nodes + 1) * sizeof(size_t));
+  MPI_Request *requests =
+      (MPI_Request *)malloc(2 * nr_nodes * sizeof(MPI_Request));
+  if (send_offset == NULL || recv_offset == NULL || requests == NULL)
+    error("Failed to allocate the mesh message offsets.");
+  MPI_Request *send_requests = requests;
+  MPI_Request *recv_requests = requests + nr_nodes;
+
+  send_offset[0] = 0;
+  recv_offset[0] = 0;
+  for (int q = 0; q < nr_nodes; ++q) {
+    send_offset[q + 1] = send_offset[q] + nr_send[q];
+    recv_offset[q + 1] = recv_offset[q] + nr_recv[q];
+  }
+
+  double *sendbuf, *recvbuf;
+  if (swift_memalign("mesh_patches_send", (void **)&sendbuf,
+                     SWIFT_CACHE_ALIGNMENT,
+                     max(send_offset[nr_nodes], (size_t)1) * sizeof(double)) !=
+          0 ||
+      swift_memalign("mesh_patches_recv", (void **)&recvbuf,
+                     SWIFT_CACHE_ALIGNMENT,
+                     max(recv_offset[nr_nodes], (size_t)1) * sizeof(double)) !=
+          0)
+    error("Failed to allocate the mesh patches buffers.");
+
+  /* Post the receives */
+  for (int q = 0; q < nr_nodes; ++q) {
+    if (nr_recv[q] == 0) {
+      recv_requests[q] = MPI_REQUEST_NULL;
+      continue;
+    }
+    if (nr_recv[q] > INT_MAX) error("Mesh patch message too large for MPI!");
+    MPI_Irecv(recvbuf + recv_offset[q], (int)nr_recv[q], MPI_DOUBLE, q, 0,
+              p->comm, &recv_requests[q]);
+  }
+
+  /* Pack the boxes going to other ranks */
+  size_t *fill = (size_t *)malloc(nr_nodes * sizeof(size_t));
+  if (fill == NULL) error("Failed to allocate the mesh message offsets.");
+  memcpy(fill, send_offset, nr_nodes * sizeof(size_t));
+
+  for (int ip = 0; ip < nr_patches; ++ip) {
+    struct pm_mesh_patch *patch = &local_patches[ip];
+    if (patch->mesh == NULL) continue;
+
+    int nr_runs[2];
+    pencil_patch_split(p, patch, runs_x, runs_y, nr_runs);
+    for (int a = 0; a < nr_runs[0]; ++a) {
+      for (int c = 0; c < nr_runs[1]; ++c) {
+        struct pm_mesh_block b;
+        const int dest =
+            pencil_patch_block(p, patch, &runs_x[a], &runs_y[c], &b);
+        if (dest == nodeID) continue;
+
+        const int patch_start[2] = {runs_x[a].patch_start,
+                                    runs_y[c].patch_start};
+        memcpy(sendbuf + fill[dest], &b, sizeof(struct pm_mesh_block));
+        pencil_patch_block_copy(patch, &b, patch_start,
+                                sendbuf + fill[dest] + header_size,
+                                /*to_patch=*/0);
+        fill[dest] += header_size + (size_t)b.size[0] * b.size[1] * b.size[2];
+      }
+    }
+  }
+  free(fill);
+
+  /* Send everything */
+  for (int q = 0; q < nr_nodes; ++q) {
+    if (nr_send[q] == 0) {
+      send_requests[q] = MPI_REQUEST_NULL;
+      continue;
+    }
+    if (nr_send[q] > INT_MAX) error("Mesh patch message too large for MPI!");
+    MPI_Isend(sendbuf + send_offset[q], (int)nr_send[q], MPI_DOUBLE, q, 0,
+              p->comm, &send_requests[q]);
+  }
+
+  if (verbose)
+    message(" - Packing and sending the mesh patches took %.3f %s.",
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+  tic = getticks();
+
+  /* While the messages travel, add the boxes that stay on this rank */
+  for (int ip = 0; ip < nr_patches; ++ip) {
+    struct pm_mesh_patch *patch = &local_patches[ip];
+    if (patch->mesh == NULL) continue;
+
+    int nr_runs[2];
+    pencil_patch_split(p, patch, runs_x, runs_y, nr_runs);
+    for (int a = 0; a < nr_runs[0]; ++a) {
+      for (int c = 0; c < nr_runs[1]; ++c) {
+        struct pm_mesh_block b;
+        const int dest =
+            pencil_patch_block(p, patch, &runs_x[a], &runs_y[c], &b);
+        if (dest != nodeID) continue;
+
+        /* Patches are contiguous along z so we add them line by line */
+        for (int i = 0; i < b.size[0]; ++i) {
+          for (int j = 0; j < b.size[1]; ++j) {
+            const struct pm_mesh_block line = {
+                {b.offset[0] + i, b.offset[1] + j, b.offset[2]},
+                {1, 1, b.size[2]}};
+            pencil_add_block(
+                p, &line,
+                patch->mesh + pm_mesh_patch_index(
+                                  patch, runs_x[a].patch_start + i,
+                                  runs_y[c].patch_start + j, 0));
+          }
+        }
+      }
+    }
+  }
+
+  /* Clean the local patches array */
+  for (int i = 0; i < nr_patches; ++i) pm_mesh_patch_clean(&local_patches[i]);
+
+  /* Add the other ranks' boxes as they arrive */
+  while (1) {
+    int q;
+    MPI_Waitany(nr_nodes, recv_requests, &q, MPI_STATUS_IGNORE);
+    if (q == MPI_UNDEFINED) break;
+
+    const double *msg = recvbuf + recv_offset[q];
+    size_t pos = 0;
+    while (pos < nr_recv[q]) {
+      struct pm_mesh_block b;
+      memcpy(&b, msg + pos, sizeof(struct pm_mesh_block));
+      pencil_add_block(p, &b, msg + pos + header_size);
+      pos += header_size + (size_t)b.size[0] * b.size[1] * b.size[2];
+    }
+  }
+  MPI_Waitall(nr_nodes, send_requests, MPI_STATUSES_IGNORE);
+
+  if (verbose)
+    message(" - Adding the mesh patches took %.3f %s.",
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+  /* Tidy up */
+  swift_free("mesh_patches_send", sendbuf);
+  swift_free("mesh_patches_recv", recvbuf);
+  free(requests);
+  free(send_offset);
+  free(recv_offset);
+  free(nr_send);
+  free(nr_recv);
+  free(runs_x);
+  free(runs_y);
+}
+
+/**
+ * @brief Retrieve the potential in the mesh cells we need to compute the
+ * force on particles on this MPI rank.
+ *
+ * Each local top-level cell gets a patch covering the cell and the stencil
+ * of the mesh forces. The patches are cut into the boxes stored on each rank
+ * and we send the list of boxes we need to each rank. Every rank replies to
+ * each request as soon as it arrives, while we copy the boxes stored
+ * locally.
+ *
+ * @param p The #pm_mesh_pencils containing the potential in real space.
+ * @param fac Inverse of the FFT mesh cell size
+ * @param s The #space containing the particles.
+ * @param local_patches The array of *local* mesh patches to fill.
+ * @param verbose Are we talkative?
+ */
+void mpi_mesh_fetch_potential_pencils(const struct pm_mesh_pencils *p,
+                                      const double fac, const struct space *s,
+                                      struct pm_mesh_patch *local_patches,
+                                      const int verbose) {
+
+  const int nr_nodes = p->grid[0] * p->grid[1];
+  const int nodeID = p->nodeID;
+  const int *local_cells = s->local_cells_top;
+  const int nr_local_cells = s->nr_local_cells;
+
+  ticks tic = getticks();
+
+  /* Create the patches we want to fill */
+  for (int icell = 0; icell < nr_local_cells; icell++) {
+    const struct cell *cell = &s->cells_top[local_cells[icell]];
+    if (cell->grav.count == 0) continue;
+    pm_mesh_patch_init_stencil(&local_patches[icell], cell, p->N, fac, s->dim);
+  }
+
+  struct pencil_run *runs_x, *runs_y;
+  pencil_alloc_runs(local_patches, nr_local_cells, &runs_x, &runs_y);
+
+  /* Count the boxes and values we need from each rank. The counts are stored
+   * as (boxes, values) pairs. */
+  size_t *nr_send = (size_t *)calloc(2 * nr_nodes, sizeof(size_t));
+  size_t *nr_recv = (size_t *)malloc(2 * nr_nodes * sizeof(size_t));
+  if (nr_send == NULL || nr_recv == NULL)
+    error("Failed to allocate the mesh message counts.");
+
+  for (int ip = 0; ip < nr_local_cells; ++ip) {
+    const struct pm_mesh_patch *patch = &local_patches[ip];
+    if (patch->mesh == NULL) continue;
+
+    int nr_runs[2];
+    pencil_patch_split(p, patch, runs_x, runs_y, nr_runs);
+    for (int a = 0; a < nr_runs[0]; ++a) {
+      for (int c = 0; c < nr_runs[1]; ++c) {
+        struct pm_mesh_block b;
+        const int dest =
+            pencil_patch_block(p, patch, &runs_x[a], &runs_y[c], &b);
+        if (dest == nodeID) continue;
+        nr_send[2 * dest] += 1;
+        nr_send[2 * dest + 1] += (size_t)b.size[0] * b.size[1] * b.size[2];
+      }
+    }
+  }
+
+  MPI_Alltoall(nr_send, 2 * sizeof(size_t), MPI_BYTE, nr_recv,
+               2 * sizeof(size_t), MPI_BYTE, p->comm);
+
+  /* Offsets of each rank's boxes and values in the buffers */
+  size_t *offsets = (size_t *)malloc(4 * (nr_nodes + 1) * sizeof(size_t));
+  if (offsets == NULL) error("Failed to allocate the mesh message offsets.");
+  size_t *send_blocks_offset = offsets;
+  size_t *send_values_offset = offsets + (nr_nodes + 1);
+  size_t *recv_blocks_offset = offsets + 2 * (nr_nodes + 1);
+  size_t *recv_values_offset = offsets + 3 * (nr_nodes + 1);
+  send_blocks_offset[0] = 0;
+  send_values_offset[0] = 0;
+  recv_blocks_offset[0] = 0;
+  recv_values_offset[0] = 0;
+  for (int q = 0; q < nr_nodes; ++q) {
+    send_blocks_offset[q + 1] = send_blocks_offset[q] + nr_send[2 * q];
+    send_values_offset[q + 1] = send_values_offset[q] + nr_send[2 * q + 1];
+    recv_blocks_offset[q + 1] = recv_blocks_offset[q] + nr_recv[2 * q];
+    recv_values_offset[q + 1] = recv_values_offset[q] + nr_recv[2 * q + 1];
+  }
+
+  /* The boxes we request, where their values will go, the boxes requested
+   * from us, the values we receive and the values we send back. */
+  const size_t nr_blocks_out = max(send_blocks_offset[nr_nodes], (size_t)1);
+  const size_t nr_blocks_in = max(recv_blocks_offset[nr_nodes], (size_t)1);
+  struct pm_mesh_block *blocks_out = (struct pm_mesh_block *)malloc(
+      nr_blocks_out * sizeof(struct pm_mesh_block));
+  struct pencil_target *targets = (struct pencil_target *)malloc(
+      nr_blocks_out * sizeof(struct pencil_target));
+  struct pm_mesh_block *blocks_in = (struct pm_mesh_block *)malloc(
+      nr_blocks_in * sizeof(struct pm_mesh_block));
+  if (blocks_out == NULL || targets == NULL || blocks_in == NULL)
+    error("Failed to allocate the mesh requests.");
+
+  double *values_in, *values_out;
+  if (swift_memalign(
+          "mesh_potential_recv", (void **)&values_in, SWIFT_CACHE_ALIGNMENT,
+          max(send_values_offset[nr_nodes], (size_t)1) * sizeof(double)) != 0 ||
+      swift_memalign(
+          "mesh_potential_send", (void **)&values_out, SWIFT_CACHE_ALIGNMENT,
+          max(recv_values_offset[nr_nodes], (size_t)1) * sizeof(double)) != 0)
+    error("Failed to allocate the mesh potential buffers.");
+
+  /* List the boxes we need from each rank */
+  size_t *fill = (size_t *)malloc(nr_nodes * sizeof(size_t));
+  if (fill == NULL) error("Failed to allocate the mesh message offsets.");
+  memcpy(fill, send_blocks_offset, nr_nodes * sizeof(size_t));
+
+  for (int ip = 0; ip < nr_local_cells; ++ip) {
+    const struct pm_mesh_patch *patch = &local_patches[ip];
+    if (patch->mesh == NULL) continue;
+
+    int nr_runs[2];
+    pencil_patch_split(p, patch, runs_x, runs_y, nr_runs);
+    for (int a = 0; a < nr_runs[0]; ++a) {
+      for (int c = 0; c < nr_runs[1]; ++c) {
+        struct pm_mesh_block b;
+        const int dest =
+            pencil_patch_block(p, patch, &runs_x[a], &runs_y[c], &b);
+        if (dest == nodeID) continue;
+        blocks_out[fill[dest]] = b;
+        targets[fill[dest]].patch = ip;
+        targets[fill[dest]].patch_start[0] = runs_x[a].patch_start;
+        targets[fill[dest]].patch_start[1] = runs_y[c].patch_start;
+        fill[dest]++;
+      }
+    }
+  }
+  free(fill);
+
+  /* Requests: sends of our requests, receives of the other ranks' requests,
+   * sends of our replies and receives of the other ranks' replies. */
+  MPI_Request *requests =
+      (MPI_Request *)malloc(4 * nr_nodes * sizeof(MPI_Request));
+  if (requests == NULL) error("Failed to allocate the MPI requests.");
+  MPI_Request *request_sends = requests;
+  MPI_Request *incoming = requests + nr_nodes;
+  MPI_Request *reply_sends = requests + 3 * nr_nodes;
+
+  for (int q = 0; q < 4 * nr_nodes; ++q) requests[q] = MPI_REQUEST_NULL;
+
+  /* Post the receives of the requests and of the replies. Both live in the
+   * incoming array such that we can serve them in the order they arrive. */
+  for (int q = 0; q < nr_nodes; ++q) {
+    const size_t nr_blocks = nr_recv[2 * q];
+    const size_t nr_values = nr_send[2 * q + 1];
+    if (nr_blocks * sizeof(struct pm_mesh_block) > INT_MAX ||
+        nr_values > INT_MAX)
+      error("Mesh potential message too large for MPI!");
+    if (nr_blocks > 0)
+      MPI_Irecv(blocks_in + recv_blocks_offset[q],
+                (int)(nr_blocks * sizeof(struct pm_mesh_block)), MPI_BYTE, q,
+                0, p->comm, &incoming[q]);
+    if (nr_values > 0)
+      MPI_Irecv(values_in + send_values_offset[q], (int)nr_values,
+                MPI_DOUBLE, q, 1, p->comm, &incoming[nr_nodes + q]);
+  }
+
+  /* Send our requests */
+  for (int q = 0; q < nr_nodes; ++q) {
+    const size_t nr_blocks = nr_send[2 * q];
+    if (nr_blocks == 0) continue;
+    if (nr_blocks * sizeof(struct pm_mesh_block) > INT_MAX)
+      error("Mesh potential message too large for MPI!");
+    MPI_Isend(blocks_out + send_blocks_offset[q],
+              (int)(nr_blocks * sizeof(struct pm_mesh_block)), MPI_BYTE, q, 0,
+              p->comm, &request_sends[q]);
+  }
+
+  if (verbose)
+    message(" - Sending the mesh requests took %.3f %s.",
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+  tic = getticks();
+
+  /* While the requests travel, fill the boxes stored on this rank */
+  for (int ip = 0; ip < nr_local_cells; ++ip) {
+    struct pm_mesh_patch *patch = &local_patches[ip];
+    if (patch->mesh == NULL) continue;
+
+    int nr_runs[2];
+    pencil_patch_split(p, patch, runs_x, runs_y, nr_runs);
+    for (int a = 0; a < nr_runs[0]; ++a) {
+      for (int c = 0; c < nr_runs[1]; ++c) {
+        struct pm_mesh_block b;
+        const int dest =
+            pencil_patch_block(p, patch, &runs_x[a], &runs_y[c], &b);
+        if (dest != nodeID) continue;
+
+        for (int i = 0; i < b.size[0]; ++i) {
+          for (int j = 0; j < b.size[1]; ++j) {
+            const struct pm_mesh_block line = {
+                {b.offset[0] + i, b.offset[1] + j, b.offset[2]},
+                {1, 1, b.size[2]}};
+            pencil_get_block(
+                p, &line,
+                patch->mesh + pm_mesh_patch_index(
+                                  patch, runs_x[a].patch_start + i,
+                                  runs_y[c].patch_start + j, 0));
+          }
+        }
+      }
+    }
+  }
+
+  /* Serve the requests and unpack the replies as they arrive */
+  while (1) {
+    int index;
+    MPI_Waitany(2 * nr_nodes, incoming, &index, MPI_STATUS_IGNORE);
+    if (index == MPI_UNDEFINED) break;
+
+    if (index < nr_nodes) {
+
+      /* A request from rank q: reply with the values of its boxes */
+      const int q = index;
+      double *reply = values_out + recv_values_offset[q];
+      size_t pos = 0;
+      for (size_t ib = recv_blocks_offset[q]; ib < recv_blocks_offset[q + 1];
+           ++ib) {
+        const struct pm_mesh_block *b = &blocks_in[ib];
+        pencil_get_block(p, b, reply + pos);
+        pos += (size_t)b->size[0] * b->size[1] * b->size[2];
+      }
+      MPI_Isend(reply, (int)pos, MPI_DOUBLE, q, 1, p->comm, &reply_sends[q]);
+
+    } else {
+
+      /* A reply from rank q: copy the values to the patches */
+      const int q = index - nr_nodes;
+      double *reply = values_in + send_values_offset[q];
+      size_t pos = 0;
+      for (size_t ib = send_blocks_offset[q]; ib < send_blocks_offset[q + 1];
+           ++ib) {
+        const struct pm_mesh_block *b = &blocks_out[ib];
+        pencil_patch_block_copy(&local_patches[targets[ib].patch], b,
+                                targets[ib].patch_start, reply + pos,
+                                /*to_patch=*/1);
+        pos += (size_t)b->size[0] * b->size[1] * b->size[2];
+      }
+    }
+  }
+  MPI_Waitall(nr_nodes, request_sends, MPI_STATUSES_IGNORE);
+  MPI_Waitall(nr_nodes, reply_sends, MPI_STATUSES_IGNORE);
+
+  if (verbose)
+    message(" - Exchanging the potential took %.3f %s.",
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+
+  /* Tidy up */
+  swift_free("mesh_potential_recv", values_in);
+  swift_free("mesh_potential_send", values_out);
+  free(requests);
+  free(blocks_out);
+  free(blocks_in);
+  free(targets);
+  free(offsets);
+  free(nr_send);
+  free(nr_recv);
+  free(runs_x);
+  free(runs_y);
+}
+
+#endif /* WITH_MPI && HAVE_MPI_FFTW */
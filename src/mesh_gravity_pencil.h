@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#ifndef SWIFT_MESH_GRAVITY_PENCIL_H
+#define SWIFT_MESH_GRAVITY_PENCIL_H
+
+/* Config parameters. */
+#include <config.h>
+
+/* MPI headers. */
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+
+#ifdef HAVE_FFTW
+#include <fftw3.h>
+#endif
+
+/* Forward declarations */
+struct space;
+struct pm_mesh_patch;
+
+#if defined(WITH_MPI) && defined(HAVE_MPI_FFTW)
+
+/**
+ * @brief Pencil decomposition of the distributed mesh.
+ *
+ * The MPI ranks form a grid[0] x grid[1] grid. In real space, each rank
+ * holds the full z extent of the mesh for a block of x and y coordinates.
+ * In Fourier space, each rank holds the full kx extent for a block of ky and
+ * kz. The 3D FFT is made of local 1D FFTs along the complete axis separated
+ * by transpositions within the rows and columns of the grid. Unlike slabs,
+ * the number of ranks sharing the work is thus not limited to N.
+ */
+struct pm_mesh_pencils {
+
+  /*! Side-length of the mesh */
+  int N;
+
+  /*! Number of ranks along x (ky) and along y (kz) */
+  int grid[2];
+
+  /*! Position of this rank in the grid */
+  int coord[2];
+
+  /*! Rank of this node */
+  int nodeID;
+
+  /*! Communicator used to exchange the mesh patches */
+  MPI_Comm comm;
+
+  /*! Ranks with the same range of x coordinates as us */
+  MPI_Comm row_comm;
+
+  /*! Ranks with the same range of kz as us */
+  MPI_Comm col_comm;
+
+  /*! Range of x coordinates of the local real-space pencils */
+  int x_start, x_count;
+
+  /*! Range of y coordinates of the local real-space pencils */
+  int y_start, y_count;
+
+  /*! Range of ky of the local Fourier-space pencils */
+  int ky_start, ky_count;
+
+  /*! Range of kz of the local Fourier-space pencils */
+  int kz_start, kz_count;
+
+  /*! Local mesh. Either the real-space pencils stored as
+   * [x][y][2 * (N / 2 + 1)] or the Fourier-space pencils stored as
+   * [ky][kx][kz] */
+  fftw_complex *data;
+
+  /*! Number of complex numbers in the local mesh */
+  size_t alloc;
+
+  /*! Plans of the 1D transforms along each axis */
+  fftw_plan forward_x, forward_y, forward_z;
+  fftw_plan inverse_x, inverse_y, inverse_z;
+};
+
+void pm_mesh_pencils_init(struct pm_mesh_pencils *p, const int N,
+                          const int verbose);
+
+void pm_mesh_pencils_clean(struct pm_mesh_pencils *p);
+
+void pm_mesh_pencils_forward(struct pm_mesh_pencils *p);
+
+void pm_mesh_pencils_inverse(struct pm_mesh_pencils *p);
+
+void mpi_mesh_local_patches_to_pencils(struct pm_mesh_pencils *p,
+                                       struct pm_mesh_patch *local_patches,
+                                       const int nr_patches,
+                                       const int verbose);
+
+void mpi_mesh_fetch_potential_pencils(const struct pm_mesh_pencils *p,
+                                      const double fac, const struct space *s,
+                                      struct pm_mesh_patch *local_patches,
+                                      const int verbose);
+
+#endif /* WITH_MPI && HAVE_MPI_FFTW */
+
+#endif /* SWIFT_MESH_GRAVITY_PENCIL_H */
@@ -33,6 +33,7 @@
 
 /* MPI data type for the multipole transfer and reduction */
 MPI_Datatype multipole_mpi_type;
+MPI_Datatype multipole_foreign_mpi_type;
 MPI_Op multipole_mpi_reduce_op;
 
 /**
@@ -82,12 +83,21 @@ void multipole_create_mpi_types(void) {
     error("Failed to create MPI type for multipole.");
   }
 
+  /* Same for the reduced version sent to the proxies */
+  if (MPI_Type_contiguous(
+          sizeof(struct gravity_tensors_foreign) / sizeof(unsigned char),
+          MPI_BYTE, &multipole_foreign_mpi_type) != MPI_SUCCESS ||
+      MPI_Type_commit(&multipole_foreign_mpi_type) != MPI_SUCCESS) {
+    error("Failed to create MPI type for foreign multipole.");
+  }
+
   /* And the reduction operator */
   MPI_Op_create(gravity_tensors_mpi_reduce, 1, &multipole_mpi_reduce_op);
 }
 
 void multipole_free_mpi_types(void) {
   MPI_Type_free(&multipole_mpi_type);
+  MPI_Type_free(&multipole_foreign_mpi_type);
   MPI_Op_free(&multipole_mpi_reduce_op);
 }
 #endif
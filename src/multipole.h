@@ -53,6 +53,9 @@ __attribute__((nonnull)) INLINE static void gravity_reset(
 
   bzero(m, sizeof(struct gravity_tensors));
   m->m_pole.min_old_a_grav_norm = FLT_MAX;
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+  m->mac_tolerance_factor = 1.f;
+#endif
 }
 
 /**
@@ -2023,7 +2026,7 @@ __attribute__((nonnull)) INLINE static void gravity_M2L_nonsym(
 
   /* Compute distance */
   const float r2 = dx * dx + dy * dy + dz * dz;
-  const float r_inv = 1. / sqrtf(r2);
+  const float r_inv = 1.f / sqrtf(r2);
 
   /* Compute all derivatives */
   struct potential_derivatives_M2L pot;
@@ -2073,7 +2076,7 @@ __attribute__((nonnull)) INLINE static void gravity_M2L_symmetric(
 
   /* Compute distance */
   const float r2 = dx * dx + dy * dy + dz * dz;
-  const float r_inv = 1. / sqrtf(r2);
+  const float r_inv = 1.f / sqrtf(r2);
 
   /* Compute all derivatives */
   struct potential_derivatives_M2L pot;
@@ -2148,7 +2151,7 @@ __attribute__((nonnull)) INLINE static void gravity_P2L(
 
   /* Compute distance */
   const float r2 = dx * dx + dy * dy + dz * dz;
-  const float r_inv = 1. / sqrtf(r2);
+  const float r_inv = 1.f / sqrtf(r2);
 
   /* Compute all derivatives */
   struct potential_derivatives_M2L pot;
@@ -22,6 +22,9 @@
 /* Config parameters. */
 #include <config.h>
 
+/* Some standard headers. */
+#include <float.h>
+
 /* Local includes */
 #include "binomial.h"
 #include "gravity_properties.h"
@@ -30,6 +33,18 @@
 #include "minmax.h"
 #include "multipole_struct.h"
 
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+
+/*! Range over which the error-budget MAC can rescale the tolerance of a
+ * cell */
+#define MAC_budget_min_factor 0.125f
+#define MAC_budget_max_factor 8.f
+
+/*! Maximal change of the tolerance scaling of a cell over one step */
+#define MAC_budget_max_step 2.f
+
+#endif
+
 /**
  * @brief Compute the inverse of the force estimator entering the MAC
  *
@@ -126,8 +141,15 @@ __attribute__((nonnull, pure)) INLINE static int gravity_M2L_accept(
   /* Maximal mass */
   const float M_max = max(A->m_pole.M_000, B->m_pole.M_000);
 
-  /* Get the relative tolerance */
+  /* Get the relative tolerance (rescaled for this sink cell during the
+   * tree-walk if we are running with an error budget) */
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+  const float eps = (props->use_MAC_error_budget && !use_rebuild_sizes)
+                        ? props->adaptive_tolerance * A->mac_tolerance_factor
+                        : props->adaptive_tolerance;
+#else
   const float eps = props->adaptive_tolerance;
+#endif
 
   /* Get the basic geometric critical angle */
   const float theta_crit = props->theta_crit;
@@ -206,6 +228,128 @@ __attribute__((nonnull, pure)) INLINE static int gravity_M2L_accept_symmetric(
          gravity_M2L_accept(props, B, A, r2, use_rebuild_sizes, periodic);
 }
 
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+
+/**
+ * @brief Estimates the error made on the acceleration of the particles in A
+ * when using the multipole in B to update the field tensor in A.
+ *
+ * This is the left-hand side of the accuracy condition of the adaptive MAC
+ * (Dehnen 2014 eq. 16) expressed as an acceleration, computed with the
+ * current sizes of the multipoles.
+ *
+ * @param props The properties of the gravity scheme.
+ * @param A The gravity tensors that we update (sink).
+ * @param B The gravity tensors that act as a source.
+ * @param r2 The square of the distance between the centres of mass of A and B.
+ * @param periodic Are we using periodic BCs?
+ */
+__attribute__((nonnull, pure)) INLINE static float gravity_M2L_error_estimate(
+    const struct gravity_props *props, const struct gravity_tensors *restrict A,
+    const struct gravity_tensors *restrict B, const float r2,
+    const int periodic) {
+
+  /* Order of the expansion */
+  const int p = 2;
+
+  /* Sizes of the multipoles */
+  const float rho_A = A->r_max;
+  const float rho_B = B->r_max;
+  const float rho_max = max(rho_A, rho_B);
+
+  /* Get the softening */
+  const float max_softening =
+      max(A->m_pole.max_softening, B->m_pole.max_softening);
+
+  /* Compute the error estimator (without the 1/M_B term that cancels out) */
+  float E_BA_term = 0.f;
+  for (int n = 0; n <= p; ++n) {
+    E_BA_term +=
+        binomial(p, n) * B->m_pole.power[n] * integer_powf(rho_A, p - n);
+  }
+  E_BA_term *= 8.f;
+  if (rho_A + rho_B > 0.f) {
+    E_BA_term *= rho_max;
+    E_BA_term /= (rho_A + rho_B);
+  }
+
+  /* Compute r^p = (r^2)^(p/2) */
+  const float r_to_p = integer_powf(r2, (p / 2));
+
+  float f_MAC_inv;
+  if (periodic && props->consider_truncation_in_MAC) {
+    f_MAC_inv = gravity_f_MAC_inverse(max_softening, props->r_s_inv, r2);
+  } else {
+    f_MAC_inv = r2;
+  }
+
+  return E_BA_term / (r_to_p * f_MAC_inv);
+}
+
+/**
+ * @brief Updates the MAC tolerance scaling of a cell based on the error
+ * accumulated by its field tensor over the current step.
+ *
+ * The error includes the contributions received by all the parents of the
+ * cell. Cells below their budget get a looser tolerance for the next
+ * tree-walk, cells above it get a tighter one.
+ *
+ * @param props The properties of the gravity scheme.
+ * @param m The #gravity_tensors of the cell.
+ */
+__attribute__((nonnull)) INLINE static void gravity_MAC_budget_update(
+    const struct gravity_props *props, struct gravity_tensors *m) {
+
+  /* Get the mimimal acceleration in the cell */
+  const float min_a_grav = m->m_pole.min_old_a_grav_norm;
+
+  /* No estimate of the accelerations yet? */
+  if (min_a_grav <= 0.f || min_a_grav == FLT_MAX) return;
+
+  /* Error budget of the particles in this cell */
+  const float target = props->MAC_error_budget * min_a_grav;
+  const float err = m->pot.mac_error;
+
+  float ratio = (err > 0.f) ? target / err : MAC_budget_max_step;
+  ratio = min(ratio, MAC_budget_max_step);
+  ratio = max(ratio, 1.f / MAC_budget_max_step);
+
+  float factor = m->mac_tolerance_factor * ratio;
+  factor = min(factor, MAC_budget_max_factor);
+  factor = max(factor, MAC_budget_min_factor);
+  m->mac_tolerance_factor = factor;
+}
+
+/**
+ * @brief Decides whether a pair of cells that failed the MAC should be
+ * interacted directly rather than opened further.
+ *
+ * This is only considered for a leaf facing a cell whose progeny are all
+ * leaves. Opening the split cell then leads to one M2L (or one direct sum)
+ * per progeny. We use the direct sum instead when it is cheaper than that
+ * many M2L kernels, with the relative cost of the two kernels given by the
+ * MAC_budget_M2L_cost parameter.
+ *
+ * @param props The properties of the gravity scheme.
+ * @param gcount_i The number of #gpart in the first cell.
+ * @param gcount_j The number of #gpart in the second cell.
+ * @param num_progeny The number of progeny of the cell that would be opened
+ * (0 if some of them are split).
+ */
+__attribute__((nonnull, pure)) INLINE static int gravity_budget_use_direct(
+    const struct gravity_props *props, const int gcount_i, const int gcount_j,
+    const int num_progeny) {
+
+  if (num_progeny == 0) return 0;
+
+  const float cost_pp = (float)gcount_i * (float)gcount_j;
+  const float cost_open = (float)num_progeny * props->MAC_budget_M2L_cost;
+
+  return cost_pp <= cost_open;
+}
+
+#endif /* SWIFT_GRAVITY_MAC_ERROR_BUDGET */
+
 /**
  * Compute the distance above which an M2L kernel is allowed to be used.
  *
@@ -100,6 +100,11 @@ struct grav_tensor {
 
 #endif
 
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+  /* Estimated error of the M2L contributions received by this tensor */
+  float mac_error;
+#endif
+
   /* Has this tensor received any contribution? */
   char interacted;
 };
@@ -215,10 +220,45 @@ struct gravity_tensors {
 
       /*! Upper limit of the CoM<->gpart distance at the last rebuild */
       double r_max_rebuild;
+
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+      /*! Scaling of the MAC tolerance when this cell is a sink (error-budget
+       * MAC only) */
+      float mac_tolerance_factor;
+#endif
     };
   };
 } SWIFT_STRUCT_ALIGN;
 
+/**
+ * @brief The part of a #gravity_tensors needed by the other ranks.
+ *
+ * The field tensor of a cell is only ever updated by the rank owning it so
+ * it is left out of the multipole exchanges.
+ */
+struct gravity_tensors_foreign {
+
+  /*! Multipole mass */
+  struct multipole m_pole;
+
+  /*! Centre of mass of the matter dsitribution */
+  double CoM[3];
+
+  /*! Centre of mass of the matter dsitribution at the last rebuild */
+  double CoM_rebuild[3];
+
+  /*! Upper limit of the CoM<->gpart distance */
+  double r_max;
+
+  /*! Upper limit of the CoM<->gpart distance at the last rebuild */
+  double r_max_rebuild;
+
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+  /*! Scaling of the MAC tolerance (error-budget MAC only) */
+  float mac_tolerance_factor;
+#endif
+};
+
 /**
  * @brief Values returned by the M2P kernel.
  */
@@ -236,6 +276,7 @@ struct reduced_grav_tensor {
 #ifdef WITH_MPI
 /* MPI datatypes for transfers */
 extern MPI_Datatype multipole_mpi_type;
+extern MPI_Datatype multipole_foreign_mpi_type;
 extern MPI_Op multipole_mpi_reduce_op;
 
 void multipole_create_mpi_types(void);
@@ -412,6 +412,8 @@ struct neutrino_response_tp_data {
   double boxlen;
   int slice_offset;
   int slice_width;
+  int kz_offset;
+  int kz_width;
 
   /* Interpolation properties */
   double inv_delta_log_k;
@@ -457,6 +459,8 @@ void neutrino_response_apply_neutrino_response_mapper(void *map_data,
 
   /* Find what slice of the full mesh is stored on this MPI rank */
   const int slice_offset = data->slice_offset;
+  const int kz_offset = data->kz_offset;
+  const int kz_width = data->kz_width;
 
   /* Range of x coordinates in the full mesh handled by this call */
   const int x_start = ((fftw_complex *)map_data - frho) + slice_offset;
@@ -465,7 +469,7 @@ void neutrino_response_apply_neutrino_response_mapper(void *map_data,
   /* Loop over the x range corresponding to this thread */
   for (int x = x_start; x < x_end; x++) {
     for (int y = 0; y < N; y++) {
-      for (int z = 0; z < N_half + 1; z++) {
+      for (int z = kz_offset; z < kz_offset + kz_width; z++) {
 
         /* Compute the wavevector (U_L^-1) */
         const double k_x = (x > N_half) ? (x - N) * delta_k : x * delta_k;
@@ -501,8 +505,8 @@ void neutrino_response_apply_neutrino_response_mapper(void *map_data,
 #endif
 
         /* Apply to the mesh */
-        const int index =
-            N * (N_half + 1) * (x - slice_offset) + (N_half + 1) * y + z;
+        const int index = N * kz_width * (x - slice_offset) + kz_width * y +
+                          (z - kz_offset);
         frho[index][0] *= correction;
         frho[index][1] *= correction;
       }
@@ -522,11 +526,14 @@ void neutrino_response_apply_neutrino_response_mapper(void *map_data,
  * @param slice_offset The x coordinate of the start of the slice on this MPI
  * rank
  * @param slice_width The width of the local slice on this MPI rank
+ * @param kz_offset The first kz stored on this MPI rank
+ * @param kz_width The number of kz stored on this MPI rank
  * @param verbose Are we talkative?
  */
 void neutrino_response_compute(const struct space *s, struct pm_mesh *mesh,
                                struct threadpool *tp, fftw_complex *frho,
                                const int slice_offset, const int slice_width,
+                               const int kz_offset, const int kz_width,
                                int verbose) {
 #ifdef HAVE_FFTW
 
@@ -572,6 +579,8 @@ void neutrino_response_compute(const struct space *s, struct pm_mesh *mesh,
   data.boxlen = boxlen;
   data.slice_offset = slice_offset;
   data.slice_width = slice_width;
+  data.kz_offset = kz_offset;
+  data.kz_width = kz_width;
   data.inv_delta_log_k = inv_delta_log_k;
   data.log_k_min = log_k_min;
   data.a_index = a_index;
@@ -587,7 +596,8 @@ void neutrino_response_compute(const struct space *s, struct pm_mesh *mesh,
                  &data);
 
   /* Correct singularity at (0,0,0) */
-  if (slice_offset == 0 && slice_width > 0) {
+  if (slice_offset == 0 && slice_width > 0 && kz_offset == 0 &&
+      kz_width > 0) {
     frho[0][0] = 0.;
     frho[0][1] = 0.;
   }
@@ -75,6 +75,7 @@ void neutrino_response_clean(struct neutrino_response *numesh);
 void neutrino_response_compute(const struct space *s, struct pm_mesh *mesh,
                                struct threadpool *tp, fftw_complex *frho,
                                const int slice_offset, const int slice_width,
+                               const int kz_offset, const int kz_width,
                                int verbose);
 #endif /* HAVE_FFTW */
 
@@ -66,7 +66,9 @@
 #include "xmf.h"
 
 /* The current limit of ROMIO (the underlying MPI-IO layer) is 2GB */
+#ifndef HDF5_PARALLEL_IO_MAX_BYTES
 #define HDF5_PARALLEL_IO_MAX_BYTES 2147000000LL
+#endif
 
 /* Are we timing the i/o? */
 //#define IO_SPEED_MEASUREMENT
@@ -352,12 +354,7 @@ void read_array_parallel(hid_t grp, struct io_props props, size_t N,
     /* Compute how many items are left */
     if (N > max_chunk_size) {
       N -= max_chunk_size;
-      props.field += max_chunk_size * props.partSize; /* char* on the field */
-      props.parts += max_chunk_size;                  /* part* on the part */
-      props.xparts += max_chunk_size;                 /* xpart* on the xpart */
-      props.gparts += max_chunk_size;                 /* gpart* on the gpart */
-      props.sparts += max_chunk_size;                 /* spart* on the spart */
-      props.bparts += max_chunk_size;                 /* bpart* on the bpart */
+      io_props_skip(&props, max_chunk_size);
       offset += max_chunk_size;
       redo = 1;
     } else {
@@ -683,12 +680,7 @@ void write_array_parallel(const struct engine* e, hid_t grp,
     /* Compute how many items are left */
     if (N > max_chunk_size) {
       N -= max_chunk_size;
-      props.field += max_chunk_size * props.partSize; /* char* on the field */
-      props.parts += max_chunk_size;                  /* part* on the part */
-      props.xparts += max_chunk_size;                 /* xpart* on the xpart */
-      props.gparts += max_chunk_size;                 /* gpart* on the gpart */
-      props.sparts += max_chunk_size;                 /* spart* on the spart */
-      props.bparts += max_chunk_size;                 /* bpart* on the bpart */
+      io_props_skip(&props, max_chunk_size);
       offset += max_chunk_size;
       redo = 1;
     } else {
@@ -790,6 +782,9 @@ void read_ic_parallel(char* fileName, const struct unit_system* internal_units,
   *Ngas = 0, *Ngparts = 0, *Ngparts_background = 0, *Nstars = 0,
   *Nblackholes = 0, *Nsinks = 0, *Nnuparts = 0;
 
+  if (ics_metadata->region_read)
+    error("Reading a region of the ICs is not supported in MPI runs.");
+
   /* Open file */
   /* message("Opening file '%s' as IC.", fileName); */
   hid_t h_plist_id = H5Pcreate(H5P_FILE_ACCESS);
@@ -1655,9 +1650,10 @@ void write_output_parallel(struct engine* e,
   /* Write the location of the particles in the arrays */
   io_write_cell_offsets(h_grp_cells, e->s->cdim, e->s->dim, e->s->cells_top,
                         e->s->nr_cells, e->s->width, mpi_rank,
-                        /*distributed=*/0, subsample, subsample_fraction,
-                        e->snapshot_output_count, N_total, offset, to_write,
-                        numFields, internal_units, snapshot_units);
+                        /*distributed=*/0, /*node_files=*/NULL, subsample,
+                        subsample_fraction, e->snapshot_output_count, N_total,
+                        offset, to_write, numFields, internal_units,
+                        snapshot_units);
 
   /* Close everything */
   if (mpi_rank == 0) {
@@ -1748,13 +1744,7 @@ void write_output_parallel(struct engine* e,
     bzero(list, 100 * sizeof(struct io_props));
     size_t Nparticles = 0;
 
-    struct part* parts_written = NULL;
-    struct xpart* xparts_written = NULL;
-    struct gpart* gparts_written = NULL;
-    struct velociraptor_gpart_data* gpart_group_data_written = NULL;
-    struct spart* sparts_written = NULL;
-    struct bpart* bparts_written = NULL;
-    struct sink* sinks_written = NULL;
+    size_t* index_written = NULL;
 
     /* Write particle fields from the particle structure */
     switch (ptype) {
@@ -1775,26 +1765,17 @@ void write_output_parallel(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           Nparticles = Ngas_written;
 
-          /* Allocate temporary arrays */
-          if (swift_memalign("parts_written", (void**)&parts_written,
-                             part_align,
-                             Ngas_written * sizeof(struct part)) != 0)
-            error("Error while allocating temporary memory for parts");
-          if (swift_memalign("xparts_written", (void**)&xparts_written,
-                             xpart_align,
-                             Ngas_written * sizeof(struct xpart)) != 0)
-            error("Error while allocating temporary memory for xparts");
-
-          /* Collect the particles we want to write */
-          io_collect_parts_to_write(
-              parts, xparts, parts_written, xparts_written,
-              subsample[swift_type_gas], subsample_fraction[swift_type_gas],
-              e->snapshot_output_count, Ngas, Ngas_written);
+          /* Select the particles we want to write */
+          index_written =
+              io_select_parts_to_write(e, parts, subsample[swift_type_gas],
+                                       subsample_fraction[swift_type_gas],
+                                       e->snapshot_output_count, Ngas,
+                                       Ngas_written);
 
           /* Select the fields to write */
-          io_select_hydro_fields(parts_written, xparts_written, with_cosmology,
-                                 with_cooling, with_temperature, with_fof,
-                                 with_stf, with_rt, e, &num_fields, list);
+          io_select_hydro_fields(parts, xparts, with_cosmology, with_cooling,
+                                 with_temperature, with_fof, with_stf, with_rt,
+                                 e, &num_fields, list);
         }
       } break;
 
@@ -1813,32 +1794,15 @@ void write_output_parallel(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           Nparticles = Ndm_written;
 
-          /* Allocate temporary array */
-          if (swift_memalign("gparts_written", (void**)&gparts_written,
-                             gpart_align,
-                             Ndm_written * sizeof(struct gpart)) != 0)
-            error("Error while allocating temporary memory for gparts");
-
-          if (with_stf) {
-            if (swift_memalign(
-                    "gpart_group_written", (void**)&gpart_group_data_written,
-                    gpart_align,
-                    Ndm_written * sizeof(struct velociraptor_gpart_data)) != 0)
-              error(
-                  "Error while allocating temporary memory for gparts STF "
-                  "data");
-          }
-
-          /* Collect the non-inhibited DM particles from gpart */
-          io_collect_gparts_to_write(
-              gparts, e->s->gpart_group_data, gparts_written,
-              gpart_group_data_written, subsample[swift_type_dark_matter],
+          /* Select the non-inhibited DM particles from gpart */
+          index_written = io_select_gparts_to_write(
+              e, gparts, subsample[swift_type_dark_matter],
               subsample_fraction[swift_type_dark_matter],
-              e->snapshot_output_count, Ntot, Ndm_written, with_stf);
+              e->snapshot_output_count, Ntot, Ndm_written);
 
           /* Select the fields to write */
-          io_select_dm_fields(gparts_written, gpart_group_data_written,
-                              with_fof, with_stf, e, &num_fields, list);
+          io_select_dm_fields(gparts, e->s->gpart_group_data, with_fof,
+                              with_stf, e, &num_fields, list);
         }
       } break;
 
@@ -1847,33 +1811,15 @@ void write_output_parallel(struct engine* e,
         /* Ok, we need to fish out the particles we want */
         Nparticles = Ndm_background;
 
-        /* Allocate temporary array */
-        if (swift_memalign("gparts_written", (void**)&gparts_written,
-                           gpart_align,
-                           Ndm_background * sizeof(struct gpart)) != 0)
-          error("Error while allocating temporart memory for gparts");
-
-        if (with_stf) {
-          if (swift_memalign(
-                  "gpart_group_written", (void**)&gpart_group_data_written,
-                  gpart_align,
-                  Ndm_background * sizeof(struct velociraptor_gpart_data)) != 0)
-            error(
-                "Error while allocating temporart memory for gparts STF "
-                "data");
-        }
-
-        /* Collect the non-inhibited DM particles from gpart */
-        io_collect_gparts_background_to_write(
-            gparts, e->s->gpart_group_data, gparts_written,
-            gpart_group_data_written,
-            subsample[swift_type_dark_matter_background],
+        /* Select the non-inhibited DM particles from gpart */
+        index_written = io_select_gparts_background_to_write(
+            e, gparts, subsample[swift_type_dark_matter_background],
             subsample_fraction[swift_type_dark_matter_background],
-            e->snapshot_output_count, Ntot, Ndm_background, with_stf);
+            e->snapshot_output_count, Ntot, Ndm_background);
 
         /* Select the fields to write */
-        io_select_dm_fields(gparts_written, gpart_group_data_written, with_fof,
-                            with_stf, e, &num_fields, list);
+        io_select_dm_fields(gparts, e->s->gpart_group_data, with_fof, with_stf,
+                            e, &num_fields, list);
       } break;
 
       case swift_type_neutrino: {
@@ -1881,32 +1827,15 @@ void write_output_parallel(struct engine* e,
         /* Ok, we need to fish out the particles we want */
         Nparticles = Ndm_neutrino;
 
-        /* Allocate temporary array */
-        if (swift_memalign("gparts_written", (void**)&gparts_written,
-                           gpart_align,
-                           Ndm_neutrino * sizeof(struct gpart)) != 0)
-          error("Error while allocating temporart memory for gparts");
-
-        if (with_stf) {
-          if (swift_memalign(
-                  "gpart_group_written", (void**)&gpart_group_data_written,
-                  gpart_align,
-                  Ndm_neutrino * sizeof(struct velociraptor_gpart_data)) != 0)
-            error(
-                "Error while allocating temporart memory for gparts STF "
-                "data");
-        }
-
-        /* Collect the non-inhibited DM particles from gpart */
-        io_collect_gparts_neutrino_to_write(
-            gparts, e->s->gpart_group_data, gparts_written,
-            gpart_group_data_written, subsample[swift_type_neutrino],
+        /* Select the non-inhibited DM particles from gpart */
+        index_written = io_select_gparts_neutrino_to_write(
+            e, gparts, subsample[swift_type_neutrino],
             subsample_fraction[swift_type_neutrino], e->snapshot_output_count,
-            Ntot, Ndm_neutrino, with_stf);
+            Ntot, Ndm_neutrino);
 
         /* Select the fields to write */
-        io_select_neutrino_fields(gparts_written, gpart_group_data_written,
-                                  with_fof, with_stf, e, &num_fields, list);
+        io_select_neutrino_fields(gparts, e->s->gpart_group_data, with_fof,
+                                  with_stf, e, &num_fields, list);
 
       } break;
 
@@ -1925,21 +1854,16 @@ void write_output_parallel(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           Nparticles = Nsinks_written;
 
-          /* Allocate temporary arrays */
-          if (swift_memalign("sinks_written", (void**)&sinks_written,
-                             sink_align,
-                             Nsinks_written * sizeof(struct sink)) != 0)
-            error("Error while allocating temporary memory for sink");
-
-          /* Collect the particles we want to write */
-          io_collect_sinks_to_write(
-              sinks, sinks_written, subsample[swift_type_sink],
-              subsample_fraction[swift_type_sink], e->snapshot_output_count,
-              Nsinks, Nsinks_written);
+          /* Select the particles we want to write */
+          index_written =
+              io_select_sinks_to_write(e, sinks, subsample[swift_type_sink],
+                                       subsample_fraction[swift_type_sink],
+                                       e->snapshot_output_count, Nsinks,
+                                       Nsinks_written);
 
           /* Select the fields to write */
-          io_select_sink_fields(sinks_written, with_cosmology, with_fof,
-                                with_stf, e, &num_fields, list);
+          io_select_sink_fields(sinks, with_cosmology, with_fof, with_stf, e,
+                                &num_fields, list);
         }
       } break;
 
@@ -1958,21 +1882,16 @@ void write_output_parallel(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           Nparticles = Nstars_written;
 
-          /* Allocate temporary arrays */
-          if (swift_memalign("sparts_written", (void**)&sparts_written,
-                             spart_align,
-                             Nstars_written * sizeof(struct spart)) != 0)
-            error("Error while allocating temporary memory for sparts");
-
-          /* Collect the particles we want to write */
-          io_collect_sparts_to_write(
-              sparts, sparts_written, subsample[swift_type_stars],
-              subsample_fraction[swift_type_stars], e->snapshot_output_count,
-              Nstars, Nstars_written);
+          /* Select the particles we want to write */
+          index_written =
+              io_select_sparts_to_write(e, sparts, subsample[swift_type_stars],
+                                        subsample_fraction[swift_type_stars],
+                                        e->snapshot_output_count, Nstars,
+                                        Nstars_written);
 
           /* Select the fields to write */
-          io_select_star_fields(sparts_written, with_cosmology, with_fof,
-                                with_stf, with_rt, e, &num_fields, list);
+          io_select_star_fields(sparts, with_cosmology, with_fof, with_stf,
+                                with_rt, e, &num_fields, list);
         }
       } break;
 
@@ -1991,21 +1910,15 @@ void write_output_parallel(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           Nparticles = Nblackholes_written;
 
-          /* Allocate temporary arrays */
-          if (swift_memalign("bparts_written", (void**)&bparts_written,
-                             bpart_align,
-                             Nblackholes_written * sizeof(struct bpart)) != 0)
-            error("Error while allocating temporary memory for bparts");
-
-          /* Collect the particles we want to write */
-          io_collect_bparts_to_write(
-              bparts, bparts_written, subsample[swift_type_black_hole],
+          /* Select the particles we want to write */
+          index_written = io_select_bparts_to_write(
+              e, bparts, subsample[swift_type_black_hole],
               subsample_fraction[swift_type_black_hole],
               e->snapshot_output_count, Nblackholes, Nblackholes_written);
 
           /* Select the fields to write */
-          io_select_bh_fields(bparts_written, with_cosmology, with_fof,
-                              with_stf, e, &num_fields, list);
+          io_select_bh_fields(bparts, with_cosmology, with_fof, with_stf, e,
+                              &num_fields, list);
         }
       } break;
 
@@ -2013,6 +1926,9 @@ void write_output_parallel(struct engine* e,
         error("Particle Type %d not yet supported. Aborting", ptype);
     }
 
+    /* Read the selected particles through their indices */
+    io_set_write_index(list, num_fields, index_written);
+
     /* Did the user specify a non-standard default for the entire particle
      * type? */
     const enum lossy_compression_schemes compression_level_current_default =
@@ -2038,14 +1954,7 @@ void write_output_parallel(struct engine* e,
     }
 
     /* Free temporary array */
-    if (parts_written) swift_free("parts_written", parts_written);
-    if (xparts_written) swift_free("xparts_written", xparts_written);
-    if (gparts_written) swift_free("gparts_written", gparts_written);
-    if (gpart_group_data_written)
-      swift_free("gpart_group_written", gpart_group_data_written);
-    if (sparts_written) swift_free("sparts_written", sparts_written);
-    if (bparts_written) swift_free("bparts_written", bparts_written);
-    if (sinks_written) swift_free("sinks_written", sinks_written);
+    if (index_written) swift_free("index_written", index_written);
 
 #ifdef IO_SPEED_MEASUREMENT
     MPI_Barrier(MPI_COMM_WORLD);
@@ -54,6 +54,119 @@
 #error "Invalid choice of external potential"
 #endif
 
+/* Local includes. */
+#include "gravity.h"
+#include "minmax.h"
+#include "part.h"
+
+/*! Number of #gpart evaluated together by
+ * external_gravity_acceleration_batch() */
+#define external_gravity_batch_size 64
+
+/**
+ * @brief Computes the gravitational acceleration of a particle due to the
+ * external potential.
+ *
+ * @param time The current time.
+ * @param potential The #external_potential used in the run.
+ * @param phys_const The physical constants in internal units.
+ * @param g Pointer to the g-particle data.
+ */
+__attribute__((always_inline)) INLINE static void external_gravity_acceleration(
+    double time, const struct external_potential* restrict potential,
+    const struct phys_const* restrict phys_const, struct gpart* restrict g) {
+
+  float pot;
+  external_gravity_acceleration_kernel(time, potential, phys_const, g->x[0],
+                                       g->x[1], g->x[2], &g->a_grav[0],
+                                       &g->a_grav[1], &g->a_grav[2], &pot);
+  gravity_add_comoving_potential(g, pot);
+}
+
+/**
+ * @brief Computes the gravitational acceleration due to the external
+ * potential for a set of particles.
+ *
+ * The positions and accelerations are copied to separate x/y/z arrays such
+ * that the loop over the potential's kernel can be vectorized. The
+ * accelerations are copied back by assignment as some potentials overwrite
+ * them rather than add to them.
+ *
+ * @param time The current time.
+ * @param potential The #external_potential used in the run.
+ * @param phys_const The physical constants in internal units.
+ * @param gparts Pointers to the g-particles.
+ * @param count The number of particles.
+ */
+__attribute__((always_inline)) INLINE static void
+external_gravity_acceleration_batch(
+    double time, const struct external_potential* restrict potential,
+    const struct phys_const* restrict phys_const, struct gpart** gparts,
+    const int count) {
+
+  double x[external_gravity_batch_size];
+  double y[external_gravity_batch_size];
+  double z[external_gravity_batch_size];
+  float a_x[external_gravity_batch_size];
+  float a_y[external_gravity_batch_size];
+  float a_z[external_gravity_batch_size];
+  float pot[external_gravity_batch_size];
+
+  for (int offset = 0; offset < count; offset += external_gravity_batch_size) {
+
+    const int n = min(count - offset, external_gravity_batch_size);
+    struct gpart** batch = gparts + offset;
+
+    /* Gather */
+    for (int i = 0; i < n; i++) {
+      x[i] = batch[i]->x[0];
+      y[i] = batch[i]->x[1];
+      z[i] = batch[i]->x[2];
+      a_x[i] = batch[i]->a_grav[0];
+      a_y[i] = batch[i]->a_grav[1];
+      a_z[i] = batch[i]->a_grav[2];
+    }
+
+    /* Compute */
+    for (int i = 0; i < n; i++)
+      external_gravity_acceleration_kernel(time, potential, phys_const, x[i],
+                                           y[i], z[i], &a_x[i], &a_y[i],
+                                           &a_z[i], &pot[i]);
+
+    /* Scatter */
+    for (int i = 0; i < n; i++) {
+      batch[i]->a_grav[0] = a_x[i];
+      batch[i]->a_grav[1] = a_y[i];
+      batch[i]->a_grav[2] = a_z[i];
+      gravity_add_comoving_potential(batch[i], pot[i]);
+    }
+  }
+}
+
+#ifndef EXTERNAL_POTENTIAL_HAS_FORCE_FREE_REGION
+
+/**
+ * @brief Is the acceleration from the external potential zero everywhere
+ * within a given box?
+ *
+ * Only potentials with a finite range (see
+ * #EXTERNAL_POTENTIAL_HAS_FORCE_FREE_REGION) provide their own version.
+ *
+ * @param time The current time.
+ * @param potential The #external_potential used in the run.
+ * @param box_min The lower corner of the box.
+ * @param box_max The upper corner of the box.
+ */
+__attribute__((always_inline)) INLINE static int
+external_gravity_box_is_force_free(
+    double time, const struct external_potential* restrict potential,
+    const double box_min[3], const double box_max[3]) {
+
+  return 0;
+}
+
+#endif
+
 /* Now, some generic functions, defined in the source file */
 void potential_init(struct swift_params* parameter_file,
                     const struct phys_const* phys_const,
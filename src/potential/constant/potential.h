@@ -67,20 +67,29 @@ __attribute__((always_inline)) INLINE static float external_gravity_timestep(
  * @param time The current time.
  * @param potential The #external_potential used in the run.
  * @param phys_const The physical constants in internal units.
- * @param g Pointer to the g-particle data.
+ * @param x The x coordinate of the particle.
+ * @param y The y coordinate of the particle.
+ * @param z The z coordinate of the particle.
+ * @param a_x (in/out) The x component of the acceleration of the particle.
+ * @param a_y (in/out) The y component of the acceleration of the particle.
+ * @param a_z (in/out) The z component of the acceleration of the particle.
+ * @param pot (return) The potential of the particle due to the external
+ * potential.
  */
-__attribute__((always_inline)) INLINE static void external_gravity_acceleration(
-    double time, const struct external_potential* potential,
-    const struct phys_const* const phys_const, struct gpart* g) {
+__attribute__((always_inline)) INLINE static void
+external_gravity_acceleration_kernel(
+    double time, const struct external_potential* restrict potential,
+    const struct phys_const* restrict phys_const, const double x,
+    const double y, const double z, float* restrict a_x, float* restrict a_y,
+    float* restrict a_z, float* restrict pot) {
 
-  const float gh = g->x[0] * potential->g[0] + g->x[1] * potential->g[1] +
-                   g->x[2] * potential->g[2];
-  const float pot = -gh / 3.f;
+  const float gh =
+      x * potential->g[0] + y * potential->g[1] + z * potential->g[2];
+  *pot = -gh / 3.f;
 
-  g->a_grav[0] += potential->g[0];
-  g->a_grav[1] += potential->g[1];
-  g->a_grav[2] += potential->g[2];
-  gravity_add_comoving_potential(g, pot);
+  *a_x += potential->g[0];
+  *a_y += potential->g[1];
+  *a_z += potential->g[2];
 }
 
 /**
@@ -163,13 +163,23 @@ __attribute__((always_inline)) INLINE static float external_gravity_timestep(
  * @param time The current time in internal units.
  * @param potential The properties of the potential.
  * @param phys_const The physical constants in internal units.
- * @param g Pointer to the g-particle data.
+ * @param x The x coordinate of the particle.
+ * @param y The y coordinate of the particle.
+ * @param z The z coordinate of the particle.
+ * @param a_x (in/out) The x component of the acceleration of the particle.
+ * @param a_y (in/out) The y component of the acceleration of the particle.
+ * @param a_z (in/out) The z component of the acceleration of the particle.
+ * @param pot (return) The potential of the particle due to the external
+ * potential.
  */
-__attribute__((always_inline)) INLINE static void external_gravity_acceleration(
+__attribute__((always_inline)) INLINE static void
+external_gravity_acceleration_kernel(
     double time, const struct external_potential* restrict potential,
-    const struct phys_const* restrict phys_const, struct gpart* restrict g) {
+    const struct phys_const* restrict phys_const, const double x,
+    const double y, const double z, float* restrict a_x, float* restrict a_y,
+    float* restrict a_z, float* restrict pot) {
 
-  const float dx = g->x[0] - potential->x_disc;
+  const float dx = x - potential->x_disc;
   const float abs_dx = fabsf(dx);
   const float t_growth = potential->growth_time;
   const float t_growth_inv = potential->growth_time_inv;
@@ -184,31 +194,54 @@ __attribute__((always_inline)) INLINE static void external_gravity_acceleration(
   const float reduction_factor = time < t_growth ? time * t_growth_inv : 1.f;
 
   /* Truncated or not ? */
-  float a_x;
-  float pot;
+  float acc;
   if (abs_dx < x_trunc) {
 
     /* Acc. 2 pi sigma tanh(x/b) */
-    a_x = reduction_factor * norm_over_G * tanhf(abs_dx * b_inv);
-    pot = -reduction_factor * norm_over_G * logf(coshf(abs_dx * b_inv)) * b;
+    acc = reduction_factor * norm_over_G * tanhf(abs_dx * b_inv);
+    *pot = -reduction_factor * norm_over_G * logf(coshf(abs_dx * b_inv)) * b;
   } else if (abs_dx < x_max) {
 
     /* Acc. 2 pi sigma tanh(x/b) [1/2 + 1/2cos((x-xmax)/(pi x_trans))] */
-    a_x =
+    acc =
         reduction_factor * norm_over_G * tanhf(abs_dx * b_inv) *
         (0.5f + 0.5f * cosf((float)(M_PI) * (abs_dx - x_trunc) * x_trans_inv));
-    pot = 0.f;
+    *pot = 0.f;
   } else {
 
     /* Acc. 0 */
-    a_x = 0.f;
-    pot = 0.f;
+    acc = 0.f;
+    *pot = 0.f;
   }
 
   /* Get the correct sign. Recall G is multipiled in later on */
-  if (dx > 0) g->a_grav[0] -= a_x;
-  if (dx < 0) g->a_grav[0] += a_x;
-  gravity_add_comoving_potential(g, pot);
+  if (dx > 0) *a_x -= acc;
+  if (dx < 0) *a_x += acc;
+}
+
+/* The disc has a finite range along x */
+#define EXTERNAL_POTENTIAL_HAS_FORCE_FREE_REGION
+
+/**
+ * @brief Is the acceleration along x due to a hydrostatic disc zero everywhere
+ * within a given box?
+ *
+ * The accelerations and the potential vanish beyond x_max on both sides of
+ * the disc.
+ *
+ * @param time The current time.
+ * @param potential The #external_potential used in the run.
+ * @param box_min The lower corner of the box.
+ * @param box_max The upper corner of the box.
+ */
+__attribute__((always_inline)) INLINE static int
+external_gravity_box_is_force_free(
+    double time, const struct external_potential* restrict potential,
+    const double box_min[3], const double box_max[3]) {
+
+  const double x_disc = potential->x_disc;
+  const double x_max = potential->x_max;
+  return (box_min[0] >= x_disc + x_max) || (box_max[0] <= x_disc - x_max);
 }
 
 /**
@@ -110,28 +110,37 @@ __attribute__((always_inline)) INLINE static float external_gravity_timestep(
  * @param time The current time.
  * @param potential The #external_potential used in the run.
  * @param phys_const The physical constants in internal units.
- * @param g Pointer to the g-particle data.
+ * @param x The x coordinate of the particle.
+ * @param y The y coordinate of the particle.
+ * @param z The z coordinate of the particle.
+ * @param a_x (in/out) The x component of the acceleration of the particle.
+ * @param a_y (in/out) The y component of the acceleration of the particle.
+ * @param a_z (in/out) The z component of the acceleration of the particle.
+ * @param pot (return) The potential of the particle due to the external
+ * potential.
  */
-__attribute__((always_inline)) INLINE static void external_gravity_acceleration(
-    double time, const struct external_potential* potential,
-    const struct phys_const* const phys_const, struct gpart* g) {
+__attribute__((always_inline)) INLINE static void
+external_gravity_acceleration_kernel(
+    double time, const struct external_potential* restrict potential,
+    const struct phys_const* restrict phys_const, const double x,
+    const double y, const double z, float* restrict a_x, float* restrict a_y,
+    float* restrict a_z, float* restrict pot) {
 
   const float G = phys_const->const_newton_G;
-  const float dx = g->x[0] - potential->x[0];
-  const float dy = g->x[1] - potential->x[1];
-  const float dz = g->x[2] - potential->x[2];
+  const float dx = x - potential->x[0];
+  const float dy = y - potential->x[1];
+  const float dz = z - potential->x[2];
   const float r2_plus_epsilon2 =
       dx * dx + dy * dy + dz * dz + potential->epsilon2;
   const float r2_plus_epsilon2_inv = 1.f / r2_plus_epsilon2;
 
   const float acc = -potential->vrot2_over_G * r2_plus_epsilon2_inv;
-  const float pot = -potential->vrot2_over_G * logf(sqrtf(r2_plus_epsilon2)) /
-                    (4. * M_PI * G);
+  *pot = -potential->vrot2_over_G * logf(sqrtf(r2_plus_epsilon2)) /
+         (4. * M_PI * G);
 
-  g->a_grav[0] += acc * dx;
-  g->a_grav[1] += acc * dy;
-  g->a_grav[2] += acc * dz;
-  gravity_add_comoving_potential(g, pot);
+  *a_x += acc * dx;
+  *a_y += acc * dy;
+  *a_z += acc * dz;
 }
 
 /**
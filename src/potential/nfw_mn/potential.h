@@ -145,15 +145,25 @@ __attribute__((always_inline)) INLINE static float external_gravity_timestep(
  * @param time The current time.
  * @param potential The #external_potential used in the run.
  * @param phys_const The physical constants in internal units.
- * @param g Pointer to the g-particle data.
+ * @param x The x coordinate of the particle.
+ * @param y The y coordinate of the particle.
+ * @param z The z coordinate of the particle.
+ * @param a_x (in/out) The x component of the acceleration of the particle.
+ * @param a_y (in/out) The y component of the acceleration of the particle.
+ * @param a_z (in/out) The z component of the acceleration of the particle.
+ * @param pot (return) The potential of the particle due to the external
+ * potential.
  */
-__attribute__((always_inline)) INLINE static void external_gravity_acceleration(
+__attribute__((always_inline)) INLINE static void
+external_gravity_acceleration_kernel(
     double time, const struct external_potential* restrict potential,
-    const struct phys_const* restrict phys_const, struct gpart* restrict g) {
+    const struct phys_const* restrict phys_const, const double x,
+    const double y, const double z, float* restrict a_x, float* restrict a_y,
+    float* restrict a_z, float* restrict pot) {
 
-  const float dx = g->x[0] - potential->x[0];
-  const float dy = g->x[1] - potential->x[1];
-  const float dz = g->x[2] - potential->x[2];
+  const float dx = x - potential->x[0];
+  const float dy = y - potential->x[1];
+  const float dz = z - potential->x[2];
 
   /* First for the NFW part */
   const float R2 = dx * dx + dy * dy;
@@ -167,10 +177,9 @@ __attribute__((always_inline)) INLINE static void external_gravity_acceleration(
   const float pot_nfw =
       -potential->pre_factor * logf(1.0f + r / potential->r_s) * r_inv;
 
-  g->a_grav[0] += acc_nfw * dx;
-  g->a_grav[1] += acc_nfw * dy;
-  g->a_grav[2] += acc_nfw * dz;
-  gravity_add_comoving_potential(g, pot_nfw);
+  *a_x += acc_nfw * dx;
+  *a_y += acc_nfw * dy;
+  *a_z += acc_nfw * dz;
 
   /* Now the the MN disk */
   const float f1 = sqrtf(potential->Zdisk * potential->Zdisk + dz * dz);
@@ -179,10 +188,10 @@ __attribute__((always_inline)) INLINE static void external_gravity_acceleration(
   const float mn_term = potential->Rdisk + sqrtf(potential->Zdisk + dz * dz);
   const float pot_mn = -potential->Mdisk / sqrtf(R2 + mn_term * mn_term);
 
-  g->a_grav[0] -= potential->Mdisk * f3 * dx;
-  g->a_grav[1] -= potential->Mdisk * f3 * dy;
-  g->a_grav[2] -= potential->Mdisk * f3 * (f2 / f1) * dz;
-  gravity_add_comoving_potential(g, pot_mn);
+  *a_x -= potential->Mdisk * f3 * dx;
+  *a_y -= potential->Mdisk * f3 * dy;
+  *a_z -= potential->Mdisk * f3 * (f2 / f1) * dz;
+  *pot = pot_nfw + pot_mn;
 }
 
 /**
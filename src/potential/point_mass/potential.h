@@ -104,22 +104,32 @@ __attribute__((always_inline)) INLINE static float external_gravity_timestep(
  * @param time The current time.
  * @param potential The proerties of the external potential.
  * @param phys_const The physical constants in internal units.
- * @param g Pointer to the g-particle data.
+ * @param x The x coordinate of the particle.
+ * @param y The y coordinate of the particle.
+ * @param z The z coordinate of the particle.
+ * @param a_x (in/out) The x component of the acceleration of the particle.
+ * @param a_y (in/out) The y component of the acceleration of the particle.
+ * @param a_z (in/out) The z component of the acceleration of the particle.
+ * @param pot (return) The potential of the particle due to the external
+ * potential.
  */
-__attribute__((always_inline)) INLINE static void external_gravity_acceleration(
+__attribute__((always_inline)) INLINE static void
+external_gravity_acceleration_kernel(
     double time, const struct external_potential* restrict potential,
-    const struct phys_const* restrict phys_const, struct gpart* restrict g) {
+    const struct phys_const* restrict phys_const, const double x,
+    const double y, const double z, float* restrict a_x, float* restrict a_y,
+    float* restrict a_z, float* restrict pot) {
 
-  const float dx = g->x[0] - potential->x[0];
-  const float dy = g->x[1] - potential->x[1];
-  const float dz = g->x[2] - potential->x[2];
+  const float dx = x - potential->x[0];
+  const float dy = y - potential->x[1];
+  const float dz = z - potential->x[2];
   const float rinv = 1.f / sqrtf(dx * dx + dy * dy + dz * dz);
   const float rinv3 = rinv * rinv * rinv;
 
-  g->a_grav[0] += -potential->mass * dx * rinv3;
-  g->a_grav[1] += -potential->mass * dy * rinv3;
-  g->a_grav[2] += -potential->mass * dz * rinv3;
-  gravity_add_comoving_potential(g, -potential->mass * rinv);
+  *a_x += -potential->mass * dx * rinv3;
+  *a_y += -potential->mass * dy * rinv3;
+  *a_z += -potential->mass * dz * rinv3;
+  *pot = -potential->mass * rinv;
 }
 
 /**
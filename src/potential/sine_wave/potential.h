@@ -73,22 +73,31 @@ __attribute__((always_inline)) INLINE static float external_gravity_timestep(
  * @param time The current time in internal units.
  * @param potential The properties of the potential.
  * @param phys_const The physical constants in internal units.
- * @param g Pointer to the g-particle data.
+ * @param x The x coordinate of the particle.
+ * @param y The y coordinate of the particle.
+ * @param z The z coordinate of the particle.
+ * @param a_x (in/out) The x component of the acceleration of the particle.
+ * @param a_y (in/out) The y component of the acceleration of the particle.
+ * @param a_z (in/out) The z component of the acceleration of the particle.
+ * @param pot (return) The potential of the particle due to the external
+ * potential.
  */
-__attribute__((always_inline)) INLINE static void external_gravity_acceleration(
+__attribute__((always_inline)) INLINE static void
+external_gravity_acceleration_kernel(
     double time, const struct external_potential* restrict potential,
-    const struct phys_const* restrict phys_const, struct gpart* restrict g) {
+    const struct phys_const* restrict phys_const, const double x,
+    const double y, const double z, float* restrict a_x, float* restrict a_y,
+    float* restrict a_z, float* restrict pot) {
 
   float Acorr = 1.;
   if (time < potential->growth_time) Acorr = time / potential->growth_time;
 
-  g->a_grav[0] = potential->amplitude * Acorr * sinf(2. * M_PI * g->x[0]) /
-                 phys_const->const_newton_G;
-
-  const float pot = potential->amplitude * Acorr * cosf(2. * M_PI * g->x[0]) /
-                    (phys_const->const_newton_G * 2. * M_PI);
+  /* Note that the acceleration along x is replaced, not accumulated */
+  *a_x = potential->amplitude * Acorr * sinf(2. * M_PI * x) /
+         phys_const->const_newton_G;
 
-  gravity_add_comoving_potential(g, pot);
+  *pot = potential->amplitude * Acorr * cosf(2. * M_PI * x) /
+         (phys_const->const_newton_G * 2. * M_PI);
 }
 
 /**
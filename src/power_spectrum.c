@@ -31,6 +31,7 @@
 /* Standard headers */
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
 
 /* This object's header. */
 #include "power_spectrum.h"
@@ -1236,6 +1237,120 @@ void power_spectrum(const enum power_type type1, const enum power_type type2,
 
 #endif /* HAVE_FFTW */
 
+#ifdef HAVE_FFTW
+
+/**
+ * @brief Make the FFTW plans of the power spectrum grids.
+ *
+ * Does require us to allocate the grids, but we delete them right away.
+ * Plans can only be used for the same FFTW call.
+ *
+ * @param p The #power_spectrum_data.
+ */
+static void power_make_fftw_plans(struct power_spectrum_data* p) {
+
+  const int Ngrid = p->Ngrid;
+
+  /* Grid is padded to allow for in-place FFT */
+  p->powgrid = fftw_alloc_real(Ngrid * Ngrid * (Ngrid + 2));
+  /* Pointer to grid to interpret it as complex data */
+  p->powgridft = (fftw_complex*)p->powgrid;
+
+  p->fftplanpow = fftw_plan_dft_r2c_3d(Ngrid, Ngrid, Ngrid, p->powgrid,
+                                       p->powgridft, FFTW_MEASURE);
+
+  fftw_free(p->powgrid);
+  p->powgrid = NULL;
+  p->powgridft = NULL;
+
+  /* Do the same for a second grid/plan to allow for cross power */
+
+  /* Grid is padded to allow for in-place FFT */
+  p->powgrid2 = fftw_alloc_real(Ngrid * Ngrid * (Ngrid + 2));
+  /* Pointer to grid to interpret it as complex data */
+  p->powgridft2 = (fftw_complex*)p->powgrid2;
+
+  p->fftplanpow2 = fftw_plan_dft_r2c_3d(Ngrid, Ngrid, Ngrid, p->powgrid2,
+                                        p->powgridft2, FFTW_MEASURE);
+
+  fftw_free(p->powgrid2);
+  p->powgrid2 = NULL;
+  p->powgridft2 = NULL;
+}
+
+/**
+ * @brief Name of the file storing the FFTW wisdom of the power spectra.
+ *
+ * The file lives next to the restart files and is specific to the size of
+ * the grid and to the number of threads FFTW uses.
+ *
+ * @param p The #power_spectrum_data.
+ * @param dir The directory of the restart files.
+ * @param filename (return) The name of the file.
+ * @param size The size of the filename buffer.
+ */
+static void power_fftw_wisdom_name(const struct power_spectrum_data* p,
+                                   const char* dir, char* filename,
+                                   const size_t size) {
+
+  const int nr_threads = p->Ngrid >= 64 ? p->nr_threads : 1;
+  const int n =
+      snprintf(filename, size, "%s/fftw_wisdom_power_N%d_threads%d.txt", dir,
+               p->Ngrid, nr_threads);
+  if (n < 0 || (size_t)n >= size)
+    error("FFTW wisdom file name too long for directory '%s'", dir);
+}
+
+#endif /* HAVE_FFTW */
+
+/**
+ * @brief Read the FFTW wisdom of the power spectra stored by a previous run,
+ * if any.
+ *
+ * Must be called before the plans are re-made after a restart such that they
+ * are not measured again.
+ *
+ * @param p The #power_spectrum_data.
+ * @param dir The directory of the restart files.
+ * @param verbose Are we talkative?
+ */
+void power_import_fftw_wisdom(const struct power_spectrum_data* p,
+                              const char* dir, const int verbose) {
+
+#ifdef HAVE_FFTW
+  char filename[PARSER_MAX_LINE_SIZE];
+  power_fftw_wisdom_name(p, dir, filename, PARSER_MAX_LINE_SIZE);
+
+  if (access(filename, R_OK) != 0) return;
+
+  if (!fftw_import_wisdom_from_filename(filename))
+    message("WARNING: Could not read the FFTW wisdom from '%s'.", filename);
+  else if (verbose)
+    message("Read the FFTW wisdom from '%s'.", filename);
+#endif
+}
+
+/**
+ * @brief Store the FFTW wisdom of the power spectra next to the restart files.
+ *
+ * @param p The #power_spectrum_data.
+ * @param dir The directory of the restart files.
+ */
+void power_export_fftw_wisdom(const struct power_spectrum_data* p,
+                              const char* dir) {
+
+#ifdef HAVE_FFTW
+  /* Nothing learnt if the plans have not been made yet */
+  if (p->fftplanpow == NULL) return;
+
+  char filename[PARSER_MAX_LINE_SIZE];
+  power_fftw_wisdom_name(p, dir, filename, PARSER_MAX_LINE_SIZE);
+
+  if (!fftw_export_wisdom_to_filename(filename))
+    message("WARNING: Could not write the FFTW wisdom to '%s'.", filename);
+#endif
+}
+
 /**
  * @brief Initialize power spectra calculation.
  *
@@ -1323,36 +1438,8 @@ void power_init(struct power_spectrum_data* p, struct swift_params* params,
     p->types2[i] = power_spectrum_get_type(type2);
   }
 
-  /* Initialize the plan only once -- much faster for FFTs run often!
-   * Does require us to allocate the grids, but we delete them right away.
-   * Plan can only be used for the same FFTW call */
-  const int Ngrid = p->Ngrid;
-
-  /* Grid is padded to allow for in-place FFT */
-  p->powgrid = fftw_alloc_real(Ngrid * Ngrid * (Ngrid + 2));
-  /* Pointer to grid to interpret it as complex data */
-  p->powgridft = (fftw_complex*)p->powgrid;
-
-  p->fftplanpow = fftw_plan_dft_r2c_3d(Ngrid, Ngrid, Ngrid, p->powgrid,
-                                       p->powgridft, FFTW_MEASURE);
-
-  fftw_free(p->powgrid);
-  p->powgrid = NULL;
-  p->powgridft = NULL;
-
-  /* Do the same for a second grid/plan to allow for cross power */
-
-  /* Grid is padded to allow for in-place FFT */
-  p->powgrid2 = fftw_alloc_real(Ngrid * Ngrid * (Ngrid + 2));
-  /* Pointer to grid to interpret it as complex data */
-  p->powgridft2 = (fftw_complex*)p->powgrid2;
-
-  p->fftplanpow2 = fftw_plan_dft_r2c_3d(Ngrid, Ngrid, Ngrid, p->powgrid2,
-                                        p->powgridft2, FFTW_MEASURE);
-
-  fftw_free(p->powgrid2);
-  p->powgrid2 = NULL;
-  p->powgridft2 = NULL;
+  /* Initialize the plans only once -- much faster for FFTs run often! */
+  power_make_fftw_plans(p);
 
   /* Create directories for power spectra and foldings */
   if (engine_rank == 0) {
@@ -1372,6 +1459,9 @@ void calc_all_power_spectra(struct power_spectrum_data* pow_data,
 
   const ticks tic = getticks();
 
+  /* Make the plans if they were dropped when restarting */
+  if (pow_data->fftplanpow == NULL) power_make_fftw_plans(pow_data);
+
   /* Loop over all type combinations the user requested */
   for (int i = 0; i < pow_data->spectrumcount; ++i)
     power_spectrum(pow_data->types1[i], pow_data->types2[i], pow_data, s, tp,
@@ -1393,8 +1483,8 @@ void calc_all_power_spectra(struct power_spectrum_data* pow_data,
 
 void power_clean(struct power_spectrum_data* pow_data) {
 #ifdef HAVE_FFTW
-  fftw_destroy_plan(pow_data->fftplanpow);
-  fftw_destroy_plan(pow_data->fftplanpow2);
+  if (pow_data->fftplanpow) fftw_destroy_plan(pow_data->fftplanpow);
+  if (pow_data->fftplanpow2) fftw_destroy_plan(pow_data->fftplanpow2);
   free(pow_data->types2);
   free(pow_data->types1);
 #ifdef HAVE_THREADED_FFTW
@@ -1457,34 +1547,9 @@ void power_spectrum_struct_restore(struct power_spectrum_data* p,
   message("Note that FFTW is not threaded!");
 #endif
 
-  /* Initialize the plan only once -- much faster for FFTs run often!
-     Does require us to allocate the grids, but we delete them right away */
-  int Ngrid = p->Ngrid;
-
-  /* Grid is padded to allow for in-place FFT */
-  p->powgrid = fftw_alloc_real(Ngrid * Ngrid * (Ngrid + 2));
-  /* Pointer to grid to interpret it as complex data */
-  p->powgridft = (fftw_complex*)p->powgrid;
-
-  p->fftplanpow = fftw_plan_dft_r2c_3d(Ngrid, Ngrid, Ngrid, p->powgrid,
-                                       p->powgridft, FFTW_MEASURE);
-
-  fftw_free(p->powgrid);
-  p->powgrid = NULL;
-  p->powgridft = NULL;
-
-  /* Do the same for a second grid/plan to allow for cross power */
-
-  /* Grid is padded to allow for in-place FFT */
-  p->powgrid2 = fftw_alloc_real(Ngrid * Ngrid * (Ngrid + 2));
-  /* Pointer to grid to interpret it as complex data */
-  p->powgridft2 = (fftw_complex*)p->powgrid2;
-
-  p->fftplanpow2 = fftw_plan_dft_r2c_3d(Ngrid, Ngrid, Ngrid, p->powgrid2,
-                                        p->powgridft2, FFTW_MEASURE);
-
-  fftw_free(p->powgrid2);
-  p->powgrid2 = NULL;
-  p->powgridft2 = NULL;
+  /* The plans will be re-made at their first use, once the FFTW wisdom
+   * stored with the restart files has been read (see engine_config()) */
+  p->fftplanpow = NULL;
+  p->fftplanpow2 = NULL;
 #endif /* HAVE_FFTW */
 }
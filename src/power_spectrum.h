@@ -105,6 +105,11 @@ void calc_all_power_spectra(struct power_spectrum_data* pow_data,
                             const int verbose);
 void power_clean(struct power_spectrum_data* pow_data);
 
+void power_import_fftw_wisdom(const struct power_spectrum_data* p,
+                              const char* dir, const int verbose);
+void power_export_fftw_wisdom(const struct power_spectrum_data* p,
+                              const char* dir);
+
 /* Dump/restore. */
 void power_spectrum_struct_dump(const struct power_spectrum_data* p,
                                 FILE* stream);
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#ifndef SWIFT_RIEMANN_BATCH_H
+#define SWIFT_RIEMANN_BATCH_H
+
+/* Local headers. */
+#include "inline.h"
+#include "riemann_checks.h"
+
+/*! Number of Riemann problems solved together */
+#define RIEMANN_BATCH_SIZE 32
+
+/**
+ * @brief A batch of independent Riemann problems.
+ *
+ * The states are stored as structures of arrays such that the solvers can
+ * process all the problems of the batch with the same instructions.
+ */
+struct riemann_batch {
+
+  /*! Number of problems in the batch */
+  int count;
+
+  /*! Left states (density, velocity, pressure) */
+  float WL[5][RIEMANN_BATCH_SIZE];
+
+  /*! Right states (density, velocity, pressure) */
+  float WR[5][RIEMANN_BATCH_SIZE];
+
+  /*! Unit vectors of the interfaces */
+  float n[3][RIEMANN_BATCH_SIZE];
+
+  /*! Velocities of the interfaces */
+  float vij[3][RIEMANN_BATCH_SIZE];
+
+  /*! Resulting fluxes */
+  float flux[5][RIEMANN_BATCH_SIZE];
+};
+
+/**
+ * @brief Copy one of the problems of a batch into regular state vectors.
+ *
+ * @param b The #riemann_batch.
+ * @param i Index of the problem in the batch.
+ * @param WL (return) Left state.
+ * @param WR (return) Right state.
+ * @param n (return) Unit vector of the interface.
+ * @param vij (return) Velocity of the interface.
+ */
+__attribute__((always_inline)) INLINE static void riemann_batch_get_problem(
+    const struct riemann_batch *b, const int i, float *WL, float *WR, float *n,
+    float *vij) {
+
+  for (int k = 0; k < 5; k++) {
+    WL[k] = b->WL[k][i];
+    WR[k] = b->WR[k][i];
+  }
+  for (int k = 0; k < 3; k++) {
+    n[k] = b->n[k][i];
+    vij[k] = b->vij[k][i];
+  }
+}
+
+/**
+ * @brief Store the flux of one of the problems of a batch.
+ *
+ * @param b The #riemann_batch.
+ * @param i Index of the problem in the batch.
+ * @param flux The flux.
+ */
+__attribute__((always_inline)) INLINE static void riemann_batch_set_flux(
+    struct riemann_batch *b, const int i, const float *flux) {
+
+  for (int k = 0; k < 5; k++) b->flux[k][i] = flux[k];
+}
+
+#ifdef SWIFT_DEBUG_CHECKS
+
+/**
+ * @brief Check the input of all the problems of a batch.
+ *
+ * @param b The #riemann_batch.
+ */
+__attribute__((always_inline)) INLINE static void riemann_batch_check_input(
+    const struct riemann_batch *b) {
+
+  for (int i = 0; i < b->count; i++) {
+    float WL[5], WR[5], n[3], vij[3];
+    riemann_batch_get_problem(b, i, WL, WR, n, vij);
+    riemann_check_input(WL, WR, n, vij);
+  }
+}
+
+/**
+ * @brief Check the fluxes of all the problems of a batch.
+ *
+ * @param b The #riemann_batch.
+ */
+__attribute__((always_inline)) INLINE static void riemann_batch_check_output(
+    const struct riemann_batch *b) {
+
+  for (int i = 0; i < b->count; i++) {
+    float WL[5], WR[5], n[3], vij[3], flux[5];
+    riemann_batch_get_problem(b, i, WL, WR, n, vij);
+    for (int k = 0; k < 5; k++) flux[k] = b->flux[k][i];
+    riemann_check_output(WL, WR, n, vij, flux);
+  }
+}
+
+#endif /* SWIFT_DEBUG_CHECKS */
+
+#endif /* SWIFT_RIEMANN_BATCH_H */
@@ -39,6 +39,7 @@
 #include "adiabatic_index.h"
 #include "error.h"
 #include "minmax.h"
+#include "riemann_batch.h"
 #include "riemann_checks.h"
 #include "riemann_vacuum.h"
 
@@ -661,4 +662,206 @@ riemann_solve_for_middle_state_flux(const float* Wi, const float* Wj,
 #endif
 }
 
+/**
+ * @brief Solve a batch of Riemann problems for the flux.
+ *
+ * Sampling the full solution depends on the wave pattern of each problem, so
+ * we simply solve the problems one after the other.
+ *
+ * @param b The #riemann_batch.
+ */
+__attribute__((always_inline)) INLINE static void riemann_solve_for_flux_batch(
+    struct riemann_batch* b) {
+
+  for (int i = 0; i < b->count; i++) {
+    float WL[5], WR[5], n[3], vij[3], flux[5];
+    riemann_batch_get_problem(b, i, WL, WR, n, vij);
+    riemann_solve_for_flux(WL, WR, n, vij, flux);
+    riemann_batch_set_flux(b, i, flux);
+  }
+}
+
+/**
+ * @brief Functions (4.6), (4.7) and (4.37) in Toro for scalar states.
+ *
+ * Both branches are evaluated and the right one selected, such that this can
+ * be used in vectorised loops.
+ *
+ * @param p The current guess for the pressure
+ * @param rho The left or right density
+ * @param P The left or right pressure
+ * @param a The left or right sound speed
+ * @param f (return) The value of the function
+ * @param fprime (return) The derivative of the function w.r.t. p
+ */
+__attribute__((always_inline)) INLINE static void riemann_fb_fprimeb_select(
+    const float p, const float rho, const float P, const float a,
+    float* restrict f, float* restrict fprime) {
+
+  /* Shock */
+  const float A = hydro_two_over_gamma_plus_one / rho;
+  const float B = hydro_gamma_minus_one_over_gamma_plus_one * P;
+  const float sq = sqrtf(A / (p + B));
+  const float f_shock = (p - P) * sq;
+  const float fprime_shock = (1.0f - 0.5f * (p - P) / (B + p)) * sq;
+
+  /* Rarefaction */
+  const float x = p / P;
+  const float px = pow_gamma_minus_one_over_two_gamma(x);
+  const float f_rare = hydro_two_over_gamma_minus_one * a * (px - 1.0f);
+  const float fprime_rare = px / (x * rho * a);
+
+  *f = (p > P) ? f_shock : f_rare;
+  *fprime = (p > P) ? fprime_shock : fprime_rare;
+}
+
+/**
+ * @brief Solve a batch of Riemann problems for the middle state flux.
+ *
+ * This follows riemann_solver_solve_middle_state(): problems for which
+ * riemann_f(0) and riemann_f(pguess) have the same sign are iterated together
+ * using Newton-Raphson steps, each problem stopping (masked out) once
+ * converged or once it has bracketed the root. The problems for which the
+ * scalar solver would then use Brent's method, the ones that would reach a
+ * negative pressure and the ones that do not converge are then solved one by
+ * one.
+ *
+ * @param b The #riemann_batch.
+ */
+__attribute__((always_inline)) INLINE static void
+riemann_solve_for_middle_state_flux_batch(struct riemann_batch* b) {
+
+#ifdef SWIFT_DEBUG_CHECKS
+  riemann_batch_check_input(b);
+#endif
+
+  const int count = b->count;
+  float rhoL[RIEMANN_BATCH_SIZE], rhoR[RIEMANN_BATCH_SIZE];
+  float PL[RIEMANN_BATCH_SIZE], PR[RIEMANN_BATCH_SIZE];
+  float vL[RIEMANN_BATCH_SIZE], vR[RIEMANN_BATCH_SIZE];
+  float aL[RIEMANN_BATCH_SIZE], aR[RIEMANN_BATCH_SIZE];
+  float p[RIEMANN_BATCH_SIZE], pguess[RIEMANN_BATCH_SIZE];
+  float fpguess[RIEMANN_BATCH_SIZE];
+  int vacuum[RIEMANN_BATCH_SIZE], active[RIEMANN_BATCH_SIZE];
+  int scalar[RIEMANN_BATCH_SIZE];
+
+  /* Velocities along the interface normals, sound speeds and first guesses */
+  int num_active = 0;
+  for (int i = 0; i < count; i++) {
+    float WL[5], WR[5], n[3], vij[3];
+    riemann_batch_get_problem(b, i, WL, WR, n, vij);
+
+    vL[i] = WL[1] * n[0] + WL[2] * n[1] + WL[3] * n[2];
+    vR[i] = WR[1] * n[0] + WR[2] * n[1] + WR[3] * n[2];
+    vacuum[i] = (WL[0] == 0.0f || WR[0] == 0.0f);
+    if (!vacuum[i]) {
+      aL[i] = sqrtf(hydro_gamma * WL[4] / WL[0]);
+      aR[i] = sqrtf(hydro_gamma * WR[4] / WR[0]);
+      vacuum[i] = riemann_is_vacuum(WL, WR, vL[i], vR[i], aL[i], aR[i]);
+    }
+
+    if (vacuum[i]) {
+      /* Harmless values for the (masked) iterations below */
+      rhoL[i] = rhoR[i] = PL[i] = PR[i] = aL[i] = aR[i] = 1.0f;
+      p[i] = pguess[i] = 1.0f;
+      fpguess[i] = vL[i] = vR[i] = 0.0f;
+      active[i] = 0;
+    } else {
+      rhoL[i] = WL[0];
+      rhoR[i] = WR[0];
+      PL[i] = WL[4];
+      PR[i] = WR[4];
+      p[i] = 0.0f;
+      pguess[i] = riemann_guess_p(WL, WR, vL[i], vR[i], aL[i], aR[i]);
+      fpguess[i] = riemann_f(pguess[i], WL, WR, vL[i], vR[i], aL[i], aR[i]);
+
+      /* riemann_f(0), both waves being rarefactions (no pow(0) needed) */
+      const float fp =
+          -hydro_two_over_gamma_minus_one * (aL[i] + aR[i]) + (vR[i] - vL[i]);
+
+      /* Newton-Raphson only if the root is not bracketed yet */
+      active[i] = (fp * fpguess[i] >= 0.0f);
+      num_active += active[i];
+    }
+    scalar[i] = 0;
+  }
+
+  /* Newton-Raphson iterations on all the problems at once */
+  for (int iter = 0; iter < 100 && num_active > 0; iter++) {
+    num_active = 0;
+    for (int i = 0; i < count; i++) {
+
+      /* Same stopping criterion as the scalar solver */
+      const int iterate =
+          active[i] &
+          (fabsf(p[i] - pguess[i]) > 1.e-6f * 0.5f * (p[i] + pguess[i])) &
+          (fpguess[i] < 0.0f);
+
+      float fL, fR, fprimeL, fprimeR;
+      riemann_fb_fprimeb_select(pguess[i], rhoL[i], PL[i], aL[i], &fL,
+                                &fprimeL);
+      riemann_fb_fprimeb_select(pguess[i], rhoR[i], PR[i], aR[i], &fR,
+                                &fprimeR);
+      const float pnew = pguess[i] - fpguess[i] / (fprimeL + fprimeR);
+
+      /* Negative pressures: leave these to the scalar solver */
+      const int negative = (pnew <= 0.0f);
+      scalar[i] |= iterate & negative;
+      active[i] = iterate & !negative;
+
+      /* The new values are only used for the active problems but are
+       * computed for all of them, so keep the pressure positive */
+      const float p_eval = max(pnew, 1.e-8f);
+      float fnewL, fnewR, fprime_unused;
+      riemann_fb_fprimeb_select(p_eval, rhoL[i], PL[i], aL[i], &fnewL,
+                                &fprime_unused);
+      riemann_fb_fprimeb_select(p_eval, rhoR[i], PR[i], aR[i], &fnewR,
+                                &fprime_unused);
+
+      p[i] = active[i] ? pguess[i] : p[i];
+      pguess[i] = active[i] ? pnew : pguess[i];
+      fpguess[i] = active[i] ? fnewL + fnewR + (vR[i] - vL[i]) : fpguess[i];
+      num_active += active[i];
+    }
+  }
+
+  /* Middle state velocity and flux */
+  for (int i = 0; i < count; i++) {
+
+    /* The problems the scalar solver hands over to Brent's method */
+    scalar[i] |= (1.e6f * fabsf(p[i] - pguess[i]) > 0.5f * (p[i] + pguess[i])) &
+                 (fpguess[i] > 0.0f);
+
+    float fL, fR, fprimeL, fprimeR;
+    riemann_fb_fprimeb_select(pguess[i], rhoL[i], PL[i], aL[i], &fL, &fprimeL);
+    riemann_fb_fprimeb_select(pguess[i], rhoR[i], PR[i], aR[i], &fR, &fprimeR);
+    const float vM = 0.5f * (vL[i] + vR[i]) + 0.5f * (fR - fL);
+    const float PM = vacuum[i] ? 0.0f : pguess[i];
+
+    const float vface = b->vij[0][i] * b->n[0][i] +
+                        b->vij[1][i] * b->n[1][i] + b->vij[2][i] * b->n[2][i];
+
+    b->flux[0][i] = 0.0f;
+    b->flux[1][i] = PM * b->n[0][i];
+    b->flux[2][i] = PM * b->n[1][i];
+    b->flux[3][i] = PM * b->n[2][i];
+    b->flux[4][i] = (vM + vface) * PM;
+  }
+
+  /* Problems that need Brent's method or did not converge are solved the
+   * safe way */
+  for (int i = 0; i < count; i++) {
+    if (scalar[i] || active[i]) {
+      float WL[5], WR[5], n[3], vij[3], flux[5];
+      riemann_batch_get_problem(b, i, WL, WR, n, vij);
+      riemann_solve_for_middle_state_flux(WL, WR, n, vij, flux);
+      riemann_batch_set_flux(b, i, flux);
+    }
+  }
+
+#ifdef SWIFT_DEBUG_CHECKS
+  riemann_batch_check_output(b);
+#endif
+}
+
 #endif /* SWIFT_RIEMANN_EXACT_H */
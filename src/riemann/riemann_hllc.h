@@ -30,6 +30,7 @@
 #include "adiabatic_index.h"
 #include "error.h"
 #include "minmax.h"
+#include "riemann_batch.h"
 #include "riemann_checks.h"
 #include "riemann_vacuum.h"
 
@@ -244,4 +245,214 @@ riemann_solve_for_middle_state_flux(const float *WL, const float *WR,
 #endif
 }
 
+/**
+ * @brief Solve a batch of Riemann problems for the flux.
+ *
+ * Same as riemann_solve_for_flux() but written without branches over the
+ * problems of the batch such that the compiler can vectorise the loop. Both
+ * sides of the contact discontinuity are handled by selecting the upwind
+ * state. The (rare) problems involving vacuum are then solved one by one.
+ *
+ * @param b The #riemann_batch.
+ */
+__attribute__((always_inline)) INLINE static void riemann_solve_for_flux_batch(
+    struct riemann_batch *restrict b) {
+
+#ifdef SWIFT_DEBUG_CHECKS
+  riemann_batch_check_input(b);
+#endif
+
+  const int count = b->count;
+  int vacuum[RIEMANN_BATCH_SIZE];
+
+  for (int i = 0; i < count; i++) {
+
+    const float nx = b->n[0][i];
+    const float ny = b->n[1][i];
+    const float nz = b->n[2][i];
+    const float rhoL = b->WL[0][i];
+    const float rhoR = b->WR[0][i];
+    const float PL = b->WL[4][i];
+    const float PR = b->WR[4][i];
+
+    /* STEP 0: obtain velocity in interface frame */
+    const float uL = b->WL[1][i] * nx + b->WL[2][i] * ny + b->WL[3][i] * nz;
+    const float uR = b->WR[1][i] * nx + b->WR[2][i] * ny + b->WR[3][i] * nz;
+    const float rhoLinv = (rhoL > 0.0f) ? 1.0f / rhoL : 0.0f;
+    const float rhoRinv = (rhoR > 0.0f) ? 1.0f / rhoR : 0.0f;
+    const float aL = sqrtf(hydro_gamma * PL * rhoLinv);
+    const float aR = sqrtf(hydro_gamma * PR * rhoRinv);
+
+    /* Vacuum problems are solved separately below */
+    vacuum[i] = (rhoL == 0.0f) | (rhoR == 0.0f) |
+                (hydro_two_over_gamma_minus_one * (aL + aR) <= uR - uL);
+
+    /* STEP 1: pressure estimate */
+    const float pPVRS =
+        0.5f * ((PL + PR) - 0.25f * (uR - uL) * (rhoL + rhoR) * (aL + aR));
+    const float pstar = max(0.0f, pPVRS);
+
+    /* STEP 2: wave speed estimates */
+    const float qL2 =
+        (pstar > PL && PL > 0.0f)
+            ? 1.0f + 0.5f * hydro_gamma_plus_one * hydro_one_over_gamma *
+                         (pstar / PL - 1.0f)
+            : 1.0f;
+    const float qR2 =
+        (pstar > PR && PR > 0.0f)
+            ? 1.0f + 0.5f * hydro_gamma_plus_one * hydro_one_over_gamma *
+                         (pstar / PR - 1.0f)
+            : 1.0f;
+    const float SLmuL = -aL * sqrtf(qL2);
+    const float SRmuR = aR * sqrtf(qR2);
+    const float Sstar = (PR - PL + rhoL * uL * SLmuL - rhoR * uR * SRmuR) /
+                        (rhoL * SLmuL - rhoR * SRmuR);
+
+    /* STEP 3: HLLC flux in a frame moving with the interface velocity, using
+     * the state upwind of the contact discontinuity */
+    const int left = (Sstar >= 0.0f);
+    const float rho = left ? rhoL : rhoR;
+    const float rhoinv = left ? rhoLinv : rhoRinv;
+    const float vx = left ? b->WL[1][i] : b->WR[1][i];
+    const float vy = left ? b->WL[2][i] : b->WR[2][i];
+    const float vz = left ? b->WL[3][i] : b->WR[3][i];
+    const float P = left ? PL : PR;
+    const float u = left ? uL : uR;
+    const float Smu = left ? SLmuL : SRmuR;
+    const float S = Smu + u;
+
+    const float rhou = rho * u;
+    const float e = P * rhoinv * hydro_one_over_gamma_minus_one +
+                    0.5f * (vx * vx + vy * vy + vz * vz);
+    float f0 = rhou;
+    float f1 = rhou * vx + P * nx;
+    float f2 = rhou * vy + P * ny;
+    float f3 = rhou * vz + P * nz;
+    float f4 = rhou * e + P * u;
+
+    /* Add the star state if the outer wave moves away from the interface */
+    const int star = left ? (S < 0.0f) : (S > 0.0f);
+    const float starfac = Smu / (star ? S - Sstar : 1.0f);
+    const float rhoS = rho * S;
+    const float rhoSstarfac = star ? rhoS * (starfac - 1.0f) : 0.0f;
+    const float rhoSSstarmu = star ? rhoS * (Sstar - u) * starfac : 0.0f;
+    const float Pstar = P / (star ? rho * Smu : 1.0f);
+
+    f0 += rhoSstarfac;
+    f1 += rhoSstarfac * vx + rhoSSstarmu * nx;
+    f2 += rhoSstarfac * vy + rhoSSstarmu * ny;
+    f3 += rhoSstarfac * vz + rhoSSstarmu * nz;
+    f4 += rhoSstarfac * e + rhoSSstarmu * (Sstar + Pstar);
+
+    /* deboost to lab frame (energy first, see riemann_solve_for_flux()) */
+    const float vijx = b->vij[0][i];
+    const float vijy = b->vij[1][i];
+    const float vijz = b->vij[2][i];
+    const float v2 = vijx * vijx + vijy * vijy + vijz * vijz;
+    f4 += vijx * f1 + vijy * f2 + vijz * f3 + 0.5f * v2 * f0;
+    f1 += vijx * f0;
+    f2 += vijy * f0;
+    f3 += vijz * f0;
+
+    b->flux[0][i] = f0;
+    b->flux[1][i] = f1;
+    b->flux[2][i] = f2;
+    b->flux[3][i] = f3;
+    b->flux[4][i] = f4;
+  }
+
+  /* Vacuum does not require iteration and is always exact */
+  for (int i = 0; i < count; i++) {
+    if (vacuum[i]) {
+      float WL[5], WR[5], n[3], vij[3], flux[5];
+      riemann_batch_get_problem(b, i, WL, WR, n, vij);
+      riemann_solve_for_flux(WL, WR, n, vij, flux);
+      riemann_batch_set_flux(b, i, flux);
+    }
+  }
+
+#ifdef SWIFT_DEBUG_CHECKS
+  riemann_batch_check_output(b);
+#endif
+}
+
+/**
+ * @brief Solve a batch of Riemann problems for the middle state flux.
+ *
+ * Same as riemann_solve_for_middle_state_flux() but written without branches
+ * over the problems of the batch such that the compiler can vectorise the
+ * loop.
+ *
+ * @param b The #riemann_batch.
+ */
+__attribute__((always_inline)) INLINE static void
+riemann_solve_for_middle_state_flux_batch(struct riemann_batch *restrict b) {
+
+#ifdef SWIFT_DEBUG_CHECKS
+  riemann_batch_check_input(b);
+#endif
+
+  const int count = b->count;
+
+  for (int i = 0; i < count; i++) {
+
+    const float nx = b->n[0][i];
+    const float ny = b->n[1][i];
+    const float nz = b->n[2][i];
+    const float rhoL = b->WL[0][i];
+    const float rhoR = b->WR[0][i];
+    const float PL = b->WL[4][i];
+    const float PR = b->WR[4][i];
+
+    /* STEP 0: obtain velocity in interface frame */
+    const float uL = b->WL[1][i] * nx + b->WL[2][i] * ny + b->WL[3][i] * nz;
+    const float uR = b->WR[1][i] * nx + b->WR[2][i] * ny + b->WR[3][i] * nz;
+    const float rhoLinv = (rhoL > 0.0f) ? 1.0f / rhoL : 0.0f;
+    const float rhoRinv = (rhoR > 0.0f) ? 1.0f / rhoR : 0.0f;
+    const float aL = sqrtf(hydro_gamma * PL * rhoLinv);
+    const float aR = sqrtf(hydro_gamma * PR * rhoRinv);
+
+    /* Vacuum (and vacuum generation) leads to a zero flux */
+    const int vacuum =
+        (rhoL == 0.0f) | (rhoR == 0.0f) |
+        (hydro_two_over_gamma_minus_one * (aL + aR) <= uR - uL);
+
+    /* STEP 1: pressure estimate */
+    const float pPVRS =
+        0.5f * ((PL + PR) - 0.25f * (uR - uL) * (rhoL + rhoR) * (aL + aR));
+    const float pstar = max(0.0f, pPVRS);
+
+    /* STEP 2: wave speed estimates */
+    const float qL2 =
+        (pstar > PL && PL > 0.0f)
+            ? 1.0f + 0.5f * hydro_gamma_plus_one * hydro_one_over_gamma *
+                         (pstar / PL - 1.0f)
+            : 1.0f;
+    const float qR2 =
+        (pstar > PR && PR > 0.0f)
+            ? 1.0f + 0.5f * hydro_gamma_plus_one * hydro_one_over_gamma *
+                         (pstar / PR - 1.0f)
+            : 1.0f;
+    const float SLmuL = -aL * sqrtf(qL2);
+    const float SRmuR = aR * sqrtf(qR2);
+    const float denom = rhoL * SLmuL - rhoR * SRmuR;
+    const float Sstar = (PR - PL + rhoL * uL * SLmuL - rhoR * uR * SRmuR) /
+                        (vacuum ? 1.0f : denom);
+
+    const float vface = b->vij[0][i] * nx + b->vij[1][i] * ny +
+                        b->vij[2][i] * nz;
+    const float p = vacuum ? 0.0f : pstar;
+
+    b->flux[0][i] = 0.0f;
+    b->flux[1][i] = p * nx;
+    b->flux[2][i] = p * ny;
+    b->flux[3][i] = p * nz;
+    b->flux[4][i] = vacuum ? 0.0f : pstar * (Sstar + vface);
+  }
+
+#ifdef SWIFT_DEBUG_CHECKS
+  riemann_batch_check_output(b);
+#endif
+}
+
 #endif /* SWIFT_RIEMANN_HLLC_H */
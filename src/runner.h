@@ -30,6 +30,10 @@
 #include "cache.h"
 #include "gravity_cache.h"
 
+#if defined(GIZMO_MFV_SPH) || defined(GIZMO_MFM_SPH)
+#include "hydro/Gizmo/hydro_flux_batch.h"
+#endif
+
 struct cell;
 struct engine;
 struct task;
@@ -84,6 +88,12 @@ struct runner {
   struct cache cj_cache;
 #endif
 
+#if defined(GIZMO_MFV_SPH) || defined(GIZMO_MFM_SPH)
+
+  /*! The Riemann problems of the force loop waiting to be solved. */
+  struct hydro_flux_batch flux_batch;
+#endif
+
 #ifdef SWIFT_DEBUG_CHECKS
   /*! Pointer to the task this runner is currently performing */
   const struct task *t;
@@ -120,6 +130,8 @@ void runner_do_init(struct runner *r, struct cell *c, int timer);
 void runner_do_cooling(struct runner *r, struct cell *c, int timer);
 void runner_do_limiter(struct runner *r, struct cell *c, int force, int timer);
 void runner_do_sync(struct runner *r, struct cell *c, int force, int timer);
+void runner_do_limiter_sync(struct runner *r, struct cell *c, int force_limiter,
+                            int force_sync, int timer);
 void runner_do_grav_mesh(struct runner *r, struct cell *c, int timer);
 void runner_do_grav_external(struct runner *r, struct cell *c, int timer);
 void runner_do_grav_fft(struct runner *r, int timer);
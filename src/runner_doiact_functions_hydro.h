@@ -934,6 +934,9 @@ void DOPAIR_SUBSET_BRANCH(struct runner *r, struct cell *restrict ci,
     DOPAIR_SUBSET(r, ci, parts_i, ind, count, cj, sid, flipped, shift);
 #endif
   }
+
+  /* Solve the interactions that are still pending */
+  IACT_FLUSH();
 }
 
 /**
@@ -1054,6 +1057,9 @@ void DOSELF_SUBSET_BRANCH(struct runner *r, struct cell *restrict ci,
 #else
   DOSELF_SUBSET(r, ci, parts, ind, count);
 #endif
+
+  /* Solve the interactions that are still pending */
+  IACT_FLUSH();
 }
 
 /**
@@ -1410,6 +1416,9 @@ void DOPAIR1_BRANCH(struct runner *r, struct cell *ci, struct cell *cj) {
 #else
   DOPAIR1(r, ci, cj, sid, shift);
 #endif
+
+  /* Solve the interactions that are still pending */
+  IACT_FLUSH();
 }
 
 /**
@@ -2051,6 +2060,9 @@ void DOPAIR2_BRANCH(struct runner *r, struct cell *ci, struct cell *cj) {
 #else
   DOPAIR2(r, ci, cj, sid, shift);
 #endif
+
+  /* Solve the interactions that are still pending */
+  IACT_FLUSH();
 }
 
 /**
@@ -2293,6 +2305,9 @@ void DOSELF1_BRANCH(struct runner *r, struct cell *c) {
 #else
   DOSELF1(r, c);
 #endif
+
+  /* Solve the interactions that are still pending */
+  IACT_FLUSH();
 }
 
 /**
@@ -2508,6 +2523,9 @@ void DOSELF2_BRANCH(struct runner *r, struct cell *c) {
 #else
   DOSELF2(r, c);
 #endif
+
+  /* Solve the interactions that are still pending */
+  IACT_FLUSH();
 }
 
 /**
@@ -527,6 +527,9 @@ void DOPAIR1_BRANCH(struct runner *r, struct cell *ci, struct cell *cj) {
 
 #if defined(SWIFT_USE_NAIVE_INTERACTIONS)
   DOPAIR1_NAIVE(r, ci, cj);
+#elif defined(WITH_VECTORIZED_LIMITER) && \
+    (FUNCTION_TASK_LOOP == TASK_LOOP_LIMITER)
+  runner_dopair1_limiter_vec(r, ci, cj, sid, shift);
 #else
   DOPAIR1(r, ci, cj, sid, shift);
 #endif
@@ -704,6 +707,9 @@ void DOSELF1_BRANCH(struct runner *r, struct cell *c) {
 
 #if defined(SWIFT_USE_NAIVE_INTERACTIONS)
   DOSELF1_NAIVE(r, c);
+#elif defined(WITH_VECTORIZED_LIMITER) && \
+    (FUNCTION_TASK_LOOP == TASK_LOOP_LIMITER)
+  runner_doself1_limiter_vec(r, c);
 #else
   DOSELF1(r, c);
 #endif
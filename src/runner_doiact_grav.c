@@ -29,6 +29,8 @@
 #include "gravity_cache.h"
 #include "gravity_iact.h"
 #include "inline.h"
+#include "mesh_gravity.h"
+#include "multipole_accept.h"
 #include "part.h"
 #include "space_getsid.h"
 #include "timers.h"
@@ -66,6 +68,9 @@ void runner_do_grav_down(struct runner *r, struct cell *c, int timer) {
 
   /* Some constants */
   const struct engine *e = r->e;
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+  const struct gravity_props *props = e->gravity_properties;
+#endif
 
   TIMER_TIC;
 
@@ -76,6 +81,12 @@ void runner_do_grav_down(struct runner *r, struct cell *c, int timer) {
     error("c->field tensor not initialised");
 #endif
 
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+  /* Adapt the MAC tolerance of this cell to the error it received */
+  if (props->use_MAC_error_budget)
+    gravity_MAC_budget_update(props, c->grav.multipole);
+#endif
+
   if (c->split) {
 
     /* Node case */
@@ -106,6 +117,13 @@ void runner_do_grav_down(struct runner *r, struct cell *c, int timer) {
           gravity_field_tensors_add(&cp->grav.multipole->pot, &shifted_tensor);
         }
 
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+        /* The errors of the parent's M2L contributions are inherited */
+        if (props->use_MAC_error_budget)
+          cp->grav.multipole->pot.mac_error +=
+              c->grav.multipole->pot.mac_error;
+#endif
+
         /* Recurse */
         runner_do_grav_down(r, cp, 0);
       }
@@ -1870,6 +1888,65 @@ void runner_doself_grav_pp(struct runner *r, struct cell *c) {
   TIMER_TOC(timer_doself_grav_pp);
 }
 
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+
+/**
+ * @brief Adds the estimated error of an M2L interaction to the field tensor
+ * of the sink.
+ *
+ * Only used by the error-budget MAC. The caller must hold the lock on the
+ * sink's multipole.
+ *
+ * @param props The properties of the gravity scheme.
+ * @param A The #gravity_tensors of the sink.
+ * @param B The #gravity_tensors of the source.
+ * @param periodic Are we using periodic BCs?
+ * @param dim The size of the simulation box.
+ */
+static INLINE void runner_grav_mm_record_error(
+    const struct gravity_props *props, struct gravity_tensors *restrict A,
+    const struct gravity_tensors *restrict B, const int periodic,
+    const double dim[3]) {
+
+  /* Get the distance between the CoMs */
+  double dx = A->CoM[0] - B->CoM[0];
+  double dy = A->CoM[1] - B->CoM[1];
+  double dz = A->CoM[2] - B->CoM[2];
+
+  /* Apply BC */
+  if (periodic) {
+    dx = nearest(dx, dim[0]);
+    dy = nearest(dy, dim[1]);
+    dz = nearest(dz, dim[2]);
+  }
+  const double r2 = dx * dx + dy * dy + dz * dz;
+
+  A->pot.mac_error += gravity_M2L_error_estimate(props, A, B, r2, periodic);
+}
+
+/**
+ * @brief Returns the number of progeny of a split cell if they are all
+ * leaves, 0 otherwise.
+ *
+ * Only used by the error-budget MAC, which replaces the opening of a cell by
+ * a direct sum only when the recursion would stop at the next level.
+ *
+ * @param c The #cell.
+ */
+static INLINE int runner_grav_count_leaf_progeny(const struct cell *c) {
+
+  int num_progeny = 0;
+  for (int k = 0; k < 8; k++) {
+    if (c->progeny[k] != NULL) {
+      if (c->progeny[k]->split) return 0;
+      num_progeny++;
+    }
+  }
+  return num_progeny;
+}
+
+#endif /* SWIFT_GRAVITY_MAC_ERROR_BUDGET */
+
 /**
  * @brief Computes the interaction of the field tensor and multipole
  * of two cells symmetrically.
@@ -1945,6 +2022,16 @@ static INLINE void runner_dopair_grav_mm_symmetric(struct runner *r,
                         multi_i, multi_j, ci->grav.multipole->CoM,
                         cj->grav.multipole->CoM, props, periodic, dim, r_s_inv);
 
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+  /* Record the error we just made */
+  if (props->use_MAC_error_budget) {
+    runner_grav_mm_record_error(props, ci->grav.multipole, cj->grav.multipole,
+                                periodic, dim);
+    runner_grav_mm_record_error(props, cj->grav.multipole, ci->grav.multipole,
+                                periodic, dim);
+  }
+#endif
+
 #ifndef SWIFT_TASKS_WITHOUT_ATOMICS
   /* Unlock the multipoles */
   if (lock_unlock(&ci->grav.mlock) != 0) error("Failed to unlock multipole");
@@ -2013,6 +2100,13 @@ static INLINE void runner_dopair_grav_mm_nonsym(struct runner *r,
   gravity_M2L_nonsym(&ci->grav.multipole->pot, multi_j, ci->grav.multipole->CoM,
                      cj->grav.multipole->CoM, props, periodic, dim, r_s_inv);
 
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+  /* Record the error we just made */
+  if (props->use_MAC_error_budget)
+    runner_grav_mm_record_error(props, ci->grav.multipole, cj->grav.multipole,
+                                periodic, dim);
+#endif
+
 #ifndef SWIFT_TASKS_WITHOUT_ATOMICS
   /* Unlock the multipoles */
   if (lock_unlock(&ci->grav.mlock) != 0) error("Failed to unlock multipole");
@@ -2314,6 +2408,20 @@ void runner_dopair_recursive_grav(struct runner *r, struct cell *ci,
     /* We have two leaves. Go P-P. */
     runner_dopair_grav_pp(r, ci, cj, /*symmetric*/ 1, /*allow_mpoles=*/1);
 
+#ifdef SWIFT_GRAVITY_MAC_ERROR_BUDGET
+    /* One leaf facing a cell whose progeny are all leaves: is a direct
+     * interaction cheaper than opening the split cell? */
+  } else if (e->gravity_properties->use_MAC_error_budget &&
+             (!ci->split || !cj->split) &&
+             gravity_budget_use_direct(
+                 e->gravity_properties, ci->grav.count, cj->grav.count,
+                 runner_grav_count_leaf_progeny(ci->split ? ci : cj))) {
+
+    /* Go P-P */
+    runner_dopair_grav_pp_no_cache(r, ci, cj);
+    runner_dopair_grav_pp_no_cache(r, cj, ci);
+
+#endif
   } else {
 
     /* Alright, we'll have to split and recurse. */
@@ -2430,10 +2538,16 @@ void runner_doself_recursive_grav(struct runner *r, struct cell *c,
   if (gettimer) TIMER_TOC(timer_dosub_self_grav);
 }
 
+/*! How many entries ahead in the long-range list we prefetch multipoles */
+#define grav_long_range_prefetch_distance 4
+
 /**
  * @brief Performs all M-M interactions between a given top-level cell and all
  * the other top-levels that are far enough.
  *
+ * The list of partners is the one constructed for the top-level parent of
+ * the cell at the last rebuild (see engine_make_grav_long_range_lists_mapper).
+ *
  * @param r The thread #runner.
  * @param ci The #cell of interest.
  * @param timer Are we timing this ?
@@ -2444,15 +2558,11 @@ void runner_do_grav_long_range(struct runner *r, struct cell *ci,
   /* Some constants */
   const struct engine *e = r->e;
   const int periodic = e->mesh->periodic;
-  const double dim[3] = {e->mesh->dim[0], e->mesh->dim[1], e->mesh->dim[2]};
-  const double max_distance2 = e->mesh->r_cut_max * e->mesh->r_cut_max;
 
   TIMER_TIC;
 
   /* Recover the list of top-level cells */
   struct cell *cells = e->s->cells_top;
-  int *cells_with_particles = e->s->cells_with_particles_top;
-  const int nr_cells_with_particles = e->s->nr_cells_with_particles;
 
   /* Anything to do here? */
   if (!cell_is_active_gravity(ci, e)) return;
@@ -2460,6 +2570,11 @@ void runner_do_grav_long_range(struct runner *r, struct cell *ci,
   if (ci->nodeID != engine_rank)
     error("Non-local cell in long-range gravity task!");
 
+  /* Start by reading the freshly computed mesh forces */
+  if (e->mesh->interpolation_pending)
+    pm_mesh_interpolate_forces(e->mesh, ci,
+                               e->physical_constants->const_newton_G);
+
   /* Check multipole has been drifted */
   if (ci->grav.ti_old_multipole < e->ti_current) cell_drift_multipole(ci, e);
 
@@ -2470,62 +2585,69 @@ void runner_do_grav_long_range(struct runner *r, struct cell *ci,
   struct cell *top = ci;
   while (top->parent != NULL) top = top->parent;
 
-  /* Loop over all the top-level cells and go for a M-M interaction if
-   * well-separated */
-  for (int n = 0; n < nr_cells_with_particles; ++n) {
+  /* Recover the list of well-separated cells constructed at rebuild time */
+  const int *list = top->grav.long_range_list;
+  const int count = top->grav.long_range_count;
 
-    /* Handle on the top-level cell and it's gravity business*/
-    struct cell *cj = &cells[cells_with_particles[n]];
-    struct gravity_tensors *const multi_j = cj->grav.multipole;
-
-    /* Avoid self contributions */
-    if (top == cj) continue;
-
-    /* Skip empty cells */
-    if (multi_j->m_pole.M_000 == 0.f) continue;
-
-    /* Can we escape early in the periodic BC case? */
-    if (periodic) {
+  /* Did some of the top-level cells fall beyond the truncation radius? */
+  if (periodic && top->grav.long_range_has_far) {
 
-      /* Minimal distance between any pair of particles */
-      const double min_radius2 =
-          cell_min_dist2_same_size(top, cj, periodic, dim);
-
-      /* Are we beyond the distance where the truncated forces are 0 ?*/
-      if (min_radius2 > max_distance2) {
+#if defined(SWIFT_DEBUG_CHECKS) || defined(SWIFT_GRAVITY_FORCE_CHECKS)
+    /* Need to account for the interactions we missed */
+    const double dim[3] = {e->mesh->dim[0], e->mesh->dim[1], e->mesh->dim[2]};
+    const double max_distance2 = e->mesh->r_cut_max * e->mesh->r_cut_max;
+    const int *cells_with_particles = e->s->cells_with_particles_top;
+    const int nr_cells_with_particles = e->s->nr_cells_with_particles;
+    for (int n = 0; n < nr_cells_with_particles; ++n) {
+
+      const struct cell *cj = &cells[cells_with_particles[n]];
+      if (top == cj) continue;
+      if (cell_min_dist2_same_size(top, cj, periodic, dim) <= max_distance2)
+        continue;
 
 #ifdef SWIFT_DEBUG_CHECKS
-        /* Need to account for the interactions we missed */
-        accumulate_add_ll(&multi_i->pot.num_interacted,
-                          multi_j->m_pole.num_gpart);
+      accumulate_add_ll(&multi_i->pot.num_interacted,
+                        cj->grav.multipole->m_pole.num_gpart);
 #endif
-
 #ifdef SWIFT_GRAVITY_FORCE_CHECKS
-        /* Need to account for the interactions we missed */
-        accumulate_add_ll(&multi_i->pot.num_interacted_pm,
-                          multi_j->m_pole.num_gpart);
+      accumulate_add_ll(&multi_i->pot.num_interacted_pm,
+                        cj->grav.multipole->m_pole.num_gpart);
+#endif
+    }
 #endif
 
-        /* Record that this multipole received a contribution */
-        multi_i->pot.interacted = 1;
+    /* Record that this multipole received a contribution */
+    multi_i->pot.interacted = 1;
+  }
 
-        /* We are done here. */
-        continue;
-      }
-    }
+  /* Loop over the well-separated top-level cells and go for a M-M
+   * interaction */
+  for (int n = 0; n < count; ++n) {
+
+    /* Bring the cells and then the multipoles further down the list closer
+     * to the core while we work on this one */
+    if (n + 2 * grav_long_range_prefetch_distance < count)
+      __builtin_prefetch(
+          &cells[list[n + 2 * grav_long_range_prefetch_distance]].grav, 0, 1);
+    if (n + grav_long_range_prefetch_distance < count)
+      __builtin_prefetch(
+          cells[list[n + grav_long_range_prefetch_distance]].grav.multipole, 0,
+          1);
 
-    if (cell_can_use_pair_mm(top, cj, e, e->s, /*use_rebuild_data=*/1,
-                             /*is_tree_walk=*/0)) {
+    /* Handle on the top-level cell and it's gravity business*/
+    struct cell *cj = &cells[list[n]];
+    struct gravity_tensors *const multi_j = cj->grav.multipole;
 
-      /* Call the PM interaction fucntion on the active sub-cells of ci */
-      runner_dopair_grav_mm_nonsym(r, ci, cj);
-      // runner_dopair_recursive_grav_pm(r, ci, cj);
+    /* Skip empty cells */
+    if (multi_j->m_pole.M_000 == 0.f) continue;
+
+    /* Call the PM interaction fucntion on the active sub-cells of ci */
+    runner_dopair_grav_mm_nonsym(r, ci, cj);
 
-      /* Record that this multipole received a contribution */
-      multi_i->pot.interacted = 1;
+    /* Record that this multipole received a contribution */
+    multi_i->pot.interacted = 1;
 
-    } /* We are in charge of this pair */
-  }   /* Loop over top-level cells */
+  } /* Loop over top-level cells */
 
   if (timer) TIMER_TOC(timer_dograv_long_range);
 }
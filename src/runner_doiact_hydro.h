@@ -95,12 +95,28 @@
 #define _DOSUB_SUBSET(f) PASTE(runner_dosub_subset, f)
 #define DOSUB_SUBSET _DOSUB_SUBSET(FUNCTION)
 
+#if (FUNCTION_TASK_LOOP == TASK_LOOP_FORCE) && \
+    (defined(GIZMO_MFV_SPH) || defined(GIZMO_MFM_SPH))
+
+/* The Riemann problems of the force loop are solved in batches */
+#define IACT_NONSYM(r2, dx, hi, hj, pi, pj, a, H) \
+  runner_iact_force_batch(&r->flux_batch, r2, dx, hi, hj, pi, pj, 0, a, H)
+#define IACT(r2, dx, hi, hj, pi, pj, a, H) \
+  runner_iact_force_batch(&r->flux_batch, r2, dx, hi, hj, pi, pj, 1, a, H)
+#define IACT_FLUSH() runner_iact_force_batch_flush(&r->flux_batch)
+
+#else
+
 #define _IACT_NONSYM(f) PASTE(runner_iact_nonsym, f)
 #define IACT_NONSYM _IACT_NONSYM(FUNCTION)
 
 #define _IACT(f) PASTE(runner_iact, f)
 #define IACT _IACT(FUNCTION)
 
+#define IACT_FLUSH() \
+  {}
+#endif
+
 #if ((FUNCTION_TASK_LOOP == TASK_LOOP_DENSITY) ||  \
      (FUNCTION_TASK_LOOP == TASK_LOOP_GRADIENT) || \
      (FUNCTION_TASK_LOOP == TASK_LOOP_FORCE))
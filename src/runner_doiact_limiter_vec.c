@@ -0,0 +1,421 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+/* Config parameters. */
+#include <config.h>
+
+/* This object's header. */
+#include "runner_doiact_limiter_vec.h"
+
+/* Local headers. */
+#include "cache.h"
+#include "timestep_limiter_iact.h"
+
+#ifdef WITH_VECTORIZED_LIMITER
+
+static const vector kernel_gamma2_vec = FILL_VEC(kernel_gamma2);
+
+/**
+ * @brief Returns the index of the first entry in a sorted list whose distance
+ * along the axis is larger or equal to a given value.
+ *
+ * @param sort The sorted list.
+ * @param count The number of entries in the list.
+ * @param d The distance to compare to.
+ */
+__attribute__((always_inline)) INLINE static int limiter_sort_lower_bound(
+    const struct sort_entry *restrict sort, const int count, const double d) {
+
+  int lo = 0, hi = count;
+  while (lo < hi) {
+    const int mid = (lo + hi) / 2;
+    if (sort[mid].d < d)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+/**
+ * @brief Returns the index of the first entry in a sorted list whose distance
+ * along the axis is strictly larger than a given value.
+ *
+ * @param sort The sorted list.
+ * @param count The number of entries in the list.
+ * @param d The distance to compare to.
+ */
+__attribute__((always_inline)) INLINE static int limiter_sort_upper_bound(
+    const struct sort_entry *restrict sort, const int count, const double d) {
+
+  int lo = 0, hi = count;
+  while (lo < hi) {
+    const int mid = (lo + hi) / 2;
+    if (sort[mid].d <= d)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+#endif /* WITH_VECTORIZED_LIMITER */
+
+/**
+ * @brief Compute the time-step limiter interactions within a cell
+ * (non-symmetric) using vector intrinsics with one particle pi at a time.
+ *
+ * The distance and time-bin tests are done on full vectors read from the
+ * runner's cache. Only the (rare) neighbours that need waking up are then
+ * passed to the scalar interaction function.
+ *
+ * @param r The #runner.
+ * @param c The #cell.
+ */
+void runner_doself1_limiter_vec(struct runner *r, struct cell *restrict c) {
+
+#ifdef WITH_VECTORIZED_LIMITER
+
+  const struct engine *e = r->e;
+  const struct cosmology *cosmo = e->cosmology;
+  struct part *restrict parts = c->hydro.parts;
+  const int count = c->hydro.count;
+
+  TIMER_TIC;
+
+  /* Cosmological terms */
+  const float a = cosmo->a;
+  const float H = cosmo->H;
+
+  /* Get the particle cache from the runner and re-allocate
+   * the cache if it is not big enough for the cell. */
+  struct cache *restrict cell_cache = &r->ci_cache;
+  if (cell_cache->count < count) cache_init(cell_cache, count);
+
+  /* Read the particles from the cell and store them locally in the cache. */
+  const int count_align =
+      cache_read_particles_limiter(c, cell_cache, e->max_active_bin);
+
+  /* Loop over the particles in the cell. */
+  for (int pid = 0; pid < count; pid++) {
+
+    /* Get a pointer to the ith particle. */
+    struct part *restrict pi = &parts[pid];
+
+    /* Skip inhibited and inactive particles. */
+    if (part_is_inhibited(pi, e)) continue;
+    if (!part_is_starting(pi, e)) continue;
+
+    /* Fill particle pi vectors. */
+    const vector v_pix = vector_set1(cell_cache->x[pid]);
+    const vector v_piy = vector_set1(cell_cache->y[pid]);
+    const vector v_piz = vector_set1(cell_cache->z[pid]);
+
+    const float hi = pi->h;
+    const vector v_hig2 = vector_set1(hi * hi * kernel_gamma2);
+
+    /* Neighbours with a time-bin above this one need waking up */
+    const vector v_tb_wake =
+        vector_set1((float)(pi->time_bin + time_bin_neighbour_max_delta_bin));
+
+    /* Loop over the other particles in blocks of VEC_SIZE. */
+    for (int pjd = 0; pjd < count_align; pjd += VEC_SIZE) {
+
+      /* Compute the pairwise distance. */
+      vector v_dx, v_dy, v_dz, v_r2;
+      v_dx.v = vec_sub(v_pix.v, vec_load(&cell_cache->x[pjd]));
+      v_dy.v = vec_sub(v_piy.v, vec_load(&cell_cache->y[pjd]));
+      v_dz.v = vec_sub(v_piz.v, vec_load(&cell_cache->z[pjd]));
+
+      v_r2.v = vec_mul(v_dx.v, v_dx.v);
+      v_r2.v = vec_fma(v_dy.v, v_dy.v, v_r2.v);
+      v_r2.v = vec_fma(v_dz.v, v_dz.v, v_r2.v);
+
+      /* Inactive particles have a zero h in the cache */
+      vector v_hj, v_hjg2;
+      v_hj.v = vec_load(&cell_cache->h[pjd]);
+      v_hjg2.v = vec_mul(vec_mul(v_hj.v, v_hj.v), kernel_gamma2_vec.v);
+
+      mask_t v_doi_mask, v_doj_mask, v_wake_mask;
+      vec_create_mask(v_doi_mask, vec_cmp_lt(v_r2.v, v_hig2.v));
+      vec_create_mask(v_doj_mask, vec_cmp_lt(v_r2.v, v_hjg2.v));
+      vec_create_mask(v_wake_mask,
+                      vec_cmp_gt(vec_load(&cell_cache->time_bin[pjd]),
+                                 v_tb_wake.v));
+
+      /* As in the scalar loop, pairs where both particles are active and in
+       * range of each other are left untouched. */
+      const int wake_mask = vec_is_mask_true(v_doi_mask) &
+                            vec_is_mask_true(v_wake_mask) &
+                            ~vec_is_mask_true(v_doj_mask);
+
+      if (wake_mask == 0) continue;
+
+      /* Wake up the neighbours that need it. */
+      for (int bit_index = 0; bit_index < VEC_SIZE; bit_index++) {
+        if (wake_mask & (1 << bit_index)) {
+
+          struct part *restrict pj = &parts[pjd + bit_index];
+          const float dx[3] = {v_dx.f[bit_index], v_dy.f[bit_index],
+                               v_dz.f[bit_index]};
+
+#ifdef SWIFT_DEBUG_CHECKS
+          if (pj->ti_drift != e->ti_current)
+            error("Particle pj not drifted to current time");
+#endif
+
+          runner_iact_nonsym_limiter(v_r2.f[bit_index], dx, hi, pj->h, pi, pj,
+                                     a, H);
+        }
+      }
+    } /* loop over all other particles. */
+  }   /* loop over all particles. */
+
+  TIMER_TOC(timer_doself_limiter);
+
+#else
+  error("Incorrectly calling vectorized time-step limiter function!");
+#endif
+}
+
+/**
+ * @brief Compute the time-step limiter interactions between a cell pair
+ * (non-symmetric) using vector intrinsics with one particle pi at a time.
+ *
+ * Follows the logic of the scalar DOPAIR1 limiter loop. The particles of the
+ * cell being woken up are read into the runner's cache in sorted order such
+ * that only the contiguous range of candidates along the pair axis is
+ * looped over.
+ *
+ * @param r The #runner.
+ * @param ci The first #cell.
+ * @param cj The second #cell.
+ * @param sid The direction of the pair.
+ * @param shift The shift vector to apply to the particles in ci.
+ */
+void runner_dopair1_limiter_vec(struct runner *r, struct cell *restrict ci,
+                                struct cell *restrict cj, const int sid,
+                                const double *shift) {
+
+#ifdef WITH_VECTORIZED_LIMITER
+
+  const struct engine *restrict e = r->e;
+  const struct cosmology *restrict cosmo = e->cosmology;
+
+  TIMER_TIC;
+
+  /* Get the cutoff shift. */
+  double rshift = 0.0;
+  for (int k = 0; k < 3; k++) rshift += shift[k] * runner_shift[sid][k];
+
+  /* Pick-out the sorted lists. */
+  const struct sort_entry *restrict sort_i = cell_get_hydro_sorts(ci, sid);
+  const struct sort_entry *restrict sort_j = cell_get_hydro_sorts(cj, sid);
+
+  /* Get some other useful values. */
+  const double hi_max = ci->hydro.h_max * kernel_gamma - rshift;
+  const double hj_max = cj->hydro.h_max * kernel_gamma;
+  const int count_i = ci->hydro.count;
+  const int count_j = cj->hydro.count;
+  struct part *restrict parts_i = ci->hydro.parts;
+  struct part *restrict parts_j = cj->hydro.parts;
+  const double di_max = sort_i[count_i - 1].d - rshift;
+  const double dj_min = sort_j[0].d;
+  const float dx_max = (ci->hydro.dx_max_sort + cj->hydro.dx_max_sort);
+
+  /* Both cells are expressed in the frame of cj */
+  const double loc_i[3] = {cj->loc[0] + shift[0], cj->loc[1] + shift[1],
+                           cj->loc[2] + shift[2]};
+  const double loc_j[3] = {cj->loc[0], cj->loc[1], cj->loc[2]};
+
+  /* Cosmological terms */
+  const float a = cosmo->a;
+  const float H = cosmo->H;
+
+  if (cell_is_starting_hydro(ci, e)) {
+
+    /* Read the particles of cj in sorted order */
+    struct cache *restrict cj_cache = &r->cj_cache;
+    if (cj_cache->count < count_j) cache_init(cj_cache, count_j);
+    const int count_j_align =
+        cache_read_particles_sorted_limiter(cj, sort_j, loc_j, cj_cache);
+
+    /* Loop over the parts in ci. */
+    for (int pid = count_i - 1;
+         pid >= 0 && sort_i[pid].d + hi_max + dx_max > dj_min; pid--) {
+
+      /* Get a hold of the ith part in ci. */
+      struct part *restrict pi = &parts_i[sort_i[pid].i];
+      const float hi = pi->h;
+
+      /* Skip inactive particles */
+      if (!part_is_starting(pi, e)) continue;
+
+      /* Is there anything we need to interact with ? */
+      const double di = sort_i[pid].d + hi * kernel_gamma + dx_max - rshift;
+      if (di < dj_min) continue;
+
+      /* Only the particles of cj below di along the axis can be in range */
+      const int exit_iteration = limiter_sort_lower_bound(sort_j, count_j, di);
+      int exit_iteration_align = exit_iteration;
+      const int rem = exit_iteration % VEC_SIZE;
+      if (rem != 0) exit_iteration_align += VEC_SIZE - rem;
+      exit_iteration_align = min(exit_iteration_align, count_j_align);
+
+      /* Fill particle pi vectors. */
+      const vector v_pix = vector_set1((float)(pi->x[0] - loc_i[0]));
+      const vector v_piy = vector_set1((float)(pi->x[1] - loc_i[1]));
+      const vector v_piz = vector_set1((float)(pi->x[2] - loc_i[2]));
+      const vector v_hig2 = vector_set1(hi * hi * kernel_gamma2);
+      const vector v_tb_wake = vector_set1(
+          (float)(pi->time_bin + time_bin_neighbour_max_delta_bin));
+
+      /* Loop over the parts in cj. */
+      for (int pjd = 0; pjd < exit_iteration_align; pjd += VEC_SIZE) {
+
+        /* Compute the pairwise distance. */
+        vector v_dx, v_dy, v_dz, v_r2;
+        v_dx.v = vec_sub(v_pix.v, vec_load(&cj_cache->x[pjd]));
+        v_dy.v = vec_sub(v_piy.v, vec_load(&cj_cache->y[pjd]));
+        v_dz.v = vec_sub(v_piz.v, vec_load(&cj_cache->z[pjd]));
+
+        v_r2.v = vec_mul(v_dx.v, v_dx.v);
+        v_r2.v = vec_fma(v_dy.v, v_dy.v, v_r2.v);
+        v_r2.v = vec_fma(v_dz.v, v_dz.v, v_r2.v);
+
+        mask_t v_doi_mask, v_wake_mask;
+        vec_create_mask(v_doi_mask, vec_cmp_lt(v_r2.v, v_hig2.v));
+        vec_create_mask(v_wake_mask,
+                        vec_cmp_gt(vec_load(&cj_cache->time_bin[pjd]),
+                                   v_tb_wake.v));
+
+        const int wake_mask =
+            vec_is_mask_true(v_doi_mask) & vec_is_mask_true(v_wake_mask);
+
+        if (wake_mask == 0) continue;
+
+        /* Wake up the neighbours that need it. */
+        for (int bit_index = 0; bit_index < VEC_SIZE; bit_index++) {
+          if (wake_mask & (1 << bit_index)) {
+
+            struct part *restrict pj = &parts_j[sort_j[pjd + bit_index].i];
+            const float dx[3] = {v_dx.f[bit_index], v_dy.f[bit_index],
+                                 v_dz.f[bit_index]};
+
+#ifdef SWIFT_DEBUG_CHECKS
+            if (pj->ti_drift != e->ti_current)
+              error("Particle pj not drifted to current time");
+#endif
+
+            runner_iact_nonsym_limiter(v_r2.f[bit_index], dx, hi, pj->h, pi,
+                                       pj, a, H);
+          }
+        }
+      } /* loop over the parts in cj. */
+    }   /* loop over the parts in ci. */
+  }     /* Cell ci is active */
+
+  if (cell_is_starting_hydro(cj, e)) {
+
+    /* Read the particles of ci in sorted order */
+    struct cache *restrict ci_cache = &r->ci_cache;
+    if (ci_cache->count < count_i) cache_init(ci_cache, count_i);
+    const int count_i_align =
+        cache_read_particles_sorted_limiter(ci, sort_i, loc_i, ci_cache);
+
+    /* Loop over the parts in cj. */
+    for (int pjd = 0; pjd < count_j && sort_j[pjd].d - hj_max - dx_max < di_max;
+         pjd++) {
+
+      /* Get a hold of the jth part in cj. */
+      struct part *pj = &parts_j[sort_j[pjd].i];
+      const float hj = pj->h;
+
+      /* Skip inactive particles */
+      if (!part_is_starting(pj, e)) continue;
+
+      /* Is there anything we need to interact with ? */
+      const double dj = sort_j[pjd].d - hj * kernel_gamma - dx_max + rshift;
+      if (dj - rshift > di_max) continue;
+
+      /* Only the particles of ci above dj along the axis can be in range */
+      const int first_iteration = limiter_sort_upper_bound(sort_i, count_i, dj);
+      const int first_iteration_align =
+          first_iteration - (first_iteration % VEC_SIZE);
+
+      /* Fill particle pj vectors. */
+      const vector v_pjx = vector_set1((float)(pj->x[0] - loc_j[0]));
+      const vector v_pjy = vector_set1((float)(pj->x[1] - loc_j[1]));
+      const vector v_pjz = vector_set1((float)(pj->x[2] - loc_j[2]));
+      const vector v_hjg2 = vector_set1(hj * hj * kernel_gamma2);
+      const vector v_tb_wake = vector_set1(
+          (float)(pj->time_bin + time_bin_neighbour_max_delta_bin));
+
+      /* Loop over the parts in ci. */
+      for (int pid = first_iteration_align; pid < count_i_align;
+           pid += VEC_SIZE) {
+
+        /* Compute the pairwise distance. */
+        vector v_dx, v_dy, v_dz, v_r2;
+        v_dx.v = vec_sub(v_pjx.v, vec_load(&ci_cache->x[pid]));
+        v_dy.v = vec_sub(v_pjy.v, vec_load(&ci_cache->y[pid]));
+        v_dz.v = vec_sub(v_pjz.v, vec_load(&ci_cache->z[pid]));
+
+        v_r2.v = vec_mul(v_dx.v, v_dx.v);
+        v_r2.v = vec_fma(v_dy.v, v_dy.v, v_r2.v);
+        v_r2.v = vec_fma(v_dz.v, v_dz.v, v_r2.v);
+
+        mask_t v_doj_mask, v_wake_mask;
+        vec_create_mask(v_doj_mask, vec_cmp_lt(v_r2.v, v_hjg2.v));
+        vec_create_mask(v_wake_mask,
+                        vec_cmp_gt(vec_load(&ci_cache->time_bin[pid]),
+                                   v_tb_wake.v));
+
+        const int wake_mask =
+            vec_is_mask_true(v_doj_mask) & vec_is_mask_true(v_wake_mask);
+
+        if (wake_mask == 0) continue;
+
+        /* Wake up the neighbours that need it. */
+        for (int bit_index = 0; bit_index < VEC_SIZE; bit_index++) {
+          if (wake_mask & (1 << bit_index)) {
+
+            struct part *restrict pi = &parts_i[sort_i[pid + bit_index].i];
+            const float dx[3] = {v_dx.f[bit_index], v_dy.f[bit_index],
+                                 v_dz.f[bit_index]};
+
+#ifdef SWIFT_DEBUG_CHECKS
+            if (pi->ti_drift != e->ti_current)
+              error("Particle pi not drifted to current time");
+#endif
+
+            runner_iact_nonsym_limiter(v_r2.f[bit_index], dx, hj, pi->h, pj,
+                                       pi, a, H);
+          }
+        }
+      } /* loop over the parts in ci. */
+    }   /* loop over the parts in cj. */
+  }     /* Cell cj is active */
+
+  TIMER_TOC(timer_dopair_limiter);
+
+#else
+  error("Incorrectly calling vectorized time-step limiter function!");
+#endif
+}
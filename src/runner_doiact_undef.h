@@ -25,6 +25,7 @@
  * undefs if they were scattered all over the place */
 #undef IACT
 #undef IACT_NONSYM
+#undef IACT_FLUSH
 #undef IACT_MHD
 #undef IACT_NONSYM_MHD
 #undef IACT_STARS
@@ -465,10 +465,17 @@ void *runner_main(void *data) {
           runner_do_timestep(r, ci, 1);
           break;
         case task_type_timestep_limiter:
-          runner_do_limiter(r, ci, 0, 1);
+          /* If the sync task of this cell runs this step, it will apply the
+           * limiter as well in a single fused pass over the particles. */
+          if (ci->timestep_sync == NULL || ci->timestep_sync->skip)
+            runner_do_limiter(r, ci, 0, 1);
           break;
         case task_type_timestep_sync:
-          runner_do_sync(r, ci, 0, 1);
+          if (cell_get_flag(ci, cell_flag_do_hydro_limiter |
+                                    cell_flag_do_hydro_sub_limiter))
+            runner_do_limiter_sync(r, ci, 0, 0, 1);
+          else
+            runner_do_sync(r, ci, 0, 1);
           break;
         case task_type_collect:
           runner_do_timestep_collect(r, ci, 1);
@@ -64,6 +64,10 @@
 /**
  * @brief Calculate gravity acceleration from external potential
  *
+ * The active particles of each leaf are gathered and passed to the potential
+ * in batches. Leaves lying entirely in a region where the potential exerts no
+ * force are skipped.
+ *
  * @param r runner task
  * @param c cell
  * @param timer 1 if the time is to be recorded.
@@ -88,21 +92,53 @@ void runner_do_grav_external(struct runner *r, struct cell *c, int timer) {
       if (c->progeny[k] != NULL) runner_do_grav_external(r, c->progeny[k], 0);
   } else {
 
-    /* Loop over the gparts in this cell. */
+    /* Bounding box of the particles. The cell geometry cannot be used as the
+     * gparts are not bound to it between rebuilds. */
+    double box_min[3] = {DBL_MAX, DBL_MAX, DBL_MAX};
+    double box_max[3] = {-DBL_MAX, -DBL_MAX, -DBL_MAX};
     for (int i = 0; i < gcount; i++) {
+      box_min[0] = min(box_min[0], gparts[i].x[0]);
+      box_min[1] = min(box_min[1], gparts[i].x[1]);
+      box_min[2] = min(box_min[2], gparts[i].x[2]);
+      box_max[0] = max(box_max[0], gparts[i].x[0]);
+      box_max[1] = max(box_max[1], gparts[i].x[1]);
+      box_max[2] = max(box_max[2], gparts[i].x[2]);
+    }
 
-      /* Get a direct pointer on the part. */
-      struct gpart *restrict gp = &gparts[i];
+    /* Anything to do in this leaf? */
+    if (!external_gravity_box_is_force_free(time, potential, box_min,
+                                            box_max)) {
+
+      struct gpart *batch[external_gravity_batch_size];
+      int count = 0;
+
+      /* Loop over the gparts in this cell. */
+      for (int i = 0; i < gcount; i++) {
+
+        /* Get a direct pointer on the part. */
+        struct gpart *restrict gp = &gparts[i];
 
 #ifdef SWIFT_DEBUG_CHECKS
-      if (gp->time_bin == time_bin_not_created)
-        error("Found an extra particle in external gravity.");
+        if (gp->time_bin == time_bin_not_created)
+          error("Found an extra particle in external gravity.");
 #endif
 
-      /* Is this part within the time step? */
-      if (gpart_is_active(gp, e)) {
-        external_gravity_acceleration(time, potential, constants, gp);
+        /* Is this part within the time step? */
+        if (!gpart_is_active(gp, e)) continue;
+
+        /* Evaluate the potential once a batch is full */
+        batch[count++] = gp;
+        if (count == external_gravity_batch_size) {
+          external_gravity_acceleration_batch(time, potential, constants,
+                                              batch, count);
+          count = 0;
+        }
       }
+
+      /* And the remainder */
+      if (count > 0)
+        external_gravity_acceleration_batch(time, potential, constants, batch,
+                                            count);
     }
   }
 
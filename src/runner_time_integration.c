@@ -1313,84 +1313,163 @@ void runner_do_timestep_collect(struct runner *r, struct cell *c,
 }
 
 /**
- * @brief Apply the time-step limiter to all awaken particles in a cell
- * hierarchy.
+ * @brief Apply the time-step limiter to a single awaken particle.
  *
- * @param r The task #runner.
- * @param c The #cell.
- * @param force Limit the particles irrespective of the #cell flags.
- * @param timer Are we timing this ?
+ * @param e The #engine.
+ * @param p The #part.
+ * @param xp The #xpart.
+ * @param ti_end_new (return) The new end of the particle's time-step.
+ * @param ti_beg_new (return) The new start of the particle's time-step.
+ * @return 1 if the particle was limited, 0 otherwise.
  */
-void runner_do_limiter(struct runner *r, struct cell *c, int force,
-                       const int timer) {
+__attribute__((always_inline)) INLINE static int runner_do_limiter_part(
+    const struct engine *e, struct part *restrict p, struct xpart *restrict xp,
+    integertime_t *ti_end_new, integertime_t *ti_beg_new) {
+
+  /* Bip, bip, bip... wake-up time */
+  if (p->limiter_data.wakeup == time_bin_not_awake) return 0;
+
+  if (!part_is_active(p, e) && p->limiter_data.to_be_synchronized) {
+    warning(
+        "Not limiting particle with id %lld because it needs to be "
+        "synced.",
+        p->id);
+    return 0;
+  }
 
-  const struct engine *e = r->e;
-  const int count = c->hydro.count;
-  struct part *restrict parts = c->hydro.parts;
-  struct xpart *restrict xparts = c->hydro.xparts;
+  // message("Limiting particle %lld in cell %lld", p->id, c->cellID);
 
-  TIMER_TIC;
+  /* Apply the limiter and get the new end of time-step */
+  *ti_end_new = timestep_limit_part(p, xp, e);
+  *ti_beg_new = *ti_end_new - get_integer_timestep(p->time_bin);
 
-#ifdef SWIFT_DEBUG_CHECKS
-  /* Check that we only limit local cells. */
-  if (c->nodeID != engine_rank) error("Limiting dt of a foreign cell is nope.");
+  /* Mark this particle has not needing synchronization */
+  p->limiter_data.to_be_synchronized = 0;
+
+#ifdef SWIFT_HYDRO_DENSITY_CHECKS
+  p->limited_part = 1;
 #endif
 
-  integertime_t ti_hydro_end_min = max_nr_timesteps, ti_hydro_end_max = 0,
-                ti_hydro_beg_max = 0;
-  integertime_t ti_gravity_end_min = max_nr_timesteps, ti_gravity_end_max = 0,
-                ti_gravity_beg_max = 0;
+  /* Also limit the gpart counter-part */
+  if (p->gpart != NULL) p->gpart->time_bin = p->time_bin;
 
-  /* Limit irrespective of cell flags? */
-  force = (force || cell_get_flag(c, cell_flag_do_hydro_limiter));
+  return 1;
+}
 
-  /* Early abort? */
-  if (c->hydro.count == 0) {
+/**
+ * @brief Apply the time-step synchronization procedure to a single particle.
+ *
+ * @param e The #engine.
+ * @param p The #part.
+ * @param xp The #xpart.
+ * @param ti_end_new (return) The new end of the particle's time-step.
+ * @param ti_beg_new (return) The new start of the particle's time-step.
+ * @return 1 if the particle was synchronized, 0 otherwise.
+ */
+__attribute__((always_inline)) INLINE static int runner_do_sync_part(
+    const struct engine *e, struct part *restrict p, struct xpart *restrict xp,
+    integertime_t *ti_end_new, integertime_t *ti_beg_new) {
 
-    /* Clear the limiter flags. */
-    cell_clear_flag(
-        c, cell_flag_do_hydro_limiter | cell_flag_do_hydro_sub_limiter);
-    return;
+  const integertime_t ti_current = e->ti_current;
+  const struct cosmology *cosmo = e->cosmology;
+  const int with_cosmology = (e->policy & engine_policy_cosmology);
+
+  /* If the particle is active no need to sync it */
+  if (part_is_active(p, e) && p->limiter_data.to_be_synchronized) {
+    p->limiter_data.to_be_synchronized = 0;
   }
 
-  /* Loop over the progeny ? */
-  if (c->split && (force || cell_get_flag(c, cell_flag_do_hydro_sub_limiter))) {
-    for (int k = 0; k < 8; k++) {
-      if (c->progeny[k] != NULL) {
-        struct cell *restrict cp = c->progeny[k];
+  if (!p->limiter_data.to_be_synchronized) return 0;
+
+  /* Finish this particle's time-step */
+  timestep_process_sync_part(p, xp, e, cosmo);
+
+  /* Note that at this moment the new RT time step is only used to
+   * limit the hydro time step here. */
+  integertime_t ti_rt_new_step = get_part_rt_timestep(p, xp, e);
+  /* Get new time-step */
+  integertime_t ti_new_step = get_part_timestep(p, xp, e, ti_rt_new_step);
+  timebin_t new_time_bin = get_time_bin(ti_new_step);
+  /* Enforce RT time-step size <= hydro step size. */
+  /* On the commented out line below: We should be doing this once we
+   * correctly add RT to this part of the code. */
+  /* ti_rt_new_step = min(ti_new_step, ti_rt_new_step); */
+
+  /* Apply the limiter if necessary */
+  if (p->limiter_data.wakeup != time_bin_not_awake) {
+    new_time_bin = min(new_time_bin, -p->limiter_data.wakeup + 2);
+    p->limiter_data.wakeup = time_bin_not_awake;
+  }
 
-        /* Recurse */
-        runner_do_limiter(r, cp, force, /*timer=*/0);
+  /* Limit the time-bin to what is allowed in this step */
+  new_time_bin = min(new_time_bin, e->max_active_bin);
+  ti_new_step = get_integer_timestep(new_time_bin);
 
-        /* And aggregate */
-        ti_hydro_end_min = min(cp->hydro.ti_end_min, ti_hydro_end_min);
-        ti_hydro_beg_max = max(cp->hydro.ti_beg_max, ti_hydro_beg_max);
-        ti_gravity_end_min = min(cp->grav.ti_end_min, ti_gravity_end_min);
-        ti_gravity_beg_max = max(cp->grav.ti_beg_max, ti_gravity_beg_max);
-      }
-    }
+  /* Time-step length in physical units */
+  // MATTHIEU: TODO: think about this one!
+  double time_step_length;
+  if (with_cosmology) {
+    time_step_length = cosmology_get_delta_time(e->cosmology, e->ti_current,
+                                                e->ti_current + ti_new_step);
+  } else {
+    time_step_length = get_timestep(new_time_bin, e->time_base);
+  }
 
-    /* Store the updated values */
-    c->hydro.ti_end_min = min(c->hydro.ti_end_min, ti_hydro_end_min);
-    c->hydro.ti_beg_max = max(c->hydro.ti_beg_max, ti_hydro_beg_max);
-    c->grav.ti_end_min = min(c->grav.ti_end_min, ti_gravity_end_min);
-    c->grav.ti_beg_max = max(c->grav.ti_beg_max, ti_gravity_beg_max);
+  /* Update particle */
+  p->time_bin = new_time_bin;
+  if (p->gpart != NULL) p->gpart->time_bin = new_time_bin;
 
-  } else if (!c->split && force) {
+  /* Update the tracers properties */
+  tracers_after_timestep_part(
+      p, xp, e->internal_units, e->physical_constants, with_cosmology,
+      e->cosmology, e->hydro_properties, e->cooling_func, e->time,
+      0 * time_step_length, e->snapshot_recording_triggers_started_part);
 
-    ti_hydro_end_min = c->hydro.ti_end_min;
-    ti_hydro_beg_max = c->hydro.ti_beg_max;
-    ti_gravity_end_min = c->grav.ti_end_min;
-    ti_gravity_beg_max = c->grav.ti_beg_max;
+#ifdef SWIFT_HYDRO_DENSITY_CHECKS
+  p->limited_part = 1;
+#endif
 
-    /* Loop over the gas particles in this cell. */
-    for (int k = 0; k < count; k++) {
+  *ti_end_new = ti_current + ti_new_step;
+  *ti_beg_new = ti_current;
 
-      /* Get a handle on the part. */
-      struct part *restrict p = &parts[k];
-      struct xpart *restrict xp = &xparts[k];
+  return 1;
+}
+
+/**
+ * @brief Apply the time-step limiter and/or the time-step synchronization
+ * procedure to all the particles of a leaf cell in a single pass.
+ *
+ * Each particle is first limited (if it was woken up) and then synchronized
+ * (if flagged). This is equivalent to running the two procedures one after
+ * the other as they only ever act on one particle at a time.
+ *
+ * @param e The #engine.
+ * @param c The (leaf) #cell.
+ * @param do_limiter Are we applying the time-step limiter?
+ * @param do_sync Are we applying the time-step synchronization?
+ */
+static void runner_do_limiter_sync_leaf(const struct engine *e, struct cell *c,
+                                        const int do_limiter,
+                                        const int do_sync) {
+
+  const int count = c->hydro.count;
+  struct part *restrict parts = c->hydro.parts;
+  struct xpart *restrict xparts = c->hydro.xparts;
+
+  integertime_t ti_hydro_end_min = c->hydro.ti_end_min;
+  integertime_t ti_hydro_beg_max = c->hydro.ti_beg_max;
+  integertime_t ti_gravity_end_min = c->grav.ti_end_min;
+  integertime_t ti_gravity_beg_max = c->grav.ti_beg_max;
+
+  /* Loop over the gas particles in this cell. */
+  for (int k = 0; k < count; k++) {
+
+    /* Get a handle on the part. */
+    struct part *restrict p = &parts[k];
+    struct xpart *restrict xp = &xparts[k];
 
 #ifdef SWIFT_HYDRO_DENSITY_CHECKS
+    if (do_limiter) {
 
       /* Finish the limiter loop by adding a (fake) self-contribution */
       p->limiter_data.N_limiter++;
@@ -1398,65 +1477,121 @@ void runner_do_limiter(struct runner *r, struct cell *c, int force,
       const float h_inv_dim = pow_dimension(1. / p->h); /* 1/h^d */
       p->limiter_data.n_limiter += kernel_root;
       p->limiter_data.n_limiter *= h_inv_dim;
+    }
 #endif
 
-      /* Avoid inhibited particles */
-      if (part_is_inhibited(p, e)) continue;
+    /* Avoid inhibited particles */
+    if (part_is_inhibited(p, e)) continue;
 
-      /* Bip, bip, bip... wake-up time */
-      if (p->limiter_data.wakeup != time_bin_not_awake) {
+    integertime_t ti_end_new = 0, ti_beg_new = 0;
+    int updated = 0;
 
-        if (!part_is_active(p, e) && p->limiter_data.to_be_synchronized) {
-          warning(
-              "Not limiting particle with id %lld because it needs to be "
-              "synced.",
-              p->id);
-          continue;
-        }
+    /* Note that the limiter clears the sync flag of the particles it acts
+     * on, so at most one of the two procedures updates any given particle. */
+    if (do_limiter)
+      updated |= runner_do_limiter_part(e, p, xp, &ti_end_new, &ti_beg_new);
 
-        // message("Limiting particle %lld in cell %lld", p->id, c->cellID);
+    if (do_sync)
+      updated |= runner_do_sync_part(e, p, xp, &ti_end_new, &ti_beg_new);
 
-        /* Apply the limiter and get the new end of time-step */
-        const integertime_t ti_end_new = timestep_limit_part(p, xp, e);
-        const timebin_t new_bin = p->time_bin;
-        const integertime_t ti_beg_new =
-            ti_end_new - get_integer_timestep(new_bin);
+    if (!updated) continue;
 
-        /* Mark this particle has not needing synchronization */
-        p->limiter_data.to_be_synchronized = 0;
+    /* What is the next sync-point ? */
+    ti_hydro_end_min = min(ti_end_new, ti_hydro_end_min);
 
-#ifdef SWIFT_HYDRO_DENSITY_CHECKS
-        p->limited_part = 1;
-#endif
+    /* What is the next starting point for this cell ? */
+    ti_hydro_beg_max = max(ti_beg_new, ti_hydro_beg_max);
 
-        /* What is the next sync-point ? */
-        ti_hydro_end_min = min(ti_end_new, ti_hydro_end_min);
-        ti_hydro_end_max = max(ti_end_new, ti_hydro_end_max);
+    /* Also update the gpart counter-part */
+    if (p->gpart != NULL) {
+      ti_gravity_end_min = min(ti_end_new, ti_gravity_end_min);
+      ti_gravity_beg_max = max(ti_beg_new, ti_gravity_beg_max);
+    }
+  }
 
-        /* What is the next starting point for this cell ? */
-        ti_hydro_beg_max = max(ti_beg_new, ti_hydro_beg_max);
+  /* Store the updated values */
+  c->hydro.ti_end_min = min(c->hydro.ti_end_min, ti_hydro_end_min);
+  c->hydro.ti_beg_max = max(c->hydro.ti_beg_max, ti_hydro_beg_max);
+  c->grav.ti_end_min = min(c->grav.ti_end_min, ti_gravity_end_min);
+  c->grav.ti_beg_max = max(c->grav.ti_beg_max, ti_gravity_beg_max);
+}
 
-        /* Also limit the gpart counter-part */
-        if (p->gpart != NULL) {
+/**
+ * @brief Aggregate the time-step information of the progeny of a cell after
+ * the limiter and/or synchronization procedure was applied to them.
+ *
+ * @param c The #cell.
+ */
+static void runner_do_limiter_sync_collect(struct cell *c) {
 
-          /* Register the time-bin */
-          p->gpart->time_bin = p->time_bin;
+  integertime_t ti_hydro_end_min = max_nr_timesteps, ti_hydro_beg_max = 0;
+  integertime_t ti_gravity_end_min = max_nr_timesteps, ti_gravity_beg_max = 0;
 
-          /* What is the next sync-point ? */
-          ti_gravity_end_min = min(ti_end_new, ti_gravity_end_min);
-          ti_gravity_end_max = max(ti_end_new, ti_gravity_end_max);
+  for (int k = 0; k < 8; k++) {
+    if (c->progeny[k] != NULL) {
+      const struct cell *restrict cp = c->progeny[k];
 
-          /* What is the next starting point for this cell ? */
-          ti_gravity_beg_max = max(ti_beg_new, ti_gravity_beg_max);
-        }
+      ti_hydro_end_min = min(cp->hydro.ti_end_min, ti_hydro_end_min);
+      ti_hydro_beg_max = max(cp->hydro.ti_beg_max, ti_hydro_beg_max);
+      ti_gravity_end_min = min(cp->grav.ti_end_min, ti_gravity_end_min);
+      ti_gravity_beg_max = max(cp->grav.ti_beg_max, ti_gravity_beg_max);
+    }
+  }
+
+  /* Store the updated values */
+  c->hydro.ti_end_min = min(c->hydro.ti_end_min, ti_hydro_end_min);
+  c->hydro.ti_beg_max = max(c->hydro.ti_beg_max, ti_hydro_beg_max);
+  c->grav.ti_end_min = min(c->grav.ti_end_min, ti_gravity_end_min);
+  c->grav.ti_beg_max = max(c->grav.ti_beg_max, ti_gravity_beg_max);
+}
+
+/**
+ * @brief Apply the time-step limiter to all awaken particles in a cell
+ * hierarchy.
+ *
+ * @param r The task #runner.
+ * @param c The #cell.
+ * @param force Limit the particles irrespective of the #cell flags.
+ * @param timer Are we timing this ?
+ */
+void runner_do_limiter(struct runner *r, struct cell *c, int force,
+                       const int timer) {
+
+  TIMER_TIC;
+
+#ifdef SWIFT_DEBUG_CHECKS
+  /* Check that we only limit local cells. */
+  if (c->nodeID != engine_rank) error("Limiting dt of a foreign cell is nope.");
+#endif
+
+  /* Limit irrespective of cell flags? */
+  force = (force || cell_get_flag(c, cell_flag_do_hydro_limiter));
+
+  /* Early abort? */
+  if (c->hydro.count == 0) {
+
+    /* Clear the limiter flags. */
+    cell_clear_flag(
+        c, cell_flag_do_hydro_limiter | cell_flag_do_hydro_sub_limiter);
+    return;
+  }
+
+  /* Loop over the progeny ? */
+  if (c->split && (force || cell_get_flag(c, cell_flag_do_hydro_sub_limiter))) {
+    for (int k = 0; k < 8; k++) {
+      if (c->progeny[k] != NULL) {
+
+        /* Recurse */
+        runner_do_limiter(r, c->progeny[k], force, /*timer=*/0);
       }
     }
 
-    /* Store the updated values */
-    c->hydro.ti_end_min = min(c->hydro.ti_end_min, ti_hydro_end_min);
-    c->hydro.ti_beg_max = max(c->hydro.ti_beg_max, ti_hydro_beg_max);
-    c->grav.ti_end_min = min(c->grav.ti_end_min, ti_gravity_end_min);
-    c->grav.ti_beg_max = max(c->grav.ti_beg_max, ti_gravity_beg_max);
+    /* And aggregate */
+    runner_do_limiter_sync_collect(c);
+
+  } else if (!c->split && force) {
+
+    runner_do_limiter_sync_leaf(r->e, c, /*do_limiter=*/1, /*do_sync=*/0);
   }
 
   /* Clear the limiter flags. */
@@ -1478,14 +1613,6 @@ void runner_do_limiter(struct runner *r, struct cell *c, int force,
 void runner_do_sync(struct runner *r, struct cell *c, int force,
                     const int timer) {
 
-  const struct engine *e = r->e;
-  const integertime_t ti_current = e->ti_current;
-  const struct cosmology *cosmo = e->cosmology;
-  const int with_cosmology = (e->policy & engine_policy_cosmology);
-  const int count = c->hydro.count;
-  struct part *restrict parts = c->hydro.parts;
-  struct xpart *restrict xparts = c->hydro.xparts;
-
   TIMER_TIC;
 
 #ifdef SWIFT_DEBUG_CHECKS
@@ -1493,11 +1620,6 @@ void runner_do_sync(struct runner *r, struct cell *c, int force,
   if (c->nodeID != engine_rank) error("Syncing of a foreign cell is nope.");
 #endif
 
-  integertime_t ti_hydro_end_min = max_nr_timesteps, ti_hydro_end_max = 0,
-                ti_hydro_beg_max = 0;
-  integertime_t ti_gravity_end_min = max_nr_timesteps, ti_gravity_end_max = 0,
-                ti_gravity_beg_max = 0;
-
   /* Limit irrespective of cell flags? */
   force = (force || cell_get_flag(c, cell_flag_do_hydro_sync));
 
@@ -1513,133 +1635,93 @@ void runner_do_sync(struct runner *r, struct cell *c, int force,
   if (c->split && (force || cell_get_flag(c, cell_flag_do_hydro_sub_sync))) {
     for (int k = 0; k < 8; k++) {
       if (c->progeny[k] != NULL) {
-        struct cell *restrict cp = c->progeny[k];
 
         /* Recurse */
-        runner_do_sync(r, cp, force, /*timer=*/0);
-
-        /* And aggregate */
-        ti_hydro_end_min = min(cp->hydro.ti_end_min, ti_hydro_end_min);
-        ti_hydro_beg_max = max(cp->hydro.ti_beg_max, ti_hydro_beg_max);
-        ti_gravity_end_min = min(cp->grav.ti_end_min, ti_gravity_end_min);
-        ti_gravity_beg_max = max(cp->grav.ti_beg_max, ti_gravity_beg_max);
+        runner_do_sync(r, c->progeny[k], force, /*timer=*/0);
       }
     }
 
-    /* Store the updated values */
-    c->hydro.ti_end_min = min(c->hydro.ti_end_min, ti_hydro_end_min);
-    c->hydro.ti_beg_max = max(c->hydro.ti_beg_max, ti_hydro_beg_max);
-    c->grav.ti_end_min = min(c->grav.ti_end_min, ti_gravity_end_min);
-    c->grav.ti_beg_max = max(c->grav.ti_beg_max, ti_gravity_beg_max);
+    /* And aggregate */
+    runner_do_limiter_sync_collect(c);
 
   } else if (!c->split && force) {
 
-    ti_hydro_end_min = c->hydro.ti_end_min;
-    ti_hydro_beg_max = c->hydro.ti_beg_max;
-    ti_gravity_end_min = c->grav.ti_end_min;
-    ti_gravity_beg_max = c->grav.ti_beg_max;
-
-    /* Loop over the gas particles in this cell. */
-    for (int k = 0; k < count; k++) {
-
-      /* Get a handle on the part. */
-      struct part *restrict p = &parts[k];
-      struct xpart *restrict xp = &xparts[k];
-
-      /* Avoid inhibited particles */
-      if (part_is_inhibited(p, e)) continue;
-
-      /* If the particle is active no need to sync it */
-      if (part_is_active(p, e) && p->limiter_data.to_be_synchronized) {
-        p->limiter_data.to_be_synchronized = 0;
-      }
-
-      if (p->limiter_data.to_be_synchronized) {
-
-        /* Finish this particle's time-step */
-        timestep_process_sync_part(p, xp, e, cosmo);
-
-        /* Note that at this moment the new RT time step is only used to
-         * limit the hydro time step here. */
-        integertime_t ti_rt_new_step = get_part_rt_timestep(p, xp, e);
-        /* Get new time-step */
-        integertime_t ti_new_step = get_part_timestep(p, xp, e, ti_rt_new_step);
-        timebin_t new_time_bin = get_time_bin(ti_new_step);
-        /* Enforce RT time-step size <= hydro step size. */
-        /* On the commented out line below: We should be doing this once we
-         * correctly add RT to this part of the code. */
-        /* ti_rt_new_step = min(ti_new_step, ti_rt_new_step); */
-
-        /* Apply the limiter if necessary */
-        if (p->limiter_data.wakeup != time_bin_not_awake) {
-          new_time_bin = min(new_time_bin, -p->limiter_data.wakeup + 2);
-          p->limiter_data.wakeup = time_bin_not_awake;
-        }
+    runner_do_limiter_sync_leaf(r->e, c, /*do_limiter=*/0, /*do_sync=*/1);
+  }
 
-        /* Limit the time-bin to what is allowed in this step */
-        new_time_bin = min(new_time_bin, e->max_active_bin);
-        ti_new_step = get_integer_timestep(new_time_bin);
+  /* Clear the sync flags. */
+  cell_clear_flag(c, cell_flag_do_hydro_sync | cell_flag_do_hydro_sub_sync);
 
-        /* Time-step length in physical units */
-        // MATTHIEU: TODO: think about this one!
-        double time_step_length;
-        if (with_cosmology) {
-          time_step_length = cosmology_get_delta_time(
-              e->cosmology, e->ti_current, e->ti_current + ti_new_step);
-        } else {
-          time_step_length = get_timestep(new_time_bin, e->time_base);
-        }
+  if (timer) TIMER_TOC(timer_do_sync);
+}
 
-        /* Update particle */
-        p->time_bin = new_time_bin;
-        if (p->gpart != NULL) p->gpart->time_bin = new_time_bin;
+/**
+ * @brief Apply the time-step limiter and the time-step synchronization
+ * procedure to a cell hierarchy in a single fused pass over the particles.
+ *
+ * This is used by the sync task when the limiter task of the same cell
+ * deferred its work to it. Cells are visited if flagged for either
+ * procedure.
+ *
+ * @param r The task #runner.
+ * @param c The #cell.
+ * @param force_limiter Limit the particles irrespective of the #cell flags.
+ * @param force_sync Sync the particles irrespective of the #cell flags.
+ * @param timer Are we timing this ?
+ */
+void runner_do_limiter_sync(struct runner *r, struct cell *c,
+                            int force_limiter, int force_sync,
+                            const int timer) {
 
-        /* Update the tracers properties */
-        tracers_after_timestep_part(
-            p, xp, e->internal_units, e->physical_constants, with_cosmology,
-            e->cosmology, e->hydro_properties, e->cooling_func, e->time,
-            0 * time_step_length, e->snapshot_recording_triggers_started_part);
+  TIMER_TIC;
 
-#ifdef SWIFT_HYDRO_DENSITY_CHECKS
-        p->limited_part = 1;
+#ifdef SWIFT_DEBUG_CHECKS
+  /* Check that we only limit local cells. */
+  if (c->nodeID != engine_rank) error("Limiting dt of a foreign cell is nope.");
 #endif
 
-        /* What is the next sync-point ? */
-        ti_hydro_end_min = min(ti_current + ti_new_step, ti_hydro_end_min);
-        ti_hydro_end_max = max(ti_current + ti_new_step, ti_hydro_end_max);
-
-        /* What is the next starting point for this cell ? */
-        ti_hydro_beg_max = max(ti_current, ti_hydro_beg_max);
-
-        /* Also limit the gpart counter-part */
-        if (p->gpart != NULL) {
+  /* Act irrespective of cell flags? */
+  force_limiter =
+      (force_limiter || cell_get_flag(c, cell_flag_do_hydro_limiter));
+  force_sync = (force_sync || cell_get_flag(c, cell_flag_do_hydro_sync));
 
-          /* Register the time-bin */
-          p->gpart->time_bin = p->time_bin;
+  const int do_sub_limiter =
+      force_limiter || cell_get_flag(c, cell_flag_do_hydro_sub_limiter);
+  const int do_sub_sync =
+      force_sync || cell_get_flag(c, cell_flag_do_hydro_sub_sync);
 
-          /* What is the next sync-point ? */
-          ti_gravity_end_min =
-              min(ti_current + ti_new_step, ti_gravity_end_min);
-          ti_gravity_end_max =
-              max(ti_current + ti_new_step, ti_gravity_end_max);
+  /* Loop over the progeny ? */
+  if (c->hydro.count > 0 && c->split && (do_sub_limiter || do_sub_sync)) {
+    for (int k = 0; k < 8; k++) {
+      if (c->progeny[k] != NULL) {
+        struct cell *restrict cp = c->progeny[k];
 
-          /* What is the next starting point for this cell ? */
-          ti_gravity_beg_max = max(ti_current, ti_gravity_beg_max);
-        }
+        /* Recurse (only along the branches that need it) */
+        if (do_sub_limiter && do_sub_sync)
+          runner_do_limiter_sync(r, cp, force_limiter, force_sync,
+                                 /*timer=*/0);
+        else if (do_sub_limiter)
+          runner_do_limiter(r, cp, force_limiter, /*timer=*/0);
+        else
+          runner_do_sync(r, cp, force_sync, /*timer=*/0);
       }
     }
 
-    /* Store the updated values */
-    c->hydro.ti_end_min = min(c->hydro.ti_end_min, ti_hydro_end_min);
-    c->hydro.ti_beg_max = max(c->hydro.ti_beg_max, ti_hydro_beg_max);
-    c->grav.ti_end_min = min(c->grav.ti_end_min, ti_gravity_end_min);
-    c->grav.ti_beg_max = max(c->grav.ti_beg_max, ti_gravity_beg_max);
+    /* And aggregate */
+    runner_do_limiter_sync_collect(c);
+
+  } else if (c->hydro.count > 0 && !c->split &&
+             (force_limiter || force_sync)) {
+
+    runner_do_limiter_sync_leaf(r->e, c, force_limiter, force_sync);
   }
 
-  /* Clear the sync flags. */
-  cell_clear_flag(c, cell_flag_do_hydro_sync | cell_flag_do_hydro_sub_sync);
+  /* Clear the limiter and sync flags. */
+  cell_clear_flag(c, cell_flag_do_hydro_limiter |
+                         cell_flag_do_hydro_sub_limiter |
+                         cell_flag_do_hydro_sync | cell_flag_do_hydro_sub_sync);
 
-  if (timer) TIMER_TOC(timer_do_sync);
+  if (timer) TIMER_TOC(timer_do_limiter);
 }
 
 /**
@@ -1725,8 +1725,13 @@ struct task *scheduler_addtask(struct scheduler *s, enum task_types type,
   t->skip = 1; /* Mark tasks as skip by default. */
   t->implicit = implicit;
   t->weight = 0;
+  t->cost = 0;
   t->rank = 0;
   t->nr_unlock_tasks = 0;
+  t->active_unlocks = NULL;
+  t->nr_active_unlocks = 0;
+  t->collapsed = 0;
+  t->feeds_send = 0;
 #ifdef SWIFT_DEBUG_TASKS
   t->rid = -1;
 #endif
@@ -1866,7 +1871,8 @@ void scheduler_ranktasks(struct scheduler *s) {
     }
 
   /* Main loop. */
-  for (int j = 0, rank = 0; j < nr_tasks; rank++) {
+  int rank = 0;
+  for (int j = 0; j < nr_tasks; rank++) {
     /* Did we get anything? */
     if (j == left) error("Unsatisfiable task dependencies detected.");
 
@@ -1891,6 +1897,13 @@ void scheduler_ranktasks(struct scheduler *s) {
     j = left_old;
   }
 
+  /* Make room for the per-rank offsets used to set the priorities. */
+  swift_free("rank_offsets", s->rank_offsets);
+  s->nr_ranks = rank;
+  if ((s->rank_offsets = (int *)swift_malloc(
+           "rank_offsets", sizeof(int) * (s->nr_ranks + 1))) == NULL)
+    error("Failed to allocate the rank offsets.");
+
 #ifdef SWIFT_DEBUG_CHECKS
   /* Verify that the tasks were ranked correctly. */
   for (int k = 1; k < s->nr_tasks; k++)
@@ -2330,6 +2343,7 @@ void scheduler_reweight(struct scheduler *s, int verbose) {
         cost = 0;
         break;
     }
+    t->cost = cost;
     t->weight += cost;
   }
 
@@ -2346,12 +2360,39 @@ void scheduler_reweight(struct scheduler *s, int verbose) {
   message( "task weights are in [ %i , %i ]." , min , max ); */
 }
 
+#ifdef SWIFT_DEBUG_CHECKS
 /**
- * @brief #threadpool_map function which runs through the task
- *        graph and re-computes the task wait counters.
+ * @brief Record that an implicit task was run in this step.
+ *
+ * @param s The #scheduler.
+ * @param t The implicit #task.
  */
-void scheduler_rewait_mapper(void *map_data, int num_elements,
-                             void *extra_data) {
+static void scheduler_mark_implicit_run(struct scheduler *s, struct task *t) {
+
+  t->ti_run = s->space->e->ti_current;
+
+  /* Mark that we have run this task on these cells */
+  if (t->ci != NULL) {
+    t->ci->tasks_executed[t->type]++;
+    t->ci->subtasks_executed[t->subtype]++;
+  }
+  if (t->cj != NULL) {
+    t->cj->tasks_executed[t->type]++;
+    t->cj->subtasks_executed[t->subtype]++;
+  }
+}
+#endif
+
+/**
+ * @brief #threadpool_map function which counts the active tasks unlocked by
+ *        each active task and collapses the trivial implicit tasks.
+ *
+ * Implicit tasks unlocking at most one active task are removed from the
+ * graph of the step. Their dependencies are forwarded to the task they
+ * unlock, if any.
+ */
+void scheduler_collapse_mapper(void *map_data, int num_elements,
+                               void *extra_data) {
   struct scheduler *s = (struct scheduler *)extra_data;
   const int *tid = (int *)map_data;
 
@@ -2361,6 +2402,47 @@ void scheduler_rewait_mapper(void *map_data, int num_elements,
     /* Ignore skipped tasks. */
     if (t->skip) continue;
 
+    /* Count the active tasks we unlock and remember the first one */
+    int count = 0, first = -1;
+    for (int k = 0; k < t->nr_unlock_tasks; k++) {
+      if (t->unlock_tasks[k]->skip) continue;
+      if (first < 0) first = k;
+      count++;
+    }
+
+    t->collapsed = t->implicit && count <= 1;
+
+    if (t->collapsed) {
+
+      /* Point directly at the task we forward our dependencies to */
+      t->active_unlocks = (count > 0) ? &t->unlock_tasks[first] : NULL;
+      t->nr_active_unlocks = count;
+
+    } else {
+
+      /* Reserve room for our active unlocks */
+      const int offset = atomic_add(&s->nr_active_unlocks, count);
+      t->active_unlocks = &s->active_unlocks[offset];
+      t->nr_active_unlocks = 0;
+    }
+  }
+}
+
+/**
+ * @brief #threadpool_map function which runs through the graph of the
+ *        active tasks and re-computes the task wait counters.
+ */
+void scheduler_rewait_mapper(void *map_data, int num_elements,
+                             void *extra_data) {
+  struct scheduler *s = (struct scheduler *)extra_data;
+  const int *tid = (int *)map_data;
+
+  for (int ind = 0; ind < num_elements; ind++) {
+    struct task *t = &s->tasks[tid[ind]];
+
+    /* Ignore skipped and collapsed tasks. */
+    if (t->skip || t->collapsed) continue;
+
     /* Increment the task's own wait counter for the enqueueing. */
     atomic_inc(&t->wait);
 
@@ -2372,9 +2454,17 @@ void scheduler_rewait_mapper(void *map_data, int num_elements,
             (1LL << (8 * sizeof(t->wait) - 1)) - 1);
 #endif
 
-    /* Sets the waits of the dependances */
+    /* Build the list of active dependances and set their waits */
     for (int k = 0; k < t->nr_unlock_tasks; k++) {
       struct task *u = t->unlock_tasks[k];
+      if (u->skip) continue;
+
+      /* Skip over the collapsed tasks */
+      while (u != NULL && u->collapsed)
+        u = (u->nr_active_unlocks > 0) ? u->active_unlocks[0] : NULL;
+      if (u == NULL) continue;
+
+      t->active_unlocks[t->nr_active_unlocks++] = u;
       atomic_inc(&u->wait);
     }
   }
@@ -2387,6 +2477,16 @@ void scheduler_enqueue_mapper(void *map_data, int num_elements,
   struct task *tasks = s->tasks;
   for (int ind = 0; ind < num_elements; ind++) {
     struct task *t = &tasks[tid[ind]];
+
+    /* Collapsed tasks are done as soon as the step starts */
+    if (t->collapsed) {
+#ifdef SWIFT_DEBUG_CHECKS
+      scheduler_mark_implicit_run(s, t);
+#endif
+      t->skip = 1;
+      continue;
+    }
+
     if (atomic_dec(&t->wait) == 1 && !t->skip) {
       scheduler_enqueue(s, t);
     }
@@ -2394,13 +2494,134 @@ void scheduler_enqueue_mapper(void *map_data, int num_elements,
   pthread_cond_broadcast(&s->sleep_cond);
 }
 
+/**
+ * @brief Mapper function setting the weight of active tasks of a given rank
+ * from the weights of their dependents.
+ *
+ * The dependents all have a higher rank and have thus been processed already.
+ *
+ * @param map_data The list of task indices.
+ * @param num_elements The number of tasks.
+ * @param extra_data Pointer to the #scheduler.
+ */
+static void scheduler_prioritise_mapper(void *map_data, int num_elements,
+                                        void *extra_data) {
+  struct scheduler *s = (struct scheduler *)extra_data;
+  struct task *tasks = s->tasks;
+  const int *tid = (int *)map_data;
+
+  float max_weight = 0.f;
+  for (int ind = 0; ind < num_elements; ind++) {
+    struct task *t = &tasks[tid[ind]];
+
+    float weight = 0.f;
+    char feeds_send = (t->type == task_type_send);
+    for (int j = 0; j < t->nr_active_unlocks; j++) {
+      const struct task *u = t->active_unlocks[j];
+      weight = max(weight, u->weight);
+      feeds_send |= u->feeds_send;
+    }
+
+    t->weight = t->cost + weight;
+    t->feeds_send = feeds_send;
+    max_weight = max(max_weight, t->weight);
+  }
+
+  atomic_max_f(&s->max_active_weight, max_weight);
+}
+
+/**
+ * @brief Set the priorities of the active tasks from the graph of the step.
+ *
+ * The weight of a task is the estimated cost of the longest chain of active
+ * tasks it starts. This uses the static cost model of scheduler_reweight(),
+ * not measured run times, so it is only an estimate of the critical path of
+ * this step. The tasks leading to a send to another rank are moved ahead of
+ * all the others when they are enqueued.
+ *
+ * The active tasks are bucketed by rank with a counting sort and the ranks
+ * are then processed from the last one down, each rank in parallel.
+ *
+ * @param s The #scheduler.
+ */
+static void scheduler_prioritise(struct scheduler *s) {
+
+  const int count = s->active_count;
+  const int nr_ranks = s->nr_ranks;
+  s->max_active_weight = 0.f;
+  if (count == 0) return;
+
+  /* Make room for the sorted list of active tasks. */
+  if (s->size_tid_ranked < count) {
+    swift_free("tid_ranked", s->tid_ranked);
+    s->size_tid_ranked = s->size;
+    if ((s->tid_ranked = (int *)swift_malloc(
+             "tid_ranked", sizeof(int) * s->size_tid_ranked)) == NULL)
+      error("Failed to allocate the sorted list of active tasks.");
+  }
+  int *tid = s->tid_ranked;
+  int *offsets = s->rank_offsets;
+
+  /* Sort the active tasks by rank, i.e. in an order compatible with the
+   * dependencies, using a counting sort. The collapsed tasks are left out. */
+  bzero(offsets, (nr_ranks + 1) * sizeof(int));
+  for (int k = 0; k < count; k++) {
+    const struct task *t = &s->tasks[s->tid_active[k]];
+    if (!t->skip && !t->collapsed) offsets[t->rank + 1]++;
+  }
+  for (int r = 0; r < nr_ranks; r++) offsets[r + 1] += offsets[r];
+  for (int k = 0; k < count; k++) {
+    const struct task *t = &s->tasks[s->tid_active[k]];
+    if (!t->skip && !t->collapsed) tid[offsets[t->rank]++] = s->tid_active[k];
+  }
+
+  /* Run through the ranks backwards and get the length of the paths. Note
+   * that offsets[r] is now the end of rank r. */
+  for (int r = nr_ranks - 1; r >= 0; r--) {
+    const int first = (r > 0) ? offsets[r - 1] : 0;
+    const int num = offsets[r] - first;
+    if (num > 1000) {
+      threadpool_map(s->threadpool, scheduler_prioritise_mapper, &tid[first],
+                     num, sizeof(int), threadpool_auto_chunk_size, s);
+    } else if (num > 0) {
+      scheduler_prioritise_mapper(&tid[first], num, s);
+    }
+  }
+}
+
 /**
  * @brief Start the scheduler, i.e. fill the queues with ready tasks.
  *
+ * Only the graph connecting the active tasks is used during the step. It is
+ * rebuilt here from the full task graph, without the implicit tasks that
+ * merely forward a dependency.
+ *
  * @param s The #scheduler.
  */
 void scheduler_start(struct scheduler *s) {
 
+  /* Make room for the unlocks of the active tasks. */
+  if (s->size_active_unlocks < s->nr_unlocks) {
+    swift_free("active_unlocks", s->active_unlocks);
+    s->size_active_unlocks = s->nr_unlocks;
+    if ((s->active_unlocks = (struct task **)swift_malloc(
+             "active_unlocks",
+             sizeof(struct task *) * s->size_active_unlocks)) == NULL)
+      error("Failed to allocate the active unlocks.");
+  }
+  s->nr_active_unlocks = 0;
+
+  /* The tasks are not all waiting for their dependencies yet. */
+  s->started = 0;
+
+  /* Collapse the implicit tasks that only forward dependencies. */
+  if (s->active_count > 1000) {
+    threadpool_map(s->threadpool, scheduler_collapse_mapper, s->tid_active,
+                   s->active_count, sizeof(int), threadpool_auto_chunk_size, s);
+  } else {
+    scheduler_collapse_mapper(s->tid_active, s->active_count, s);
+  }
+
   /* Re-wait the tasks. */
   if (s->active_count > 1000) {
     threadpool_map(s->threadpool, scheduler_rewait_mapper, s->tid_active,
@@ -2409,6 +2630,9 @@ void scheduler_start(struct scheduler *s) {
     scheduler_rewait_mapper(s->tid_active, s->active_count, s);
   }
 
+  /* Set the priorities along the estimated critical path of this step. */
+  scheduler_prioritise(s);
+
   /* Loop over the tasks and enqueue whoever is ready. */
   if (s->active_count > 1000) {
     threadpool_map(s->threadpool, scheduler_enqueue_mapper, s->tid_active,
@@ -2417,6 +2641,9 @@ void scheduler_start(struct scheduler *s) {
     scheduler_enqueue_mapper(s->tid_active, s->active_count, s);
   }
 
+  /* All the tasks now only wait for their dependencies. */
+  s->started = 1;
+
   /* Clear the list of active tasks. */
   s->active_count = 0;
 
@@ -2440,21 +2667,11 @@ void scheduler_enqueue(struct scheduler *s, struct task *t) {
   /* If this is an implicit task, just pretend it's done. */
   if (t->implicit) {
 #ifdef SWIFT_DEBUG_CHECKS
-    t->ti_run = s->space->e->ti_current;
-
-    /* Mark that we have run this task on these cells */
-    if (t->ci != NULL) {
-      t->ci->tasks_executed[t->type]++;
-      t->ci->subtasks_executed[t->subtype]++;
-    }
-    if (t->cj != NULL) {
-      t->cj->tasks_executed[t->type]++;
-      t->cj->subtasks_executed[t->subtype]++;
-    }
+    scheduler_mark_implicit_run(s, t);
 #endif
     t->skip = 1;
-    for (int j = 0; j < t->nr_unlock_tasks; j++) {
-      struct task *t2 = t->unlock_tasks[j];
+    for (int j = 0; j < t->nr_active_unlocks; j++) {
+      struct task *t2 = t->active_unlocks[j];
       if (atomic_dec(&t2->wait) == 1) scheduler_enqueue(s, t2);
     }
   }
@@ -2719,6 +2936,22 @@ void scheduler_enqueue(struct scheduler *s, struct task *t) {
     /* Save qid as owner for next time a task accesses this cell. */
     if (owner != NULL) *owner = qid;
 
+    if (t->feeds_send) {
+
+      /* Move the tasks another rank is waiting for ahead of all the others */
+      t->weight += s->max_active_weight;
+
+    } else if (s->started && t->nr_active_unlocks > 0) {
+
+      /* Demote the tasks whose dependents still wait for many others. This
+       * is only done once the start of the step is over as the waits still
+       * include the enqueueing before that. */
+      int min_wait = INT_MAX;
+      for (int k = 0; k < t->nr_active_unlocks; k++)
+        min_wait = min(min_wait, t->active_unlocks[k]->wait);
+      if (min_wait > 1) t->weight /= min_wait;
+    }
+
     /* Increase the waiting counter. */
     atomic_inc(&s->waiting);
 
@@ -2740,11 +2973,10 @@ struct task *scheduler_done(struct scheduler *s, struct task *t) {
   /* Release whatever locks this task held. */
   if (!t->implicit) task_unlock(t);
 
-  /* Loop through the dependencies and add them to a queue if
+  /* Loop through the active dependencies and add them to a queue if
      they are ready. */
-  for (int k = 0; k < t->nr_unlock_tasks; k++) {
-    struct task *t2 = t->unlock_tasks[k];
-    if (t2->skip) continue;
+  for (int k = 0; k < t->nr_active_unlocks; k++) {
+    struct task *t2 = t->active_unlocks[k];
 
     const int res = atomic_dec(&t2->wait);
     if (res < 1) {
@@ -2783,10 +3015,10 @@ struct task *scheduler_done(struct scheduler *s, struct task *t) {
  *         been identified.
  */
 struct task *scheduler_unlock(struct scheduler *s, struct task *t) {
-  /* Loop through the dependencies and add them to a queue if
+  /* Loop through the active dependencies and add them to a queue if
      they are ready. */
-  for (int k = 0; k < t->nr_unlock_tasks; k++) {
-    struct task *t2 = t->unlock_tasks[k];
+  for (int k = 0; k < t->nr_active_unlocks; k++) {
+    struct task *t2 = t->active_unlocks[k];
     const int res = atomic_dec(&t2->wait);
     if (res < 1) {
       error("Negative wait!");
@@ -2930,6 +3162,15 @@ void scheduler_init(struct scheduler *s, struct space *space, int nr_tasks,
     error("Failed to allocate unlocks.");
   s->nr_unlocks = 0;
   s->size_unlocks = scheduler_init_nr_unlocks;
+  s->active_unlocks = NULL;
+  s->nr_active_unlocks = 0;
+  s->size_active_unlocks = 0;
+  s->tid_ranked = NULL;
+  s->size_tid_ranked = 0;
+  s->rank_offsets = NULL;
+  s->nr_ranks = 0;
+  s->max_active_weight = 0.f;
+  s->started = 0;
 
   /* Set the scheduler variables. */
   s->nr_queues = nr_queues;
@@ -2977,6 +3218,9 @@ void scheduler_clean(struct scheduler *s) {
   scheduler_free_tasks(s);
   swift_free("unlocks", s->unlocks);
   swift_free("unlock_ind", s->unlock_ind);
+  swift_free("active_unlocks", s->active_unlocks);
+  swift_free("tid_ranked", s->tid_ranked);
+  swift_free("rank_offsets", s->rank_offsets);
   for (int i = 0; i < s->nr_queues; ++i) queue_clean(&s->queues[i]);
   swift_free("queues", s->queues);
 }
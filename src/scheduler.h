@@ -81,6 +81,21 @@ struct scheduler {
   int *tid_active;
   int active_count;
 
+  /* The task unlocks between the active tasks of the current step. */
+  struct task **active_unlocks;
+  int nr_active_unlocks, size_active_unlocks;
+
+  /* The active tasks sorted by rank and the end of each rank in that list. */
+  int *tid_ranked, *rank_offsets;
+  int size_tid_ranked, nr_ranks;
+
+  /* The largest weight of the active tasks of the current step. */
+  float max_active_weight;
+
+  /* Have all the active tasks of the step been through their first
+   * enqueueing? */
+  volatile int started;
+
   /* The task unlocks. */
   struct task **volatile unlocks;
   int *volatile unlock_ind;
@@ -69,6 +69,10 @@
  * @param h_grp The group from which to read.
  * @param prop The #io_props of the field to read
  * @param N The number of particles.
+ * @param chunk_offsets The first particle of each range of the dataset to read
+ * (NULL to read the whole dataset).
+ * @param chunk_counts The number of particles in each range to read.
+ * @param num_chunks The number of ranges to read.
  * @param internal_units The #unit_system used internally
  * @param ic_units The #unit_system used in the ICs
  * @param cleanup_h Are we removing h-factors from the ICs?
@@ -81,6 +85,8 @@
  * the part array will be written once the structures have been stabilized.
  */
 void read_array_single(hid_t h_grp, const struct io_props props, size_t N,
+                       const long long* chunk_offsets,
+                       const long long* chunk_counts, const int num_chunks,
                        const struct unit_system* internal_units,
                        const struct unit_system* ic_units, int cleanup_h,
                        int cleanup_sqrt_a, double h, double a) {
@@ -123,13 +129,38 @@ void read_array_single(hid_t h_grp, const struct io_props props, size_t N,
   void* temp = malloc(num_elements * typeSize);
   if (temp == NULL) error("Unable to allocate memory for temporary buffer");
 
+  /* Select the ranges of particles to read, if any */
+  hid_t h_memspace = H5S_ALL, h_filespace = H5S_ALL;
+  if (chunk_offsets != NULL) {
+
+    h_filespace = H5Dget_space(h_data);
+    const int rank = H5Sget_simple_extent_ndims(h_filespace);
+    H5Sselect_none(h_filespace);
+    for (int k = 0; k < num_chunks; ++k) {
+      const hsize_t start[2] = {(hsize_t)chunk_offsets[k], 0};
+      const hsize_t count[2] = {(hsize_t)chunk_counts[k],
+                                (hsize_t)props.dimension};
+      if (H5Sselect_hyperslab(h_filespace, H5S_SELECT_OR, start, NULL, count,
+                              NULL) < 0)
+        error("Error while selecting a region of data set '%s'.", props.name);
+    }
+
+    const hsize_t shape[2] = {N, (hsize_t)props.dimension};
+    h_memspace = H5Screate_simple(rank, shape, NULL);
+  }
+
   /* Read HDF5 dataspace in temporary buffer */
   /* Dirty version that happens to work for vectors but should be improved */
   /* Using HDF5 dataspaces would be better */
-  const hid_t h_err = H5Dread(h_data, io_hdf5_type(props.type), H5S_ALL,
-                              H5S_ALL, H5P_DEFAULT, temp);
+  const hid_t h_err = H5Dread(h_data, io_hdf5_type(props.type), h_memspace,
+                              h_filespace, H5P_DEFAULT, temp);
   if (h_err < 0) error("Error while reading data array '%s'.", props.name);
 
+  if (chunk_offsets != NULL) {
+    H5Sclose(h_memspace);
+    H5Sclose(h_filespace);
+  }
+
   /* Unit conversion if necessary */
   const double unit_factor =
       units_conversion_factor(ic_units, internal_units, props.units);
@@ -229,34 +260,19 @@ void read_array_single(hid_t h_grp, const struct io_props props, size_t N,
  * @param partTypeGroupName The name of the group containing the particles in
  * the HDF5 file.
  * @param props The #io_props of the field to read
+ * @param temp The buffer containing the field converted to snapshot units.
  * @param N The number of particles to write.
- * @param internal_units The #unit_system used internally
  * @param snapshot_units The #unit_system used in the snapshots
- *
- * @todo A better version using HDF5 hyper-slabs to write the file directly from
- * the part array will be written once the structures have been stabilized.
  */
 void write_array_single(const struct engine* e, hid_t grp, const char* fileName,
                         FILE* xmfFile, const char* partTypeGroupName,
-                        const struct io_props props, const size_t N,
+                        const struct io_props props, const void* temp,
+                        const size_t N,
                         const enum lossy_compression_schemes lossy_compression,
-                        const struct unit_system* internal_units,
                         const struct unit_system* snapshot_units) {
 
-  const size_t typeSize = io_sizeof_type(props.type);
-  const size_t num_elements = N * props.dimension;
-
   /* message("Writing '%s' array...", props.name); */
 
-  /* Allocate temporary buffer */
-  void* temp = NULL;
-  if (swift_memalign("writebuff", (void**)&temp, IO_BUFFER_ALIGNMENT,
-                     num_elements * typeSize) != 0)
-    error("Unable to allocate temporary i/o buffer");
-
-  /* Copy the particle data to the temporary buffer */
-  io_copy_temp_buffer(temp, e, props, N, internal_units, snapshot_units);
-
   /* Create data space */
   const hid_t h_space = H5Screate(H5S_SIMPLE);
   if (h_space < 0)
@@ -384,7 +400,6 @@ void write_array_single(const struct engine* e, hid_t grp, const char* fileName,
   io_write_attribute_s(h_data, "Description", props.description);
 
   /* Free and close everything */
-  swift_free("writebuff", temp);
   H5Tclose(h_type);
   H5Pclose(h_prop);
   H5Dclose(h_data);
@@ -514,6 +529,36 @@ void read_ic_single(
   for (int ptype = 0; ptype < swift_type_count; ++ptype)
     N[ptype] = (numParticles[ptype]) + (numParticles_highWord[ptype] << 32);
 
+  /* Only keep the particles in the cells overlapping the requested region */
+  long long* chunk_offsets[swift_type_count] = {NULL};
+  long long* chunk_counts[swift_type_count] = {NULL};
+  int num_chunks[swift_type_count] = {0};
+  if (ics_metadata->region_read) {
+
+    /* Box size in the file's units */
+    const double box_size[3] = {
+        boxSize[0], (boxSize[1] < 0) ? boxSize[0] : boxSize[1],
+        (boxSize[2] < 0) ? boxSize[0] : boxSize[2]};
+
+    for (int ptype = 0; ptype < swift_type_count; ++ptype) {
+      if (N[ptype] == 0) continue;
+
+      const size_t N_total = N[ptype];
+      N[ptype] = io_select_cells_in_region(
+          h_file, ptype, box_size, ics_metadata->region_min,
+          ics_metadata->region_max, &chunk_offsets[ptype],
+          &chunk_counts[ptype], &num_chunks[ptype]);
+
+      message(
+          "Reading %zd/%zd particles of type %d from %d contiguous ranges in "
+          "the region [%e %e %e] - [%e %e %e].",
+          N[ptype], N_total, ptype, num_chunks[ptype],
+          ics_metadata->region_min[0], ics_metadata->region_min[1],
+          ics_metadata->region_min[2], ics_metadata->region_max[0],
+          ics_metadata->region_max[1], ics_metadata->region_max[2]);
+    }
+  }
+
   /* Get the box size if not cubic */
   dim[0] = boxSize[0];
   dim[1] = (boxSize[1] < 0) ? boxSize[0] : boxSize[1];
@@ -731,14 +776,21 @@ void read_ic_single(
         if (remap_ids && strcmp(list[i].name, "ParticleIDs") == 0) continue;
 
         /* Read array. */
-        read_array_single(h_grp, list[i], Nparticles, internal_units, ic_units,
-                          cleanup_h, cleanup_sqrt_a, h, a);
+        read_array_single(h_grp, list[i], Nparticles, chunk_offsets[ptype],
+                          chunk_counts[ptype], num_chunks[ptype],
+                          internal_units, ic_units, cleanup_h, cleanup_sqrt_a,
+                          h, a);
       }
 
     /* Close particle group */
     H5Gclose(h_grp);
   }
 
+  for (int ptype = 0; ptype < swift_type_count; ++ptype) {
+    free(chunk_offsets[ptype]);
+    free(chunk_counts[ptype]);
+  }
+
   /* If we are remapping ParticleIDs later, start by setting them to 1. */
   if (remap_ids) io_set_ids_to_one(*gparts, *Ngparts);
 
@@ -1103,9 +1155,10 @@ void write_output_single(struct engine* e,
   /* Write the location of the particles in the arrays */
   io_write_cell_offsets(h_grp, e->s->cdim, e->s->dim, e->s->cells_top,
                         e->s->nr_cells, e->s->width, e->nodeID,
-                        /*distributed=*/0, subsample, subsample_fraction,
-                        e->snapshot_output_count, N_total, global_offsets,
-                        to_write, numFields, internal_units, snapshot_units);
+                        /*distributed=*/0, /*node_files=*/NULL, subsample,
+                        subsample_fraction, e->snapshot_output_count, N_total,
+                        global_offsets, to_write, numFields, internal_units,
+                        snapshot_units);
   H5Gclose(h_grp);
 
   /* Loop over all particle types */
@@ -1145,13 +1198,7 @@ void write_output_single(struct engine* e,
     bzero(list, 100 * sizeof(struct io_props));
     size_t N = 0;
 
-    struct part* parts_written = NULL;
-    struct xpart* xparts_written = NULL;
-    struct gpart* gparts_written = NULL;
-    struct velociraptor_gpart_data* gpart_group_data_written = NULL;
-    struct spart* sparts_written = NULL;
-    struct bpart* bparts_written = NULL;
-    struct sink* sinks_written = NULL;
+    size_t* index_written = NULL;
 
     /* Write particle fields from the particle structure */
     switch (ptype) {
@@ -1172,26 +1219,17 @@ void write_output_single(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           N = Ngas_written;
 
-          /* Allocate temporary arrays */
-          if (swift_memalign("parts_written", (void**)&parts_written,
-                             part_align,
-                             Ngas_written * sizeof(struct part)) != 0)
-            error("Error while allocating temporary memory for parts");
-          if (swift_memalign("xparts_written", (void**)&xparts_written,
-                             xpart_align,
-                             Ngas_written * sizeof(struct xpart)) != 0)
-            error("Error while allocating temporary memory for xparts");
-
-          /* Collect the particles we want to write */
-          io_collect_parts_to_write(
-              parts, xparts, parts_written, xparts_written,
-              subsample[swift_type_gas], subsample_fraction[swift_type_gas],
-              e->snapshot_output_count, Ngas, Ngas_written);
+          /* Select the particles we want to write */
+          index_written =
+              io_select_parts_to_write(e, parts, subsample[swift_type_gas],
+                                       subsample_fraction[swift_type_gas],
+                                       e->snapshot_output_count, Ngas,
+                                       Ngas_written);
 
           /* Select the fields to write */
-          io_select_hydro_fields(parts_written, xparts_written, with_cosmology,
-                                 with_cooling, with_temperature, with_fof,
-                                 with_stf, with_rt, e, &num_fields, list);
+          io_select_hydro_fields(parts, xparts, with_cosmology, with_cooling,
+                                 with_temperature, with_fof, with_stf, with_rt,
+                                 e, &num_fields, list);
         }
       } break;
 
@@ -1211,32 +1249,15 @@ void write_output_single(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           N = Ndm_written;
 
-          /* Allocate temporary array */
-          if (swift_memalign("gparts_written", (void**)&gparts_written,
-                             gpart_align,
-                             Ndm_written * sizeof(struct gpart)) != 0)
-            error("Error while allocating temporary memory for gparts");
-
-          if (with_stf) {
-            if (swift_memalign(
-                    "gpart_group_written", (void**)&gpart_group_data_written,
-                    gpart_align,
-                    Ndm_written * sizeof(struct velociraptor_gpart_data)) != 0)
-              error(
-                  "Error while allocating temporary memory for gparts STF "
-                  "data");
-          }
-
-          /* Collect the non-inhibited DM particles from gpart */
-          io_collect_gparts_to_write(
-              gparts, e->s->gpart_group_data, gparts_written,
-              gpart_group_data_written, subsample[swift_type_dark_matter],
+          /* Select the non-inhibited DM particles from gpart */
+          index_written = io_select_gparts_to_write(
+              e, gparts, subsample[swift_type_dark_matter],
               subsample_fraction[swift_type_dark_matter],
-              e->snapshot_output_count, Ntot, Ndm_written, with_stf);
+              e->snapshot_output_count, Ntot, Ndm_written);
 
           /* Select the fields to write */
-          io_select_dm_fields(gparts_written, gpart_group_data_written,
-                              with_fof, with_stf, e, &num_fields, list);
+          io_select_dm_fields(gparts, e->s->gpart_group_data, with_fof,
+                              with_stf, e, &num_fields, list);
         }
       } break;
 
@@ -1245,33 +1266,15 @@ void write_output_single(struct engine* e,
         /* Ok, we need to fish out the particles we want */
         N = Ndm_background;
 
-        /* Allocate temporary array */
-        if (swift_memalign("gparts_written", (void**)&gparts_written,
-                           gpart_align,
-                           Ndm_background * sizeof(struct gpart)) != 0)
-          error("Error while allocating temporary memory for gparts");
-
-        if (with_stf) {
-          if (swift_memalign(
-                  "gpart_group_written", (void**)&gpart_group_data_written,
-                  gpart_align,
-                  Ndm_background * sizeof(struct velociraptor_gpart_data)) != 0)
-            error(
-                "Error while allocating temporary memory for gparts STF "
-                "data");
-        }
-
-        /* Collect the non-inhibited DM particles from gpart */
-        io_collect_gparts_background_to_write(
-            gparts, e->s->gpart_group_data, gparts_written,
-            gpart_group_data_written,
-            subsample[swift_type_dark_matter_background],
+        /* Select the non-inhibited DM particles from gpart */
+        index_written = io_select_gparts_background_to_write(
+            e, gparts, subsample[swift_type_dark_matter_background],
             subsample_fraction[swift_type_dark_matter_background],
-            e->snapshot_output_count, Ntot, Ndm_background, with_stf);
+            e->snapshot_output_count, Ntot, Ndm_background);
 
         /* Select the fields to write */
-        io_select_dm_fields(gparts_written, gpart_group_data_written, with_fof,
-                            with_stf, e, &num_fields, list);
+        io_select_dm_fields(gparts, e->s->gpart_group_data, with_fof, with_stf,
+                            e, &num_fields, list);
 
       } break;
 
@@ -1280,32 +1283,15 @@ void write_output_single(struct engine* e,
         /* Ok, we need to fish out the particles we want */
         N = Ndm_neutrino;
 
-        /* Allocate temporary array */
-        if (swift_memalign("gparts_written", (void**)&gparts_written,
-                           gpart_align,
-                           Ndm_neutrino * sizeof(struct gpart)) != 0)
-          error("Error while allocating temporary memory for gparts");
-
-        if (with_stf) {
-          if (swift_memalign(
-                  "gpart_group_written", (void**)&gpart_group_data_written,
-                  gpart_align,
-                  Ndm_neutrino * sizeof(struct velociraptor_gpart_data)) != 0)
-            error(
-                "Error while allocating temporary memory for gparts STF "
-                "data");
-        }
-
-        /* Collect the non-inhibited DM particles from gpart */
-        io_collect_gparts_neutrino_to_write(
-            gparts, e->s->gpart_group_data, gparts_written,
-            gpart_group_data_written, subsample[swift_type_neutrino],
+        /* Select the non-inhibited DM particles from gpart */
+        index_written = io_select_gparts_neutrino_to_write(
+            e, gparts, subsample[swift_type_neutrino],
             subsample_fraction[swift_type_neutrino], e->snapshot_output_count,
-            Ntot, Ndm_neutrino, with_stf);
+            Ntot, Ndm_neutrino);
 
         /* Select the fields to write */
-        io_select_neutrino_fields(gparts_written, gpart_group_data_written,
-                                  with_fof, with_stf, e, &num_fields, list);
+        io_select_neutrino_fields(gparts, e->s->gpart_group_data, with_fof,
+                                  with_stf, e, &num_fields, list);
 
       } break;
 
@@ -1323,21 +1309,16 @@ void write_output_single(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           N = Nsinks_written;
 
-          /* Allocate temporary arrays */
-          if (swift_memalign("sinks_written", (void**)&sinks_written,
-                             sink_align,
-                             Nsinks_written * sizeof(struct sink)) != 0)
-            error("Error while allocating temporary memory for sinks");
-
-          /* Collect the particles we want to write */
-          io_collect_sinks_to_write(
-              sinks, sinks_written, subsample[swift_type_sink],
-              subsample_fraction[swift_type_sink], e->snapshot_output_count,
-              Nsinks, Nsinks_written);
+          /* Select the particles we want to write */
+          index_written =
+              io_select_sinks_to_write(e, sinks, subsample[swift_type_sink],
+                                       subsample_fraction[swift_type_sink],
+                                       e->snapshot_output_count, Nsinks,
+                                       Nsinks_written);
 
           /* Select the fields to write */
-          io_select_sink_fields(sinks_written, with_cosmology, with_fof,
-                                with_stf, e, &num_fields, list);
+          io_select_sink_fields(sinks, with_cosmology, with_fof, with_stf, e,
+                                &num_fields, list);
         }
       } break;
 
@@ -1356,21 +1337,16 @@ void write_output_single(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           N = Nstars_written;
 
-          /* Allocate temporary arrays */
-          if (swift_memalign("sparts_written", (void**)&sparts_written,
-                             spart_align,
-                             Nstars_written * sizeof(struct spart)) != 0)
-            error("Error while allocating temporary memory for sparts");
-
-          /* Collect the particles we want to write */
-          io_collect_sparts_to_write(
-              sparts, sparts_written, subsample[swift_type_stars],
-              subsample_fraction[swift_type_stars], e->snapshot_output_count,
-              Nstars, Nstars_written);
+          /* Select the particles we want to write */
+          index_written =
+              io_select_sparts_to_write(e, sparts, subsample[swift_type_stars],
+                                        subsample_fraction[swift_type_stars],
+                                        e->snapshot_output_count, Nstars,
+                                        Nstars_written);
 
           /* Select the fields to write */
-          io_select_star_fields(sparts_written, with_cosmology, with_fof,
-                                with_stf, with_rt, e, &num_fields, list);
+          io_select_star_fields(sparts, with_cosmology, with_fof, with_stf,
+                                with_rt, e, &num_fields, list);
         }
       } break;
 
@@ -1389,21 +1365,15 @@ void write_output_single(struct engine* e,
           /* Ok, we need to fish out the particles we want */
           N = Nblackholes_written;
 
-          /* Allocate temporary arrays */
-          if (swift_memalign("bparts_written", (void**)&bparts_written,
-                             bpart_align,
-                             Nblackholes_written * sizeof(struct bpart)) != 0)
-            error("Error while allocating temporary memory for bparts");
-
-          /* Collect the particles we want to write */
-          io_collect_bparts_to_write(
-              bparts, bparts_written, subsample[swift_type_black_hole],
+          /* Select the particles we want to write */
+          index_written = io_select_bparts_to_write(
+              e, bparts, subsample[swift_type_black_hole],
               subsample_fraction[swift_type_black_hole],
               e->snapshot_output_count, Nblackholes, Nblackholes_written);
 
           /* Select the fields to write */
-          io_select_bh_fields(bparts_written, with_cosmology, with_fof,
-                              with_stf, e, &num_fields, list);
+          io_select_bh_fields(bparts, with_cosmology, with_fof, with_stf, e,
+                              &num_fields, list);
         }
       } break;
 
@@ -1411,6 +1381,9 @@ void write_output_single(struct engine* e,
         error("Particle Type %d not yet supported. Aborting", ptype);
     }
 
+    /* Read the selected particles through their indices */
+    io_set_write_index(list, num_fields, index_written);
+
     /* Did the user specify a non-standard default for the entire particle
      * type? */
     const enum lossy_compression_schemes compression_level_current_default =
@@ -1418,7 +1391,9 @@ void write_output_single(struct engine* e,
             output_options->select_output, current_selection_name,
             (enum part_type)ptype, e->verbose);
 
-    /* Write everything that is not cancelled */
+    /* Select everything that is not cancelled */
+    struct io_props list_written[100];
+    enum lossy_compression_schemes compression_written[100];
     int num_fields_written = 0;
     for (int i = 0; i < num_fields; ++i) {
 
@@ -1430,25 +1405,34 @@ void write_output_single(struct engine* e,
               e->verbose);
 
       if (compression_level != compression_do_not_write) {
-        write_array_single(e, h_grp, fileName, xmfFile, partTypeGroupName,
-                           list[i], N, compression_level, internal_units,
-                           snapshot_units);
+        list_written[num_fields_written] = list[i];
+        compression_written[num_fields_written] = compression_level;
         num_fields_written++;
       }
     }
 
+    /* Copy groups of fields in one pass over the particles and write them */
+    for (int first = 0; first < num_fields_written;) {
+
+      void* temps[100];
+      const int group_size = io_copy_next_field_group(
+          temps, e, list_written, first, num_fields_written, N,
+          internal_units, snapshot_units);
+
+      for (int k = 0; k < group_size; ++k) {
+        write_array_single(e, h_grp, fileName, xmfFile, partTypeGroupName,
+                           list_written[first + k], temps[k], N,
+                           compression_written[first + k], snapshot_units);
+        swift_free("writebuff", temps[k]);
+      }
+      first += group_size;
+    }
+
     /* Only write this now that we know exactly how many fields there are. */
     io_write_attribute_i(h_grp, "NumberOfFields", num_fields_written);
 
     /* Free temporary arrays */
-    if (parts_written) swift_free("parts_written", parts_written);
-    if (xparts_written) swift_free("xparts_written", xparts_written);
-    if (gparts_written) swift_free("gparts_written", gparts_written);
-    if (gpart_group_data_written)
-      swift_free("gpart_group_written", gpart_group_data_written);
-    if (sparts_written) swift_free("sparts_written", sparts_written);
-    if (bparts_written) swift_free("bparts_written", bparts_written);
-    if (sinks_written) swift_free("sinks_written", sinks_written);
+    if (index_written) swift_free("index_written", index_written);
 
     /* Close particle group */
     H5Gclose(h_grp);
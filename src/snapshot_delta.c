@@ -0,0 +1,496 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+/* Config parameters. */
+#include <config.h>
+
+/* Some standard headers. */
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(HAVE_HDF5) && !defined(WITH_MPI)
+#include <hdf5.h>
+#endif
+
+/* This object's header. */
+#include "snapshot_delta.h"
+
+/* Local includes. */
+#include "engine.h"
+#include "error.h"
+#include "io_properties.h"
+#include "output_options.h"
+#include "threadpool.h"
+#include "tools.h"
+#include "units.h"
+#include "version.h"
+
+/**
+ * @brief Free the memory used by a #snapshot_delta.
+ *
+ * @param d The #snapshot_delta (can be NULL).
+ */
+void snapshot_delta_clean(struct snapshot_delta *d) {
+
+  if (d == NULL) return;
+  free(d->ids);
+  free(d->x);
+  free(d->v);
+  free(d);
+}
+
+/**
+ * @brief Is the next snapshot a keyframe of the delta-encoded stream?
+ *
+ * @param e The #engine.
+ */
+int snapshot_delta_next_is_keyframe(const struct engine *e) {
+
+  const struct snapshot_delta *d = e->snapshot_delta;
+  return d == NULL || d->frames_since_keyframe >= e->snapshot_delta_frames;
+}
+
+#if defined(HAVE_HDF5) && !defined(WITH_MPI)
+
+/**
+ * @brief The gas particles of the current step, sorted by ID.
+ */
+struct snapshot_delta_state {
+  size_t count;
+  long long *ids;
+  double *x;
+  float *v;
+};
+
+/**
+ * @brief Pair of ID and position in the unsorted arrays, used for sorting.
+ */
+struct snapshot_delta_key {
+  long long id;
+  size_t index;
+};
+
+static int snapshot_delta_key_compare(const void *a, const void *b) {
+  const struct snapshot_delta_key *ka = (const struct snapshot_delta_key *)a;
+  const struct snapshot_delta_key *kb = (const struct snapshot_delta_key *)b;
+  return (ka->id > kb->id) - (ka->id < kb->id);
+}
+
+/**
+ * @brief Construct the name of the file of the next snapshot.
+ *
+ * @param e The #engine.
+ * @param fileName (return) The name of the file.
+ */
+static void snapshot_delta_get_filename(const struct engine *e,
+                                        char fileName[FILENAME_BUFFER_SIZE]) {
+
+  char current_selection_name[FIELD_BUFFER_SIZE] =
+      select_output_header_default_name;
+  if (e->output_list_snapshots)
+    output_list_get_current_select_output(e->output_list_snapshots,
+                                          current_selection_name);
+
+  char xmfFileName[FILENAME_BUFFER_SIZE];
+  char snapshot_subdir_name[FILENAME_BUFFER_SIZE];
+  char snapshot_base_name[FILENAME_BUFFER_SIZE];
+  output_options_get_basename(e->output_options, current_selection_name,
+                              e->snapshot_subdir, e->snapshot_base_name,
+                              snapshot_subdir_name, snapshot_base_name);
+  io_get_snapshot_filename(
+      fileName, xmfFileName, e->output_list_snapshots, e->snapshot_invoke_stf,
+      e->stf_output_count, e->snapshot_output_count, e->snapshot_subdir,
+      snapshot_subdir_name, e->snapshot_base_name, snapshot_base_name);
+  safe_checkdir(snapshot_subdir_name, /*create=*/1);
+}
+
+/**
+ * @brief Extract the IDs, positions and velocities of the gas particles as
+ * they would be written in a snapshot, sorted by ID.
+ *
+ * @param e The #engine.
+ * @param internal_units The system of units used internally.
+ * @param snapshot_units The system of units used for the snapshots.
+ * @param state (return) The sorted particle data.
+ */
+static void snapshot_delta_get_state(struct engine *e,
+                                     const struct unit_system *internal_units,
+                                     const struct unit_system *snapshot_units,
+                                     struct snapshot_delta_state *state) {
+
+  const struct space *s = e->s;
+  const size_t Ngas = s->nr_parts;
+  const size_t N = s->nr_parts - s->nr_inhibited_parts - s->nr_extra_parts;
+
+  /* Select the particles we want, if necessary */
+  size_t *index_written = NULL;
+  if (N != Ngas)
+    index_written = io_select_parts_to_write(
+        e, s->parts, /*subsample=*/0, /*subsample_ratio=*/1.f,
+        e->snapshot_output_count, Ngas, N);
+
+  /* Get the fields exactly as they are written in the snapshots */
+  int num_fields = 0;
+  struct io_props list[100];
+  io_select_hydro_fields(
+      s->parts, s->xparts, e->policy & engine_policy_cosmology,
+      e->policy & engine_policy_cooling, e->policy & engine_policy_temperature,
+      e->policy & engine_policy_fof, /*with_stf=*/0,
+      e->policy & engine_policy_rt, e, &num_fields, list);
+  io_set_write_index(list, num_fields, index_written);
+
+  long long *ids = (long long *)malloc(N * sizeof(long long));
+  double *x = (double *)malloc(3 * N * sizeof(double));
+  float *v = (float *)malloc(3 * N * sizeof(float));
+  if (ids == NULL || x == NULL || v == NULL)
+    error("Unable to allocate memory for the delta frame");
+
+  int found = 0;
+  for (int i = 0; i < num_fields; ++i) {
+    void *temp = NULL;
+    if (strcmp(list[i].name, "ParticleIDs") == 0)
+      temp = ids;
+    else if (strcmp(list[i].name, "Coordinates") == 0)
+      temp = x;
+    else if (strcmp(list[i].name, "Velocities") == 0)
+      temp = v;
+    if (temp == NULL) continue;
+
+    if (io_sizeof_type(list[i].type) !=
+        (temp == x ? sizeof(double) : (temp == v ? sizeof(float) : 8)))
+      error("Unexpected type for field '%s' in delta frames", list[i].name);
+
+    io_copy_temp_buffer(temp, e, list[i], N, internal_units, snapshot_units);
+    found++;
+  }
+  if (found != 3) error("Could not find the fields needed for delta frames");
+
+  if (index_written) swift_free("index_written", index_written);
+
+  /* Sort everything by ID */
+  struct snapshot_delta_key *keys = (struct snapshot_delta_key *)malloc(
+      N * sizeof(struct snapshot_delta_key));
+  if (keys == NULL) error("Unable to allocate memory for the delta frame");
+  for (size_t i = 0; i < N; ++i) {
+    keys[i].id = ids[i];
+    keys[i].index = i;
+  }
+  qsort(keys, N, sizeof(struct snapshot_delta_key),
+        snapshot_delta_key_compare);
+
+  state->count = N;
+  state->ids = (long long *)malloc(N * sizeof(long long));
+  state->x = (double *)malloc(3 * N * sizeof(double));
+  state->v = (float *)malloc(3 * N * sizeof(float));
+  if (state->ids == NULL || state->x == NULL || state->v == NULL)
+    error("Unable to allocate memory for the delta frame");
+  for (size_t i = 0; i < N; ++i) {
+    const size_t j = keys[i].index;
+    state->ids[i] = ids[j];
+    for (int k = 0; k < 3; ++k) {
+      state->x[3 * i + k] = x[3 * j + k];
+      state->v[3 * i + k] = v[3 * j + k];
+    }
+  }
+
+  free(keys);
+  free(ids);
+  free(x);
+  free(v);
+}
+
+/**
+ * @brief Current time and box size in snapshot units.
+ */
+static void snapshot_delta_get_time_and_box(
+    const struct engine *e, const struct unit_system *internal_units,
+    const struct unit_system *snapshot_units, double *time, double box[3]) {
+
+  *time = e->time * units_conversion_factor(internal_units, snapshot_units,
+                                            UNIT_CONV_TIME);
+  const double length_factor =
+      units_conversion_factor(internal_units, snapshot_units, UNIT_CONV_LENGTH);
+  for (int k = 0; k < 3; ++k) box[k] = e->s->dim[k] * length_factor;
+}
+
+/**
+ * @brief Record the state of the gas particles written in a keyframe.
+ *
+ * Must be called just before the keyframe (a regular snapshot) is written.
+ *
+ * @param e The #engine.
+ * @param internal_units The system of units used internally.
+ * @param snapshot_units The system of units used for the snapshots.
+ */
+void snapshot_delta_record_keyframe(struct engine *e,
+                                    const struct unit_system *internal_units,
+                                    const struct unit_system *snapshot_units) {
+
+  struct snapshot_delta_state state;
+  snapshot_delta_get_state(e, internal_units, snapshot_units, &state);
+
+  snapshot_delta_clean(e->snapshot_delta);
+  struct snapshot_delta *d =
+      (struct snapshot_delta *)malloc(sizeof(struct snapshot_delta));
+  if (d == NULL) error("Unable to allocate memory for the delta frames");
+
+  d->count = state.count;
+  d->ids = state.ids;
+  d->x = state.x;
+  d->v = (double *)malloc(3 * state.count * sizeof(double));
+  if (d->v == NULL) error("Unable to allocate memory for the delta frames");
+  for (size_t i = 0; i < 3 * state.count; ++i) d->v[i] = state.v[i];
+  free(state.v);
+
+  double box[3];
+  snapshot_delta_get_time_and_box(e, internal_units, snapshot_units, &d->time,
+                                  box);
+  d->frames_since_keyframe = 0;
+  snapshot_delta_get_filename(e, d->last_frame);
+
+  e->snapshot_delta = d;
+}
+
+/**
+ * @brief Data used by the quantisation mapper.
+ */
+struct snapshot_delta_quantise_data {
+
+  /*! Current state of the particles */
+  const struct snapshot_delta_state *state;
+
+  /*! Reconstructed state of the previous frame */
+  const struct snapshot_delta *previous;
+
+  /*! Index of each particle in the previous frame (-1 if not present) */
+  const long long *match;
+
+  /*! The quantised residuals */
+  long long *dx, *dv;
+
+  /*! The new reconstructed state */
+  double *x_rec, *v_rec;
+
+  /*! Time since the previous frame */
+  double dt;
+
+  /*! Quanta of the position and velocity residuals */
+  double quantum_x, quantum_v;
+
+  /*! Box size and periodicity */
+  double box[3];
+  int periodic;
+};
+
+/**
+ * @brief Quantise the difference between the current state of the particles
+ * and the state predicted from the previous frame.
+ *
+ * The elements are particle indices, i.e. byte offsets from NULL.
+ */
+void snapshot_delta_quantise_mapper(void *map_data, int num_elements,
+                                    void *extra_data) {
+
+  const struct snapshot_delta_quantise_data *data =
+      (const struct snapshot_delta_quantise_data *)extra_data;
+  const struct snapshot_delta_state *state = data->state;
+  const struct snapshot_delta *previous = data->previous;
+  const size_t first = (size_t)map_data;
+
+  for (size_t i = first; i < first + num_elements; ++i) {
+
+    const long long j = data->match[i];
+
+    for (int k = 0; k < 3; ++k) {
+
+      /* Prediction from the previous frame (zero for new particles) */
+      double x_pred = 0., v_pred = 0.;
+      if (j >= 0) {
+        v_pred = previous->v[3 * j + k];
+        x_pred = previous->x[3 * j + k] + v_pred * data->dt;
+      }
+
+      /* Position residual, taking the nearest periodic image */
+      double dx = state->x[3 * i + k] - x_pred;
+      if (data->periodic) dx -= data->box[k] * nearbyint(dx / data->box[k]);
+      const long long qx = llround(dx / data->quantum_x);
+      double x_rec = x_pred + qx * data->quantum_x;
+      if (data->periodic) {
+        if (x_rec >= data->box[k]) x_rec -= data->box[k];
+        if (x_rec < 0.) x_rec += data->box[k];
+      }
+
+      /* Velocity residual */
+      const double dv = state->v[3 * i + k] - v_pred;
+      const long long qv = llround(dv / data->quantum_v);
+
+      data->dx[3 * i + k] = qx;
+      data->dv[3 * i + k] = qv;
+      data->x_rec[3 * i + k] = x_rec;
+      data->v_rec[3 * i + k] = v_pred + qv * data->quantum_v;
+    }
+  }
+}
+
+/**
+ * @brief Write a delta frame of the gas particles.
+ *
+ * The frame contains the IDs of the particles (as differences between
+ * consecutive sorted IDs) and the quantised residuals of their positions and
+ * velocities with respect to the prediction from the previous frame. Particles
+ * not present in the previous frame are predicted at the origin with zero
+ * velocity.
+ *
+ * @param e The #engine.
+ * @param internal_units The system of units used internally.
+ * @param snapshot_units The system of units used for the snapshots.
+ */
+void snapshot_delta_write_frame(struct engine *e,
+                                const struct unit_system *internal_units,
+                                const struct unit_system *snapshot_units) {
+
+  const ticks tic = getticks();
+  struct snapshot_delta *previous = e->snapshot_delta;
+  if (previous == NULL) error("Writing a delta frame without a keyframe");
+
+  struct snapshot_delta_state state;
+  snapshot_delta_get_state(e, internal_units, snapshot_units, &state);
+  const size_t N = state.count;
+
+  double time, box[3];
+  snapshot_delta_get_time_and_box(e, internal_units, snapshot_units, &time,
+                                  box);
+
+  /* Match the particles with the previous frame (both are sorted by ID) */
+  long long *match = (long long *)malloc(N * sizeof(long long));
+  long long *id_deltas = (long long *)malloc(N * sizeof(long long));
+  if (match == NULL || id_deltas == NULL)
+    error("Unable to allocate memory for the delta frame");
+  size_t j = 0;
+  for (size_t i = 0; i < N; ++i) {
+    while (j < previous->count && previous->ids[j] < state.ids[i]) j++;
+    match[i] = (j < previous->count && previous->ids[j] == state.ids[i])
+                   ? (long long)j
+                   : -1;
+    id_deltas[i] = state.ids[i] - (i > 0 ? state.ids[i - 1] : 0);
+  }
+
+  /* Quantise the residuals */
+  struct snapshot_delta_quantise_data data;
+  data.state = &state;
+  data.previous = previous;
+  data.match = match;
+  data.dx = (long long *)malloc(3 * N * sizeof(long long));
+  data.dv = (long long *)malloc(3 * N * sizeof(long long));
+  data.x_rec = (double *)malloc(3 * N * sizeof(double));
+  data.v_rec = (double *)malloc(3 * N * sizeof(double));
+  if (data.dx == NULL || data.dv == NULL || data.x_rec == NULL ||
+      data.v_rec == NULL)
+    error("Unable to allocate memory for the delta frame");
+  data.dt = time - previous->time;
+  data.quantum_x = e->snapshot_delta_position_quantum;
+  data.quantum_v = e->snapshot_delta_velocity_quantum;
+  data.periodic = e->s->periodic;
+  for (int k = 0; k < 3; ++k) data.box[k] = box[k];
+
+  if (N > 0)
+    threadpool_map(&e->threadpool, snapshot_delta_quantise_mapper, NULL, N, 1,
+                   threadpool_auto_chunk_size, &data);
+
+  /* Write the frame */
+  char fileName[FILENAME_BUFFER_SIZE];
+  snapshot_delta_get_filename(e, fileName);
+
+  const hid_t h_file = H5Fcreate(fileName, H5F_ACC_TRUNC, H5P_DEFAULT,
+                                 H5P_DEFAULT);
+  if (h_file < 0) error("Error while opening file '%s'.", fileName);
+
+  hid_t h_grp =
+      H5Gcreate(h_file, "/Header", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  if (h_grp < 0) error("Error while creating file header\n");
+  io_write_attribute_s(h_grp, "Code", "SWIFT");
+  io_write_attribute_s(h_grp, "Frame type", "Delta");
+  io_write_attribute_s(h_grp, "Previous frame", previous->last_frame);
+  io_write_attribute_d(h_grp, "Time", time);
+  io_write_attribute_d(h_grp, "Time since previous frame", data.dt);
+  io_write_attribute(h_grp, "BoxSize", DOUBLE, box, 3);
+  io_write_attribute_i(h_grp, "Periodic", e->s->periodic);
+  io_write_attribute_ll(h_grp, "NumPart", (long long)N);
+  io_write_attribute_d(h_grp, "Position quantum", data.quantum_x);
+  io_write_attribute_d(h_grp, "Velocity quantum", data.quantum_v);
+  H5Gclose(h_grp);
+
+  io_write_unit_system(h_file, snapshot_units, "Units");
+
+  h_grp = H5Gcreate(h_file, "/PartType0", H5P_DEFAULT, H5P_DEFAULT,
+                    H5P_DEFAULT);
+  if (h_grp < 0) error("Error while creating particle group.");
+  if (N > 0) {
+    io_write_array(h_grp, N, /*dim=*/1, id_deltas, LONGLONG,
+                   "ParticleIDDeltas", "delta frame");
+    io_write_array(h_grp, N, /*dim=*/3, data.dx, LONGLONG,
+                   "CoordinateResiduals", "delta frame");
+    io_write_array(h_grp, N, /*dim=*/3, data.dv, LONGLONG,
+                   "VelocityResiduals", "delta frame");
+  }
+  H5Gclose(h_grp);
+  H5Fclose(h_file);
+
+  /* The reconstructed state is the reference of the next frame */
+  free(previous->ids);
+  free(previous->x);
+  free(previous->v);
+  previous->count = N;
+  previous->ids = state.ids;
+  previous->x = data.x_rec;
+  previous->v = data.v_rec;
+  previous->time = time;
+  previous->frames_since_keyframe++;
+  strcpy(previous->last_frame, fileName);
+
+  free(state.x);
+  free(state.v);
+  free(match);
+  free(id_deltas);
+  free(data.dx);
+  free(data.dv);
+
+  e->snapshot_output_count++;
+
+  if (e->verbose)
+    message("Writing delta frame '%s' took %.3f %s.", fileName,
+            clocks_from_ticks(getticks() - tic), clocks_getunit());
+}
+
+#else
+
+void snapshot_delta_record_keyframe(struct engine *e,
+                                    const struct unit_system *internal_units,
+                                    const struct unit_system *snapshot_units) {
+  error("Delta-encoded snapshots require HDF5 and a non-MPI build.");
+}
+
+void snapshot_delta_write_frame(struct engine *e,
+                                const struct unit_system *internal_units,
+                                const struct unit_system *snapshot_units) {
+  error("Delta-encoded snapshots require HDF5 and a non-MPI build.");
+}
+
+#endif /* HAVE_HDF5 && !WITH_MPI */
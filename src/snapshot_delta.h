@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#ifndef SWIFT_SNAPSHOT_DELTA_H
+#define SWIFT_SNAPSHOT_DELTA_H
+
+/* Config parameters. */
+#include <config.h>
+
+/* Local includes. */
+#include "common_io.h"
+
+/* Avoid cyclic inclusions */
+struct engine;
+struct unit_system;
+
+/**
+ * @brief State of the gas particles as reconstructed from the last frame of a
+ * delta-encoded snapshot stream.
+ *
+ * Delta frames store the quantised difference between the state of each gas
+ * particle and the state predicted from the previous frame. The writer keeps
+ * the state a reader would reconstruct (not the exact one) such that the
+ * quantisation errors do not accumulate along the stream.
+ */
+struct snapshot_delta {
+
+  /*! Number of particles in the last frame */
+  size_t count;
+
+  /*! IDs of the particles, in increasing order */
+  long long *ids;
+
+  /*! Reconstructed positions (snapshot units) */
+  double *x;
+
+  /*! Reconstructed velocities (snapshot units) */
+  double *v;
+
+  /*! Time of the last frame (snapshot units) */
+  double time;
+
+  /*! Number of delta frames written since the last keyframe */
+  int frames_since_keyframe;
+
+  /*! Name of the file containing the last frame */
+  char last_frame[FILENAME_BUFFER_SIZE];
+};
+
+int snapshot_delta_next_is_keyframe(const struct engine *e);
+void snapshot_delta_record_keyframe(struct engine *e,
+                                    const struct unit_system *internal_units,
+                                    const struct unit_system *snapshot_units);
+void snapshot_delta_write_frame(struct engine *e,
+                                const struct unit_system *internal_units,
+                                const struct unit_system *snapshot_units);
+void snapshot_delta_clean(struct snapshot_delta *d);
+
+#endif /* SWIFT_SNAPSHOT_DELTA_H */
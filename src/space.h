@@ -155,13 +155,16 @@ struct space {
   /*! Number of top-level cells that have >0 particle (of any kind) */
   int nr_local_cells_with_particles;
 
-  /*! The (level 0) cells themselves. */
+  /*! The (level 0) cells themselves. This is a dense array covering the
+   * whole grid, empty cells included, so loops run every step should go
+   * through the lists of cells with particles below instead. */
   struct cell *cells_top;
 
   /*! Buffer of unused cells for the sub-cells. One chunk per thread. */
   struct cell **cells_sub;
 
-  /*! The multipoles associated with the top-level (level 0) cells */
+  /*! The multipoles associated with the top-level (level 0) cells (dense,
+   * like #cells_top) */
   struct gravity_tensors *multipoles_top;
 
   /*! Buffer of unused multipoles for the sub-cells. One chunk per thread. */
@@ -414,6 +417,14 @@ void space_sinks_get_cell_index(struct space *s, int *sind, int *cell_counts,
                                 size_t *count_inhibited_sinks,
                                 size_t *count_extra_sinks, int verbose);
 void space_synchronize_particle_positions(struct space *s);
+void space_synchronize_part_positions_mapper(void *map_data, int nr_parts,
+                                             void *extra_data);
+void space_synchronize_spart_positions_mapper(void *map_data, int nr_sparts,
+                                              void *extra_data);
+void space_synchronize_bpart_positions_mapper(void *map_data, int nr_bparts,
+                                              void *extra_data);
+void space_synchronize_sink_positions_mapper(void *map_data, int nr_sinks,
+                                             void *extra_data);
 void space_first_init_parts(struct space *s, int verbose);
 void space_first_init_gparts(struct space *s, int verbose);
 void space_first_init_sparts(struct space *s, int verbose);
@@ -19,6 +19,9 @@
 #ifndef SWIFT_VELOCIRAPTOR_PART_H
 #define SWIFT_VELOCIRAPTOR_PART_H
 
+/* Some standard headers. */
+#include <stddef.h>
+
 #include "part_type.h"
 
 /**
@@ -64,4 +67,43 @@ struct swift_vel_part {
   int index;
 };
 
+/**
+ * @brief Access to the SWIFT particles for an in-situ analysis library.
+ *
+ * Instead of receiving a converted copy of all the particles, the library
+ * pulls them in chunks into buffers of its own, either one top-level cell at
+ * a time or by walking the array of particles of this rank. The conversion
+ * functions are thread-safe and can be called concurrently on disjoint
+ * ranges of particles.
+ *
+ * This is a proposed interface only: no version of the VELOCIraptor library
+ * accepts it yet and SWIFT always hands over a full copy of the particles
+ * through InvokeVelociraptor().
+ */
+struct swift_particle_source {
+
+  /*! Opaque pointer to pass back to the functions below. */
+  void *context;
+
+  /*! Total number of particles on this rank. */
+  size_t num_parts;
+
+  /*! Number of top-level cells. */
+  int num_cells;
+
+  /*! Largest number of particles to request in one call. */
+  size_t max_chunk_size;
+
+  /*! Number of particles in a top-level cell (0 for foreign cells). */
+  size_t (*cell_count)(void *context, const int cell_id);
+
+  /*! Convert the particles [offset, offset + count[ of a top-level cell. */
+  void (*cell_fill)(void *context, const int cell_id, const size_t offset,
+                    const size_t count, struct swift_vel_part *buffer);
+
+  /*! Convert the particles [offset, offset + count[ of this rank. */
+  void (*chunk_fill)(void *context, const size_t offset, const size_t count,
+                     struct swift_vel_part *buffer);
+};
+
 #endif /* SWIFT_VELOCIRAPTOR_PART_H */
@@ -236,6 +236,9 @@ struct task {
   /*! List of tasks unlocked by this one */
   struct task **unlock_tasks;
 
+  /*! List of active tasks unlocked by this one in the current step */
+  struct task **active_unlocks;
+
   /*! Flags used to carry additional information (e.g. sort directions) */
   long long flags;
 
@@ -252,12 +255,18 @@ struct task {
   /*! Rank of a task in the order */
   int rank;
 
-  /*! Weight of the task */
+  /*! Weight of the task, i.e. its priority in the queues */
   float weight;
 
+  /*! Estimated cost of running this task alone */
+  float cost;
+
   /*! Number of tasks unlocked by this one */
   int nr_unlock_tasks;
 
+  /*! Number of active tasks unlocked by this one in the current step */
+  int nr_active_unlocks;
+
   /*! Number of unsatisfied dependencies */
   int wait;
 
@@ -273,6 +282,13 @@ struct task {
   /*! Is this task implicit (i.e. does not do anything) ? */
   char implicit;
 
+  /*! Has this implicit task been removed from the graph of the current
+   * step? */
+  char collapsed;
+
+  /*! Does this task lead to a send to another rank in the current step? */
+  char feeds_send;
+
 #ifdef SWIFT_DEBUG_TASKS
   /*! ID of the queue or runner owning this task */
   short int rid;
@@ -191,6 +191,7 @@ int main(int argc, char *argv[]) {
   int with_line_of_sight = 0;
   int with_rt = 0;
   int with_power = 0;
+  int with_image_maps = 0;
   int verbose = 0;
   int nr_threads = 1;
   int nr_pool_threads = -1;
@@ -264,6 +265,8 @@ int main(int argc, char *argv[]) {
                   NULL, 0, 0),
       OPT_BOOLEAN(0, "power", &with_power, "Run with power spectrum outputs.",
                   NULL, 0, 0),
+      OPT_BOOLEAN(0, "image-maps", &with_image_maps,
+                  "Run with on-the-fly projected image outputs.", NULL, 0, 0),
 
       OPT_GROUP("  Simulation meta-options:\n"),
       OPT_BOOLEAN(0, "quick-lyman-alpha", &with_qla,
@@ -613,6 +616,16 @@ int main(int argc, char *argv[]) {
     return 1;
   }
 
+  if (!with_hydro && with_image_maps) {
+    if (myrank == 0) {
+      argparse_usage(&argparse);
+      printf(
+          "\nError: Cannot use image map outputs without gas, --hydro must be "
+          "chosen.\n");
+    }
+    return 1;
+  }
+
 #ifdef RT_NONE
   if (with_rt) {
     error("Running with radiative transfer but compiled without it!");
@@ -1493,6 +1506,7 @@ int main(int argc, char *argv[]) {
     if (with_sinks) engine_policies |= engine_policy_sinks;
     if (with_rt) engine_policies |= engine_policy_rt;
     if (with_power) engine_policies |= engine_policy_power_spectra;
+    if (with_image_maps) engine_policies |= engine_policy_image_maps;
 
     /* Initialize the engine with the space and policies. */
     engine_init(&e, &s, params, output_options, N_total[swift_type_gas],
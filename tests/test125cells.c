@@ -610,6 +610,9 @@ int main(int argc, char *argv[]) {
 
   struct runner runner;
   runner.e = &engine;
+#if defined(GIZMO_MFV_SPH) || defined(GIZMO_MFM_SPH)
+  runner.flux_batch.riemann.count = 0;
+#endif
 
   struct lightcone_array_props lightcone_array_properties;
   lightcone_array_properties.nr_lightcones = 0;
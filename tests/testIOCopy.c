@@ -0,0 +1,238 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+/* Some standard headers. */
+#include <config.h>
+
+/* Includes. */
+#include "swift.h"
+
+/* Number of particles and chunk size used to split the copies. The chunk
+ * size is deliberately not a multiple of the fused copy block size. */
+#define NUM_PARTS 1000
+#define CHUNK_SIZE 77
+
+#ifdef HAVE_HDF5
+
+/**
+ * @brief Conversion function used to test the converted fields.
+ */
+void convert_x_sum(const struct engine *e, const struct part *p,
+                   const struct xpart *xp, double *ret) {
+  ret[0] = p->x[0] + 2. * p->x[1] - p->x[2];
+}
+
+/**
+ * @brief Single-precision conversion function used to test the fused copy.
+ */
+void convert_h_ratio(const struct engine *e, const struct part *p,
+                     const struct xpart *xp, float *ret) {
+  ret[0] = p->h / (1.f + p->x[0]);
+}
+
+/**
+ * @brief Copies a field in chunks the same way the parallel writer does
+ * and checks every element against the particles selected by the index.
+ *
+ * @param e The #engine.
+ * @param props The #io_props of the field (with an index list).
+ * @param N The number of particles in the index list.
+ * @param parts The particles.
+ * @param index The list of particles to copy.
+ * @param us The #unit_system (internal and snapshot).
+ */
+void test_chunked_copy(const struct engine *e, struct io_props props,
+                       const size_t N, const struct part *parts,
+                       const size_t *index, const struct unit_system *us) {
+
+  const size_t copySize = io_sizeof_type(props.type) * props.dimension;
+  char *temp = (char *)malloc(N * copySize);
+  if (temp == NULL) error("Unable to allocate the buffer");
+
+  /* Copy the data in chunks */
+  size_t offset = 0;
+  size_t left = N;
+  int num_chunks = 0;
+  while (left > 0) {
+    const size_t this_chunk = (left > CHUNK_SIZE) ? CHUNK_SIZE : left;
+    io_copy_temp_buffer(temp + offset * copySize, e, props, this_chunk, us,
+                        us);
+    io_props_skip(&props, this_chunk);
+    offset += this_chunk;
+    left -= this_chunk;
+    num_chunks++;
+  }
+  if (num_chunks < 2) error("The copy was not split in chunks!");
+
+  /* Check against the particles selected by the index */
+  const double *temp_d = (const double *)temp;
+  for (size_t i = 0; i < N; i++) {
+    const struct part *p = &parts[index[i]];
+    if (props.conversion == 0) {
+      for (int k = 0; k < 3; k++)
+        if (temp_d[3 * i + k] != p->x[k])
+          error("Wrong value for '%s' element %zd (chunk %zd)", props.name, i,
+                i / CHUNK_SIZE);
+    } else {
+      double expected;
+      convert_x_sum(e, p, NULL, &expected);
+      if (temp_d[i] != expected)
+        error("Wrong value for '%s' element %zd (chunk %zd)", props.name, i,
+              i / CHUNK_SIZE);
+    }
+  }
+
+  message("'%s' copied correctly in %d chunks.", props.name, num_chunks);
+  free(temp);
+}
+
+/**
+ * @brief Copies several fields in a single fused pass over the particles and
+ * checks the buffers byte by byte against one io_copy_temp_buffer() call per
+ * field.
+ *
+ * @param e The #engine.
+ * @param props The #io_props of the fields (without index list).
+ * @param num_fields The number of fields.
+ * @param N The number of particles.
+ * @param internal_units The internal #unit_system.
+ * @param snapshot_units The #unit_system of the snapshots.
+ */
+void test_fused_copy(const struct engine *e, const struct io_props *props,
+                     const int num_fields, const size_t N,
+                     const struct unit_system *internal_units,
+                     const struct unit_system *snapshot_units) {
+
+  void *fused[num_fields];
+  for (int f = 0; f < num_fields; f++) {
+    const size_t copySize = io_sizeof_type(props[f].type) * props[f].dimension;
+    if (posix_memalign(&fused[f], IO_BUFFER_ALIGNMENT, N * copySize) != 0)
+      error("Unable to allocate the buffer");
+  }
+
+  /* All the fields at once */
+  io_copy_temp_buffers_fused(fused, e, props, num_fields, N, internal_units,
+                             snapshot_units);
+
+  /* And each field on its own */
+  for (int f = 0; f < num_fields; f++) {
+
+    const size_t copySize = io_sizeof_type(props[f].type) * props[f].dimension;
+    char *temp = NULL;
+    if (posix_memalign((void **)&temp, IO_BUFFER_ALIGNMENT, N * copySize) !=
+        0)
+      error("Unable to allocate the buffer");
+    io_copy_temp_buffer(temp, e, props[f], N, internal_units, snapshot_units);
+
+    for (size_t i = 0; i < N; i++)
+      if (memcmp(temp + i * copySize, (char *)fused[f] + i * copySize,
+                 copySize) != 0)
+        error("Fused copy of '%s' differs at element %zd", props[f].name, i);
+
+    free(temp);
+    free(fused[f]);
+  }
+
+  message("%d fields copied identically by the fused and per-field copies.",
+          num_fields);
+}
+
+#endif /* HAVE_HDF5 */
+
+int main(int argc, char *argv[]) {
+
+#ifdef HAVE_HDF5
+
+  /* Initialize CPU frequency, this also starts time. */
+  unsigned long long cpufreq = 0;
+  clocks_set_cpufreq(cpufreq);
+
+  /* Initialise a few things to get us going */
+  srand(1234);
+
+  struct unit_system us;
+  units_init_cgs(&us);
+
+  struct engine e;
+  bzero(&e, sizeof(struct engine));
+  threadpool_init(&e.threadpool, 4);
+
+  /* Create some particles */
+  struct part *parts = (struct part *)calloc(NUM_PARTS, sizeof(struct part));
+  struct xpart *xparts =
+      (struct xpart *)calloc(NUM_PARTS, sizeof(struct xpart));
+  if (parts == NULL || xparts == NULL) error("Unable to allocate particles");
+  for (int i = 0; i < NUM_PARTS; i++) {
+    for (int k = 0; k < 3; k++) parts[i].x[k] = random_uniform(0., 1.);
+    parts[i].h = random_uniform(0.01, 0.1);
+    parts[i].id = i + 1;
+  }
+
+  /* Select every third particle, in reverse order */
+  size_t N = 0;
+  size_t *index = (size_t *)malloc(NUM_PARTS * sizeof(size_t));
+  if (index == NULL) error("Unable to allocate the index");
+  for (int i = NUM_PARTS - 1; i >= 0; i -= 3) index[N++] = i;
+
+  /* A field copied straight from the particles */
+  struct io_props props =
+      io_make_output_field("Coordinates", DOUBLE, 3, UNIT_CONV_LENGTH, 1.f,
+                           parts, x, "Test positions");
+  props.index = index;
+  test_chunked_copy(&e, props, N, parts, index, &us);
+
+  /* A field going through a conversion function */
+  props = io_make_output_field_convert_part("XSum", DOUBLE, 1,
+                                            UNIT_CONV_LENGTH, 1.f, parts,
+                                            xparts, convert_x_sum, "Test sum");
+  props.index = index;
+  test_chunked_copy(&e, props, N, parts, index, &us);
+
+  /* Snapshot units differing from the internal ones such that the fused
+   * copy has to apply the conversion factors */
+  struct unit_system snap_us;
+  units_init(&snap_us, 1.98841e43, 3.08567758e24, 3.08567758e19, 1., 1.);
+
+  /* Fields of all types, with and without conversion functions */
+  struct io_props list[5];
+  list[0] = io_make_output_field("Coordinates", DOUBLE, 3, UNIT_CONV_LENGTH,
+                                 1.f, parts, x, "Test positions");
+  list[1] = io_make_output_field("SmoothingLengths", FLOAT, 1,
+                                 UNIT_CONV_LENGTH, 1.f, parts, h,
+                                 "Test smoothing lengths");
+  list[2] = io_make_output_field("ParticleIDs", ULONGLONG, 1,
+                                 UNIT_CONV_NO_UNITS, 0.f, parts, id,
+                                 "Test IDs");
+  list[3] = io_make_output_field_convert_part(
+      "XSum", DOUBLE, 1, UNIT_CONV_LENGTH, 1.f, parts, xparts, convert_x_sum,
+      "Test sum");
+  list[4] = io_make_output_field_convert_part(
+      "HRatio", FLOAT, 1, UNIT_CONV_LENGTH, 1.f, parts, xparts,
+      convert_h_ratio, "Test ratio");
+  test_fused_copy(&e, list, 5, NUM_PARTS, &us, &snap_us);
+
+  free(index);
+  free(xparts);
+  free(parts);
+  threadpool_clean(&e.threadpool);
+
+#endif /* HAVE_HDF5 */
+
+  return 0;
+}
@@ -116,8 +116,85 @@ int main(int argc, char* argv[]) {
 
       check_value(swift_corr_pot_lr, corr_pot, "corr_pot", 3.4e-3, r, r_s);
       check_value(swift_corr_f_lr, corr_f, "corr_f", 2.4e-4, r, r_s);
+
+      /* Same for the tabulated version */
+      float table_corr_f_lr, table_corr_pot_lr;
+      kernel_long_grav_eval_tabulated(r / r_s, &table_corr_f_lr,
+                                      &table_corr_pot_lr);
+
+      check_value(table_corr_pot_lr, corr_pot, "table corr_pot", 4e-6, r, r_s);
+      check_value(table_corr_f_lr, corr_f, "table corr_f", 1.2e-6, r, r_s);
+    }
+  }
+
+  /* Check the vectorised version against the scalar one (including beyond
+   * the end of the table) */
+#ifdef WITH_VECTORIZATION
+  for (int n = 0; n < num_tests; ++n) {
+
+    vector u;
+    for (int k = 0; k < VEC_SIZE; ++k)
+      u.f[k] = 12.f * rand() / ((float)RAND_MAX);
+
+    vector corr_f_vec, corr_pot_vec;
+    kernel_long_grav_eval_vec(&u, &corr_f_vec, &corr_pot_vec);
+
+    for (int k = 0; k < VEC_SIZE; ++k) {
+      float corr_f, corr_pot;
+      kernel_long_grav_eval_tabulated(u.f[k], &corr_f, &corr_pot);
+
+      if (fabsf(corr_f - corr_f_vec.f[k]) > 1e-6f * fabsf(corr_f) ||
+          fabsf(corr_pot - corr_pot_vec.f[k]) > 1e-6f * fabsf(corr_pot))
+        error(
+            "Vector and scalar versions inconsistent for r/r_s=%e: "
+            "corr_f=%e/%e corr_pot=%e/%e",
+            u.f[k], corr_f, corr_f_vec.f[k], corr_pot, corr_pot_vec.f[k]);
     }
   }
+#endif
+
+  /* Now time the different versions */
+  const int num_vals = 1 << 24;
+  float *data = NULL, *out = NULL;
+  if (posix_memalign((void**)&data, 64, num_vals * sizeof(float)) != 0 ||
+      posix_memalign((void**)&out, 64, num_vals * sizeof(float)) != 0)
+    error("Failed to allocate memory for the timing test");
+  for (int k = 0; k < num_vals; k++) {
+    data[k] = 5.f * rand() / ((float)RAND_MAX);
+    out[k] = 0.f;
+  }
+
+  ticks tic = getticks();
+  for (int k = 0; k < num_vals; k++) {
+    float corr_f, corr_pot;
+    kernel_long_grav_eval(data[k], &corr_f, &corr_pot);
+    out[k] = corr_f + corr_pot;
+  }
+  message("kernel_long_grav_eval           took %9.3f %s (out[0] = %e).",
+          clocks_from_ticks(getticks() - tic), clocks_getunit(), out[0]);
+
+  tic = getticks();
+  for (int k = 0; k < num_vals; k++) {
+    float corr_f, corr_pot;
+    kernel_long_grav_eval_tabulated(data[k], &corr_f, &corr_pot);
+    out[k] = corr_f + corr_pot;
+  }
+  message("kernel_long_grav_eval_tabulated took %9.3f %s (out[0] = %e).",
+          clocks_from_ticks(getticks() - tic), clocks_getunit(), out[0]);
+
+#ifdef WITH_VECTORIZATION
+  tic = getticks();
+  for (int k = 0; k < num_vals; k += VEC_SIZE) {
+    vector u, corr_f, corr_pot;
+    u.v = vec_load(&data[k]);
+    kernel_long_grav_eval_vec(&u, &corr_f, &corr_pot);
+    vec_store(vec_add(corr_f.v, corr_pot.v), &out[k]);
+  }
+  message("kernel_long_grav_eval_vec       took %9.3f %s (out[0] = %e).",
+          clocks_from_ticks(getticks() - tic), clocks_getunit(), out[0]);
+#endif
 
+  free(out);
+  free(data);
   return 0;
 }
@@ -0,0 +1,263 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#include <config.h>
+
+/* Some standard headers. */
+#include <fenv.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Local headers. */
+#include "runner_doiact_limiter_vec.h"
+#include "space_getsid.h"
+#include "swift.h"
+
+/* Number of random configurations to test */
+#define NUM_RUNS 20
+
+/* Largest time-bin given to the particles */
+#define MAX_TIME_BIN 12
+
+/* Scalar loops of the time-step limiter (see runner_doiact_limiter.c) */
+void runner_doself1_limiter(struct runner *r, struct cell *restrict c);
+void runner_dopair1_limiter(struct runner *r, struct cell *ci, struct cell *cj,
+                            const int sid, const double *shift);
+
+/**
+ * @brief Constructs a cell with randomly placed particles with random
+ * smoothing lengths and time-bins.
+ *
+ * @param count The number of particles.
+ * @param offset The position of the cell.
+ * @param size The cell size.
+ * @param h The mean smoothing length in units of the inter-particle
+ * separation.
+ * @param max_active_bin The largest active time-bin.
+ * @param starting Are the particles of this cell allowed to be active?
+ * @param partId The running counter of IDs.
+ */
+struct cell *make_cell(const int count, const double offset[3],
+                       const double size, const double h,
+                       const timebin_t max_active_bin, const int starting,
+                       long long *partId) {
+
+  struct cell *c = NULL;
+  if (posix_memalign((void **)&c, cell_align, sizeof(struct cell)) != 0)
+    error("Couldn't allocate the cell");
+  bzero(c, sizeof(struct cell));
+
+  if (posix_memalign((void **)&c->hydro.parts, part_align,
+                     count * sizeof(struct part)) != 0)
+    error("Couldn't allocate the particles");
+  bzero(c->hydro.parts, count * sizeof(struct part));
+
+  const double dx = size / cbrt((double)count);
+  float h_max = 0.f;
+
+  for (int i = 0; i < count; ++i) {
+    struct part *p = &c->hydro.parts[i];
+    for (int k = 0; k < 3; ++k)
+      p->x[k] = offset[k] + size * random_uniform(0., 1.);
+    p->h = h * dx * random_uniform(0.5, 1.5);
+    p->id = ++(*partId);
+
+    if (starting)
+      p->time_bin = (timebin_t)(1 + rand() % MAX_TIME_BIN);
+    else
+      p->time_bin =
+          (timebin_t)(max_active_bin + 1 +
+                      rand() % (MAX_TIME_BIN - max_active_bin));
+    p->limiter_data.wakeup = time_bin_not_awake;
+    h_max = max(h_max, p->h);
+  }
+
+  c->hydro.count = count;
+  c->hydro.h_max = h_max;
+  c->width[0] = c->width[1] = c->width[2] = size;
+  c->dmin = size;
+  c->loc[0] = offset[0];
+  c->loc[1] = offset[1];
+  c->loc[2] = offset[2];
+  c->hydro.super = c;
+  c->nodeID = 0;
+
+  /* Cells whose particles all sleep are not starting */
+  c->hydro.ti_beg_max = starting ? 0 : -1;
+
+  return c;
+}
+
+/**
+ * @brief Frees a cell and its particles.
+ */
+void clean_up(struct cell *c) {
+  free(c->hydro.parts);
+  free(c->hydro.sort);
+  free(c);
+}
+
+/**
+ * @brief Runs all the self and pair limiter interactions of the central
+ * cell, using either the scalar or the vectorised loops.
+ *
+ * @param r The #runner.
+ * @param s The #space.
+ * @param cells The 27 cells.
+ * @param vec Use the vectorised loops?
+ */
+void run_limiter(struct runner *r, const struct space *s, struct cell **cells,
+                 const int vec) {
+
+  /* The self-interactions of all the cells */
+  for (int i = 0; i < 27; ++i) {
+    if (vec)
+      runner_doself1_limiter_vec(r, cells[i]);
+    else
+      runner_doself1_limiter(r, cells[i]);
+  }
+
+  /* The pairs made of the central cell and its neighbours */
+  for (int i = 0; i < 27; ++i) {
+    if (i == 13) continue;
+
+    struct cell *ci = cells[13];
+    struct cell *cj = cells[i];
+    double shift[3] = {0., 0., 0.};
+    const int sid = space_getsid(s, &ci, &cj, shift);
+
+    if (vec)
+      runner_dopair1_limiter_vec(r, ci, cj, sid, shift);
+    else
+      runner_dopair1_limiter(r, ci, cj, sid, shift);
+  }
+}
+
+int main(int argc, char *argv[]) {
+
+  /* Initialize CPU frequency, this also starts time. */
+  unsigned long long cpufreq = 0;
+  clocks_set_cpufreq(cpufreq);
+
+/* Choke on FPEs */
+#ifdef HAVE_FE_ENABLE_EXCEPT
+  feenableexcept(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW);
+#endif
+
+#ifdef WITH_VECTORIZED_LIMITER
+
+  /* Initialise a few things to get us going */
+  srand(1234);
+
+  struct space s;
+  bzero(&s, sizeof(struct space));
+  s.periodic = 0;
+  s.dim[0] = s.dim[1] = s.dim[2] = 3.;
+
+  struct cosmology cosmo;
+  cosmology_init_no_cosmo(&cosmo);
+
+  struct engine e;
+  bzero(&e, sizeof(struct engine));
+  e.s = &s;
+  e.cosmology = &cosmo;
+  e.ti_current = 0;
+  e.nodeID = 0;
+
+  struct runner r;
+  bzero(&r, sizeof(struct runner));
+  r.e = &e;
+
+  static long long partId = 0;
+  long long num_woken = 0;
+
+  for (int n = 0; n < NUM_RUNS; ++n) {
+
+    /* Vary the fraction of active particles and the neighbour numbers */
+    const timebin_t max_active_bin = (timebin_t)(2 + n % 8);
+    const double h = random_uniform(0.8, 2.5);
+    e.max_active_bin = max_active_bin;
+
+    /* Construct the 27 cells, some of them without any active particle */
+    struct cell *cells[27];
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        for (int k = 0; k < 3; ++k) {
+          const int ind = i * 9 + j * 3 + k;
+          const double offset[3] = {i * 1., j * 1., k * 1.};
+          const int count = 20 + rand() % 130;
+          const int starting = (ind == 13) || (rand() % 4 != 0);
+          cells[ind] = make_cell(count, offset, 1., h, max_active_bin,
+                                 starting, &partId);
+          runner_do_hydro_sort(&r, cells[ind], 0x1FFF, 0, 0, 0);
+        }
+      }
+    }
+
+    /* Scalar loops first */
+    run_limiter(&r, &s, cells, /*vec=*/0);
+
+    /* Collect the result and reset the particles */
+    int total = 0;
+    for (int i = 0; i < 27; ++i) total += cells[i]->hydro.count;
+    char *wakeup = (char *)malloc(total * sizeof(char));
+    if (wakeup == NULL) error("Unable to allocate the wake-up flags");
+    for (int i = 0, m = 0; i < 27; ++i) {
+      for (int k = 0; k < cells[i]->hydro.count; ++k, ++m) {
+        struct part *p = &cells[i]->hydro.parts[k];
+        wakeup[m] = p->limiter_data.wakeup;
+        p->limiter_data.wakeup = time_bin_not_awake;
+      }
+    }
+
+    /* And now the vectorised ones */
+    run_limiter(&r, &s, cells, /*vec=*/1);
+
+    /* Verify everything */
+    for (int i = 0, m = 0; i < 27; ++i) {
+      for (int k = 0; k < cells[i]->hydro.count; ++k, ++m) {
+        const struct part *p = &cells[i]->hydro.parts[k];
+        if (p->limiter_data.wakeup != wakeup[m])
+          error(
+              "Run %d: wake-up of particle %lld in cell %d differs: scalar=%d "
+              "vectorised=%d (time-bin=%d)",
+              n, p->id, i, wakeup[m], p->limiter_data.wakeup, p->time_bin);
+        if (wakeup[m] != time_bin_not_awake) num_woken++;
+      }
+    }
+
+    free(wakeup);
+    for (int i = 0; i < 27; ++i) clean_up(cells[i]);
+  }
+
+  /* Make sure the test exercised the wake-up path */
+  if (num_woken == 0) error("No particle was woken up!");
+
+  message("%lld particles woken up identically by the scalar and vector loops.",
+          num_woken);
+
+  cache_clean(&r.ci_cache);
+  cache_clean(&r.cj_cache);
+
+#else
+  message("Vectorised time-step limiter not compiled in. Nothing to test.");
+#endif
+
+  return 0;
+}
@@ -0,0 +1,240 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+#include <config.h>
+
+/* Some standard headers. */
+#include <fenv.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Local headers. */
+#include "swift.h"
+
+/* Number of random cell pairs to test */
+#define NUM_TESTS 100
+
+/* Number of particles in each cell */
+#define NUM_GPARTS 64
+
+/* Size of the cells */
+#define CELL_SIZE 1.
+
+/* Relative error allowed by the single-precision kernel on its own */
+#define FLOAT_TOLERANCE 2e-5
+
+/**
+ * @brief Check that a and b are consistent (up to some relative error)
+ *
+ * @param a First value
+ * @param b Second value
+ * @param s String used to identify this check in messages
+ * @param rel_tol Maximal relative error
+ */
+void check_value(double a, double b, const char *s, double rel_tol) {
+  if (fabs(a - b) / fabs(a + b) > rel_tol)
+    error("Values are inconsistent: SWIFT:%12.15e true:%12.15e (%s)!", a, b, s);
+}
+
+/**
+ * @brief Places particles of random masses at random positions in a cell.
+ *
+ * @param gparts The particles.
+ * @param loc The position of the corner of the cell.
+ */
+void make_cell(struct gpart *gparts, const double loc[3]) {
+
+  bzero(gparts, NUM_GPARTS * sizeof(struct gpart));
+  for (int i = 0; i < NUM_GPARTS; ++i) {
+    for (int k = 0; k < 3; ++k)
+      gparts[i].x[k] = loc[k] + CELL_SIZE * random_uniform(0., 1.);
+    gparts[i].mass = random_uniform(0.5, 1.5);
+    gparts[i].time_bin = 1;
+    gparts[i].type = swift_type_dark_matter;
+#ifdef MULTI_SOFTENING_GRAVITY
+    gparts[i].epsilon = 0.01;
+#endif
+  }
+}
+
+/**
+ * @brief Checks the accelerations (and potentials) obtained from a field
+ * tensor against a direct double-precision sum over the source particles.
+ *
+ * @param l The field tensor (after M2L).
+ * @param pos The position of the field tensor.
+ * @param sinks The particles receiving the field.
+ * @param sources The particles that made the multipole.
+ * @param rel_tol The maximal relative error.
+ * @param s String used to identify this check in messages.
+ */
+void check_field(const struct grav_tensor *l, const double pos[3],
+                 struct gpart *sinks, const struct gpart *sources,
+                 const double rel_tol, const char *s) {
+
+  for (int i = 0; i < NUM_GPARTS; ++i) {
+
+    struct gpart *gp = &sinks[i];
+    gp->a_grav[0] = gp->a_grav[1] = gp->a_grav[2] = 0.f;
+#ifndef SWIFT_GRAVITY_NO_POTENTIAL
+    gp->potential = 0.f;
+#endif
+
+    /* Single-precision M2L, evaluated at the particle */
+    gravity_L2P(l, pos, gp);
+
+    /* Double-precision reference */
+    double a_true[3] = {0., 0., 0.};
+    double pot_true = 0.;
+    for (int j = 0; j < NUM_GPARTS; ++j) {
+      const double dx[3] = {gp->x[0] - sources[j].x[0],
+                            gp->x[1] - sources[j].x[1],
+                            gp->x[2] - sources[j].x[2]};
+      const double r = sqrt(dx[0] * dx[0] + dx[1] * dx[1] + dx[2] * dx[2]);
+      const double m = sources[j].mass;
+      pot_true -= m / r;
+      for (int k = 0; k < 3; ++k) a_true[k] -= m * dx[k] / (r * r * r);
+    }
+
+    /* Compare the norm of the error to the norm of the acceleration */
+    double diff2 = 0., norm2 = 0.;
+    for (int k = 0; k < 3; ++k) {
+      diff2 += (gp->a_grav[k] - a_true[k]) * (gp->a_grav[k] - a_true[k]);
+      norm2 += a_true[k] * a_true[k];
+    }
+    if (sqrt(diff2 / norm2) > rel_tol)
+      error(
+          "Acceleration inconsistent (%s) for particle %d: SWIFT=[%e %e %e] "
+          "true=[%e %e %e] rel. error=%e",
+          s, i, gp->a_grav[0], gp->a_grav[1], gp->a_grav[2], a_true[0],
+          a_true[1], a_true[2], sqrt(diff2 / norm2));
+
+#ifndef SWIFT_GRAVITY_NO_POTENTIAL
+    check_value(gp->potential, pot_true, s, rel_tol);
+#endif
+  }
+}
+
+int main(int argc, char *argv[]) {
+
+  /* Initialize CPU frequency, this also starts time. */
+  unsigned long long cpufreq = 0;
+  clocks_set_cpufreq(cpufreq);
+
+/* Choke on FPEs */
+#ifdef HAVE_FE_ENABLE_EXCEPT
+  feenableexcept(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW);
+#endif
+
+  /* Initialise a few things to get us going */
+  srand(1234);
+
+  struct gravity_props props;
+  bzero(&props, sizeof(struct gravity_props));
+
+  const double dim[3] = {0., 0., 0.};
+
+  struct gpart *gparts_a = NULL, *gparts_b = NULL;
+  if (posix_memalign((void **)&gparts_a, gpart_align,
+                     NUM_GPARTS * sizeof(struct gpart)) != 0 ||
+      posix_memalign((void **)&gparts_b, gpart_align,
+                     NUM_GPARTS * sizeof(struct gpart)) != 0)
+    error("Impossible to allocate the particles");
+
+  struct gravity_tensors *m_a = NULL, *m_b = NULL;
+  if (posix_memalign((void **)&m_a, SWIFT_CACHE_ALIGNMENT,
+                     sizeof(struct gravity_tensors)) != 0 ||
+      posix_memalign((void **)&m_b, SWIFT_CACHE_ALIGNMENT,
+                     sizeof(struct gravity_tensors)) != 0)
+    error("Impossible to allocate the multipoles");
+
+  double max_tol = 0.;
+
+  for (int n = 0; n < NUM_TESTS; ++n) {
+
+    /* Cell A far from the origin such that the distances between the
+     * multipoles must be computed in double before being converted */
+    const double loc_a[3] = {1000. * random_uniform(0., 1.),
+                             1000. * random_uniform(0., 1.),
+                             1000. * random_uniform(0., 1.)};
+
+    /* Cell B in a random direction, well separated from A */
+    double dir[3], dir_norm = 0.;
+    do {
+      dir_norm = 0.;
+      for (int k = 0; k < 3; ++k) {
+        dir[k] = random_uniform(-1., 1.);
+        dir_norm += dir[k] * dir[k];
+      }
+    } while (dir_norm > 1. || dir_norm < 1e-2);
+    const double dist = CELL_SIZE * random_uniform(40., 80.);
+    double loc_b[3];
+    for (int k = 0; k < 3; ++k)
+      loc_b[k] = loc_a[k] + dist * dir[k] / sqrt(dir_norm);
+
+    make_cell(gparts_a, loc_a);
+    make_cell(gparts_b, loc_b);
+
+    /* Construct the multipoles */
+    gravity_reset(m_a);
+    gravity_reset(m_b);
+    gravity_P2M(m_a, gparts_a, NUM_GPARTS, &props);
+    gravity_P2M(m_b, gparts_b, NUM_GPARTS, &props);
+
+    /* Expected truncation error of the expansion on its own */
+    const double r_ab = sqrt((m_a->CoM[0] - m_b->CoM[0]) *
+                                 (m_a->CoM[0] - m_b->CoM[0]) +
+                             (m_a->CoM[1] - m_b->CoM[1]) *
+                                 (m_a->CoM[1] - m_b->CoM[1]) +
+                             (m_a->CoM[2] - m_b->CoM[2]) *
+                                 (m_a->CoM[2] - m_b->CoM[2]));
+    const double theta = 2. * sqrt(3.) * CELL_SIZE / r_ab;
+    const double rel_tol =
+        FLOAT_TOLERANCE + pow(theta, SELF_GRAVITY_MULTIPOLE_ORDER + 1);
+    max_tol = max(max_tol, rel_tol);
+
+    /* Non-symmetric M2L from A to B */
+    struct grav_tensor l_a, l_b;
+    gravity_field_tensors_init(&l_b, 0);
+    gravity_M2L_nonsym(&l_b, &m_a->m_pole, m_b->CoM, m_a->CoM, &props,
+                       /*periodic=*/0, dim, /*rs_inv=*/0.f);
+    check_field(&l_b, m_b->CoM, gparts_b, gparts_a, rel_tol, "M2L non-sym");
+
+    /* Symmetric M2L between A and B */
+    gravity_field_tensors_init(&l_a, 0);
+    gravity_field_tensors_init(&l_b, 0);
+    gravity_M2L_symmetric(&l_a, &l_b, &m_a->m_pole, &m_b->m_pole, m_a->CoM,
+                          m_b->CoM, &props, /*periodic=*/0, dim,
+                          /*rs_inv=*/0.f);
+    check_field(&l_a, m_a->CoM, gparts_a, gparts_b, rel_tol, "M2L sym (a)");
+    check_field(&l_b, m_b->CoM, gparts_b, gparts_a, rel_tol, "M2L sym (b)");
+  }
+
+  message(
+      "Single-precision M2L (order %d) consistent with the double-precision "
+      "sums to better than %e.",
+      SELF_GRAVITY_MULTIPOLE_ORDER, max_tol);
+
+  free(m_a);
+  free(m_b);
+  free(gparts_a);
+  free(gparts_b);
+  return 0;
+}
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * This file is part of SWIFT.
+ * Copyright (c) 2026 SWIFT Collaboration
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+/* Some standard headers. */
+#include <config.h>
+
+/* Some standard headers. */
+#include <fenv.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* MPI headers. */
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+
+/* Includes. */
+#include "mesh_gravity_pencil.h"
+#include "swift.h"
+
+/* Mesh sizes to test. Odd sizes and sizes not divisible by the number of
+ * ranks give pencils of different sizes. */
+const int mesh_sizes[] = {16, 21, 30};
+
+/* Tolerance on the potential, relative to its largest value */
+const double max_rel_error = 1e-10;
+
+#if defined(WITH_MPI) && defined(HAVE_MPI_FFTW)
+
+/**
+ * @brief Value of the (random) density field in a cell of the mesh.
+ *
+ * The same values are generated on all the ranks without communication.
+ */
+double density(const int i, const int j, const int k, const int N) {
+  const unsigned int seed = (unsigned int)((i * N + j) * N + k) * 2654435761u;
+  return (double)(seed >> 8) / (double)(1u << 24);
+}
+
+/**
+ * @brief Compute the potential of a random density field with the mesh
+ * distributed in pencils and compare it to the potential of the full mesh
+ * computed on every rank.
+ *
+ * @param N The size of the mesh.
+ * @param tp The #threadpool.
+ */
+void test_pencils(const int N, struct threadpool *tp) {
+
+  const int N_half_1 = N / 2 + 1;
+  const double r_s = 1.25 * 100. / N;
+  const double box_size = 100.;
+
+  /* The potential of the full mesh */
+  double *rho = (double *)fftw_malloc(2 * N * N * N_half_1 * sizeof(double));
+  fftw_complex *frho =
+      (fftw_complex *)fftw_malloc(N * N * N_half_1 * sizeof(fftw_complex));
+  if (rho == NULL || frho == NULL) error("Failed to allocate the full mesh.");
+
+  for (int i = 0; i < N; ++i)
+    for (int j = 0; j < N; ++j)
+      for (int k = 0; k < N; ++k)
+        rho[(i * N + j) * N + k] = density(i, j, k, N);
+
+  fftw_plan forward =
+      fftw_plan_dft_r2c_3d(N, N, N, rho, frho, FFTW_ESTIMATE);
+  fftw_plan inverse =
+      fftw_plan_dft_c2r_3d(N, N, N, frho, rho, FFTW_ESTIMATE);
+  fftw_execute(forward);
+  mesh_apply_Green_function(tp, frho, 0, N, 0, N_half_1, N, r_s, box_size);
+  fftw_execute(inverse);
+  fftw_destroy_plan(forward);
+  fftw_destroy_plan(inverse);
+
+  /* The potential from the pencils */
+  struct pm_mesh_pencils p;
+  pm_mesh_pencils_init(&p, N, /*verbose=*/0);
+
+  double *data = (double *)p.data;
+  for (int i = 0; i < p.x_count; ++i)
+    for (int j = 0; j < p.y_count; ++j)
+      for (int k = 0; k < N; ++k)
+        data[(i * p.y_count + j) * 2 * N_half_1 + k] =
+            density(p.x_start + i, p.y_start + j, k, N);
+
+  pm_mesh_pencils_forward(&p);
+  mesh_apply_Green_function(tp, p.data, p.ky_start, p.ky_count, p.kz_start,
+                            p.kz_count, N, r_s, box_size);
+  pm_mesh_pencils_inverse(&p);
+
+  /* Compare the local pencils to the full mesh */
+  double max_pot = 0., max_diff = 0.;
+  for (int i = 0; i < N * N * N; ++i) max_pot = max(max_pot, fabs(rho[i]));
+  for (int i = 0; i < p.x_count; ++i) {
+    for (int j = 0; j < p.y_count; ++j) {
+      for (int k = 0; k < N; ++k) {
+        const double pot_pencil =
+            data[(i * p.y_count + j) * 2 * N_half_1 + k];
+        const double pot_full =
+            rho[((p.x_start + i) * N + p.y_start + j) * N + k];
+        max_diff = max(max_diff, fabs(pot_pencil - pot_full));
+      }
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &max_diff, 1, MPI_DOUBLE, MPI_MAX,
+                MPI_COMM_WORLD);
+
+  if (max_diff > max_rel_error * max_pot)
+    error("Pencil and full mesh potentials differ for N=%d: %e (max=%e)", N,
+          max_diff, max_pot);
+
+  if (engine_rank == 0)
+    message("N=%d on a %d x %d grid: max difference %e (max=%e).", N,
+            p.grid[0], p.grid[1], max_diff, max_pot);
+
+  pm_mesh_pencils_clean(&p);
+  fftw_free(rho);
+  fftw_free(frho);
+}
+
+#endif /* WITH_MPI && HAVE_MPI_FFTW */
+
+int main(int argc, char *argv[]) {
+
+#if defined(WITH_MPI) && defined(HAVE_MPI_FFTW)
+
+  int prov = 0;
+  if (MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &prov) !=
+      MPI_SUCCESS)
+    error("Call to MPI_Init failed.");
+  MPI_Comm_rank(MPI_COMM_WORLD, &engine_rank);
+
+  /* Initialize CPU frequency, this also starts time. */
+  unsigned long long cpufreq = 0;
+  clocks_set_cpufreq(cpufreq);
+
+/* Choke on FP-exceptions */
+#ifdef HAVE_FE_ENABLE_EXCEPT
+  feenableexcept(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW);
+#endif
+
+  struct threadpool tp;
+  threadpool_init(&tp, 1);
+
+  for (size_t n = 0; n < sizeof(mesh_sizes) / sizeof(int); ++n)
+    test_pencils(mesh_sizes[n], &tp);
+
+  threadpool_clean(&tp);
+  MPI_Finalize();
+
+#endif /* WITH_MPI && HAVE_MPI_FFTW */
+
+  return 0;
+}
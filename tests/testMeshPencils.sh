@@ -0,0 +1,10 @@
+#!/bin/bash
+
+# Compare the potential of the pencil decomposition of the mesh to the one
+# of the full mesh on a few rank counts, including ones giving uneven grids.
+for nr_ranks in 1 2 3 4 6
+do
+    ${MPIRUN:-mpirun} -np $nr_ranks ./testMeshPencils || exit 1
+done
+
+exit $?
@@ -0,0 +1,3 @@
+#!/bin/bash
+
+./testNeutrinoCosmology ./testNeutrinoCosmology.dat
@@ -0,0 +1,3 @@
+#!/bin/bash
+
+./testParser ./testParserInput.yaml
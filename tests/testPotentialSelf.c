@@ -114,6 +114,7 @@ int main(int argc, char *argv[]) {
   e.mesh = &mesh;
 
   struct gravity_props props;
+  bzero(&props, sizeof(struct gravity_props));
   props.a_smooth = 1.25;
   props.epsilon_DM_cur = eps;
   props.epsilon_baryon_cur = eps;
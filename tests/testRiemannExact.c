@@ -392,6 +392,82 @@ void check_riemann_symmetry(void) {
   }
 }
 
+/**
+ * @brief Check that the batched solvers give the same fluxes as the solver
+ * called on each problem of a random batch separately
+ */
+void check_riemann_batch(void) {
+  struct riemann_batch b;
+  float WL[5], WR[5], n_unit[3], n_norm, vij[3], flux[5];
+
+  b.count = RIEMANN_BATCH_SIZE;
+  for (int i = 0; i < RIEMANN_BATCH_SIZE; i++) {
+    b.WL[0][i] = random_uniform(0.1f, 1.0f);
+    b.WL[4][i] = random_uniform(0.1f, 1.0f);
+    b.WR[0][i] = random_uniform(0.1f, 1.0f);
+    b.WR[4][i] = random_uniform(0.1f, 1.0f);
+    for (int k = 1; k < 4; k++) {
+      b.WL[k][i] = random_uniform(-10.0f, 10.0f);
+      b.WR[k][i] = random_uniform(-10.0f, 10.0f);
+    }
+
+    n_unit[0] = random_uniform(-1.0f, 1.0f);
+    n_unit[1] = random_uniform(-1.0f, 1.0f);
+    n_unit[2] = random_uniform(-1.0f, 1.0f);
+    n_norm = sqrtf(n_unit[0] * n_unit[0] + n_unit[1] * n_unit[1] +
+                   n_unit[2] * n_unit[2]);
+    for (int k = 0; k < 3; k++) {
+      b.n[k][i] = n_unit[k] / n_norm;
+      b.vij[k][i] = random_uniform(-10.0f, 10.0f);
+    }
+  }
+
+  for (int middle_state = 0; middle_state < 2; middle_state++) {
+
+    if (middle_state)
+      riemann_solve_for_middle_state_flux_batch(&b);
+    else
+      riemann_solve_for_flux_batch(&b);
+
+    for (int i = 0; i < RIEMANN_BATCH_SIZE; i++) {
+      riemann_batch_get_problem(&b, i, WL, WR, n_unit, vij);
+
+      if (middle_state)
+        riemann_solve_for_middle_state_flux(WL, WR, n_unit, vij, flux);
+      else
+        riemann_solve_for_flux(WL, WR, n_unit, vij, flux);
+
+      /* The fluxes are sums of terms of order rho v^n that can cancel, so
+       * compare the differences to these terms rather than to the fluxes */
+      const float rho = max(WL[0], WR[0]);
+      const float P = max(WL[4], WR[4]);
+      const float v = sqrtf(WL[1] * WL[1] + WL[2] * WL[2] + WL[3] * WL[3]) +
+                      sqrtf(WR[1] * WR[1] + WR[2] * WR[2] + WR[3] * WR[3]) +
+                      sqrtf(vij[0] * vij[0] + vij[1] * vij[1] +
+                            vij[2] * vij[2]) +
+                      sqrtf(hydro_gamma * P / min(WL[0], WR[0]));
+      const float flux_scale[5] = {rho * v, rho * v * v + P, rho * v * v + P,
+                                   rho * v * v + P, (rho * v * v + P) * v};
+
+      for (int k = 0; k < 5; k++) {
+        const float diff = fabsf(b.flux[k][i] - flux[k]);
+        if (diff > 1.e-5f * flux_scale[k]) {
+          message("WL=[%.8e, %.8e, %.8e, %.8e, %.8e]", WL[0], WL[1], WL[2],
+                  WL[3], WL[4]);
+          message("WR=[%.8e, %.8e, %.8e, %.8e, %.8e]", WR[0], WR[1], WR[2],
+                  WR[3], WR[4]);
+          message("n_unit=[%.8e, %.8e, %.8e]", n_unit[0], n_unit[1],
+                  n_unit[2]);
+          message("vij=[%.8e, %.8e, %.8e]", vij[0], vij[1], vij[2]);
+          error("Batch flux %d differs from the scalar one: %.8e %.8e (%s)",
+                k, b.flux[k][i], flux[k],
+                middle_state ? "middle state" : "full flux");
+        }
+      }
+    }
+  }
+}
+
 /**
  * @brief Check the exact Riemann solver
  */
@@ -419,5 +495,10 @@ int main(int argc, char* argv[]) {
     check_riemann_symmetry();
   }
 
+  /* batch test */
+  for (int i = 0; i < 10000; ++i) {
+    check_riemann_batch();
+  }
+
   return 0;
 }